@@ -10,6 +10,7 @@
 #include "EditMenu.h"
 
 #include "common_widgets/RaCoClipboard.h"
+#include "core/ObjectsSnapshot.h"
 #include "object_tree_view/ObjectTreeDock.h"
 #include "object_tree_view/ObjectTreeDockManager.h"
 #include "object_tree_view/ObjectTreeView.h"
@@ -99,7 +100,11 @@ void EditMenu::globalPasteCallback(raco::application::RaCoApplication* racoAppli
 
 		focusedTreeView->globalPasteCallback(focusedTreeView->getSelectedInsertionTargetIndex());
 	} else {
-		auto copiedObjs = raco::RaCoClipboard::get();
-		racoApplication->activeRaCoProject().commandInterface()->pasteObjects(copiedObjs);
+		auto commandInterface = racoApplication->activeRaCoProject().commandInterface();
+		if (auto snapshot = raco::RaCoClipboard::getSnapshot()) {
+			commandInterface->pasteObjects(*snapshot);
+		} else {
+			commandInterface->pasteObjects(raco::RaCoClipboard::get());
+		}
 	}
 }
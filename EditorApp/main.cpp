@@ -133,7 +133,8 @@ int main(int argc, char *argv[]) {
 
 	auto ramsesCommandLineArgs = parser.value(forwardCommandLineArgs).toStdString();
 	raco::ramses_widgets::RendererBackend rendererBackend{parser.isSet(forwardCommandLineArgs) ? ramsesCommandLineArgs : ""};
-	raco::application::RaCoApplication app{rendererBackend, projectFile};
+	// External projects are loaded completely once a Project Browser is shown, see createAndAddProjectBrowser.
+	raco::application::RaCoApplication app{rendererBackend, projectFile, nullptr, true};
 
 	MainWindow w{&app, &rendererBackend};
 	w.show();
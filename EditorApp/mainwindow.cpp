@@ -86,6 +86,7 @@
 #include <QShortcut>
 #include <QShortcutEvent>
 #include <QTimer>
+#include <algorithm>
 #include <chrono>
 #include <string>
 #include <vector>
@@ -189,6 +190,8 @@ ads::CDockAreaWidget* createAndAddObjectTree(const char* title, const char* dock
 }
 
 ads::CDockAreaWidget* createAndAddProjectBrowser(MainWindow* mainWindow, const char* dockObjName, RaCoDockManager* dockManager, raco::object_tree::view::ObjectTreeDockManager& treeDockManager, raco::application::RaCoApplication* racoApplication, ads::CDockAreaWidget* dockArea) {
+	// The Project Browser lists all objects of the external projects, so they can't be loaded partially.
+	racoApplication->setPartialExternalProjects(false);
 	auto* model = new raco::object_tree::model::ObjectTreeViewExternalProjectModel(racoApplication->activeRaCoProject().commandInterface(), racoApplication->dataChangeDispatcher(), racoApplication->externalProjects());
 	return createAndAddObjectTree(MainWindow::DockWidgetTypes::PROJECT_BROWSER, dockObjName, model, new QSortFilterProxyModel, Queries::filterForVisibleObjects, ads::BottomDockWidgetArea, mainWindow, dockManager, treeDockManager, dockArea);
 }
@@ -516,6 +519,12 @@ void MainWindow::openProject(const QString& file) {
 		// destroying QSettings actually creates and saves settings file
 	}
 
+	// Load the external projects of the new project partially unless the restored layout has a Project Browser.
+	auto cachedDocks = dockManager_->getCachedLayoutInfo();
+	racoApplication_->setPartialExternalProjects(std::none_of(cachedDocks.begin(), cachedDocks.end(), [](const auto& dock) {
+		return dock.first == DockWidgetTypes::PROJECT_BROWSER;
+	}));
+
 	// Delete all ui widgets (and their listeners) before changing the project
 	// Don't create a new DockManager right away - making QMessageBoxes pop up messes up state restoring
 	// (see https://github.com/githubuser0xFFFF/Qt-Advanced-Docking-System/issues/315)
@@ -7,6 +7,8 @@
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
  * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
  */
+#include "application/BatchExport.h"
+#include "application/PhaseReport.h"
 #include "application/RaCoApplication.h"
 #include "components/DataChangeDispatcher.h"
 #include "components/RaCoNameConstants.h"
@@ -18,21 +20,53 @@
 #include "utils/PathUtils.h"
 
 #include <QCoreApplication>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QJsonObject>
 #include <QTimer>
+#include <algorithm>
 #include <iostream>
+#include <memory>
+#include <thread>
+
+namespace {
+
+bool writeJson(const QString& path, const QJsonObject& json) {
+	QFile file{path};
+	return file.open(QIODevice::WriteOnly) && file.write(QJsonDocument{json}.toJson()) >= 0;
+}
+
+}  // namespace
 
 class Worker : public QObject {
 	Q_OBJECT
 
 public:
-	Worker(QObject* parent, QString& projectFile, QString& exportPath, bool compressExport)
-		: QObject(parent), projectFile_(projectFile), exportPath_(exportPath), compressExport_(compressExport) {
+	Worker(QObject* parent, QString& projectFile, QString& exportPath, bool compressExport, QString& savePath, bool binaryFormat, QString& reportPath, QString& manifestPath, QString& summaryPath, int threadCount)
+		: QObject(parent), projectFile_(projectFile), exportPath_(exportPath), compressExport_(compressExport), savePath_(savePath), binaryFormat_(binaryFormat), reportPath_(reportPath), manifestPath_(manifestPath), summaryPath_(summaryPath), threadCount_(threadCount) {
+	}
+
+	int exitCode() const {
+		return exitCode_;
 	}
 
 public Q_SLOTS:
 	void run() {
+		if (!manifestPath_.isEmpty()) {
+			runBatch();
+			Q_EMIT finished();
+			return;
+		}
+
+		std::unique_ptr<raco::application::PhaseReport> report;
+		if (!reportPath_.isEmpty()) {
+			report = std::make_unique<raco::application::PhaseReport>();
+		}
+
 		raco::ramses_base::HeadlessEngineBackend backend{};
-		raco::application::RaCoApplication app{backend, projectFile_};
+		// Without Project Browser, external projects only need the objects the project uses.
+		raco::application::RaCoApplication app{backend, projectFile_, report.get(), true};
 
 		if ( !exportPath_.isEmpty() ) {
 			QString ramsesPath = exportPath_ + "." + raco::names::FILE_EXTENSION_RAMSES_EXPORT;
@@ -44,16 +78,61 @@ public Q_SLOTS:
 			}
 		}
 
+		if (!savePath_.isEmpty()) {
+			auto& project = app.activeRaCoProject();
+			project.setFileFormat(binaryFormat_ ? raco::application::RaCoProject::FileFormat::Binary : raco::application::RaCoProject::FileFormat::Json);
+			raco::application::PhaseReport::Scope phase{report.get(), "save"};
+			if (!project.saveAs(savePath_)) {
+				LOG_ERROR(raco::log_system::COMMON, "error saving project to {}", savePath_.toStdString());
+			}
+		}
+
+		if (report) {
+			// Only for the report: the first logic engine update happens in the application loop, which doesn't run
+			// before the export.
+			app.doOneLoop();
+			writeReport(*report);
+		}
+
 		Q_EMIT finished();
 	}
 
 Q_SIGNALS:
 	void finished();
 
-	private:
+private:
+	void writeReport(const raco::application::PhaseReport& report) {
+		if (!writeJson(reportPath_, report.toJson())) {
+			LOG_ERROR(raco::log_system::COMMON, "error writing report to {}", reportPath_.toStdString());
+		}
+	}
+
+	void runBatch() {
+		auto jobs = raco::application::readBatchManifest(manifestPath_, compressExport_);
+		if (!jobs) {
+			exitCode_ = 1;
+			return;
+		}
+
+		raco::ramses_base::HeadlessEngineBackend backend{};
+		raco::application::RaCoApplication app{backend};
+		auto summary = raco::application::runBatchExport(app, *jobs, threadCount_);
+		if (!summaryPath_.isEmpty() && !writeJson(summaryPath_, summary)) {
+			LOG_ERROR(raco::log_system::COMMON, "error writing batch summary to {}", summaryPath_.toStdString());
+		}
+		exitCode_ = summary["failed"].toInt() > 0 ? 1 : 0;
+	}
+
 	QString projectFile_;
 	QString exportPath_;
 	bool compressExport_;
+	QString savePath_;
+	bool binaryFormat_;
+	QString reportPath_;
+	QString manifestPath_;
+	QString summaryPath_;
+	int threadCount_;
+	int exitCode_ = 0;
 };
 
 #include "main.moc"
@@ -81,6 +160,34 @@ int main(int argc, char* argv[]) {
 		QStringList() << "c"
 					  << "compress",
 		"Compress Ramses scene on export.");
+	QCommandLineOption saveProjectAction(
+		QStringList() << "s"
+					  << "save",
+		"Save the loaded project to path, e.g. to convert it between the JSON and the binary project file format.",
+		"save-path");
+	QCommandLineOption binaryFormatAction(
+		QStringList() << "b"
+					  << "binary",
+		"Use the binary project file format when saving the project.");
+	QCommandLineOption reportAction(
+		QStringList() << "r"
+					  << "report",
+		"Write the duration and memory usage of the loading and export phases and the object counts per type to a JSON file.",
+		"report-path");
+	QCommandLineOption manifestAction(
+		QStringList() << "m"
+					  << "manifest",
+		"Export all projects listed in a JSON manifest file instead of a single project. The project, export and save options are ignored.",
+		"manifest-path");
+	QCommandLineOption summaryAction(
+		QStringList() << "summary",
+		"Write the status and duration of each job of the manifest to a JSON file.",
+		"summary-path");
+	QCommandLineOption jobsAction(
+		QStringList() << "j"
+					  << "jobs",
+		"Number of threads used to read and migrate the project files of the manifest ahead of their export.",
+		"count");
 	QCommandLineOption noDumpFileCheckOption(
 		QStringList() << "d"
 					  << "nodump",
@@ -88,6 +195,12 @@ int main(int argc, char* argv[]) {
 	parser.addOption(loadProjectAction);
 	parser.addOption(exportProjectAction);
 	parser.addOption(compressExportAction);
+	parser.addOption(saveProjectAction);
+	parser.addOption(binaryFormatAction);
+	parser.addOption(reportAction);
+	parser.addOption(manifestAction);
+	parser.addOption(summaryAction);
+	parser.addOption(jobsAction);
 	parser.addOption(noDumpFileCheckOption);
 
 	// application must be instantiated before parsing command line
@@ -126,18 +239,37 @@ int main(int argc, char* argv[]) {
 	QString exportPath{};
 	bool compressExport = parser.isSet(compressExportAction);
 	if (parser.isSet(exportProjectAction)) {
-		QFileInfo path( parser.value(exportProjectAction));
+		exportPath = raco::application::exportBasePath(parser.value(exportProjectAction));
+	}
 
-		exportPath = path.absoluteFilePath();
-		if (path.suffix().compare(raco::names::FILE_EXTENSION_RAMSES_EXPORT, Qt::CaseInsensitive) == 0) {
-			exportPath.chop(static_cast<int>(strlen(raco::names::FILE_EXTENSION_RAMSES_EXPORT) + 1));
-		} else if (path.suffix().compare(raco::names::FILE_EXTENSION_LOGIC_EXPORT, Qt::CaseInsensitive) == 0) {
-			exportPath.chop(static_cast<int>(strlen(raco::names::FILE_EXTENSION_LOGIC_EXPORT) + 1));
-		}
+	QString savePath{};
+	if (parser.isSet(saveProjectAction)) {
+		savePath = QFileInfo(parser.value(saveProjectAction)).absoluteFilePath();
+	}
+	bool binaryFormat = parser.isSet(binaryFormatAction);
+
+	QString reportPath{};
+	if (parser.isSet(reportAction)) {
+		reportPath = QFileInfo(parser.value(reportAction)).absoluteFilePath();
+	}
+
+	QString manifestPath{};
+	if (parser.isSet(manifestAction)) {
+		manifestPath = QFileInfo(parser.value(manifestAction)).absoluteFilePath();
+	}
+	QString summaryPath{};
+	if (parser.isSet(summaryAction)) {
+		summaryPath = QFileInfo(parser.value(summaryAction)).absoluteFilePath();
+	}
+	int threadCount = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+	if (parser.isSet(jobsAction)) {
+		threadCount = std::max(0, parser.value(jobsAction).toInt());
 	}
 
-	Worker* task = new Worker(&a, projectFile, exportPath, compressExport );
-	QObject::connect(task, &Worker::finished, &QCoreApplication::quit);
+	Worker* task = new Worker(&a, projectFile, exportPath, compressExport, savePath, binaryFormat, reportPath, manifestPath, summaryPath, threadCount);
+	QObject::connect(task, &Worker::finished, [task]() {
+		QCoreApplication::exit(task->exitCode());
+	});
 	QTimer::singleShot(0, task, &Worker::run);
 
 	return a.exec();
@@ -0,0 +1,55 @@
+/*
+ * SPDX-License-Identifier: MPL-2.0
+ *
+ * This file is part of Ramses Composer
+ * (see https://github.com/GENIVI/ramses-composer).
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include <QJsonObject>
+#include <QString>
+
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+namespace raco::application {
+
+class RaCoApplication;
+
+// Number of mesh files whose meshes stay loaded during a batch export after no project uses them anymore.
+constexpr size_t BATCH_MAX_UNUSED_MESH_FILES = 16;
+
+struct BatchJob {
+	QString projectFile;
+	// Export path without the file extension of the ramses or logic export files.
+	QString exportPath;
+	bool compress;
+};
+
+// Export path without the file extension of the ramses or logic export files.
+QString exportBasePath(const QString& exportPath);
+
+// Manifest format: {"jobs": [{"project": <project-path>, "export": <export-path>, "compress": <bool, optional>}, ...]}
+// Relative paths are relative to the folder of the manifest, jobs without "compress" use `defaultCompress`.
+// Returns nothing and logs an error if the manifest can't be read or is invalid.
+std::optional<std::vector<BatchJob>> readBatchManifest(const QString& manifestPath, bool defaultCompress);
+
+/**
+ * Loads and exports the projects of `jobs` one after another with `app`, which is left with a new empty project.
+ *
+ * The project files are read, parsed and migrated into the project file cache of `app` on `threadCount` worker threads
+ * ahead of their load. Meshes of up to BATCH_MAX_UNUSED_MESH_FILES files are kept loaded between the projects; there is
+ * no such cache for textures.
+ * External reference projects are loaded with only the objects the exported projects use.
+ *
+ * Returns the summary of the batch: {"jobs": [<job result>, ...], "succeeded": <count>, "failed": <count>, "totalMsec": <duration>}
+ * with the job results {"project": <path>, "export": <path>, "success": <bool>, "error": <message, if failed>,
+ * "loadMsec": <duration>, "exportMsec": <duration>, "totalMsec": <duration>}.
+ */
+QJsonObject runBatchExport(RaCoApplication& app, const std::vector<BatchJob>& jobs, int threadCount);
+
+}  // namespace raco::application
@@ -37,8 +37,14 @@ public:
 
 	bool isCurrent(const std::string& projectPath) const;
 
+	// Load projects added with addExternalProjectObjects with only the requested objects and the objects they depend on,
+	// instead of all their objects. Disabling it loads the partially loaded projects completely, e.g. when a
+	// Project Browser is opened, which lists all objects of the projects in the store.
+	void setPartialLoading(bool partial);
+
 	// @return true if loaded successfully
 	raco::core::Project* addExternalProject(const std::string& projectPath, std::vector<std::string>& pathStack) override;
+	raco::core::Project* addExternalProjectObjects(const std::string& projectPath, const std::set<std::string>& objectIDs, std::vector<std::string>& pathStack) override;
 	void removeExternalProject(const std::string& projectPath) override;
 	bool canRemoveExternalProject(const std::string& projectPath) const override;
 
@@ -67,6 +73,10 @@ private:
 
 	std::map<std::string, std::unique_ptr<RaCoProject>> externalProjects_;
 
+	bool partialLoading_ = false;
+	// Requested object IDs of the partially loaded projects.
+	std::map<std::string, std::set<std::string>> requestedObjects_;
+
 	components::ProjectFileChangeMonitor externalProjectFileChangeMonitor_;
 
 	std::unordered_map<std::string, raco::components::ProjectFileChangeMonitor::UniqueListener> externalProjectFileChangeListeners_;
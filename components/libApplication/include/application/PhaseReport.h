@@ -0,0 +1,88 @@
+/*
+ * SPDX-License-Identifier: MPL-2.0
+ *
+ * This file is part of Ramses Composer
+ * (see https://github.com/GENIVI/ramses-composer).
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include <QJsonObject>
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace raco::core {
+class Project;
+}
+
+namespace raco::application {
+
+/**
+ * Duration and memory usage of the phases of loading and exporting a project, e.g. for the timing report of RaCoHeadless.
+ *
+ * Phases are recorded with PhaseReport::Scope objects. A phase started while another one is running is nested into it,
+ * so the phases of external reference projects loaded during the extref update of a project appear below that update.
+ */
+class PhaseReport {
+public:
+	struct Phase {
+		std::string name;
+		// Names of the enclosing phases and this phase, separated by '/'.
+		std::string path;
+		int depth;
+		double startMsec;
+		double durationMsec;
+		// Resident memory of the process in bytes at the start and end of the phase, -1 if not available.
+		int64_t memoryBefore;
+		int64_t memoryAfter;
+	};
+
+	// Records the phase `name` from construction to destruction; does nothing if `report` is null.
+	class Scope {
+	public:
+		Scope(PhaseReport* report, const std::string& name);
+		~Scope();
+
+		Scope(const Scope&) = delete;
+		Scope& operator=(const Scope&) = delete;
+
+	private:
+		PhaseReport* report_;
+		size_t index_;
+	};
+
+	PhaseReport();
+
+	const std::vector<Phase>& phases() const;
+
+	// Replaces the object counts per type name with those of the instances of `project`.
+	void setObjectTypeCounts(const core::Project& project);
+	const std::map<std::string, size_t>& objectTypeCounts() const;
+
+	QJsonObject toJson() const;
+
+	// Resident memory of the process in bytes, -1 if not available on this platform.
+	static int64_t currentMemoryUsage();
+	// Maximum resident memory of the process so far in bytes, -1 if not available on this platform.
+	static int64_t peakMemoryUsage();
+
+private:
+	size_t beginPhase(const std::string& name);
+	void endPhase(size_t index);
+	double elapsedMsec() const;
+
+	std::chrono::steady_clock::time_point startTime_;
+	std::vector<Phase> phases_;
+	// Indices into phases_ of the phases currently running.
+	std::vector<size_t> running_;
+	std::map<std::string, size_t> objectTypeCounts_;
+	size_t linkCount_ = 0;
+};
+
+}  // namespace raco::application
@@ -10,10 +10,12 @@
 #pragma once
 
 #include "application/ExternalProjectsStore.h"
+#include "application/PhaseReport.h"
 #include "application/RaCoProject.h"
 #include "components/DataChangeDispatcher.h"
 #include "core/ChangeRecorder.h"
 #include "core/Project.h"
+#include "core/ProjectFileCache.h"
 #include <memory>
 
 #include "core/ExtrefOperations.h"
@@ -38,7 +40,9 @@ class RaCoApplication {
 public:
 	static const inline QString APPLICATION_NAME{"Ramses Composer"};
 
-	explicit RaCoApplication(ramses_base::BaseEngineBackend& engine, const QString& initialProject = {});
+	// If `phaseReport` is not null, the phases of loading, exporting and updating projects are recorded in it.
+	// `partialExternalProjects` applies setPartialExternalProjects before loading `initialProject`.
+	explicit RaCoApplication(ramses_base::BaseEngineBackend& engine, const QString& initialProject = {}, PhaseReport* phaseReport = nullptr, bool partialExternalProjects = false);
 
 	RaCoProject& activeRaCoProject();
 	const RaCoProject& activeRaCoProject() const;
@@ -63,7 +67,16 @@ public:
 	bool canSaveActiveProject() const;
 
 	raco::core::ExternalProjectsStoreInterface* externalProjects();
+	// Load external projects with only the objects referenced by the projects using them, see ExternalProjectsStore::setPartialLoading.
+	void setPartialExternalProjects(bool partial);
 	raco::core::MeshCache* meshCache();
+	// Keep the meshes of up to `maxCount` mesh files loaded by previous projects when switching projects,
+	// see MeshCacheImpl::setMaxUnusedEntries.
+	void setMaxUnusedMeshes(size_t maxCount);
+	// Cache of migrated project documents used when loading project files.
+	raco::serialization::ProjectFileCache* projectFileCache();
+	// Report passed to the constructor, may be null.
+	PhaseReport* phaseReport() const;
 
 	const core::SceneBackendInterface* sceneBackend() const;
 
@@ -81,6 +94,8 @@ private:
 
 	ramses_base::BaseEngineBackend* engine_;
 
+	PhaseReport* phaseReport_;
+
 	raco::components::SDataChangeDispatcher dataChangeDispatcher_;
 	raco::components::SDataChangeDispatcher dataChangeDispatcherEngine_;
 
@@ -88,6 +103,8 @@ private:
 
 	components::MeshCacheImpl meshCache_;
 
+	raco::serialization::ProjectFileCache projectFileCache_;
+
 	std::unique_ptr<RaCoProject> activeProject_;
 
 	ExternalProjectsStore externalProjectsStore_;
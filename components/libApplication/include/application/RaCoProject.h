@@ -15,12 +15,15 @@
 #include "core/Context.h"
 #include "core/Errors.h"
 #include "core/Project.h"
+#include "core/ProjectFileCache.h"
 #include "core/Undo.h"
 #include "core/Serialization.h"
+#include "core/SerializationCache.h"
 #include "user_types/UserObjectFactory.h"
 #include <QObject>
 #include <exception>
 #include <functional>
+#include <set>
 
 namespace raco::application {
 
@@ -40,20 +43,47 @@ public:
 	Q_DISABLE_COPY(RaCoProject);
 	~RaCoProject();
 
+	enum class FileFormat {
+		Json,
+		Binary
+	};
+
 	static std::unique_ptr<RaCoProject> createNew(RaCoApplication* app);
 	/**
 	 * @exception FutureFileVersion when the loaded file contains a file version which is bigger than the known versions
 	 * @exception ExtrefError
+	 *
+	 * Read-only projects are used as source of external references and are only read and copied from.
+	 * They keep no undo state, don't watch their project file and don't reload their external files:
+	 * the objects keep the state saved in the file.
+	 *
+	 * If `objectIDs` is given, only the objects with these IDs, the ProjectSettings and the objects they depend on are loaded:
+	 * referenced objects, parents and the start objects of links ending on loaded objects. Only for read-only projects used
+	 * as source of external references, since saving such a project would lose the other objects.
+	 */
+	static std::unique_ptr<RaCoProject> loadFromFile(const QString& filename, RaCoApplication* app, std::vector<std::string>& pathStack, bool readOnly = false, const std::set<std::string>* objectIDs = nullptr);
+	/**
+	 * Parse and migrate the project file and store the result in `projectFileCache`, so that a later `loadFromFile`
+	 * deserializes the cache entry without parsing or migrating the file. Uses no application state: different files
+	 * can be prepared on parallel threads.
+	 * @return true if a later load needs no parsing or migration, i.e. for binary files with the current file version
+	 * and for files with a valid cache entry. False if the file can't be read, parsed or migrated, or if migration
+	 * issues warnings: such files are not cached and the errors are reported when the file is loaded.
 	 */
-	static std::unique_ptr<RaCoProject> loadFromFile(const QString& filename, RaCoApplication* app, std::vector<std::string>& pathStack);
-	static std::unique_ptr<RaCoProject> loadFromJson(const QJsonDocument& migratedJson, const QString& filename, RaCoApplication* app, std::vector<std::string>& pathStack);
+	static bool prepareCacheEntry(const QString& filename, const raco::serialization::ProjectFileCache& projectFileCache);
+	static std::unique_ptr<RaCoProject> loadFromJson(const QJsonDocument& migratedJson, const QString& filename, RaCoApplication* app, std::vector<std::string>& pathStack, bool readOnly = false, const std::set<std::string>* objectIDs = nullptr);
 
 	QString name() const;
 
 	bool dirty() const noexcept;
+	bool readOnly() const noexcept;
 	bool save();
 	bool saveAs(const QString& fileName, bool setProjectName = false);
 
+	// Format written by save and saveAs. Loaded projects keep the format of the file they were loaded from.
+	FileFormat fileFormat() const noexcept;
+	void setFileFormat(FileFormat format);
+
 	// @exception ExtrefError
 	void updateExternalReferences(std::vector<std::string>& pathStack);
 
@@ -63,15 +93,27 @@ public:
 	raco::core::CommandInterface* commandInterface();
 	raco::core::UndoStack* undoStack();
 	raco::core::MeshCache* meshCache();
+	// Serialized instances reused by writeProject; changes released from recorder() must be passed to its invalidate.
+	raco::core::SerializationCache* serializationCache();
 
 	QJsonDocument serializeProject(const std::unordered_map<std::string, std::vector<int>>& currentVersions);
+	// Writes the text of serializeProject(currentVersions).toJson() without building the whole document in memory.
+	bool writeProject(QIODevice& device, const std::unordered_map<std::string, std::vector<int>>& currentVersions);
+	// Writes the binary encoding of serializeProject(currentVersions), also without building the document.
+	bool writeBinaryProject(QIODevice& device, const std::unordered_map<std::string, std::vector<int>>& currentVersions);
 
 Q_SIGNALS:
 	void activeProjectFileChanged();
 
 private:
+	// Number of undo stack entries below the current index which are kept in memory.
+	static constexpr size_t UNDO_SPILL_DEPTH = 100;
+
+	// Restores the references between the deserialized objects and creates the project from them.
+	static std::unique_ptr<RaCoProject> loadFromDeserialization(raco::serialization::ProjectDeserializationInfo& result, const QString& filename, RaCoApplication* app, std::vector<std::string>& pathStack, bool readOnly, const std::set<std::string>* objectIDs);
+
 	// @exception ExtrefError
-	RaCoProject(const QString& file, raco::core::Project& p, raco::core::EngineInterface* engineInterface, const raco::core::UndoStack::Callback& callback, raco::core::ExternalProjectsStoreInterface* externalProjectsStore, RaCoApplication* app, std::vector<std::string>& pathStack);
+	RaCoProject(const QString& file, raco::core::Project& p, raco::core::EngineInterface* engineInterface, const raco::core::UndoStack::Callback& callback, raco::core::ExternalProjectsStoreInterface* externalProjectsStore, RaCoApplication* app, std::vector<std::string>& pathStack, bool readOnly = false);
 
 	void onAfterProjectPathChange(const std::string& oldPath, const std::string& newPath);
 	void generateProjectSubfolder(const std::string& subFolderPath);
@@ -84,11 +126,14 @@ private:
 
 	std::shared_ptr<raco::core::BaseContext> context_;
 	bool dirty_{false};
+	bool readOnly_{false};
+	FileFormat fileFormat_{FileFormat::Json};
 
 	components::ProjectFileChangeMonitor activeProjectFileChangeMonitor_;
 	raco::components::ProjectFileChangeMonitor::UniqueListener activeProjectFileChangeListener_;
 
 	raco::core::MeshCache* meshCache_;
+	raco::core::SerializationCache serializationCache_;
 	raco::core::UndoStack undoStack_;
 	raco::core::CommandInterface commandInterface_;
 };
@@ -0,0 +1,176 @@
+/*
+ * SPDX-License-Identifier: MPL-2.0
+ *
+ * This file is part of Ramses Composer
+ * (see https://github.com/GENIVI/ramses-composer).
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "application/BatchExport.h"
+
+#include "application/RaCoApplication.h"
+#include "application/RaCoProject.h"
+#include "components/RaCoNameConstants.h"
+#include "log_system/log.h"
+#include "utils/PathUtils.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <future>
+#include <thread>
+
+namespace {
+
+double elapsedMsec(std::chrono::steady_clock::time_point start) {
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+QJsonObject runJob(raco::application::RaCoApplication& app, const raco::application::BatchJob& job) {
+	auto jobStart = std::chrono::steady_clock::now();
+	QJsonObject result{
+		{"project", job.projectFile},
+		{"export", job.exportPath}};
+
+	std::string error;
+	if (!raco::utils::path::isExistingFile(job.projectFile.toStdString()) || !raco::utils::path::userHasReadAccess(job.projectFile.toStdString())) {
+		error = "project file could not be read";
+	} else {
+		try {
+			app.switchActiveRaCoProject(job.projectFile);
+			result["loadMsec"] = elapsedMsec(jobStart);
+
+			auto exportStart = std::chrono::steady_clock::now();
+			QString ramsesPath = job.exportPath + "." + raco::names::FILE_EXTENSION_RAMSES_EXPORT;
+			QString logicPath = job.exportPath + "." + raco::names::FILE_EXTENSION_LOGIC_EXPORT;
+			app.exportProject(app.activeRaCoProject(), ramsesPath.toStdString(), logicPath.toStdString(), job.compress, error);
+			result["exportMsec"] = elapsedMsec(exportStart);
+		} catch (const raco::application::FutureFileVersion& e) {
+			error = fmt::format("project file version {} is not supported by this version", e.fileVersion_);
+		} catch (const std::exception& e) {
+			error = e.what();
+		}
+		if (!error.empty()) {
+			// Don't keep a partially loaded or failed project around for the next job.
+			app.switchActiveRaCoProject({});
+		}
+	}
+
+	if (error.empty()) {
+		LOG_INFO(raco::log_system::COMMON, "exported {} to {}", job.projectFile.toStdString(), job.exportPath.toStdString());
+	} else {
+		LOG_ERROR(raco::log_system::COMMON, "error exporting {}: {}", job.projectFile.toStdString(), error);
+		result["error"] = QString::fromStdString(error);
+	}
+	result["success"] = error.empty();
+	result["totalMsec"] = elapsedMsec(jobStart);
+	return result;
+}
+
+}  // namespace
+
+namespace raco::application {
+
+QString exportBasePath(const QString& exportPath) {
+	QFileInfo path(exportPath);
+
+	auto basePath = path.absoluteFilePath();
+	if (path.suffix().compare(raco::names::FILE_EXTENSION_RAMSES_EXPORT, Qt::CaseInsensitive) == 0) {
+		basePath.chop(static_cast<int>(strlen(raco::names::FILE_EXTENSION_RAMSES_EXPORT) + 1));
+	} else if (path.suffix().compare(raco::names::FILE_EXTENSION_LOGIC_EXPORT, Qt::CaseInsensitive) == 0) {
+		basePath.chop(static_cast<int>(strlen(raco::names::FILE_EXTENSION_LOGIC_EXPORT) + 1));
+	}
+	return basePath;
+}
+
+std::optional<std::vector<BatchJob>> readBatchManifest(const QString& manifestPath, bool defaultCompress) {
+	QFile file{manifestPath};
+	if (!file.open(QIODevice::ReadOnly)) {
+		LOG_ERROR(raco::log_system::COMMON, "manifest file could not be read {}", manifestPath.toStdString());
+		return {};
+	}
+	auto document = QJsonDocument::fromJson(file.readAll());
+	if (!document.isObject() || !document.object()["jobs"].isArray()) {
+		LOG_ERROR(raco::log_system::COMMON, "invalid manifest file {}", manifestPath.toStdString());
+		return {};
+	}
+
+	auto manifestFolder = QFileInfo(manifestPath).absoluteDir();
+	std::vector<BatchJob> jobs;
+	for (const auto& value : document.object()["jobs"].toArray()) {
+		auto job = value.toObject();
+		if (!job["project"].isString() || !job["export"].isString()) {
+			LOG_ERROR(raco::log_system::COMMON, "manifest job without project or export path in {}", manifestPath.toStdString());
+			return {};
+		}
+		jobs.emplace_back(BatchJob{
+			QDir::cleanPath(manifestFolder.absoluteFilePath(job["project"].toString())),
+			exportBasePath(QDir::cleanPath(manifestFolder.absoluteFilePath(job["export"].toString()))),
+			job["compress"].toBool(defaultCompress)});
+	}
+	return jobs;
+}
+
+QJsonObject runBatchExport(RaCoApplication& app, const std::vector<BatchJob>& jobs, int threadCount) {
+	auto batchStart = std::chrono::steady_clock::now();
+	app.setMaxUnusedMeshes(BATCH_MAX_UNUSED_MESH_FILES);
+	app.setPartialExternalProjects(true);
+
+	// The application loads and exports one project at a time. Reading, parsing and migrating the project files
+	// doesn't need the application and is done ahead on worker threads, so that loading the projects below only
+	// deserializes the project file cache entries.
+	auto projectFileCache = app.projectFileCache();
+	std::vector<std::promise<void>> prepared(jobs.size());
+	std::vector<std::future<void>> preparedFutures;
+	for (auto& promise : prepared) {
+		preparedFutures.emplace_back(promise.get_future());
+	}
+	std::atomic<size_t> nextJob{0};
+	std::vector<std::thread> threads;
+	for (int thread = 0; thread < std::min<int>(threadCount, static_cast<int>(jobs.size())); thread++) {
+		threads.emplace_back([&jobs, &prepared, &nextJob, projectFileCache]() {
+			for (size_t index = nextJob++; index < jobs.size(); index = nextJob++) {
+				RaCoProject::prepareCacheEntry(jobs[index].projectFile, *projectFileCache);
+				prepared[index].set_value();
+			}
+		});
+	}
+
+	QJsonArray results;
+	int failedCount = 0;
+	for (size_t index = 0; index < jobs.size(); index++) {
+		if (threads.empty()) {
+			prepared[index].set_value();
+		}
+		preparedFutures[index].wait();
+		auto result = runJob(app, jobs[index]);
+		if (!result["success"].toBool()) {
+			failedCount++;
+		}
+		results.append(result);
+	}
+	for (auto& thread : threads) {
+		thread.join();
+	}
+
+	app.switchActiveRaCoProject({});
+	app.setMaxUnusedMeshes(0);
+	app.setPartialExternalProjects(false);
+
+	LOG_INFO(raco::log_system::COMMON, "batch export finished: {} of {} jobs failed", failedCount, jobs.size());
+	return QJsonObject{
+		{"jobs", results},
+		{"succeeded", static_cast<int>(jobs.size()) - failedCount},
+		{"failed", failedCount},
+		{"totalMsec", elapsedMsec(batchStart)}};
+}
+
+}  // namespace raco::application
@@ -13,6 +13,8 @@
 
 #include "utils/PathUtils.h"
 
+#include <algorithm>
+
 namespace raco::application {
 
 ExternalProjectsStore::ExternalProjectsStore(RaCoApplication* app) : application_(app) {
@@ -21,9 +23,32 @@ ExternalProjectsStore::ExternalProjectsStore(RaCoApplication* app) : application
 void ExternalProjectsStore::clear() {
 	activeProject_ = nullptr;
 	externalProjects_.clear();
+	requestedObjects_.clear();
 	externalProjectFileChangeListeners_.clear();
 }
 
+void ExternalProjectsStore::setPartialLoading(bool partial) {
+	partialLoading_ = partial;
+	if (partial || requestedObjects_.empty()) {
+		return;
+	}
+
+	// Reload the partially loaded projects completely, the projects they use first: loading a project updates its
+	// external references from the projects already in the store.
+	std::vector<ProjectGraphNode> orderedProjects;
+	for (const auto& item : externalProjects_) {
+		buildProjectGraph(item.first, orderedProjects);
+	}
+	auto partialProjects = std::move(requestedObjects_);
+	requestedObjects_.clear();
+	for (const auto& node : orderedProjects) {
+		if (partialProjects.find(node.path) != partialProjects.end()) {
+			std::vector<std::string> stack;
+			loadExternalProject(node.path, stack);
+		}
+	}
+}
+
 void ExternalProjectsStore::setActiveProject(RaCoProject* activeProject) {
 	activeProject_ = activeProject;
 }
@@ -127,6 +152,29 @@ raco::core::Project* ExternalProjectsStore::addExternalProject(const std::string
 	return nullptr;
 }
 
+raco::core::Project* ExternalProjectsStore::addExternalProjectObjects(const std::string& projectPath, const std::set<std::string>& objectIDs, std::vector<std::string>& pathStack) {
+	if (!partialLoading_) {
+		return addExternalProject(projectPath, pathStack);
+	}
+
+	auto it = externalProjects_.find(projectPath);
+	if (it == externalProjects_.end()) {
+		requestedObjects_[projectPath] = objectIDs;
+		return addExternalProject(projectPath, pathStack);
+	}
+
+	// Reload partially loaded projects without some of the objects, unless the project is still being loaded.
+	auto requestedIt = requestedObjects_.find(projectPath);
+	if (it->second && requestedIt != requestedObjects_.end() &&
+		!std::includes(requestedIt->second.begin(), requestedIt->second.end(), objectIDs.begin(), objectIDs.end()) &&
+		std::find(pathStack.begin(), pathStack.end(), projectPath) == pathStack.end()) {
+		requestedIt->second.insert(objectIDs.begin(), objectIDs.end());
+		loadExternalProject(projectPath, pathStack);
+		it = externalProjects_.find(projectPath);
+	}
+	return it->second ? it->second->project() : nullptr;
+}
+
 std::string ExternalProjectsStore::activeProjectPath() const {
 	if (activeProject_ && !activeProject_->project()->currentFileName().empty()) {
 		return activeProject_->project()->currentPath();
@@ -140,7 +188,9 @@ bool ExternalProjectsStore::loadExternalProject(const std::string& projectPath,
 	if (utils::path::isExistingFile(projectPath)) {
 		if (projectPath != activeProjectPath()) {
 			try {
-				project = RaCoProject::loadFromFile(QString::fromStdString(projectPath), application_, pathStack);
+				auto requestedIt = requestedObjects_.find(projectPath);
+				project = RaCoProject::loadFromFile(QString::fromStdString(projectPath), application_, pathStack, true,
+					requestedIt != requestedObjects_.end() ? &requestedIt->second : nullptr);
 				success = true;
 			} catch (raco::application::FutureFileVersion& fileVerError) {
 				LOG_ERROR(raco::log_system::OBJECT_TREE_VIEW, "Can not add Project {} to Project Browser - incompatible file version {} of project file", projectPath, fileVerError.fileVersion_);
@@ -170,6 +220,7 @@ bool ExternalProjectsStore::canRemoveExternalProject(const std::string& projectP
 void ExternalProjectsStore::removeExternalProject(const std::string& projectPath) {
 	if (canRemoveExternalProject(projectPath)) {
 		externalProjects_.erase(externalProjects_.find(projectPath));
+		requestedObjects_.erase(projectPath);
 		externalProjectFileChangeListeners_.erase(projectPath);
 
 		application_->dataChangeDispatcher()->setExternalProjectChanged();
@@ -0,0 +1,145 @@
+/*
+ * SPDX-License-Identifier: MPL-2.0
+ *
+ * This file is part of Ramses Composer
+ * (see https://github.com/GENIVI/ramses-composer).
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "application/PhaseReport.h"
+
+#include "core/Project.h"
+
+#include <QJsonArray>
+#include <QtGlobal>
+
+#include <cassert>
+#include <fstream>
+
+#if defined(Q_OS_WIN)
+#include <Windows.h>
+#include <Psapi.h>
+#elif defined(Q_OS_UNIX)
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+namespace raco::application {
+
+PhaseReport::Scope::Scope(PhaseReport* report, const std::string& name) : report_(report), index_(report ? report->beginPhase(name) : 0) {
+}
+
+PhaseReport::Scope::~Scope() {
+	if (report_) {
+		report_->endPhase(index_);
+	}
+}
+
+PhaseReport::PhaseReport() : startTime_(std::chrono::steady_clock::now()) {
+}
+
+const std::vector<PhaseReport::Phase>& PhaseReport::phases() const {
+	return phases_;
+}
+
+size_t PhaseReport::beginPhase(const std::string& name) {
+	auto path = running_.empty() ? name : phases_[running_.back()].path + "/" + name;
+	phases_.emplace_back(Phase{name, path, static_cast<int>(running_.size()), elapsedMsec(), 0.0, currentMemoryUsage(), -1});
+	running_.emplace_back(phases_.size() - 1);
+	return phases_.size() - 1;
+}
+
+void PhaseReport::endPhase(size_t index) {
+	assert(!running_.empty() && running_.back() == index);
+	auto& phase = phases_[index];
+	phase.durationMsec = elapsedMsec() - phase.startMsec;
+	phase.memoryAfter = currentMemoryUsage();
+	running_.pop_back();
+}
+
+double PhaseReport::elapsedMsec() const {
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime_).count();
+}
+
+void PhaseReport::setObjectTypeCounts(const core::Project& project) {
+	objectTypeCounts_.clear();
+	for (const auto& instance : project.instances()) {
+		++objectTypeCounts_[instance->getTypeDescription().typeName];
+	}
+	linkCount_ = project.links().size();
+}
+
+const std::map<std::string, size_t>& PhaseReport::objectTypeCounts() const {
+	return objectTypeCounts_;
+}
+
+QJsonObject PhaseReport::toJson() const {
+	QJsonArray phases;
+	for (const auto& phase : phases_) {
+		phases.append(QJsonObject{
+			{"name", QString::fromStdString(phase.name)},
+			{"path", QString::fromStdString(phase.path)},
+			{"depth", phase.depth},
+			{"startMsec", phase.startMsec},
+			{"durationMsec", phase.durationMsec},
+			{"memoryBefore", static_cast<qint64>(phase.memoryBefore)},
+			{"memoryAfter", static_cast<qint64>(phase.memoryAfter)},
+			{"memoryDelta", phase.memoryBefore < 0 || phase.memoryAfter < 0 ? 0 : static_cast<qint64>(phase.memoryAfter - phase.memoryBefore)}});
+	}
+
+	QJsonObject typeCounts;
+	size_t objectCount = 0;
+	for (const auto& [typeName, count] : objectTypeCounts_) {
+		typeCounts.insert(QString::fromStdString(typeName), static_cast<qint64>(count));
+		objectCount += count;
+	}
+
+	return QJsonObject{
+		{"totalMsec", elapsedMsec()},
+		{"peakMemory", static_cast<qint64>(peakMemoryUsage())},
+		{"phases", phases},
+		{"objectCount", static_cast<qint64>(objectCount)},
+		{"linkCount", static_cast<qint64>(linkCount_)},
+		{"objectTypeCounts", typeCounts}};
+}
+
+int64_t PhaseReport::currentMemoryUsage() {
+#if defined(Q_OS_WIN)
+	PROCESS_MEMORY_COUNTERS counters;
+	if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+		return static_cast<int64_t>(counters.WorkingSetSize);
+	}
+#elif defined(Q_OS_LINUX)
+	// Second field of statm is the number of resident pages.
+	std::ifstream statm{"/proc/self/statm"};
+	int64_t size = 0;
+	int64_t resident = 0;
+	if (statm >> size >> resident) {
+		return resident * static_cast<int64_t>(sysconf(_SC_PAGESIZE));
+	}
+#endif
+	return -1;
+}
+
+int64_t PhaseReport::peakMemoryUsage() {
+#if defined(Q_OS_WIN)
+	PROCESS_MEMORY_COUNTERS counters;
+	if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+		return static_cast<int64_t>(counters.PeakWorkingSetSize);
+	}
+#elif defined(Q_OS_UNIX)
+	rusage usage;
+	if (getrusage(RUSAGE_SELF, &usage) == 0) {
+#if defined(Q_OS_MACOS)
+		return static_cast<int64_t>(usage.ru_maxrss);
+#else
+		// Linux reports kilobytes.
+		return static_cast<int64_t>(usage.ru_maxrss) * 1024;
+#endif
+	}
+#endif
+	return -1;
+}
+
+}  // namespace raco::application
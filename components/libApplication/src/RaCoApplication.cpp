@@ -30,21 +30,30 @@ extern Q_CORE_EXPORT int qt_ntfs_permission_lookup;
 
 namespace raco::application {
 
-RaCoApplication::RaCoApplication(ramses_base::BaseEngineBackend& engine, const QString& initialProject)
+RaCoApplication::RaCoApplication(ramses_base::BaseEngineBackend& engine, const QString& initialProject, PhaseReport* phaseReport, bool partialExternalProjects)
 	: engine_{&engine},
+	  phaseReport_{phaseReport},
 	  dataChangeDispatcher_{std::make_shared<raco::components::DataChangeDispatcher>()},
 	  dataChangeDispatcherEngine_{std::make_shared<raco::components::DataChangeDispatcher>()},
 	  scenesBackend_{new ramses_adaptor::SceneBackend(&engine, dataChangeDispatcherEngine_)},
+	  projectFileCache_{raco::core::PathManager::projectCacheDirectory()},
 	  externalProjectsStore_(this) {
 	ramses_base::enableLogicLoggerOutputToStdout(false);
 	// Preferences need to be initalized before we have a fist initial project
 	raco::components::RaCoPreferences::init();
+	externalProjectsStore_.setPartialLoading(partialExternalProjects);
 	std::vector<std::string> stack;
 	activeProject_ = initialProject.isEmpty() ? RaCoProject::createNew(this) : RaCoProject::loadFromFile(initialProject, this, stack);
 	externalProjectsStore_.setActiveProject(activeProject_.get());
+	if (phaseReport_) {
+		phaseReport_->setObjectTypeCounts(*activeProject_->project());
+	}
 
 	logicEngineNeedsUpdate_ = true;
-	scenesBackend_->setScene(activeRaCoProject().project(), activeRaCoProject().errors());
+	{
+		PhaseReport::Scope phase{phaseReport_, "scene adaptor construction"};
+		scenesBackend_->setScene(activeRaCoProject().project(), activeRaCoProject().errors());
+	}
 
 	const auto& prefs = raco::components::RaCoPreferences::instance();
 	raco::core::PathManager::setAllCachedPathRoots(activeProjectFolder(),
@@ -92,10 +101,16 @@ void RaCoApplication::switchActiveRaCoProject(const QString& file) {
 	std::vector<std::string> stack;
 	activeProject_ = file.isEmpty() ? RaCoProject::createNew(this) : RaCoProject::loadFromFile(file, this, stack);
 	externalProjectsStore_.setActiveProject(activeProject_.get());
+	if (phaseReport_) {
+		phaseReport_->setObjectTypeCounts(*activeProject_->project());
+	}
 
 	logicEngineNeedsUpdate_ = true;
 
-	scenesBackend_->setScene(activeRaCoProject().project(), activeRaCoProject().errors());
+	{
+		PhaseReport::Scope phase{phaseReport_, "scene adaptor construction"};
+		scenesBackend_->setScene(activeRaCoProject().project(), activeRaCoProject().errors());
+	}
 
 	const auto& prefs = raco::components::RaCoPreferences::instance();
 	raco::core::PathManager::setAllCachedPathRoots(activeProjectFolder(),
@@ -108,6 +123,7 @@ void RaCoApplication::switchActiveRaCoProject(const QString& file) {
 bool RaCoApplication::exportProject(const RaCoProject& project, const std::string& ramsesExport, const std::string& logicExport, bool compress, std::string& outError) const {
 	// we currently only support export of active project currently
 	assert(&project == &activeRaCoProject());
+	PhaseReport::Scope phase{phaseReport_, "export"};
 	auto status = scenesBackend_->currentScene()->saveToFile(ramsesExport.c_str(), compress);
 	if (status != ramses::StatusOK) {
 		outError = scenesBackend_->currentScene()->getStatusMessage(status);
@@ -127,6 +143,7 @@ bool RaCoApplication::exportProject(const RaCoProject& project, const std::strin
 void RaCoApplication::doOneLoop() {
 	// write data into engine
 	if (ramses_adaptor::SceneBackend::toSceneId(*activeRaCoProject().project()->settings()->sceneId_) != scenesBackend_->currentSceneId()) {
+		PhaseReport::Scope phase{phaseReport_, "scene adaptor construction"};
 		scenesBackend_->setScene(activeRaCoProject().project(), activeRaCoProject().errors());
 	}
 
@@ -149,6 +166,7 @@ void RaCoApplication::doOneLoop() {
 	auto dataChanges = activeProject_->recorder()->release();
 	dataChangeDispatcherEngine_->dispatch(dataChanges);
 	if (activeProjectRunsTimer || logicEngineNeedsUpdate_ || !dataChanges.getAllChangedObjects(true, true, true).empty()) {
+		PhaseReport::Scope phase{phaseReport_, "logic engine update"};
 		if (!engine_->logicEngine().update()) {
 			LOG_ERROR_IF(raco::log_system::RAMSES_BACKEND, !engine_->logicEngine().getErrors().empty(), "{}", LogicEngineErrors{engine_->logicEngine()});
 		}
@@ -163,6 +181,8 @@ void RaCoApplication::doOneLoop() {
 	for (auto animNode : animNodes) {
 		animNode->getInputs()->getChild("timeDelta")->set(msecDiff / 1000.0F);
 	}
+	// Includes the values read back from the engine above.
+	activeProject_->serializationCache()->invalidate(dataChanges);
 	dataChangeDispatcher_->dispatch(dataChanges);
 }
 
@@ -223,8 +243,24 @@ core::ExternalProjectsStoreInterface* RaCoApplication::externalProjects() {
 	return &externalProjectsStore_;
 }
 
+void RaCoApplication::setPartialExternalProjects(bool partial) {
+	externalProjectsStore_.setPartialLoading(partial);
+}
+
 raco::core::MeshCache* RaCoApplication::meshCache() {
 	return &meshCache_;
 }
 
+void RaCoApplication::setMaxUnusedMeshes(size_t maxCount) {
+	meshCache_.setMaxUnusedEntries(maxCount);
+}
+
+raco::serialization::ProjectFileCache* RaCoApplication::projectFileCache() {
+	return &projectFileCache_;
+}
+
+PhaseReport* RaCoApplication::phaseReport() const {
+	return phaseReport_;
+}
+
 }  // namespace raco::application
\ No newline at end of file
@@ -23,6 +23,7 @@
 #include "application/RaCoApplication.h"
 #include "components/RaCoPreferences.h"
 #include "core/RamsesProjectMigration.h"
+#include "core/BinarySerialization.h"
 #include "core/Serialization.h"
 #include "core/SerializationKeys.h"
 #include "user_types/MeshNode.h"
@@ -40,9 +41,15 @@
 
 #include <QFile>
 #include <QFileInfo>
+#include <QSaveFile>
 #include <QTextStream>
 #include "utils/stdfilesystem.h"
+#include <algorithm>
+#include <cassert>
+#include <chrono>
 #include <functional>
+#include <optional>
+#include <unordered_set>
 
 #include "core/PrefabOperations.h"
 #include "user_types/PrefabInstance.h"
@@ -51,19 +58,158 @@ namespace raco::application {
 
 using namespace raco::core;
 
-RaCoProject::RaCoProject(const QString& file, Project& p, EngineInterface* engineInterface, const UndoStack::Callback& callback, ExternalProjectsStoreInterface* externalProjectsStore, RaCoApplication* app, std::vector<std::string>& pathStack)
+namespace {
+
+std::optional<std::string> resolveReferencedId(const raco::data_storage::ValueBase& value) {
+	if (value.asRef()) {
+		return value.asRef()->objectID();
+	} else {
+		return {};
+	}
+}
+
+// IDs of the objects in `objectIDs` and of all objects they depend on: the objects they reference, their parents and the
+// start objects of the links ending on them. The ProjectSettings are always included.
+std::unordered_set<std::string> collectDependencies(const std::vector<SEditorObject>& instances, const std::vector<SLink>& links, const std::set<std::string>& objectIDs) {
+	std::map<std::string, SEditorObject> parents;
+	for (const auto& object : instances) {
+		for (const auto& child : object->children_->asVector<SEditorObject>()) {
+			if (child) {
+				parents[child->objectID()] = object;
+			}
+		}
+	}
+	std::map<std::string, std::vector<SEditorObject>> linkStartObjects;
+	for (const auto& link : links) {
+		if (*link->startObject_ && *link->endObject_) {
+			linkStartObjects[(*link->endObject_)->objectID()].emplace_back(*link->startObject_);
+		}
+	}
+
+	std::vector<SEditorObject> pending;
+	for (const auto& object : instances) {
+		if (objectIDs.find(object->objectID()) != objectIDs.end() || &object->getTypeDescription() == &ProjectSettings::typeDescription) {
+			pending.emplace_back(object);
+		}
+	}
+	std::unordered_set<std::string> dependencies;
+	while (!pending.empty()) {
+		auto object = pending.back();
+		pending.pop_back();
+		if (!dependencies.insert(object->objectID()).second) {
+			continue;
+		}
+		for (const auto& reference : Queries::findAllReferences(object)) {
+			pending.emplace_back(reference.asRef());
+		}
+		auto parentIt = parents.find(object->objectID());
+		if (parentIt != parents.end()) {
+			pending.emplace_back(parentIt->second);
+		}
+		auto linkIt = linkStartObjects.find(object->objectID());
+		if (linkIt != linkStartObjects.end()) {
+			pending.insert(pending.end(), linkIt->second.begin(), linkIt->second.end());
+		}
+	}
+	return dependencies;
+}
+
+// Parse and migrate the contents of a project file, adding the migration warnings to `migrationObjWarnings`.
+// @exception FutureFileVersion, std::runtime_error
+QJsonDocument parseAndMigrate(const QByteArray& data, RaCoProject::FileFormat fileFormat, std::unordered_map<std::string, std::string>& migrationObjWarnings, PhaseReport* phaseReport) {
+	QJsonDocument document;
+	{
+		PhaseReport::Scope phase{phaseReport, "parse"};
+		document = fileFormat == RaCoProject::FileFormat::Binary ? raco::serialization::fromBinaryProject(data) : QJsonDocument::fromJson(data);
+	}
+	if (document.isNull()) {
+		throw std::runtime_error("Loading JSON file resulted in a null document object");
+	}
+
+	auto fileVersion{raco::serialization::deserializeFileVersion(document)};
+	if (fileVersion > raco::core::RAMSES_PROJECT_FILE_VERSION) {
+		throw FutureFileVersion{fileVersion};
+	}
+
+	auto migrationStart = std::chrono::steady_clock::now();
+	QJsonDocument migratedJson;
+	{
+		PhaseReport::Scope phase{phaseReport, "migration"};
+		migratedJson = migrateProject(document, migrationObjWarnings);
+	}
+	if (fileVersion < raco::core::RAMSES_PROJECT_FILE_VERSION) {
+		auto migrationTime = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - migrationStart).count();
+		LOG_INFO(raco::log_system::PROJECT, "Migrated project from file version {} to {} in {} ms", fileVersion, raco::core::RAMSES_PROJECT_FILE_VERSION, migrationTime);
+	} else {
+		LOG_INFO(raco::log_system::PROJECT, "Project file version {} is current, migration skipped", fileVersion);
+	}
+	return migratedJson;
+}
+
+// Binary project files with the current file version need no migration and are deserialized without a JSON document.
+// @return the checked file contents, or nothing for JSON files and binary files with an older file version.
+// @exception FutureFileVersion, std::runtime_error
+std::optional<raco::serialization::BinaryProject> currentBinaryProject(const QByteArray& data, RaCoProject::FileFormat fileFormat, PhaseReport* phaseReport) {
+	if (fileFormat != RaCoProject::FileFormat::Binary) {
+		return {};
+	}
+	std::optional<raco::serialization::BinaryProject> binary;
+	{
+		PhaseReport::Scope phase{phaseReport, "parse"};
+		binary.emplace(data);
+	}
+	auto fileVersion = binary->fileVersion();
+	if (fileVersion > raco::core::RAMSES_PROJECT_FILE_VERSION) {
+		throw FutureFileVersion{fileVersion};
+	}
+	if (fileVersion < raco::core::RAMSES_PROJECT_FILE_VERSION) {
+		return {};
+	}
+	LOG_INFO(raco::log_system::PROJECT, "Project file version {} is current, migration skipped", fileVersion);
+	return binary;
+}
+
+// The migrated project in the binary format if it can be loaded without parsing and migrating the file: the file
+// itself for binary files with the current file version, otherwise the valid cache entry if there is one.
+// @exception FutureFileVersion, std::runtime_error
+std::optional<raco::serialization::BinaryProject> binaryProjectWithoutMigration(const QString& filename, const QByteArray& data, RaCoProject::FileFormat fileFormat, const raco::serialization::ProjectFileCache* projectFileCache, PhaseReport* phaseReport) {
+	if (auto binary = currentBinaryProject(data, fileFormat, phaseReport)) {
+		return binary;
+	}
+	if (!projectFileCache) {
+		return {};
+	}
+	PhaseReport::Scope phase{phaseReport, "cache lookup"};
+	auto cached = projectFileCache->lookup(filename.toStdString(), data);
+	if (cached) {
+		LOG_INFO(raco::log_system::PROJECT, "Using cached project from {}", projectFileCache->entryPath(filename.toStdString()));
+	}
+	return cached;
+}
+
+raco::serialization::DeserializationFactory deserializationFactory() {
+	return user_types::UserObjectFactoryInterface::deserializationFactory(&user_types::UserObjectFactory::getInstance());
+}
+
+}  // namespace
+
+RaCoProject::RaCoProject(const QString& file, Project& p, EngineInterface* engineInterface, const UndoStack::Callback& callback, ExternalProjectsStoreInterface* externalProjectsStore, RaCoApplication* app, std::vector<std::string>& pathStack, bool readOnly)
 	: recorder_{},
 	  errors_{&recorder_},
 	  project_{p},
 	  context_{std::make_shared<BaseContext>(&project_, engineInterface, &user_types::UserObjectFactory::getInstance(), &recorder_, &errors_)},
+	  readOnly_{readOnly},
 	  undoStack_(context_.get(), [this, callback]() {
 		  dirty_ = true;
 		  callback();
-	  }),
+	  }, !readOnly),
 	  commandInterface_(context_.get(), &undoStack_),
-	  meshCache_{app->meshCache()} {
+	  meshCache_{app->meshCache()},
+	  serializationCache_{resolveReferencedId} {
 	context_->setMeshCache(meshCache_);
 	context_->setExternalProjectsStore(externalProjectsStore);
+	// Keep only the most recent undo steps in memory and move the older ones to a temporary file.
+	undoStack_.setSpillDepth(UNDO_SPILL_DEPTH);
 	
 	// Abort file loading if we encounter external reference RenderPasses or extref cameras outside a Prefab.
 	// A bug in V0.9.0 allowed to create such projects.
@@ -122,17 +268,23 @@ RaCoProject::RaCoProject(const QString& file, Project& p, EngineInterface* engin
 		}
 	}
 	
-	context_->performExternalFileReload(project_.instances());
+	if (!readOnly_) {
+		PhaseReport::Scope phase{app->phaseReport(), "external file reload"};
+		context_->performExternalFileReload(project_.instances());
+	}
 
-	// Push currently loading project on the project load stack to enable project loop detection to work.
-	pathStack.emplace_back(file.toStdString());
-	context_->updateExternalReferences(pathStack);
-	pathStack.pop_back();
+	{
+		PhaseReport::Scope phase{app->phaseReport(), "extref update"};
+		// Push currently loading project on the project load stack to enable project loop detection to work.
+		pathStack.emplace_back(file.toStdString());
+		context_->updateExternalReferences(pathStack);
+		pathStack.pop_back();
+	}
 
 	undoStack_.reset();
 	context_->changeMultiplexer().reset();
 
-	if (!project_.currentFileName().empty()) {
+	if (!readOnly_ && !project_.currentFileName().empty()) {
 		updateActiveFileListener();
 	}
 	dirty_ = false;
@@ -221,7 +373,7 @@ std::unique_ptr<RaCoProject> RaCoProject::createNew(RaCoApplication* app) {
 	return result;
 }
 
-std::unique_ptr<RaCoProject> RaCoProject::loadFromFile(const QString& filename, RaCoApplication* app, std::vector<std::string>& pathStack) {
+std::unique_ptr<RaCoProject> RaCoProject::loadFromFile(const QString& filename, RaCoApplication* app, std::vector<std::string>& pathStack, bool readOnly, const std::set<std::string>* objectIDs) {
 	LOG_INFO(raco::log_system::PROJECT, "Loading project from {}", filename.toLatin1());
 
 	if (!raco::utils::path::isExistingFile(filename.toStdString())) {
@@ -229,26 +381,47 @@ std::unique_ptr<RaCoProject> RaCoProject::loadFromFile(const QString& filename,
 		return {};
 	}
 
-	QFile file{filename};
-	if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-		LOG_WARNING(raco::log_system::PROJECT, "Can't read file {}", filename.toLatin1());
-		return {};
-	}
-	auto document{QJsonDocument::fromJson(file.readAll())};
-	if (document.isNull()) {
-		throw std::runtime_error("Loading JSON file resulted in a null document object");
+	auto phaseReport = app->phaseReport();
+	PhaseReport::Scope loadPhase{phaseReport, "load project"};
+
+	QByteArray data;
+	{
+		PhaseReport::Scope phase{phaseReport, "file read"};
+		QFile file{filename};
+		// No text mode: binary files must be read unmodified and the JSON parser accepts any line endings.
+		if (!file.open(QIODevice::ReadOnly)) {
+			LOG_WARNING(raco::log_system::PROJECT, "Can't read file {}", filename.toLatin1());
+			return {};
+		}
+		data = file.readAll();
 	}
-	file.close();
 
-	auto fileVersion{raco::serialization::deserializeFileVersion(document)};
-	if (fileVersion > raco::core::RAMSES_PROJECT_FILE_VERSION) {
-		throw FutureFileVersion{fileVersion};
-	}
+	auto fileFormat = raco::serialization::isBinaryProject(data) ? FileFormat::Binary : FileFormat::Json;
 
 	std::unordered_map<std::string, std::string> migrationObjWarnings;
-	auto migratedJson{migrateProject(document, migrationObjWarnings)};
+	auto projectFileCache = app->projectFileCache();
+	raco::serialization::ProjectDeserializationInfo result;
+	if (auto binary = binaryProjectWithoutMigration(filename, data, fileFormat, projectFileCache, phaseReport)) {
+		PhaseReport::Scope phase{phaseReport, "deserialization"};
+		result = binary->deserialize(deserializationFactory());
+	} else {
+		auto migratedJson = parseAndMigrate(data, fileFormat, migrationObjWarnings, phaseReport);
+
+		// Migration warnings are not part of the document, so files producing them are not cached.
+		if (projectFileCache) {
+			if (migrationObjWarnings.empty()) {
+				projectFileCache->store(filename.toStdString(), data, raco::serialization::toBinaryProject(migratedJson));
+			} else {
+				projectFileCache->remove(filename.toStdString());
+			}
+		}
+
+		PhaseReport::Scope phase{phaseReport, "deserialization"};
+		result = raco::serialization::deserializeProject(migratedJson, deserializationFactory());
+	}
 
-	auto newProject = loadFromJson(migratedJson, filename, app, pathStack);
+	auto newProject = loadFromDeserialization(result, filename, app, pathStack, readOnly, objectIDs);
+	newProject->fileFormat_ = fileFormat;
 
 	for (const auto& [objectID, infoMessage] : migrationObjWarnings) {
 		if (const auto migratedObj = newProject->project()->getInstanceByID(objectID)) {
@@ -261,33 +434,88 @@ std::unique_ptr<RaCoProject> RaCoProject::loadFromFile(const QString& filename,
 	return newProject;
 }
 
-std::unique_ptr<RaCoProject> RaCoProject::loadFromJson(const QJsonDocument& migratedJson, const QString& filename, RaCoApplication* app, std::vector<std::string>& pathStack) {
-	auto result{ raco::serialization::deserializeProject(migratedJson,
-		user_types::UserObjectFactoryInterface::deserializationFactory(&user_types::UserObjectFactory::getInstance())) };
+bool RaCoProject::prepareCacheEntry(const QString& filename, const raco::serialization::ProjectFileCache& projectFileCache) {
+	QFile file{filename};
+	if (!file.open(QIODevice::ReadOnly)) {
+		return false;
+	}
+	auto data{file.readAll()};
+	file.close();
+
+	try {
+		auto fileFormat = raco::serialization::isBinaryProject(data) ? FileFormat::Binary : FileFormat::Json;
+		if (binaryProjectWithoutMigration(filename, data, fileFormat, &projectFileCache, nullptr)) {
+			return true;
+		}
+		std::unordered_map<std::string, std::string> migrationObjWarnings;
+		auto migratedJson = parseAndMigrate(data, fileFormat, migrationObjWarnings, nullptr);
+		return migrationObjWarnings.empty() && projectFileCache.store(filename.toStdString(), data, raco::serialization::toBinaryProject(migratedJson));
+	} catch (const std::exception&) {
+		return false;
+	}
+}
+
+std::unique_ptr<RaCoProject> RaCoProject::loadFromJson(const QJsonDocument& migratedJson, const QString& filename, RaCoApplication* app, std::vector<std::string>& pathStack, bool readOnly, const std::set<std::string>* objectIDs) {
+	raco::serialization::ProjectDeserializationInfo result;
+	{
+		PhaseReport::Scope phase{app->phaseReport(), "deserialization"};
+		result = raco::serialization::deserializeProject(migratedJson, deserializationFactory());
+	}
+	return loadFromDeserialization(result, filename, app, pathStack, readOnly, objectIDs);
+}
 
+std::unique_ptr<RaCoProject> RaCoProject::loadFromDeserialization(raco::serialization::ProjectDeserializationInfo& result, const QString& filename, RaCoApplication* app, std::vector<std::string>& pathStack, bool readOnly, const std::set<std::string>* objectIDs) {
 	std::vector<core::SEditorObject> instances{};
-	std::map<std::string, core::SEditorObject> instanceMap;
-	instances.reserve(result.objectsDeserialization.objects.size());
-	for (auto& d : result.objectsDeserialization.objects) {
-		auto obj = std::dynamic_pointer_cast<core::EditorObject>(d);
-		instances.push_back(obj);
-		instanceMap[obj->objectID()] = obj;
-	}
-	for (const auto& pair : result.objectsDeserialization.references) {
-		if (instanceMap.find(pair.second) != instanceMap.end()) {
-			*pair.first = instanceMap.at(pair.second);
-		} else {
-			LOG_WARNING(raco::log_system::PROJECT, "Load: referenced object not found: {}", pair.second);
+	{
+		PhaseReport::Scope phase{app->phaseReport(), "reference restore"};
+		std::map<std::string, core::SEditorObject> instanceMap;
+		instances.reserve(result.objectsDeserialization.objects.size());
+		for (auto& d : result.objectsDeserialization.objects) {
+			auto obj = std::dynamic_pointer_cast<core::EditorObject>(d);
+			instances.push_back(obj);
+			instanceMap[obj->objectID()] = obj;
+		}
+		for (const auto& pair : result.objectsDeserialization.references) {
+			if (instanceMap.find(pair.second) != instanceMap.end()) {
+				*pair.first = instanceMap.at(pair.second);
+			} else {
+				LOG_WARNING(raco::log_system::PROJECT, "Load: referenced object not found: {}", pair.second);
+			}
 		}
 	}
 
+	std::vector<SLink> links;
+	for (const auto& link : result.objectsDeserialization.links) {
+		links.emplace_back(std::dynamic_pointer_cast<Link>(link));
+	}
+
+	if (objectIDs) {
+		PhaseReport::Scope phase{app->phaseReport(), "dependency filter"};
+		auto dependencies = collectDependencies(instances, links, *objectIDs);
+		// Clearing the references to the objects left out also breaks reference cycles between them.
+		for (const auto& [value, id] : result.objectsDeserialization.references) {
+			if (dependencies.find(id) == dependencies.end()) {
+				*value = SEditorObject{};
+			}
+		}
+		instances.erase(std::remove_if(instances.begin(), instances.end(), [&dependencies](const SEditorObject& object) {
+			return dependencies.find(object->objectID()) == dependencies.end();
+		}), instances.end());
+		links.erase(std::remove_if(links.begin(), links.end(), [](const SLink& link) {
+			return !*link->startObject_ || !*link->endObject_;
+		}), links.end());
+		LOG_INFO(raco::log_system::PROJECT, "Loading {} of {} objects requested from {}", instances.size(), result.objectsDeserialization.objects.size(), filename.toLatin1());
+	}
+
 	Project p{ instances };
 	p.setCurrentPath(filename.toStdString());
 	for (const auto& instance : instances) {
 		instance->onAfterDeserialization();
 	}
-	for (const auto& link : result.objectsDeserialization.links) {
-		p.addLink(std::dynamic_pointer_cast<Link>(link));
+	// The parents are only known after onAfterDeserialization.
+	p.updateInstanceNames({instances.begin(), instances.end()});
+	for (const auto& link : links) {
+		p.addLink(link);
 	}
 	for (auto [id, info] : result.objectsDeserialization.externalProjectsMap) {
 		auto absPath = PathManager::constructAbsolutePath(p.currentFolder(), info.path);
@@ -296,6 +524,7 @@ std::unique_ptr<RaCoProject> RaCoProject::loadFromJson(const QJsonDocument& migr
 	LOG_INFO(raco::log_system::PROJECT, "Finished loading project from {}", filename.toLatin1());
 
 	Consistency::checkProjectSettings(p);
+	assert(p.checkInstanceNames());
 
 	return std::unique_ptr<RaCoProject>(new RaCoProject{
 		filename,
@@ -304,7 +533,8 @@ std::unique_ptr<RaCoProject> RaCoProject::loadFromJson(const QJsonDocument& migr
 		[app]() { app->dataChangeDispatcher()->setUndoChanged(); },
 		app->externalProjects(),
 		app,
-		pathStack });
+		pathStack,
+		readOnly });
 }
 
 QString RaCoProject::name() const {
@@ -321,20 +551,53 @@ QJsonDocument RaCoProject::serializeProject(const std::unordered_map<std::string
 		currentVersions,
 		instancesInterface, linksInterface,
 		project_.externalProjectsMap(),
-		[](const raco::data_storage::ValueBase& value) -> std::optional<std::string> {
-			if (value.asRef()) {
-				return value.asRef()->objectID();
-			} else {
-				return {};
-			}
+		resolveReferencedId);
+}
+
+bool RaCoProject::writeProject(QIODevice& device, const std::unordered_map<std::string, std::vector<int>>& currentVersions) {
+	const auto& instances{context_->project()->instances()};
+	std::vector<std::shared_ptr<ReflectionInterface>> instancesInterface{instances.begin(), instances.end()};
+	const auto& links{context_->project()->links()};
+	std::vector<std::shared_ptr<ReflectionInterface>> linksInterface{links.begin(), links.end()};
+
+	// Changes not yet released by the application loop.
+	serializationCache_.invalidate(recorder_);
+
+	return serialization::writeProject(
+		device,
+		currentVersions,
+		instancesInterface, linksInterface,
+		project_.externalProjectsMap(),
+		resolveReferencedId,
+		[this](const serialization::SReflectionInterface& object) {
+			return serializationCache_.instanceFragment(object);
 		});
 }
 
+bool RaCoProject::writeBinaryProject(QIODevice& device, const std::unordered_map<std::string, std::vector<int>>& currentVersions) {
+	const auto& instances{context_->project()->instances()};
+	std::vector<std::shared_ptr<ReflectionInterface>> instancesInterface{instances.begin(), instances.end()};
+	const auto& links{context_->project()->links()};
+	std::vector<std::shared_ptr<ReflectionInterface>> linksInterface{links.begin(), links.end()};
+
+	return serialization::writeBinaryProject(
+		device,
+		currentVersions,
+		instancesInterface, linksInterface,
+		project_.externalProjectsMap(),
+		resolveReferencedId);
+}
+
 bool RaCoProject::save() {
 	const auto path(project_.currentPath());
 	LOG_INFO(raco::log_system::PROJECT, "Saving project to {}", path);
-	QFile file{path.c_str()};
-	if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+	// QSaveFile writes to a temporary file and renames it on commit, so a failed save leaves the previous file intact.
+	QSaveFile file{path.c_str()};
+	QIODevice::OpenMode openMode{QIODevice::WriteOnly};
+	if (fileFormat_ == FileFormat::Json) {
+		openMode |= QIODevice::Text;
+	}
+	if (!file.open(openMode)) {
 		LOG_ERROR(raco::log_system::PROJECT, "Saving project failed: Could not open file for writing: {} FileError {} {}", path, file.error(), file.errorString().toStdString());
 		return false;
 	}
@@ -347,13 +610,11 @@ bool RaCoProject::save() {
 		{raco::serialization::keys::RAMSES_VERSION, {ramsesVersion.major, ramsesVersion.minor, ramsesVersion.patch}},
 		{raco::serialization::keys::RAMSES_LOGIC_ENGINE_VERSION, {static_cast<int>(ramsesLogicEngineVersion.major), static_cast<int>(ramsesLogicEngineVersion.minor), static_cast<int>(ramsesLogicEngineVersion.patch)}},
 		{raco::serialization::keys::RAMSES_COMPOSER_VERSION, {RACO_VERSION_MAJOR, RACO_VERSION_MINOR, RACO_VERSION_PATCH}}};
-	file.write(serializeProject(currentVersions).toJson());
-	if (!file.flush() || file.error() != QFile::FileError::NoError) {
+	bool written = fileFormat_ == FileFormat::Binary ? writeBinaryProject(file, currentVersions) : writeProject(file, currentVersions);
+	if (!written || !file.commit()) {
 		LOG_ERROR(raco::log_system::PROJECT, "Saving project failed: Could not write to disk: FileError {} {}", file.error(), file.errorString().toStdString());
-		file.close();
 		return false;
 	}
-	file.close();
 	generateAllProjectSubfolders();
 
 	const auto& prefs = raco::components::RaCoPreferences::instance();
@@ -395,10 +656,22 @@ bool RaCoProject::saveAs(const QString& fileName, bool setProjectName) {
 	}
 }
 
+RaCoProject::FileFormat RaCoProject::fileFormat() const noexcept {
+	return fileFormat_;
+}
+
+void RaCoProject::setFileFormat(FileFormat format) {
+	fileFormat_ = format;
+}
+
 bool RaCoProject::dirty() const noexcept {
 	return dirty_;
 }
 
+bool RaCoProject::readOnly() const noexcept {
+	return readOnly_;
+}
+
 void RaCoProject::updateExternalReferences(std::vector<std::string>& pathStack) {
 	context_->updateExternalReferences(pathStack);
 }
@@ -423,6 +696,10 @@ UndoStack* RaCoProject::undoStack() {
 	return &undoStack_;
 }
 
+SerializationCache* RaCoProject::serializationCache() {
+	return &serializationCache_;
+}
+
 MeshCache* RaCoProject::meshCache() {
 	return meshCache_;
 }
@@ -0,0 +1,107 @@
+/*
+ * SPDX-License-Identifier: MPL-2.0
+ *
+ * This file is part of Ramses Composer
+ * (see https://github.com/GENIVI/ramses-composer).
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "application/BatchExport.h"
+#include "application/RaCoApplication.h"
+#include "ramses_adaptor/SceneBackend.h"
+#include "ramses_base/BaseEngineBackend.h"
+#include "testing/TestEnvironmentCore.h"
+#include "testing/TestUtil.h"
+#include "utils/FileUtils.h"
+#include "utils/PathUtils.h"
+
+#include <QDir>
+#include <QJsonArray>
+
+using raco::application::RaCoApplication;
+
+class BatchExportFixture : public RacoBaseTest<> {
+public:
+	QString path(const std::string& relativePath) {
+		return QDir::cleanPath(QString::fromStdString((cwd_path() / relativePath).string()));
+	}
+
+	raco::ramses_base::HeadlessEngineBackend backend{};
+};
+
+TEST_F(BatchExportFixture, readManifest_missing_file) {
+	EXPECT_FALSE(raco::application::readBatchManifest(path("missing.json"), false).has_value());
+}
+
+TEST_F(BatchExportFixture, readManifest_invalid) {
+	raco::utils::file::write((cwd_path() / "not-json.json").string(), "{\"jobs\": [");
+	EXPECT_FALSE(raco::application::readBatchManifest(path("not-json.json"), false).has_value());
+
+	raco::utils::file::write((cwd_path() / "no-jobs.json").string(), R"({"projects": []})");
+	EXPECT_FALSE(raco::application::readBatchManifest(path("no-jobs.json"), false).has_value());
+
+	raco::utils::file::write((cwd_path() / "no-export.json").string(), R"({"jobs": [{"project": "project.rca"}]})");
+	EXPECT_FALSE(raco::application::readBatchManifest(path("no-export.json"), false).has_value());
+}
+
+TEST_F(BatchExportFixture, readManifest_relative_paths) {
+	raco::utils::file::write((cwd_path() / "batch" / "manifest.json").string(), R"({"jobs": [
+		{"project": "../project.rca", "export": "out/project.ramses", "compress": true},
+		{"project": "sub/other.rca", "export": "../other.logic"},
+		{"project": "third.rca", "export": "third"}
+	]})");
+
+	auto jobs = raco::application::readBatchManifest(path("batch/manifest.json"), false);
+	ASSERT_TRUE(jobs.has_value());
+	ASSERT_EQ(jobs->size(), 3);
+	EXPECT_EQ((*jobs)[0].projectFile, path("project.rca"));
+	EXPECT_EQ((*jobs)[0].exportPath, path("batch/out/project"));
+	EXPECT_TRUE((*jobs)[0].compress);
+	EXPECT_EQ((*jobs)[1].projectFile, path("batch/sub/other.rca"));
+	EXPECT_EQ((*jobs)[1].exportPath, path("other"));
+	EXPECT_FALSE((*jobs)[1].compress);
+	EXPECT_EQ((*jobs)[2].exportPath, path("batch/third"));
+
+	auto compressedJobs = raco::application::readBatchManifest(path("batch/manifest.json"), true);
+	ASSERT_TRUE(compressedJobs.has_value());
+	EXPECT_TRUE((*compressedJobs)[1].compress);
+}
+
+TEST_F(BatchExportFixture, batch_summary) {
+	{
+		RaCoApplication app{backend};
+		raco::createLinkedScene(*app.activeRaCoProject().commandInterface(), cwd_path());
+		ASSERT_TRUE(app.activeRaCoProject().saveAs(path("project.rca")));
+	}
+	raco::utils::file::write((cwd_path() / "manifest.json").string(), R"({"jobs": [
+		{"project": "project.rca", "export": "project"},
+		{"project": "missing.rca", "export": "missing"}
+	]})");
+
+	auto jobs = raco::application::readBatchManifest(path("manifest.json"), false);
+	ASSERT_TRUE(jobs.has_value());
+	RaCoApplication app{backend};
+	auto summary = raco::application::runBatchExport(app, *jobs, 2);
+
+	EXPECT_EQ(summary["succeeded"].toInt(), 1);
+	EXPECT_EQ(summary["failed"].toInt(), 1);
+	EXPECT_TRUE(summary["totalMsec"].isDouble());
+
+	auto results = summary["jobs"].toArray();
+	ASSERT_EQ(results.size(), 2);
+	auto exported = results[0].toObject();
+	EXPECT_EQ(exported["project"].toString(), path("project.rca"));
+	EXPECT_EQ(exported["export"].toString(), path("project"));
+	EXPECT_TRUE(exported["success"].toBool());
+	EXPECT_FALSE(exported.contains("error"));
+	EXPECT_TRUE(exported["loadMsec"].isDouble());
+	EXPECT_TRUE(exported["exportMsec"].isDouble());
+	EXPECT_TRUE(raco::utils::path::isExistingFile((cwd_path() / "project.ramses").string()));
+	EXPECT_TRUE(raco::utils::path::isExistingFile((cwd_path() / "project.logic").string()));
+
+	auto missing = results[1].toObject();
+	EXPECT_FALSE(missing["success"].toBool());
+	EXPECT_EQ(missing["error"].toString(), "project file could not be read");
+	EXPECT_FALSE(raco::utils::path::isExistingFile((cwd_path() / "missing.ramses").string()));
+}
@@ -11,9 +11,12 @@
 #include "ramses_adaptor/SceneBackend.h"
 #include "ramses_base/BaseEngineBackend.h"
 #include "application/RaCoProject.h"
+#include "application/PhaseReport.h"
 #include "application/RaCoApplication.h"
 #include "components/RaCoPreferences.h"
 #include "core/PathManager.h"
+#include "core/RamsesProjectMigration.h"
+#include "core/SerializationKeys.h"
 #include "testing/TestEnvironmentCore.h"
 #include "testing/TestUtil.h"
 #include "user_types/LuaScript.h"
@@ -22,8 +25,14 @@
 #include "user_types/Mesh.h"
 #include "user_types/MeshNode.h"
 #include "user_types/Node.h"
+#include "utils/FileUtils.h"
 #include "utils/PathUtils.h"
 
+#include <QBuffer>
+#include <QJsonArray>
+
+#include <algorithm>
+
 class RaCoProjectFixture : public RacoBaseTest<> {
 public:
 	raco::ramses_base::HeadlessEngineBackend backend{};
@@ -44,6 +53,171 @@ TEST_F(RaCoProjectFixture, saveLoadWithLink) {
 }
 
 
+TEST_F(RaCoProjectFixture, writeProjectMatchesSerializeProject) {
+	RaCoApplication app{backend};
+	std::unordered_map<std::string, std::vector<int>> versions = {
+		{raco::serialization::keys::FILE_VERSION, {raco::core::RAMSES_PROJECT_FILE_VERSION}},
+		{raco::serialization::keys::RAMSES_VERSION, {1, 2, 3}},
+		{raco::serialization::keys::RAMSES_LOGIC_ENGINE_VERSION, {4, 5, 6}},
+		{raco::serialization::keys::RAMSES_COMPOSER_VERSION, {7, 8, 9}}};
+
+	auto checkStreamedOutput = [&app, &versions]() {
+		QBuffer streamed;
+		ASSERT_TRUE(streamed.open(QIODevice::WriteOnly));
+		ASSERT_TRUE(app.activeRaCoProject().writeProject(streamed, versions));
+		ASSERT_EQ(streamed.data().toStdString(), app.activeRaCoProject().serializeProject(versions).toJson().toStdString());
+	};
+
+	ASSERT_TRUE(app.activeRaCoProject().project()->links().empty());
+	checkStreamedOutput();
+
+	raco::createLinkedScene(*app.activeRaCoProject().commandInterface(), cwd_path());
+	app.activeRaCoProject().project()->addExternalProjectMapping("extref_id", (cwd_path() / "lib \"quoted\".rca").string(), "lib");
+	checkStreamedOutput();
+}
+
+TEST_F(RaCoProjectFixture, writeProjectReusesSerializationCache) {
+	RaCoApplication app{backend};
+	auto& project = app.activeRaCoProject();
+	auto cmd = project.commandInterface();
+	std::unordered_map<std::string, std::vector<int>> versions = {
+		{raco::serialization::keys::FILE_VERSION, {raco::core::RAMSES_PROJECT_FILE_VERSION}},
+		{raco::serialization::keys::RAMSES_VERSION, {1, 2, 3}},
+		{raco::serialization::keys::RAMSES_LOGIC_ENGINE_VERSION, {4, 5, 6}},
+		{raco::serialization::keys::RAMSES_COMPOSER_VERSION, {7, 8, 9}}};
+
+	// Returns the number of objects serialized by the write.
+	auto checkStreamedOutput = [&project, &versions]() -> size_t {
+		auto before = project.serializationCache()->serializedCount();
+		QBuffer streamed;
+		EXPECT_TRUE(streamed.open(QIODevice::WriteOnly));
+		EXPECT_TRUE(project.writeProject(streamed, versions));
+		EXPECT_EQ(streamed.data().toStdString(), project.serializeProject(versions).toJson().toStdString());
+		return project.serializationCache()->serializedCount() - before;
+	};
+
+	auto [luaScript, node, link] = raco::createLinkedScene(*cmd, cwd_path());
+	app.doOneLoop();
+	EXPECT_EQ(checkStreamedOutput(), project.project()->instances().size());
+	EXPECT_EQ(checkStreamedOutput(), 0u);
+
+	cmd->set({node, &raco::user_types::Node::scale_, &raco::data_storage::Vec3f::y}, 2.0);
+	EXPECT_EQ(checkStreamedOutput(), 1u);
+
+	// Changes released by the application loop
+	cmd->set({node, &raco::user_types::Node::scale_, &raco::data_storage::Vec3f::z}, 3.0);
+	app.doOneLoop();
+	EXPECT_EQ(checkStreamedOutput(), 1u);
+
+	cmd->undoStack().undo();
+	EXPECT_EQ(checkStreamedOutput(), 1u);
+
+	auto child = cmd->createObject(raco::user_types::Node::typeDescription.typeName, "child");
+	cmd->moveScenegraphChildren({child}, node);
+	EXPECT_EQ(checkStreamedOutput(), 2u);
+
+	cmd->deleteObjects({child});
+	checkStreamedOutput();
+	EXPECT_EQ(project.serializationCache()->size(), project.project()->instances().size());
+}
+
+TEST_F(RaCoProjectFixture, saveLoadBinaryFormat) {
+	{
+		RaCoApplication app{backend};
+		raco::createLinkedScene(*app.activeRaCoProject().commandInterface(), cwd_path());
+		ASSERT_TRUE(app.activeRaCoProject().saveAs((cwd_path() / "project.rca").string().c_str()));
+		app.activeRaCoProject().setFileFormat(raco::application::RaCoProject::FileFormat::Binary);
+		ASSERT_TRUE(app.activeRaCoProject().saveAs((cwd_path() / "project-binary.rca").string().c_str()));
+	}
+	{
+		raco::application::PhaseReport report;
+		RaCoApplication app{backend, (cwd_path() / "project-binary.rca").string().c_str(), &report};
+		ASSERT_EQ(app.activeRaCoProject().fileFormat(), raco::application::RaCoProject::FileFormat::Binary);
+		ASSERT_EQ(1, app.activeRaCoProject().project()->links().size());
+		// Binary files with the current file version are deserialized directly.
+		for (const auto& phase : report.phases()) {
+			EXPECT_NE(phase.path, "load project/migration");
+		}
+
+		app.activeRaCoProject().setFileFormat(raco::application::RaCoProject::FileFormat::Json);
+		ASSERT_TRUE(app.activeRaCoProject().saveAs((cwd_path() / "project-from-binary.rca").string().c_str()));
+	}
+	{
+		RaCoApplication app{backend, (cwd_path() / "project.rca").string().c_str()};
+		ASSERT_EQ(app.activeRaCoProject().fileFormat(), raco::application::RaCoProject::FileFormat::Json);
+		ASSERT_TRUE(app.activeRaCoProject().saveAs((cwd_path() / "project-from-json.rca").string().c_str()));
+	}
+	ASSERT_EQ(raco::utils::file::read((cwd_path() / "project-from-json.rca").string()), raco::utils::file::read((cwd_path() / "project-from-binary.rca").string()));
+}
+
+TEST_F(RaCoProjectFixture, loadWithPhaseReport) {
+	{
+		RaCoApplication app{backend};
+		raco::createLinkedScene(*app.activeRaCoProject().commandInterface(), cwd_path());
+		ASSERT_TRUE(app.activeRaCoProject().saveAs((cwd_path() / "project.rca").string().c_str()));
+	}
+
+	raco::application::PhaseReport report;
+	RaCoApplication app{backend, (cwd_path() / "project.rca").string().c_str(), &report};
+	app.doOneLoop();
+
+	std::vector<std::string> paths;
+	for (const auto& phase : report.phases()) {
+		paths.emplace_back(phase.path);
+		EXPECT_GE(phase.durationMsec, 0.0);
+	}
+	// Parsing and migration are skipped if the project file cache has an entry for the file.
+	for (const auto& path : {"load project", "load project/file read", "load project/deserialization", "load project/reference restore",
+			 "load project/extref update", "scene adaptor construction", "logic engine update"}) {
+		EXPECT_NE(std::find(paths.begin(), paths.end(), path), paths.end()) << path;
+	}
+
+	EXPECT_EQ(report.objectTypeCounts().at(raco::user_types::LuaScript::typeDescription.typeName), 1u);
+	auto json = report.toJson();
+	EXPECT_EQ(json["linkCount"].toInt(), 1);
+	EXPECT_EQ(json["objectCount"].toInt(), static_cast<int>(app.activeRaCoProject().project()->instances().size()));
+	EXPECT_EQ(json["phases"].toArray().size(), static_cast<int>(report.phases().size()));
+}
+
+TEST_F(RaCoProjectFixture, loadPreparedCacheEntry) {
+	{
+		RaCoApplication app{backend};
+		raco::createLinkedScene(*app.activeRaCoProject().commandInterface(), cwd_path());
+		// Object with random ID, so that the cache can't have an entry from other tests.
+		app.activeRaCoProject().commandInterface()->createObject(raco::user_types::Node::typeDescription.typeName, "prepared");
+		ASSERT_TRUE(app.activeRaCoProject().saveAs((cwd_path() / "project.rca").string().c_str()));
+		ASSERT_TRUE(app.activeRaCoProject().saveAs((cwd_path() / "project-current.rca").string().c_str()));
+	}
+
+	// Turn the project into a file of the previous file version, whose migration doesn't change projects without meshes.
+	auto contents = raco::utils::file::read((cwd_path() / "project.rca").string());
+	auto currentVersion = "\"fileVersion\": " + std::to_string(raco::core::RAMSES_PROJECT_FILE_VERSION);
+	auto versionPos = contents.find(currentVersion);
+	ASSERT_NE(versionPos, std::string::npos);
+	contents.replace(versionPos, currentVersion.size(), "\"fileVersion\": " + std::to_string(raco::core::RAMSES_PROJECT_FILE_VERSION - 1));
+	raco::utils::file::write((cwd_path() / "project.rca").string(), contents);
+
+	raco::application::PhaseReport report;
+	RaCoApplication app{backend, {}, &report};
+	auto path = QString::fromStdString((cwd_path() / "project.rca").string());
+	auto currentPath = QString::fromStdString((cwd_path() / "project-current.rca").string());
+	ASSERT_TRUE(raco::application::RaCoProject::prepareCacheEntry(path, *app.projectFileCache()));
+	// Files with the current file version are cached as well, which skips parsing the JSON document.
+	ASSERT_TRUE(raco::application::RaCoProject::prepareCacheEntry(currentPath, *app.projectFileCache()));
+	EXPECT_TRUE(raco::utils::path::isExistingFile(app.projectFileCache()->entryPath(currentPath.toStdString())));
+	EXPECT_FALSE(raco::application::RaCoProject::prepareCacheEntry(QString::fromStdString((cwd_path() / "missing.rca").string()), *app.projectFileCache()));
+
+	for (const auto& file : {path, currentPath}) {
+		app.switchActiveRaCoProject(file);
+		ASSERT_EQ(1, app.activeRaCoProject().project()->links().size());
+		EXPECT_NE(raco::core::Queries::findByName(app.activeRaCoProject().project()->instances(), "prepared"), nullptr);
+	}
+	for (const auto& phase : report.phases()) {
+		EXPECT_NE(phase.path, "load project/parse");
+		EXPECT_NE(phase.path, "load project/migration");
+	}
+}
+
 TEST_F(RaCoProjectFixture, saveLoadWithRunningAnimation) {
 	{
 		RaCoApplication app{backend};
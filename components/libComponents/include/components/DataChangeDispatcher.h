@@ -11,8 +11,14 @@
 
 #include "core/Context.h"
 
+#include <algorithm>
+#include <array>
+#include <cstdint>
 #include <functional>
+#include <map>
 #include <memory>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace raco::components {
@@ -78,6 +84,24 @@ public:
 	using BulkChangeCallback = std::function<void(const core::SEditorObjectSet&)>;
 	using LinkCallback = std::function<void(const core::LinkDescriptor&)>;
 
+	// Listener kinds for which the number of dispatched events is counted.
+	enum class ListenerKind {
+		ValueHandle,
+		Children,
+		PropertyChange,
+		ObjectLifecycle,
+		LinkLifecycle,
+		LinkValidity,
+		ErrorChanged,
+		ErrorChangedInScene,
+		PreviewDirty,
+		UndoChanged,
+		ExternalProjectChanged,
+		ExternalProjectMapChanged,
+		AfterDispatch,
+		Count
+	};
+
 	explicit DataChangeDispatcher();
 
 	Subscription registerOn(core::ValueHandle valueHandle, Callback callback) noexcept;
@@ -106,6 +130,10 @@ public:
 
 	void assertEmpty();
 
+	// Number of listener callbacks of the given kind invoked since construction or the last reset.
+	uint64_t dispatchedEvents(ListenerKind kind) const;
+	void resetDispatchedEvents();
+
 	void setUndoChanged() {
 		undoChanged_ = true;
 	}
@@ -115,7 +143,7 @@ public:
 	}
 
 private:
-	void emitUpdateFor(const std::map<std::string, std::set<core::ValueHandle>>& valueHandles);
+	void emitUpdateFor(const core::DataChangeRecorder::ChangedValueMap& valueHandles);
 	void emitErrorChanged(const core::ValueHandle& valueHandle);
 	void emitErrorChangedInScene();
 	void emitCreated(core::SEditorObject obj);
@@ -123,24 +151,157 @@ private:
 	void emitPreviewDirty(core::SEditorObject obj);
 	void emitBulkChange(const core::SEditorObjectSet& changedObjects);
 
-	std::set<std::weak_ptr<ObjectLifecycleListener>, std::owner_less<std::weak_ptr<ObjectLifecycleListener>>> objectLifecycleListeners_{};
-	std::set<std::weak_ptr<LinkLifecycleListener>, std::owner_less<std::weak_ptr<LinkLifecycleListener>>> linkLifecycleListeners_{};
-	std::set<std::weak_ptr<LinkListener>, std::owner_less<std::weak_ptr<LinkListener>>> linkValidityChangeListeners_{};
-	std::map<std::string, std::set<std::weak_ptr<ValueHandleListener>, std::owner_less<std::weak_ptr<ValueHandleListener>>>> listeners_{};
-	std::map<std::string, std::set<std::weak_ptr<ChildrenListener>, std::owner_less<std::weak_ptr<ChildrenListener>>>> childrenListeners_{};
-	std::set<std::weak_ptr<EditorObjectListener>, std::owner_less<std::weak_ptr<EditorObjectListener>>> previewDirtyListeners_{};
-	std::set<std::weak_ptr<ValueHandleListener>, std::owner_less<std::weak_ptr<ValueHandleListener>>> errorChangedListeners_{};
-	std::set<std::weak_ptr<UndoListener>, std::owner_less<std::weak_ptr<UndoListener>>> errorChangedInSceneListeners_{};
-	std::map<std::string, std::set<std::weak_ptr<PropertyChangeListener>, std::owner_less<std::weak_ptr<PropertyChangeListener>>>> propertyChangeListeners_{};
+	// private helper class holding weak listener pointers: the listeners are owned by their Subscription, which
+	// removes them again. Each listener is kept alive while it is called, so that its callback can destroy its own Subscription.
+	// Listeners removed while the list is iterated are only reset and compacted after the outermost iteration;
+	// listeners added while the list is iterated are not visited by that iteration.
+	template <typename Listener>
+	class ListenerList {
+	public:
+		void add(const std::shared_ptr<Listener>& listener) {
+			positions_[listener.get()] = listeners_.size();
+			listeners_.push_back(listener);
+		}
+
+		void remove(Listener* listener) {
+			auto it = positions_.find(listener);
+			if (it == positions_.end()) {
+				return;
+			}
+			size_t index = it->second;
+			positions_.erase(it);
+			if (iterationDepth_ > 0) {
+				listeners_[index].reset();
+				compactionPending_ = true;
+			} else {
+				if (index + 1 != listeners_.size()) {
+					listeners_[index] = listeners_.back();
+					positions_[listeners_[index].lock().get()] = index;
+				}
+				listeners_.pop_back();
+			}
+		}
+
+		bool empty() const {
+			return positions_.empty();
+		}
+
+		bool iterating() const {
+			return iterationDepth_ > 0;
+		}
+
+		// Call func for every listener and return the number of calls.
+		template <typename Func>
+		size_t forEach(Func&& func) {
+			IterationGuard guard{*this};
+			size_t count = 0;
+			const size_t size = listeners_.size();
+			for (size_t index = 0; index < size; index++) {
+				if (auto listener = listeners_[index].lock()) {
+					func(listener.get());
+					++count;
+				}
+			}
+			return count;
+		}
+
+	private:
+		// Compacts the removed listeners at the end of the outermost iteration. Listener calls are noexcept.
+		struct IterationGuard {
+			explicit IterationGuard(ListenerList& list) : list_(list) {
+				++list_.iterationDepth_;
+			}
+			~IterationGuard() {
+				if (--list_.iterationDepth_ == 0 && list_.compactionPending_) {
+					list_.compact();
+				}
+			}
+			ListenerList& list_;
+		};
+
+		void compact() {
+			listeners_.erase(std::remove_if(listeners_.begin(), listeners_.end(), [](const auto& listener) { return listener.expired(); }), listeners_.end());
+			for (size_t index = 0; index < listeners_.size(); index++) {
+				positions_[listeners_[index].lock().get()] = index;
+			}
+			compactionPending_ = false;
+		}
+
+		std::vector<std::weak_ptr<Listener>> listeners_;
+		std::unordered_map<Listener*, size_t> positions_;
+		int iterationDepth_ = 0;
+		bool compactionPending_ = false;
+	};
+
+	// ListenerLists indexed by a key, e.g. the ValueHandle or the property name the listeners are registered on.
+	template <typename Key, typename Listener, typename Map = std::map<Key, ListenerList<Listener>>>
+	class ListenerIndex {
+	public:
+		void add(const Key& key, const std::shared_ptr<Listener>& listener) {
+			index_[key].add(listener);
+		}
+
+		void remove(const Key& key, Listener* listener) {
+			auto it = index_.find(key);
+			if (it != index_.end()) {
+				it->second.remove(listener);
+				if (it->second.empty() && !it->second.iterating()) {
+					index_.erase(it);
+				}
+			}
+		}
+
+		bool contains(const Key& key) const {
+			return index_.find(key) != index_.end();
+		}
+
+		bool empty() const {
+			return index_.empty();
+		}
+
+		template <typename Func>
+		size_t forEach(const Key& key, Func&& func) {
+			auto it = index_.find(key);
+			if (it == index_.end()) {
+				return 0;
+			}
+			// Element references stay valid while other keys are added or removed by the callbacks.
+			auto& list = it->second;
+			size_t count = list.forEach(std::forward<Func>(func));
+			if (list.empty() && !list.iterating()) {
+				index_.erase(key);
+			}
+			return count;
+		}
+
+	private:
+		Map index_;
+	};
+
+	void countDispatched(ListenerKind kind, size_t count) {
+		dispatchedEvents_[static_cast<size_t>(kind)] += count;
+	}
+
+	ListenerList<ObjectLifecycleListener> objectLifecycleListeners_{};
+	ListenerList<LinkLifecycleListener> linkLifecycleListeners_{};
+	ListenerList<LinkListener> linkValidityChangeListeners_{};
+	ListenerIndex<core::ValueHandle, ValueHandleListener> listeners_{};
+	ListenerIndex<core::ValueHandle, ChildrenListener> childrenListeners_{};
+	ListenerIndex<const core::EditorObject*, EditorObjectListener, std::unordered_map<const core::EditorObject*, ListenerList<EditorObjectListener>>> previewDirtyListeners_{};
+	ListenerIndex<core::ValueHandle, ValueHandleListener> errorChangedListeners_{};
+	ListenerList<UndoListener> errorChangedInSceneListeners_{};
+	ListenerIndex<std::string, PropertyChangeListener, std::unordered_map<std::string, ListenerList<PropertyChangeListener>>> propertyChangeListeners_{};
 
 	bool undoChanged_{false};
-	std::set<std::weak_ptr<UndoListener>, std::owner_less<std::weak_ptr<UndoListener>>> undoChangeListeners_{};
+	ListenerList<UndoListener> undoChangeListeners_{};
 
 	bool externalProjectChanged_{false};
-	std::set<std::weak_ptr<UndoListener>, std::owner_less<std::weak_ptr<UndoListener>>> externalProjectChangedListeners_{};
-	std::set<std::weak_ptr<UndoListener>, std::owner_less<std::weak_ptr<UndoListener>>> externalProjectMapChangedListeners_{};
+	ListenerList<UndoListener> externalProjectChangedListeners_{};
+	ListenerList<UndoListener> externalProjectMapChangedListeners_{};
+
+	ListenerList<UndoListener> onAfterDispatchListeners_{};
 
-	std::set<std::weak_ptr<UndoListener>, std::owner_less<std::weak_ptr<UndoListener>>> onAfterDispatchListeners_{};
+	std::array<uint64_t, static_cast<size_t>(ListenerKind::Count)> dispatchedEvents_{};
 
 	BulkChangeCallback bulkChangeCallback_;
 };
@@ -13,8 +13,11 @@
 #include "core/MeshCacheInterface.h"
 
 #include <functional>
+#include <list>
+#include <map>
 #include <memory>
 #include <string>
+#include <tuple>
 #include <unordered_set>
 
 namespace raco::core {
@@ -27,6 +30,7 @@ class MeshCacheImpl : public GenericFileChangeMonitorImpl<core::MeshCache> {
 public:
 	MeshCacheImpl() {}
 
+	// Returns the same MeshData for identical descriptors as long as it is in use, until the mesh file changes.
 	core::SharedMeshData loadMesh(const raco::core::MeshDescriptor& descriptor) override;
 	core::MeshScenegraph* getMeshScenegraph(const raco::core::MeshDescriptor& descriptor) override;
 	std::string getMeshError(const std::string& absPath) override;
@@ -34,6 +38,13 @@ public:
 
 	std::shared_ptr<raco::core::MeshAnimationSamplerData> getAnimationSamplerData(const std::string& absPath, int animIndex, int samplerIndex) override;
 
+	typename core::MeshCache::UniqueListener registerFileChangedHandler(std::string absPath, typename core::MeshCache::Callback callback) override;
+
+	// Keep the entries of up to `maxCount` mesh files without listeners, so that the next project using them doesn't
+	// load them again. The entries unused for the longest time are dropped first.
+	// Changes of a mesh file while its entry has no listeners are not detected: only use this if files don't change.
+	void setMaxUnusedEntries(size_t maxCount);
+
 private:
 	virtual void unregister(std::string absPath, typename core::MeshCache::Callback* listener) override;
 	virtual void notify(const std::string& absPath) override;
@@ -42,8 +53,18 @@ private:
 
 	void forceReloadCachedMesh(const std::string& absPath);
 	void onAfterMeshFileUpdate(const std::string& meshFileAbsPath);
+	void forgetLoadedMeshes(const std::string& absPath);
+	void evictUnusedEntries();
+
+	// Path, bake flag, submesh index if not baked, optimize flag.
+	using MeshKey = std::tuple<std::string, bool, int, bool>;
 
 	std::unordered_map<std::string, core::UniqueMeshCacheEntry> meshCacheEntries_;
+	// Meshes returned by loadMesh, without keeping them alive.
+	std::map<MeshKey, std::weak_ptr<core::MeshData>> loadedMeshes_;
+	// Paths of the retained entries without listeners, most recently used first.
+	std::list<std::string> unusedEntries_;
+	size_t maxUnusedEntries_ = 0;
 };
 
 }  // namespace raco::components
\ No newline at end of file
@@ -172,25 +172,17 @@ void DataChangeDispatcher::dispatch(const DataChangeRecorder& dataChanges) {
 
 	for (auto& [endObjId, links] : dataChanges.getValidityChangedLinks()) {
 		for (auto& link : links) {
-			auto copy{linkValidityChangeListeners_};
-			for (const auto& ptr : copy) {
-				if (!ptr.expired()) {
-					auto listener{ptr.lock()};
-					listener->onLinkChange(link);
-				}
-			}
+			countDispatched(ListenerKind::LinkValidity, linkValidityChangeListeners_.forEach([&link](LinkListener* listener) {
+				listener->onLinkChange(link);
+			}));
 		}
 	}
 
 	for (auto& [endObjId, links] : dataChanges.getRemovedLinks()) {
 		for (auto& link : links) {
-			auto copy{linkLifecycleListeners_};
-			for (const auto& ptr : copy) {
-				if (!ptr.expired()) {
-					auto listener{ptr.lock()};
-					listener->onDeletion_(link);
-				}
-			}
+			countDispatched(ListenerKind::LinkLifecycle, linkLifecycleListeners_.forEach([&link](LinkLifecycleListener* listener) {
+				listener->onDeletion_(link);
+			}));
 		}
 	}
 
@@ -227,13 +219,9 @@ void DataChangeDispatcher::dispatch(const DataChangeRecorder& dataChanges) {
 
 	for (auto& [endObjId, links] : dataChanges.getAddedLinks()) {
 		for (auto& link : links) {
-			auto copy{linkLifecycleListeners_};
-			for (const auto& ptr : copy) {
-				if (!ptr.expired()) {
-					auto listener{ptr.lock()};
-					listener->onCreation_(link);
-				}
-			}
+			countDispatched(ListenerKind::LinkLifecycle, linkLifecycleListeners_.forEach([&link](LinkLifecycleListener* listener) {
+				listener->onCreation_(link);
+			}));
 		}
 	}
 
@@ -246,46 +234,36 @@ void DataChangeDispatcher::dispatch(const DataChangeRecorder& dataChanges) {
 	}
 
 	if (undoChanged_) {
-		for (auto& undoListener : undoChangeListeners_) {
-			if (!undoListener.expired())
-				undoListener.lock()->call();
-		}
+		countDispatched(ListenerKind::UndoChanged, undoChangeListeners_.forEach([](UndoListener* listener) {
+			listener->call();
+		}));
 		undoChanged_ = false;
 	}
 
 	if (externalProjectChanged_) {
-		for (auto& listener : externalProjectChangedListeners_) {
-			if (!listener.expired())
-				listener.lock()->call();
-		}
+		countDispatched(ListenerKind::ExternalProjectChanged, externalProjectChangedListeners_.forEach([](UndoListener* listener) {
+			listener->call();
+		}));
 		externalProjectChanged_ = false;
 	}
 
 	if (dataChanges.externalProjectMapChanged()) {
-		for (auto& listener : externalProjectMapChangedListeners_) {
-			if (!listener.expired())
-				listener.lock()->call();
-		}
+		countDispatched(ListenerKind::ExternalProjectMapChanged, externalProjectMapChangedListeners_.forEach([](UndoListener* listener) {
+			listener->call();
+		}));
 	}
 
-	for (auto& listener : onAfterDispatchListeners_) {
-		if (!listener.expired()) {
-			listener.lock()->call();
-		}
-	}
+	countDispatched(ListenerKind::AfterDispatch, onAfterDispatchListeners_.forEach([](UndoListener* listener) {
+		listener->call();
+	}));
 }
 
 Subscription DataChangeDispatcher::registerOn(ValueHandle valueHandle, Callback callback) noexcept {
 	auto listener{std::make_shared<ValueHandleListener>(std::move(valueHandle), std::move(callback))};
-	listeners_[listener->valueHandle().rootObject()->objectID()].insert(listener);
+	listeners_.add(listener->valueHandle(), listener);
 	return Subscription{
 		this, listener, [this, listener]() {
-			const auto& objectID = listener->valueHandle().rootObject()->objectID();
-			auto it = listeners_.find(objectID);
-			it->second.erase(listener);
-			if (it->second.empty()) {
-				listeners_.erase(objectID);
-			}
+			listeners_.remove(listener->valueHandle(), listener.get());
 		}};
 }
 
@@ -300,110 +278,101 @@ Subscription DataChangeDispatcher::registerOn(ValueHandles handles, ValueHandleC
 
 Subscription DataChangeDispatcher::registerOnPropertyChange(const std::string& propertyName, ValueHandleCallback callback) noexcept {
 	auto listener{std::make_shared<PropertyChangeListener>(propertyName, callback)};
-	propertyChangeListeners_[propertyName].insert(listener);
+	propertyChangeListeners_.add(propertyName, listener);
 	return Subscription{
-		this, listener, [this, propertyName, listener]() {
-			auto it = propertyChangeListeners_.find(propertyName);
-			it->second.erase(listener);
-			if (it->second.empty()) {
-				propertyChangeListeners_.erase(propertyName);
-			}
+		this, listener, [this, listener]() {
+			propertyChangeListeners_.remove(listener->property(), listener.get());
 		}};
 }
 
 Subscription DataChangeDispatcher::registerOnChildren(ValueHandle valueHandle, ValueHandleCallback callback) noexcept {
 	auto listener{std::make_shared<ChildrenListener>(std::move(valueHandle), std::move(callback))};
-	childrenListeners_[listener->valueHandle().rootObject()->objectID()].insert(listener);
+	childrenListeners_.add(listener->valueHandle(), listener);
 	return Subscription{
 		this, listener, [this, listener]() {
-			const auto& objectID = listener->valueHandle().rootObject()->objectID();
-			auto it = childrenListeners_.find(objectID);
-			it->second.erase(listener);
-			if (it->second.empty()) {
-				childrenListeners_.erase(objectID);
-			}
+			childrenListeners_.remove(listener->valueHandle(), listener.get());
 		}};
 }
 
 
 Subscription DataChangeDispatcher::registerOnObjectsLifeCycle(EditorObjectCallback onCreation, EditorObjectCallback onDeletion) noexcept {
 	auto listener{std::make_shared<ObjectLifecycleListener>(onCreation, onDeletion)};
-	objectLifecycleListeners_.insert(listener);
+	objectLifecycleListeners_.add(listener);
 	return Subscription{this, listener, [this, listener]() { 
-		objectLifecycleListeners_.erase(listener); 
+		objectLifecycleListeners_.remove(listener.get()); 
 	}};
 }
 
 Subscription DataChangeDispatcher::registerOnLinksLifeCycle(LinkCallback onCreation, LinkCallback onDeletion) noexcept {
 	auto listener{std::make_shared<LinkLifecycleListener>(onCreation, onDeletion)};
-	linkLifecycleListeners_.insert(listener);
+	linkLifecycleListeners_.add(listener);
 	return Subscription{this, listener, [this, listener]() { 
-		linkLifecycleListeners_.erase(listener); 
+		linkLifecycleListeners_.remove(listener.get()); 
 	}};
 }
 
 Subscription DataChangeDispatcher::registerOnLinkValidityChange(LinkCallback callback) noexcept {
 	auto listener{std::make_shared<LinkListener>(callback)};
-	linkValidityChangeListeners_.insert(listener);
+	linkValidityChangeListeners_.add(listener);
 	return Subscription{this, listener, [this, listener]() { 
-		linkValidityChangeListeners_.erase(listener); 
+		linkValidityChangeListeners_.remove(listener.get()); 
 	}};
 }
 
 Subscription DataChangeDispatcher::registerOnErrorChanged(ValueHandle valueHandle, Callback callback) noexcept {
 	auto listener{std::make_shared<ValueHandleListener>(std::move(valueHandle), std::move(callback))};
-	errorChangedListeners_.insert(listener);
+	errorChangedListeners_.add(listener->valueHandle(), listener);
 	return Subscription{this, listener, [this, listener]() { 
-		errorChangedListeners_.erase(listener); 
+		errorChangedListeners_.remove(listener->valueHandle(), listener.get()); 
 	}};
 }
 
 Subscription DataChangeDispatcher::registerOnErrorChangedInScene(Callback callback) noexcept {
 	auto listener{std::make_shared<UndoListener>(std::move(callback))};
-	errorChangedInSceneListeners_.insert(listener);
+	errorChangedInSceneListeners_.add(listener);
 	return Subscription{this, listener, [this, listener]() {
-		errorChangedInSceneListeners_.erase(listener);
+		errorChangedInSceneListeners_.remove(listener.get());
 	}};
 }
 
 Subscription DataChangeDispatcher::registerOnPreviewDirty(SEditorObject obj, Callback callback) noexcept {
 	assert(obj);
 	auto listener{std::make_shared<EditorObjectListener>(obj, std::move(callback))};
-	previewDirtyListeners_.insert(listener);
+	previewDirtyListeners_.add(listener->editorObject().get(), listener);
 	return Subscription{this, listener, [this, listener]() { 
-		previewDirtyListeners_.erase(listener); 
+		previewDirtyListeners_.remove(listener->editorObject().get(), listener.get()); 
 	}};
 }
 
 Subscription DataChangeDispatcher::registerOnUndoChanged(Callback callback) noexcept {
 	auto listener{std::make_shared<UndoListener>(std::move(callback))};
-	undoChangeListeners_.insert(listener);
+	undoChangeListeners_.add(listener);
 	return Subscription{this, listener, [this, listener]() { 
-		undoChangeListeners_.erase(listener); 
+		undoChangeListeners_.remove(listener.get()); 
 	}};
 }
 
 Subscription DataChangeDispatcher::registerOnExternalProjectChanged(Callback callback) noexcept {
 	auto listener{std::make_shared<UndoListener>(std::move(callback))};
-	externalProjectChangedListeners_.insert(listener);
+	externalProjectChangedListeners_.add(listener);
 	return Subscription{this, listener, [this, listener]() { 
-		externalProjectChangedListeners_.erase(listener); 
+		externalProjectChangedListeners_.remove(listener.get()); 
 	}};
 }
 
 Subscription DataChangeDispatcher::registerOnExternalProjectMapChanged(Callback callback) noexcept {
 	auto listener{std::make_shared<UndoListener>(std::move(callback))};
-	externalProjectMapChangedListeners_.insert(listener);
+	externalProjectMapChangedListeners_.add(listener);
 	return Subscription{this, listener, [this, listener]() {
-		externalProjectMapChangedListeners_.erase(listener);
+		externalProjectMapChangedListeners_.remove(listener.get());
 	}};
 }
 
 Subscription DataChangeDispatcher::registerOnAfterDispatch(Callback callback) {
 	auto listener{std::make_shared<UndoListener>(std::move(callback))};
-	onAfterDispatchListeners_.insert(listener);
+	onAfterDispatchListeners_.add(listener);
 	return Subscription{this, listener, [this, listener]() { 
-		onAfterDispatchListeners_.erase(listener); 
+		onAfterDispatchListeners_.remove(listener.get()); 
 	}};
 }
 
@@ -415,103 +384,68 @@ void DataChangeDispatcher::resetBulkChangeCallback() {
 	bulkChangeCallback_ = nullptr;
 }
 
-void DataChangeDispatcher::emitUpdateFor(const std::map<std::string, std::set<core::ValueHandle>>& valueHandles) {
-	decltype(listeners_)::mapped_type dirtyListeners;
+void DataChangeDispatcher::emitUpdateFor(const core::DataChangeRecorder::ChangedValueMap& valueHandles) {
+	// Handles with exact-match listeners; these are called once after all children and property listeners.
+	std::vector<ValueHandle> dirtyHandles;
 
-	for (const auto& [objectID, cont] : valueHandles) {
-		for (const auto& valueHandle : cont) {
+	// Dispatch the objects ordered by object ID: the order of the recorder's hash map depends on the object addresses.
+	std::vector<const core::DataChangeRecorder::ChangedValueMap::value_type*> changedObjects;
+	changedObjects.reserve(valueHandles.size());
+	for (const auto& item : valueHandles) {
+		changedObjects.emplace_back(&item);
+	}
+	std::sort(changedObjects.begin(), changedObjects.end(), [](const auto* lhs, const auto* rhs) {
+		return lhs->first->objectID() < rhs->first->objectID();
+	});
+
+	for (const auto* item : changedObjects) {
+		for (const auto& valueHandle : item->second) {
 			LOG_TRACE_IF(log_system::DATA_CHANGE, valueHandle && !valueHandle.isObject(), "emit changedValueHandle Property {}:{}", valueHandle.rootObject()->objectName(), valueHandle.getPropName());
 			LOG_TRACE_IF(log_system::DATA_CHANGE, valueHandle && valueHandle.isObject(), "emit changedValueHandle Object {}:{}", valueHandle.rootObject()->objectName(), valueHandle.rootObject()->objectID());
 			LOG_TRACE_IF(log_system::DATA_CHANGE, !valueHandle, "emit changedValueHandle project-global");
 
-			auto listenerIt = listeners_.find(objectID);
-			if (listenerIt != listeners_.end()) {
-				for (const auto& ptr : listenerIt->second) {
-					if (!ptr.expired()) {
-						auto listener{ptr.lock()};
-						if (listener->valueHandle() == valueHandle) {
-							dirtyListeners.insert(ptr);
-						}
-					}
-				}
+			if (listeners_.contains(valueHandle)) {
+				dirtyHandles.emplace_back(valueHandle);
 			}
 
-			decltype(childrenListeners_)::mapped_type dirtyChildrenListeners;
-			auto childListenerIt = childrenListeners_.find(objectID);
-			if (childListenerIt != childrenListeners_.end()) {
-				for (const auto& ptr : childListenerIt->second) {
-					if (!ptr.expired()) {
-						auto listener{ptr.lock()};
-						if (listener->valueHandle() == valueHandle || listener->valueHandle().contains(valueHandle)) {
-							dirtyChildrenListeners.insert(ptr);
-						}
-					}
-				}
-			}
-			for (const auto& ptr : dirtyChildrenListeners) {
-				if (!ptr.expired()) {
-					ptr.lock()->call(valueHandle);
-				}
+			// Children listeners are registered on the changed handle itself or on one of its parents.
+			for (ValueHandle parent = valueHandle; parent.rootObject(); parent = parent.parent()) {
+				countDispatched(ListenerKind::Children, childrenListeners_.forEach(parent, [&valueHandle](ChildrenListener* listener) {
+					listener->call(valueHandle);
+				}));
 			}
 
 			if (valueHandle.depth() > 0) {
-				auto propName = valueHandle.getPropName();
-
-				decltype(propertyChangeListeners_)::mapped_type dirtyPropertyListeners;
-				auto it = propertyChangeListeners_.find(propName);
-				if (it != propertyChangeListeners_.end()) {
-					for (const auto& ptr : it->second) {
-						if (!ptr.expired()) {
-							dirtyPropertyListeners.insert(ptr);
-						}
-					}
-				}
-				for (const auto& ptr : dirtyPropertyListeners) {
-					if (!ptr.expired()) {
-						ptr.lock()->call(valueHandle);
-					}
-				}
+				countDispatched(ListenerKind::PropertyChange, propertyChangeListeners_.forEach(valueHandle.getPropName(), [&valueHandle](PropertyChangeListener* listener) {
+					listener->call(valueHandle);
+				}));
 			}
 		}
 	}
 
-	for (const auto& ptr : dirtyListeners) {
-		if (!ptr.expired()) {
-			ptr.lock()->call();
-		}
+	for (const auto& handle : dirtyHandles) {
+		countDispatched(ListenerKind::ValueHandle, listeners_.forEach(handle, [](ValueHandleListener* listener) {
+			listener->call();
+		}));
 	}
 }
 
 void DataChangeDispatcher::emitErrorChanged(const ValueHandle& valueHandle) {
-	auto copy{errorChangedListeners_};
-	for (const auto& ptr : copy) {
-		if (!ptr.expired()) {
-			auto listener{ptr.lock()};
-			if (listener->valueHandle() == valueHandle) {
-				listener->call();
-			}
-		}
-	}
+	countDispatched(ListenerKind::ErrorChanged, errorChangedListeners_.forEach(valueHandle, [](ValueHandleListener* listener) {
+		listener->call();
+	}));
 }
 
 void DataChangeDispatcher::emitErrorChangedInScene() {
-	auto copy{errorChangedInSceneListeners_};
-	for (const auto& ptr : copy) {
-		if (!ptr.expired()) {
-			auto listener{ptr.lock()};
-			listener->call();
-		}
-	}
+	countDispatched(ListenerKind::ErrorChangedInScene, errorChangedInSceneListeners_.forEach([](UndoListener* listener) {
+		listener->call();
+	}));
 }
 
 void DataChangeDispatcher::emitCreated(SEditorObject obj) {
-	auto copy{objectLifecycleListeners_};
-	for (const auto& ptr : copy) {
-		if (!ptr.expired()) {
-			auto listener{ptr.lock()};
-			listener->onCreation(obj);
-		}
-	}
+	countDispatched(ListenerKind::ObjectLifecycle, objectLifecycleListeners_.forEach([&obj](ObjectLifecycleListener* listener) {
+		listener->onCreation(obj);
+	}));
 }
 
 void DataChangeDispatcher::assertEmpty() {
@@ -530,26 +464,24 @@ void DataChangeDispatcher::assertEmpty() {
 	assert(onAfterDispatchListeners_.empty());
 }
 
+uint64_t DataChangeDispatcher::dispatchedEvents(ListenerKind kind) const {
+	return dispatchedEvents_[static_cast<size_t>(kind)];
+}
+
+void DataChangeDispatcher::resetDispatchedEvents() {
+	dispatchedEvents_.fill(0);
+}
+
 void DataChangeDispatcher::emitDeleted(SEditorObject obj) {
-	auto copy{objectLifecycleListeners_};
-	for (const auto& ptr : copy) {
-		if (!ptr.expired()) {
-			auto listener{ptr.lock()};
-			listener->onDeletion(obj);
-		}
-	}
+	countDispatched(ListenerKind::ObjectLifecycle, objectLifecycleListeners_.forEach([&obj](ObjectLifecycleListener* listener) {
+		listener->onDeletion(obj);
+	}));
 }
 
 void DataChangeDispatcher::emitPreviewDirty(SEditorObject obj) {
-	auto copy{previewDirtyListeners_};
-	for (const auto& ptr : copy) {
-		if (!ptr.expired()) {
-			auto listener{ptr.lock()};
-			if (listener->editorObject() == obj) {
-				listener->call();
-			}
-		}
-	}
+	countDispatched(ListenerKind::PreviewDirty, previewDirtyListeners_.forEach(obj.get(), [](EditorObjectListener* listener) {
+		listener->call();
+	}));
 }
 
 void DataChangeDispatcher::emitBulkChange(const SEditorObjectSet& changedObjects) {
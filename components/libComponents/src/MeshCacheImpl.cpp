@@ -18,14 +18,34 @@
 #include "mesh_loader/glTFFileLoader.h"
 
 #include "utils/stdfilesystem.h"
+#include <limits>
 #include <memory>
 
 namespace raco::components {
 
+core::MeshCache::UniqueListener MeshCacheImpl::registerFileChangedHandler(std::string absPath, typename core::MeshCache::Callback callback) {
+	unusedEntries_.remove(absPath);
+	return GenericFileChangeMonitorImpl<core::MeshCache>::registerFileChangedHandler(absPath, callback);
+}
+
 void MeshCacheImpl::unregister(std::string absPath, typename core::MeshCache::Callback *listener) {
 	GenericFileChangeMonitorImpl<core::MeshCache>::unregister(absPath, listener);
-	if (callbacks_.find(absPath) == callbacks_.end()) {
-		meshCacheEntries_.erase(absPath);
+	if (callbacks_.find(absPath) == callbacks_.end() && meshCacheEntries_.find(absPath) != meshCacheEntries_.end()) {
+		unusedEntries_.push_front(absPath);
+		evictUnusedEntries();
+	}
+}
+
+void MeshCacheImpl::setMaxUnusedEntries(size_t maxCount) {
+	maxUnusedEntries_ = maxCount;
+	evictUnusedEntries();
+}
+
+void MeshCacheImpl::evictUnusedEntries() {
+	while (unusedEntries_.size() > maxUnusedEntries_) {
+		meshCacheEntries_.erase(unusedEntries_.back());
+		forgetLoadedMeshes(unusedEntries_.back());
+		unusedEntries_.pop_back();
 	}
 }
 	
@@ -35,8 +55,21 @@ void MeshCacheImpl::notify(const std::string &absPath) {
 }
 
 raco::core::SharedMeshData MeshCacheImpl::loadMesh(const raco::core::MeshDescriptor &descriptor) {
+	MeshKey key{descriptor.absPath, descriptor.bakeAllSubmeshes, descriptor.bakeAllSubmeshes ? 0 : descriptor.submeshIndex, descriptor.optimize};
+	auto it = loadedMeshes_.find(key);
+	if (it != loadedMeshes_.end()) {
+		if (auto mesh = it->second.lock()) {
+			return mesh;
+		}
+		loadedMeshes_.erase(it);
+	}
+
 	auto *loader = getLoader(descriptor.absPath);
-	return loader->loadMesh(descriptor);
+	auto mesh = loader->loadMesh(descriptor);
+	if (mesh) {
+		loadedMeshes_[key] = mesh;
+	}
+	return mesh;
 }
 
 raco::core::MeshScenegraph* raco::components::MeshCacheImpl::getMeshScenegraph(const raco::core::MeshDescriptor &descriptor) {
@@ -62,6 +95,14 @@ std::shared_ptr<raco::core::MeshAnimationSamplerData> MeshCacheImpl::getAnimatio
 void MeshCacheImpl::forceReloadCachedMesh(const std::string &absPath) {
 	auto *loader = getLoader(absPath);
 	loader->reset();
+	forgetLoadedMeshes(absPath);
+}
+
+void MeshCacheImpl::forgetLoadedMeshes(const std::string &absPath) {
+	auto it = loadedMeshes_.lower_bound(MeshKey{absPath, false, std::numeric_limits<int>::min(), false});
+	while (it != loadedMeshes_.end() && std::get<0>(it->first) == absPath) {
+		it = loadedMeshes_.erase(it);
+	}
 }
 
 void MeshCacheImpl::onAfterMeshFileUpdate(const std::string &meshFileAbsPath) {
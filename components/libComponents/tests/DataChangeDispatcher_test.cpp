@@ -149,3 +149,135 @@ TEST(DataChangeDispatcher, registerOnChildren_dispatchEmitUpdated) {
 	testing::Mock::VerifyAndClearExpectations(&callback1);
 	testing::Mock::VerifyAndClearExpectations(&callback2);
 }
+
+TEST(DataChangeDispatcher, subscriptionDestroyedDuringDispatchIsNotCalled) {
+	DataChangeRecorder recorder{};
+	Errors errors{&recorder};
+	DataChangeDispatcher underTest{};
+	raco::ramses_base::HeadlessEngineBackend backend{};
+	BaseContext context{new Project{}, backend.coreInterface(), &UserObjectFactory::getInstance(), &recorder, &errors};
+	SEditorObject node = std::make_shared<Node>();
+	ValueHandle valueHandle{node, {"translation", "x"}};
+
+	int calls = 0;
+	bool lateRegistered = false;
+	Subscription subscription1;
+	Subscription subscription2;
+	Subscription lateSubscription;
+	subscription1 = underTest.registerOn(valueHandle, [&]() {
+		calls++;
+		subscription2 = Subscription{};
+		if (!lateRegistered) {
+			lateSubscription = underTest.registerOn(valueHandle, [&]() { calls++; });
+			lateRegistered = true;
+		}
+	});
+	subscription2 = underTest.registerOn(valueHandle, [&]() {
+		calls++;
+		subscription1 = Subscription{};
+		if (!lateRegistered) {
+			lateSubscription = underTest.registerOn(valueHandle, [&]() { calls++; });
+			lateRegistered = true;
+		}
+	});
+
+	// TEST
+	context.set(valueHandle, 1.0);
+	underTest.dispatch(recorder.release());
+	EXPECT_EQ(calls, 1);
+
+	context.set(valueHandle, 2.0);
+	underTest.dispatch(recorder.release());
+	EXPECT_EQ(calls, 3);
+}
+
+TEST(DataChangeDispatcher, subscriptionDestroyedByOwnCallbackStaysAliveDuringCall) {
+	DataChangeRecorder recorder{};
+	Errors errors{&recorder};
+	DataChangeDispatcher underTest{};
+	raco::ramses_base::HeadlessEngineBackend backend{};
+	BaseContext context{new Project{}, backend.coreInterface(), &UserObjectFactory::getInstance(), &recorder, &errors};
+	SEditorObject node = std::make_shared<Node>();
+	ValueHandle valueHandle{node, {"translation", "x"}};
+
+	// The callback owns state which must still be valid after it destroyed its own subscription.
+	auto state = std::make_shared<std::vector<int>>(100, 1);
+	std::vector<int> seen;
+	Subscription subscription;
+	subscription = underTest.registerOn(valueHandle, [&subscription, &seen, state]() {
+		subscription = Subscription{};
+		seen = *state;
+	});
+	state.reset();
+
+	// TEST
+	context.set(valueHandle, 1.0);
+	underTest.dispatch(recorder.release());
+	EXPECT_EQ(seen, std::vector<int>(100, 1));
+
+	seen.clear();
+	context.set(valueHandle, 2.0);
+	underTest.dispatch(recorder.release());
+	EXPECT_TRUE(seen.empty());
+}
+
+TEST(DataChangeDispatcher, subscriptionDestroyedByOtherCallbackIsNotCalled) {
+	DataChangeRecorder recorder{};
+	Errors errors{&recorder};
+	DataChangeDispatcher underTest{};
+	raco::ramses_base::HeadlessEngineBackend backend{};
+	BaseContext context{new Project{}, backend.coreInterface(), &UserObjectFactory::getInstance(), &recorder, &errors};
+	SEditorObject node = std::make_shared<Node>();
+	ValueHandle valueHandle{node, {"translation", "x"}};
+
+	int firstCalls = 0;
+	int secondCalls = 0;
+	Subscription first;
+	Subscription second;
+	first = underTest.registerOn(valueHandle, [&]() {
+		firstCalls++;
+		second = Subscription{};
+	});
+	second = underTest.registerOn(valueHandle, [&]() {
+		secondCalls++;
+	});
+
+	// TEST
+	context.set(valueHandle, 1.0);
+	underTest.dispatch(recorder.release());
+	context.set(valueHandle, 2.0);
+	underTest.dispatch(recorder.release());
+	EXPECT_EQ(firstCalls, 2);
+	EXPECT_EQ(secondCalls, 0);
+}
+
+TEST(DataChangeDispatcher, dispatchedEventsCountedPerListenerKind) {
+	DataChangeRecorder recorder{};
+	Errors errors{&recorder};
+	DataChangeDispatcher underTest{};
+	raco::ramses_base::HeadlessEngineBackend backend{};
+	BaseContext context{new Project{}, backend.coreInterface(), &UserObjectFactory::getInstance(), &recorder, &errors};
+	SEditorObject node = std::make_shared<Node>();
+	ValueHandle translation{node, {"translation"}};
+	ValueHandle x{translation.get("x")};
+	ValueHandle y{translation.get("y")};
+
+	auto objectSubscription = underTest.registerOnChildren(ValueHandle{node}, [](const ValueHandle&) {});
+	auto childrenSubscription = underTest.registerOnChildren(translation, [](const ValueHandle&) {});
+	auto valueSubscription = underTest.registerOn(x, []() {});
+	auto unrelatedSubscription = underTest.registerOn(y, []() {});
+	auto propertySubscription = underTest.registerOnPropertyChange("x", [](const ValueHandle&) {});
+
+	// TEST
+	context.set(x, 1.0);
+	underTest.dispatch(recorder.release());
+
+	using Kind = DataChangeDispatcher::ListenerKind;
+	EXPECT_EQ(underTest.dispatchedEvents(Kind::Children), 2u);
+	EXPECT_EQ(underTest.dispatchedEvents(Kind::ValueHandle), 1u);
+	EXPECT_EQ(underTest.dispatchedEvents(Kind::PropertyChange), 1u);
+	EXPECT_EQ(underTest.dispatchedEvents(Kind::ObjectLifecycle), 0u);
+
+	underTest.resetDispatchedEvents();
+	EXPECT_EQ(underTest.dispatchedEvents(Kind::Children), 0u);
+}
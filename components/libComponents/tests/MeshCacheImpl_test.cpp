@@ -0,0 +1,82 @@
+/*
+ * SPDX-License-Identifier: MPL-2.0
+ *
+ * This file is part of Ramses Composer
+ * (see https://github.com/GENIVI/ramses-composer).
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "gtest/gtest.h"
+
+#include "components/MeshCacheImpl.h"
+#include "testing/TestEnvironmentCore.h"
+
+using namespace raco::core;
+
+class MeshCacheImplTest : public TestEnvironmentCore {
+protected:
+	MeshDescriptor descriptor(bool bake, int submeshIndex = 0, bool optimize = false) {
+		MeshDescriptor desc;
+		desc.absPath = (cwd_path() / "meshes/CesiumMilkTruck/CesiumMilkTruck.gltf").string();
+		desc.bakeAllSubmeshes = bake;
+		desc.submeshIndex = submeshIndex;
+		desc.optimize = optimize;
+		return desc;
+	}
+};
+
+TEST_F(MeshCacheImplTest, identical_descriptors_share_mesh_data) {
+	auto baked = meshCache.loadMesh(descriptor(true));
+	ASSERT_NE(baked, nullptr);
+	EXPECT_EQ(meshCache.loadMesh(descriptor(true)), baked);
+	// The submesh index is ignored when baking.
+	EXPECT_EQ(meshCache.loadMesh(descriptor(true, 1)), baked);
+
+	auto submesh = meshCache.loadMesh(descriptor(false, 1));
+	EXPECT_NE(submesh, baked);
+	EXPECT_EQ(meshCache.loadMesh(descriptor(false, 1)), submesh);
+	EXPECT_NE(meshCache.loadMesh(descriptor(false, 2)), submesh);
+	EXPECT_NE(meshCache.loadMesh(descriptor(false, 1, true)), submesh);
+}
+
+TEST_F(MeshCacheImplTest, unused_mesh_data_is_released) {
+	auto mesh = meshCache.loadMesh(descriptor(true));
+	std::weak_ptr<MeshData> weakMesh = mesh;
+	mesh.reset();
+	EXPECT_TRUE(weakMesh.expired());
+
+	mesh = meshCache.loadMesh(descriptor(true));
+	ASSERT_NE(mesh, nullptr);
+	EXPECT_EQ(meshCache.loadMesh(descriptor(true)), mesh);
+}
+
+TEST_F(MeshCacheImplTest, unused_entries_evicted_least_recently_used_first) {
+	meshCache.setMaxUnusedEntries(1);
+
+	auto truckDescriptor = descriptor(true);
+	MeshDescriptor duckDescriptor;
+	duckDescriptor.absPath = (cwd_path() / "meshes/Duck.glb").string();
+	duckDescriptor.bakeAllSubmeshes = true;
+
+	auto truckListener = meshCache.registerFileChangedHandler(truckDescriptor.absPath, []() {});
+	auto duckListener = meshCache.registerFileChangedHandler(duckDescriptor.absPath, []() {});
+	auto truck = meshCache.loadMesh(truckDescriptor);
+	auto duck = meshCache.loadMesh(duckDescriptor);
+	ASSERT_NE(truck, nullptr);
+	ASSERT_NE(duck, nullptr);
+
+	// The truck entry is retained while it is the only unused one.
+	truckListener.reset();
+	EXPECT_EQ(meshCache.loadMesh(truckDescriptor), truck);
+
+	// Evicted once the duck entry becomes unused after it.
+	duckListener.reset();
+	EXPECT_NE(meshCache.loadMesh(truckDescriptor), truck);
+	EXPECT_EQ(meshCache.loadMesh(duckDescriptor), duck);
+
+	// Using an entry again removes it from the unused entries.
+	duckListener = meshCache.registerFileChangedHandler(duckDescriptor.absPath, []() {});
+	meshCache.setMaxUnusedEntries(0);
+	EXPECT_EQ(meshCache.loadMesh(duckDescriptor), duck);
+}
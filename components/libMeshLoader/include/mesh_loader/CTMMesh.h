@@ -20,7 +20,7 @@ namespace raco::mesh_loader {
 
 class CTMMesh : public raco::core::MeshData {
 public:
-	CTMMesh(CTMimporter& importer);
+	CTMMesh(CTMimporter& importer, const core::MeshDescriptor& descriptor);
 
 	uint32_t numSubmeshes() const override;
 	uint32_t numTriangles() const override;
@@ -28,6 +28,7 @@ public:
 
 
 	const std::vector<uint32_t>& getIndices() const override;
+	const std::vector<uint16_t>& getIndices16() const override;
 	std::vector<std::string> getMaterialNames() const override;
 
 	const std::vector<IndexBufferRangeInfo>& submeshIndexBufferRanges() const override;
@@ -50,6 +51,7 @@ private:
 	uint32_t numVertices_;
 
 	std::vector<uint32_t> indexBuffer_;
+	std::vector<uint16_t> indexBuffer16_;
 	std::vector<Attribute> attributes_;
 	std::vector<IndexBufferRangeInfo> submeshIndexBufferRanges_;
 };
@@ -0,0 +1,44 @@
+/*
+ * SPDX-License-Identifier: MPL-2.0
+ *
+ * This file is part of Ramses Composer
+ * (see https://github.com/GENIVI/ramses-composer).
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include "core/MeshCacheInterface.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace raco::mesh_loader {
+
+// Per-vertex data of one attribute with `components` floats per vertex.
+struct MeshOptimizerAttribute {
+	std::vector<float>* data;
+	size_t components;
+};
+
+size_t attributeComponents(core::MeshData::VertexAttribDataType type);
+
+// Maps every vertex to the first vertex with bitwise identical values in all `attributes`.
+std::vector<uint32_t> findDuplicateVertices(uint32_t vertexCount, const std::vector<MeshOptimizerAttribute>& attributes);
+
+// Reorders the triangles in `indices` to reduce the misses of the post-transform vertex cache of the GPU.
+// Uses the algorithm of Tom Forsyth, see https://tomforsyth1000.github.io/papers/fast_vert_cache_opt.html
+void optimizeVertexCache(uint32_t* indices, size_t indexCount, uint32_t vertexCount);
+
+// Welds vertices with identical attribute values, reorders the triangles of each index range with optimizeVertexCache
+// and renumbers the vertices in the order of their first use. Vertices not referenced by any index are removed.
+// The mesh is left unchanged if the attribute sizes or indices don't match `vertexCount`.
+// @return the number of vertices after the optimization.
+uint32_t optimizeMesh(std::vector<uint32_t>& indices, const std::vector<core::MeshData::IndexBufferRangeInfo>& ranges, const std::vector<MeshOptimizerAttribute>& attributes, uint32_t vertexCount);
+
+// 16-bit copy of `indices` if all vertices of a mesh with `vertexCount` vertices can be addressed with 16 bits, empty otherwise.
+std::vector<uint16_t> narrowIndices(const std::vector<uint32_t>& indices, uint32_t vertexCount);
+
+}  // namespace raco::mesh_loader
@@ -10,37 +10,158 @@
 #pragma once
 
 #include <log_system/log.h>
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <limits>
 #include <set>
 #include <tiny_gltf.h>
+#include <type_traits>
 
+// Strided view of the elements of a glTF accessor with component type T, pointing into the buffer of the model.
+// Element `index` starts `index * stride()` bytes after the first one and consists of `components()` values.
+template <typename T>
+class glTFAccessorView {
+public:
+	glTFAccessorView(const unsigned char *data, size_t size, size_t stride, size_t components)
+		: data_(data), size_(size), stride_(stride), components_(components) {
+	}
+
+	size_t size() const {
+		return size_;
+	}
+
+	size_t stride() const {
+		return stride_;
+	}
+
+	size_t components() const {
+		return components_;
+	}
+
+	// No gaps between the elements: the view is an array of `size() * components()` values.
+	bool contiguous() const {
+		return stride_ == components_ * sizeof(T);
+	}
+
+	// First component of the element at `index`.
+	const T *operator[](size_t index) const {
+		assert(index < size_);
+		return reinterpret_cast<const T *>(data_ + index * stride_);
+	}
+
+private:
+	const unsigned char *data_;
+	size_t size_;
+	size_t stride_;
+	size_t components_;
+};
+
+// glTF int-to-float conversion of normalized integers, see
+// https://github.com/KhronosGroup/glTF/blob/main/specification/2.0/Specification.adoc#animations
+template <typename T>
+inline float glTFNormalizedToFloat(T value) {
+	if constexpr (std::is_floating_point_v<T>) {
+		return static_cast<float>(value);
+	} else if constexpr (std::is_signed_v<T>) {
+		return std::max(value / static_cast<float>(std::numeric_limits<T>::max()), -1.0F);
+	} else {
+		return value / static_cast<float>(std::numeric_limits<T>::max());
+	}
+}
+
+// Converts the first `count` elements of `view` to `components` floats each, see glTFBufferData::readFloats.
+template <typename T>
+void glTFReadFloats(const glTFAccessorView<T> &view, size_t count, float *out, size_t components, float fill) {
+	assert(count <= view.size());
+	if (count == 0) {
+		return;
+	}
+	if (view.contiguous() && view.components() == components) {
+		// Single loop over all values, which the compiler can vectorize.
+		const T *values = view[0];
+		if constexpr (std::is_same_v<T, float>) {
+			std::memcpy(out, values, count * components * sizeof(float));
+		} else {
+			for (size_t index = 0; index < count * components; index++) {
+				out[index] = glTFNormalizedToFloat(values[index]);
+			}
+		}
+		return;
+	}
+
+	auto converted = std::min(components, view.components());
+	for (size_t index = 0; index < count; index++) {
+		const T *element = view[index];
+		float *dest = out + index * components;
+		for (size_t component = 0; component < converted; component++) {
+			dest[component] = glTFNormalizedToFloat(element[component]);
+		}
+		for (size_t component = converted; component < components; component++) {
+			dest[component] = fill;
+		}
+	}
+}
+
+// Data of a glTF accessor. The data of the first buffer is read from `binChunk` if given, which is the BIN chunk of
+// a memory-mapped .glb file whose copy in the model has been released.
 struct glTFBufferData {
-	glTFBufferData(const tinygltf::Model &scene, int accessorIndex, const std::set<int> &&allowedComponentTypes = {})
+	glTFBufferData(const tinygltf::Model &scene, int accessorIndex, const std::set<int> &&allowedComponentTypes = {}, const unsigned char *binChunk = nullptr)
 		: scene_(scene),
 		  accessor_(scene_.accessors[accessorIndex]),
 		  view_(scene_.bufferViews[accessor_.bufferView]),
-		  bufferBytes(scene_.buffers[view_.buffer].data) {
+		  bufferBytes(binChunk && view_.buffer == 0 ? binChunk : scene_.buffers[view_.buffer].data.data()) {
 		if (!allowedComponentTypes.empty() && allowedComponentTypes.find(accessor_.componentType) == allowedComponentTypes.end()) {
 			LOG_ERROR(raco::log_system::MESH_LOADER, "glTF buffer accessor '{}' has invalid data type {}", accessor_.name, accessor_.componentType);
 		}
 	}
 
-	template <typename T>
-	std::vector<T> getDataAt(size_t index, bool useComponentSize = true) {
-		auto componentSize = (useComponentSize) ? accessor_.ByteStride(view_) / sizeof(T) : 1;
-		assert(componentSize > 0);
+	size_t count() const {
+		return accessor_.count;
+	}
 
-		auto firstByte = reinterpret_cast<const T *>(&bufferBytes[(accessor_.byteOffset + view_.byteOffset)]);
-		std::vector<T> values(componentSize);
+	// Number of components of each element, e.g. 3 for VEC3.
+	size_t components() const {
+		return static_cast<size_t>(std::max(tinygltf::GetNumComponentsInType(static_cast<uint32_t>(accessor_.type)), 1));
+	}
 
-		for (int i = 0; i < values.size(); ++i) {
-			values[i] = firstByte[index * componentSize + i];
-		}
+	// View of the elements without copying them; T must match the component type of the accessor.
+	template <typename T>
+	glTFAccessorView<T> view() const {
+		auto stride = accessor_.ByteStride(view_);
+		assert(stride > 0);
+		return glTFAccessorView<T>(bufferBytes + accessor_.byteOffset + view_.byteOffset, accessor_.count, static_cast<size_t>(stride), components());
+	}
 
-		return values;
+	// Writes the first `count` elements as `components` floats each to `out`, which must have room for `count * components` values.
+	// Integer components are converted like normalized integers in glTF, e.g. 255 to 1.0 for unsigned bytes.
+	// Missing components of elements with less than `components` values are set to `fill`, additional ones are dropped.
+	// @return false if the component type of the accessor is not supported.
+	bool readFloats(float *out, size_t count, size_t components, float fill = 0.0F) const {
+		switch (accessor_.componentType) {
+			case TINYGLTF_COMPONENT_TYPE_FLOAT:
+				glTFReadFloats(view<float>(), count, out, components, fill);
+				return true;
+			case TINYGLTF_COMPONENT_TYPE_BYTE:
+				glTFReadFloats(view<int8_t>(), count, out, components, fill);
+				return true;
+			case TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE:
+				glTFReadFloats(view<uint8_t>(), count, out, components, fill);
+				return true;
+			case TINYGLTF_COMPONENT_TYPE_SHORT:
+				glTFReadFloats(view<int16_t>(), count, out, components, fill);
+				return true;
+			case TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT:
+				glTFReadFloats(view<uint16_t>(), count, out, components, fill);
+				return true;
+			default:
+				return false;
+		}
 	}
 
 	const tinygltf::Model &scene_;
 	const tinygltf::Accessor &accessor_;
 	const tinygltf::BufferView &view_;
-	const std::vector<unsigned char> &bufferBytes;
-};
\ No newline at end of file
+	const unsigned char *bufferBytes;
+};
@@ -11,12 +11,20 @@
 
 #include "core/MeshCacheInterface.h"
 
+#include <cstdint>
+#include <set>
+#include <utility>
+
 namespace tinygltf {
 class TinyGLTF;
 class Model;
 class Node;
 }
 
+namespace raco::utils::file {
+class MappedFile;
+}
+
 namespace raco::mesh_loader {
 
 class glTFFileLoader final : public raco::core::MeshCacheEntry {
@@ -41,10 +49,35 @@ private:
 	std::string error_;
 	std::string warning_;
 
+	// Mapped .glb file while mesh or animation data is extracted. The first buffer of scene_ is empty and read
+	// from binChunk_ instead, at binChunkOffset_ in the file. The file is mapped again for the next extraction.
+	std::unique_ptr<raco::utils::file::MappedFile> mappedFile_;
+	const unsigned char* binChunk_ = nullptr;
+	size_t binChunkOffset_ = 0;
+	size_t binChunkSize_ = 0;
+	bool binChunkReleased_ = false;
+
+	// Modification time and size of the file when the model was parsed.
+	std::pair<int64_t, uint64_t> fileStamp_{};
+
+	// Kept when the model is released, like the scenegraph.
+	int totalMeshCount_ = 0;
+
+	// Submeshes and animation samplers extracted from the current model of a .glb file.
+	std::set<int> extractedSubmeshes_;
+	std::set<std::pair<int, int>> extractedSamplers_;
+
 	bool buildglTFScenegraph();
 	bool importglTFScene(const std::string& absPath);
+	// Also parses the model or maps the BIN chunk again if they have been released after the last extraction.
+	bool importglTFModel(const std::string& absPath);
+	bool loadModel(const std::string& absPath);
+	bool mapBinChunk(const std::string& absPath);
 	void importAnimations();
-
+	bool allDataExtracted() const;
+	// Called after an extraction. Unmaps the BIN chunk of .glb files, and releases their whole model once all
+	// submeshes and animation samplers have been extracted. The model of other glTF files is kept.
+	void releaseModelData();
 };
 
 } // namespace raco::mesh_loader
\ No newline at end of file
@@ -12,6 +12,7 @@
 #include "core/MeshCacheInterface.h"
 
 #include <glm/mat4x4.hpp>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -26,7 +27,8 @@ namespace raco::mesh_loader {
 
 class glTFMesh : public raco::core::MeshData {
 public:
-	glTFMesh(const tinygltf::Model &scene, const core::MeshScenegraph &sceneGraph, const core::MeshDescriptor &descriptor);
+	// `binChunk` is the BIN chunk of a memory-mapped .glb file if the model doesn't hold a copy of it, see glTFBufferData.
+	glTFMesh(const tinygltf::Model &scene, const core::MeshScenegraph &sceneGraph, const core::MeshDescriptor &descriptor, const unsigned char *binChunk = nullptr);
 
 	uint32_t numSubmeshes() const override;
 	uint32_t numTriangles() const override;
@@ -35,6 +37,7 @@ public:
 	std::vector<std::string> getMaterialNames() const override;
 
 	const std::vector<uint32_t>& getIndices() const override;
+	const std::vector<uint16_t>& getIndices16() const override;
 
 	const std::vector<IndexBufferRangeInfo>& submeshIndexBufferRanges() const override;
 
@@ -55,13 +58,21 @@ private:
 	constexpr static inline auto MAX_NUMBER_TEXTURECOORDS = 2;
 	constexpr static inline auto MAX_NUMBER_COLORS = 2;
 
-	void loadPrimitiveData(const tinygltf::Primitive& primitive, const tinygltf::Model& scene, std::vector<float>& vertexBuffer, std::vector<float>& normalBuffer, std::vector<float>& tangentBuffer, std::vector<float>& bitangentBuffer,
-		std::vector<std::vector<float>>& uvBuffers, std::vector<std::vector<float>>& colorBuffers, glm::dmat4* rootTrafoMatrix = nullptr);
+	struct BufferOffsets;
+	struct VertexBuffers;
+	struct PrimitiveData;
+
+	// Checks the accessors of `primitive` and appends them to `primitives`, with the offsets of its data in the mesh buffers.
+	// Adds the sizes of its data to `sizes` and its vertices and triangles to the mesh.
+	void addPrimitive(const tinygltf::Primitive& primitive, const tinygltf::Model& scene, const unsigned char* binChunk, const std::optional<glm::mat4>& transformation, std::vector<PrimitiveData>& primitives, BufferOffsets& sizes);
+	// Reads the data of a primitive into its ranges of the preallocated buffers; may run concurrently for different primitives.
+	void loadPrimitiveData(const PrimitiveData& data, VertexBuffers& buffers);
 
 	uint32_t numTriangles_;
 	uint32_t numVertices_;
 
 	std::vector<uint32_t> indexBuffer_;
+	std::vector<uint16_t> indexBuffer16_;
 	std::vector<Attribute> attributes_;
 	std::vector<IndexBufferRangeInfo> submeshIndexBufferRanges_;
 
@@ -87,7 +87,7 @@ bool CTMFileLoader::loadFile() {
 
 raco::core::SharedMeshData CTMFileLoader::loadMesh(const raco::core::MeshDescriptor& descriptor) {
 	if (loadFile()) {
-		return std::make_shared<CTMMesh>(*importer_.get());
+		return std::make_shared<CTMMesh>(*importer_.get(), descriptor);
 	}
 	return raco::core::SharedMeshData();
 }
@@ -9,13 +9,15 @@
  */
 #include "mesh_loader/CTMMesh.h"
 
+#include "mesh_loader/MeshOptimizer.h"
+
 #include <openctmpp.h>
 
 namespace raco::mesh_loader {
 
 using namespace raco::core;
 
-CTMMesh::CTMMesh(CTMimporter& importer) {
+CTMMesh::CTMMesh(CTMimporter& importer, const MeshDescriptor& descriptor) {
 	numTriangles_ = importer.GetInteger(CTM_TRIANGLE_COUNT);
 	numVertices_ = importer.GetInteger(CTM_VERTEX_COUNT);
 
@@ -55,6 +57,15 @@ CTMMesh::CTMMesh(CTMimporter& importer) {
 	}
 
 	submeshIndexBufferRanges_ = {{0, 3 * numTriangles_}};
+
+	if (descriptor.optimize) {
+		std::vector<MeshOptimizerAttribute> optimizerAttributes;
+		for (auto& attribute : attributes_) {
+			optimizerAttributes.emplace_back(MeshOptimizerAttribute{&attribute.data, attributeComponents(attribute.type)});
+		}
+		numVertices_ = optimizeMesh(indexBuffer_, submeshIndexBufferRanges_, optimizerAttributes, numVertices_);
+		indexBuffer16_ = narrowIndices(indexBuffer_, numVertices_);
+	}
 }
 
 uint32_t CTMMesh::numSubmeshes() const {
@@ -77,6 +88,10 @@ const std::vector<uint32_t>& CTMMesh::getIndices() const {
 	return indexBuffer_;
 }
 
+const std::vector<uint16_t>& CTMMesh::getIndices16() const {
+	return indexBuffer16_;
+}
+
 const std::vector<MeshData::IndexBufferRangeInfo>& CTMMesh::submeshIndexBufferRanges() const {
 	return submeshIndexBufferRanges_;
 }
@@ -0,0 +1,289 @@
+/*
+ * SPDX-License-Identifier: MPL-2.0
+ *
+ * This file is part of Ramses Composer
+ * (see https://github.com/GENIVI/ramses-composer).
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "mesh_loader/MeshOptimizer.h"
+
+#include <log_system/log.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+namespace {
+
+using raco::mesh_loader::MeshOptimizerAttribute;
+
+constexpr uint32_t INVALID_VERTEX = std::numeric_limits<uint32_t>::max();
+
+// Parameters of the vertex cache optimization as proposed by Tom Forsyth.
+constexpr size_t CACHE_SIZE = 32;
+constexpr float CACHE_DECAY_POWER = 1.5F;
+constexpr float LAST_TRIANGLE_SCORE = 0.75F;
+constexpr float VALENCE_BOOST_SCALE = 2.0F;
+constexpr float VALENCE_BOOST_POWER = 0.5F;
+
+float vertexScore(int cachePosition, uint32_t activeTriangles) {
+	if (activeTriangles == 0) {
+		// Not used by any remaining triangle.
+		return -1.0F;
+	}
+	float score = 0.0F;
+	if (cachePosition >= 0) {
+		if (cachePosition < 3) {
+			// Used by the last triangle: fixed score to avoid favoring any of its edges.
+			score = LAST_TRIANGLE_SCORE;
+		} else {
+			score = std::pow(1.0F - static_cast<float>(cachePosition - 3) / static_cast<float>(CACHE_SIZE - 3), CACHE_DECAY_POWER);
+		}
+	}
+	// Prefer vertices with few remaining triangles to get rid of lone triangles early.
+	return score + VALENCE_BOOST_SCALE * std::pow(static_cast<float>(activeTriangles), -VALENCE_BOOST_POWER);
+}
+
+uint64_t hashVertex(uint32_t vertex, const std::vector<MeshOptimizerAttribute> &attributes) {
+	// FNV-1a over the bit patterns of all attribute values.
+	uint64_t hash = 14695981039346656037ULL;
+	for (const auto &attribute : attributes) {
+		const float *values = attribute.data->data() + vertex * attribute.components;
+		for (size_t component = 0; component < attribute.components; component++) {
+			uint32_t bits;
+			std::memcpy(&bits, &values[component], sizeof(bits));
+			hash = (hash ^ bits) * 1099511628211ULL;
+		}
+	}
+	// The low bits used for the table slot only depend on the low mantissa bits so far, which are zero for many typical values.
+	hash ^= hash >> 33;
+	hash *= 0xff51afd7ed558ccdULL;
+	hash ^= hash >> 33;
+	return hash;
+}
+
+bool equalVertices(uint32_t left, uint32_t right, const std::vector<MeshOptimizerAttribute> &attributes) {
+	for (const auto &attribute : attributes) {
+		const float *values = attribute.data->data();
+		if (std::memcmp(values + left * attribute.components, values + right * attribute.components, attribute.components * sizeof(float)) != 0) {
+			return false;
+		}
+	}
+	return true;
+}
+
+}  // namespace
+
+namespace raco::mesh_loader {
+
+size_t attributeComponents(core::MeshData::VertexAttribDataType type) {
+	switch (type) {
+		case core::MeshData::VertexAttribDataType::VAT_Float:
+			return 1;
+		case core::MeshData::VertexAttribDataType::VAT_Float2:
+			return 2;
+		case core::MeshData::VertexAttribDataType::VAT_Float3:
+			return 3;
+		case core::MeshData::VertexAttribDataType::VAT_Float4:
+			return 4;
+		default:  // NOLINT(clang-diagnostic-covered-switch-default)
+			throw std::range_error("Not a valid attribute type.");
+	}
+}
+
+std::vector<uint32_t> findDuplicateVertices(uint32_t vertexCount, const std::vector<MeshOptimizerAttribute> &attributes) {
+	std::vector<uint32_t> firstVertex(vertexCount);
+
+	// Open addressing hash table of the first vertices, with at most 50% load.
+	size_t tableSize = 1;
+	while (tableSize < 2 * static_cast<size_t>(vertexCount)) {
+		tableSize *= 2;
+	}
+	std::vector<uint32_t> table(tableSize, INVALID_VERTEX);
+
+	for (uint32_t vertex = 0; vertex < vertexCount; vertex++) {
+		auto slot = static_cast<size_t>(hashVertex(vertex, attributes)) & (tableSize - 1);
+		while (table[slot] != INVALID_VERTEX && !equalVertices(table[slot], vertex, attributes)) {
+			slot = (slot + 1) & (tableSize - 1);
+		}
+		if (table[slot] == INVALID_VERTEX) {
+			table[slot] = vertex;
+		}
+		firstVertex[vertex] = table[slot];
+	}
+	return firstVertex;
+}
+
+void optimizeVertexCache(uint32_t *indices, size_t indexCount, uint32_t vertexCount) {
+	auto triangleCount = indexCount / 3;
+	if (triangleCount == 0) {
+		return;
+	}
+
+	// Triangles not emitted yet using each vertex: the first activeTriangles[v] entries at vertexTriangles[triangleOffsets[v]].
+	std::vector<uint32_t> activeTriangles(vertexCount, 0);
+	for (size_t index = 0; index < triangleCount * 3; index++) {
+		++activeTriangles[indices[index]];
+	}
+	std::vector<uint32_t> triangleOffsets(vertexCount + 1, 0);
+	for (uint32_t vertex = 0; vertex < vertexCount; vertex++) {
+		triangleOffsets[vertex + 1] = triangleOffsets[vertex] + activeTriangles[vertex];
+	}
+	std::vector<uint32_t> vertexTriangles(triangleCount * 3);
+	{
+		std::vector<uint32_t> fill(triangleOffsets.begin(), triangleOffsets.end() - 1);
+		for (size_t index = 0; index < triangleCount * 3; index++) {
+			vertexTriangles[fill[indices[index]]++] = static_cast<uint32_t>(index / 3);
+		}
+	}
+
+	std::vector<float> vertexScores(vertexCount);
+	for (uint32_t vertex = 0; vertex < vertexCount; vertex++) {
+		vertexScores[vertex] = vertexScore(-1, activeTriangles[vertex]);
+	}
+	std::vector<float> triangleScores(triangleCount);
+	for (size_t triangle = 0; triangle < triangleCount; triangle++) {
+		triangleScores[triangle] = vertexScores[indices[3 * triangle]] + vertexScores[indices[3 * triangle + 1]] + vertexScores[indices[3 * triangle + 2]];
+	}
+	std::vector<bool> emitted(triangleCount, false);
+
+	std::vector<uint32_t> result;
+	result.reserve(triangleCount * 3);
+	std::vector<uint32_t> cache;
+	std::vector<uint32_t> newCache;
+	cache.reserve(CACHE_SIZE + 3);
+	newCache.reserve(CACHE_SIZE + 3);
+
+	auto bestTriangle = static_cast<size_t>(std::max_element(triangleScores.begin(), triangleScores.end()) - triangleScores.begin());
+	size_t nextUnemitted = 0;
+	while (true) {
+		emitted[bestTriangle] = true;
+		const uint32_t *triangleVertices = indices + 3 * bestTriangle;
+		result.insert(result.end(), triangleVertices, triangleVertices + 3);
+		if (result.size() == triangleCount * 3) {
+			break;
+		}
+
+		// Move the vertices of the emitted triangle to the front of the cache.
+		newCache.clear();
+		for (size_t corner = 0; corner < 3; corner++) {
+			auto vertex = triangleVertices[corner];
+			auto first = vertexTriangles.begin() + triangleOffsets[vertex];
+			auto last = first + activeTriangles[vertex];
+			auto it = std::find(first, last, static_cast<uint32_t>(bestTriangle));
+			if (it != last) {
+				std::iter_swap(it, last - 1);
+				--activeTriangles[vertex];
+			}
+			if (std::find(newCache.begin(), newCache.end(), vertex) == newCache.end()) {
+				newCache.emplace_back(vertex);
+			}
+		}
+		auto triangleVertexCount = newCache.size();
+		for (auto vertex : cache) {
+			if (std::find(newCache.begin(), newCache.begin() + triangleVertexCount, vertex) == newCache.begin() + triangleVertexCount) {
+				newCache.emplace_back(vertex);
+			}
+		}
+
+		// Update the scores of all vertices in the cache, including those just pushed out of it.
+		for (size_t position = 0; position < newCache.size(); position++) {
+			auto vertex = newCache[position];
+			auto cachePosition = position < CACHE_SIZE ? static_cast<int>(position) : -1;
+			auto score = vertexScore(cachePosition, activeTriangles[vertex]);
+			auto delta = score - vertexScores[vertex];
+			vertexScores[vertex] = score;
+			for (auto index = triangleOffsets[vertex]; index < triangleOffsets[vertex] + activeTriangles[vertex]; index++) {
+				triangleScores[vertexTriangles[index]] += delta;
+			}
+		}
+		if (newCache.size() > CACHE_SIZE) {
+			newCache.resize(CACHE_SIZE);
+		}
+		std::swap(cache, newCache);
+
+		// The next triangle is the best one using a cached vertex, or the next one not emitted yet if there is none.
+		float bestScore = -std::numeric_limits<float>::max();
+		bool found = false;
+		for (auto vertex : cache) {
+			for (auto index = triangleOffsets[vertex]; index < triangleOffsets[vertex] + activeTriangles[vertex]; index++) {
+				auto triangle = vertexTriangles[index];
+				if (triangleScores[triangle] > bestScore) {
+					bestScore = triangleScores[triangle];
+					bestTriangle = triangle;
+					found = true;
+				}
+			}
+		}
+		if (!found) {
+			while (emitted[nextUnemitted]) {
+				++nextUnemitted;
+			}
+			bestTriangle = nextUnemitted;
+		}
+	}
+
+	std::copy(result.begin(), result.end(), indices);
+}
+
+uint32_t optimizeMesh(std::vector<uint32_t> &indices, const std::vector<core::MeshData::IndexBufferRangeInfo> &ranges, const std::vector<MeshOptimizerAttribute> &attributes, uint32_t vertexCount) {
+	for (const auto &attribute : attributes) {
+		if (attribute.data->size() != vertexCount * attribute.components) {
+			LOG_WARNING(raco::log_system::MESH_LOADER, "Mesh attributes have different vertex counts - mesh will not be optimized");
+			return vertexCount;
+		}
+	}
+	if (std::any_of(indices.begin(), indices.end(), [vertexCount](uint32_t index) { return index >= vertexCount; })) {
+		LOG_WARNING(raco::log_system::MESH_LOADER, "Mesh indices are out of range - mesh will not be optimized");
+		return vertexCount;
+	}
+
+	auto firstVertex = findDuplicateVertices(vertexCount, attributes);
+	for (auto &index : indices) {
+		index = firstVertex[index];
+	}
+
+	for (const auto &range : ranges) {
+		// Only triangle lists can be reordered.
+		if (range.count % 3 == 0 && static_cast<size_t>(range.start) + range.count <= indices.size()) {
+			optimizeVertexCache(indices.data() + range.start, range.count, vertexCount);
+		}
+	}
+
+	// Renumber the vertices in the order of their first use to improve the locality of the vertex fetches.
+	std::vector<uint32_t> newIndices(vertexCount, INVALID_VERTEX);
+	std::vector<uint32_t> oldIndices;
+	oldIndices.reserve(vertexCount);
+	for (auto &index : indices) {
+		if (newIndices[index] == INVALID_VERTEX) {
+			newIndices[index] = static_cast<uint32_t>(oldIndices.size());
+			oldIndices.emplace_back(index);
+		}
+		index = newIndices[index];
+	}
+
+	for (const auto &attribute : attributes) {
+		std::vector<float> data(oldIndices.size() * attribute.components);
+		for (size_t vertex = 0; vertex < oldIndices.size(); vertex++) {
+			std::copy_n(attribute.data->data() + oldIndices[vertex] * attribute.components, attribute.components, data.data() + vertex * attribute.components);
+		}
+		*attribute.data = std::move(data);
+	}
+
+	return static_cast<uint32_t>(oldIndices.size());
+}
+
+std::vector<uint16_t> narrowIndices(const std::vector<uint32_t> &indices, uint32_t vertexCount) {
+	if (vertexCount > static_cast<uint32_t>(std::numeric_limits<uint16_t>::max()) + 1) {
+		return {};
+	}
+	std::vector<uint16_t> result(indices.size());
+	std::transform(indices.begin(), indices.end(), result.begin(), [](uint32_t index) { return static_cast<uint16_t>(index); });
+	return result;
+}
+
+}  // namespace raco::mesh_loader
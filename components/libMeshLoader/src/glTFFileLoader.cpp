@@ -16,6 +16,7 @@
 
 #include "mesh_loader/glTFBufferData.h"
 #include "mesh_loader/glTFMesh.h"
+#include "utils/FileUtils.h"
 #include "utils/MathUtils.h"
 #include "utils/stdfilesystem.h"
 
@@ -26,8 +27,51 @@
 #include <glm/gtc/epsilon.hpp>
 #include <glm/gtx/matrix_decompose.hpp>
 
+#include <cstring>
+#include <limits>
+
 namespace {
 
+// Start of the BIN chunk of a .glb file, see https://registry.khronos.org/glTF/specs/2.0/glTF-2.0.html#binary-gltf-layout
+// @return nullptr if the file has no BIN chunk.
+const unsigned char* glbBinChunk(const unsigned char* data, size_t size, size_t& chunkSize) {
+	constexpr size_t HEADER_SIZE = 12;
+	constexpr size_t CHUNK_HEADER_SIZE = 8;
+	constexpr uint32_t CHUNK_TYPE_BIN = 0x004E4942;
+
+	if (size < HEADER_SIZE + CHUNK_HEADER_SIZE) {
+		return nullptr;
+	}
+	uint32_t jsonLength;
+	std::memcpy(&jsonLength, data + HEADER_SIZE, sizeof(jsonLength));
+	auto binHeader = HEADER_SIZE + CHUNK_HEADER_SIZE + static_cast<size_t>(jsonLength);
+	if (size < binHeader + CHUNK_HEADER_SIZE) {
+		return nullptr;
+	}
+	uint32_t binLength;
+	uint32_t binType;
+	std::memcpy(&binLength, data + binHeader, sizeof(binLength));
+	std::memcpy(&binType, data + binHeader + sizeof(binLength), sizeof(binType));
+	if (binType != CHUNK_TYPE_BIN || size - binHeader - CHUNK_HEADER_SIZE < binLength) {
+		return nullptr;
+	}
+	chunkSize = binLength;
+	return data + binHeader + CHUNK_HEADER_SIZE;
+}
+
+std::pair<int64_t, uint64_t> fileStamp(const std::string& path) {
+	std::error_code ec;
+	auto time = std::filesystem::last_write_time(path, ec);
+	if (ec) {
+		return {};
+	}
+	auto size = std::filesystem::file_size(path, ec);
+	if (ec) {
+		return {};
+	}
+	return {static_cast<int64_t>(time.time_since_epoch().count()), static_cast<uint64_t>(size)};
+}
+
 std::array<std::array<double, 3>, 3> tinyglTFtrafoMatrixToXYZTrafos(const std::vector<double>& tinyMatrix) {
 	assert(tinyMatrix.size() == 16);
 
@@ -70,12 +114,22 @@ void glTFFileLoader::reset() {
 	sceneGraph_.reset();
 	importer_.reset();
 	scene_.reset(new tinygltf::Model);
+	mappedFile_.reset();
+	binChunk_ = nullptr;
+	binChunkReleased_ = false;
+	totalMeshCount_ = 0;
+	extractedSubmeshes_.clear();
+	extractedSamplers_.clear();
 }
 
 bool glTFFileLoader::buildglTFScenegraph() {
 	sceneGraph_.reset(new raco::core::MeshScenegraph);
 
 	// import nodes
+	totalMeshCount_ = 0;
+	for (const auto& mesh : scene_->meshes) {
+		totalMeshCount_ += static_cast<int>(mesh.primitives.size());
+	}
 	std::vector<int> totalMeshPrimitiveSums(scene_->meshes.size());
 	for (auto meshIndex = 0; meshIndex < scene_->meshes.size(); ++meshIndex) {
 		const auto& mesh = scene_->meshes[meshIndex];
@@ -151,24 +205,8 @@ bool glTFFileLoader::buildglTFScenegraph() {
 bool glTFFileLoader::importglTFScene(const std::string& absPath) {
 	error_.clear();
 
-	if (!importer_) {
-		LOG_DEBUG(log_system::MESH_LOADER, "Create importer for: {}", absPath);
-		importer_ = std::make_unique<tinygltf::TinyGLTF>();
-		std::string err;
-		std::string warn;
-
-		if (std::filesystem::path(absPath).extension() == ".glb") {
-			importer_->LoadBinaryFromFile(&*scene_, &err, &warn, absPath);
-		} else {
-			importer_->LoadASCIIFromFile(&*scene_, &err, &warn, absPath);
-		}
-		if (!warn.empty()) {
-			LOG_WARNING(log_system::MESH_LOADER, "Encountered warnings while loading glTF mesh {}: {}", absPath, warn);
-		}
-		if (!err.empty()) {
-			error_ = err;
-			LOG_ERROR(log_system::MESH_LOADER, "Encountered an error while loading glTF mesh {}\n\tError: {}", absPath, error_);
-			importer_.reset();
+	if (!sceneGraph_) {
+		if (!loadModel(absPath)) {
 			return false;
 		}
 
@@ -182,6 +220,116 @@ bool glTFFileLoader::importglTFScene(const std::string& absPath) {
 	return true;
 }
 
+bool glTFFileLoader::importglTFModel(const std::string& absPath) {
+	if (!importglTFScene(absPath)) {
+		return false;
+	}
+	if (importer_ && !binChunkReleased_) {
+		return true;
+	}
+	if (fileStamp(absPath) != fileStamp_) {
+		// The file changed since it was parsed, so the scenegraph may not match it anymore either.
+		LOG_DEBUG(log_system::MESH_LOADER, "glTF file changed since it was parsed: {}", absPath);
+		reset();
+		return importglTFScene(absPath);
+	}
+	if (importer_) {
+		return mapBinChunk(absPath);
+	}
+	return loadModel(absPath);
+}
+
+bool glTFFileLoader::loadModel(const std::string& absPath) {
+	LOG_DEBUG(log_system::MESH_LOADER, "Create importer for: {}", absPath);
+	importer_ = std::make_unique<tinygltf::TinyGLTF>();
+	scene_.reset(new tinygltf::Model);
+	mappedFile_.reset();
+	binChunk_ = nullptr;
+	binChunkReleased_ = false;
+	fileStamp_ = fileStamp(absPath);
+	std::string err;
+	std::string warn;
+
+	if (std::filesystem::path(absPath).extension() == ".glb") {
+		auto mappedFile = std::make_unique<raco::utils::file::MappedFile>(absPath);
+		if (mappedFile->data() && mappedFile->size() <= std::numeric_limits<unsigned int>::max()) {
+			importer_->LoadBinaryFromMemory(&*scene_, &err, &warn, mappedFile->data(), static_cast<unsigned int>(mappedFile->size()), std::filesystem::path(absPath).parent_path().string());
+
+			// tinygltf copies the BIN chunk into the first buffer: read it from the mapped file instead and release the copy.
+			size_t binChunkSize = 0;
+			auto binChunk = glbBinChunk(mappedFile->data(), mappedFile->size(), binChunkSize);
+			if (err.empty() && binChunk && !scene_->buffers.empty() && scene_->buffers.front().uri.empty() && scene_->buffers.front().data.size() <= binChunkSize) {
+				std::vector<unsigned char>().swap(scene_->buffers.front().data);
+				binChunk_ = binChunk;
+				binChunkOffset_ = static_cast<size_t>(binChunk - mappedFile->data());
+				binChunkSize_ = binChunkSize;
+				mappedFile_ = std::move(mappedFile);
+			}
+		} else {
+			// Let tinygltf report why the file can't be read.
+			importer_->LoadBinaryFromFile(&*scene_, &err, &warn, absPath);
+		}
+	} else {
+		importer_->LoadASCIIFromFile(&*scene_, &err, &warn, absPath);
+	}
+	if (!warn.empty()) {
+		LOG_WARNING(log_system::MESH_LOADER, "Encountered warnings while loading glTF mesh {}: {}", absPath, warn);
+	}
+	if (!err.empty()) {
+		error_ = err;
+		LOG_ERROR(log_system::MESH_LOADER, "Encountered an error while loading glTF mesh {}\n\tError: {}", absPath, error_);
+		importer_.reset();
+		mappedFile_.reset();
+		binChunk_ = nullptr;
+		return false;
+	}
+	return true;
+}
+
+bool glTFFileLoader::mapBinChunk(const std::string& absPath) {
+	auto mappedFile = std::make_unique<raco::utils::file::MappedFile>(absPath);
+	if (!mappedFile->data() || mappedFile->size() < binChunkOffset_ + binChunkSize_) {
+		// Parse the file again, which reports why it can't be read.
+		reset();
+		return importglTFScene(absPath);
+	}
+	binChunk_ = mappedFile->data() + binChunkOffset_;
+	mappedFile_ = std::move(mappedFile);
+	binChunkReleased_ = false;
+	return true;
+}
+
+bool glTFFileLoader::allDataExtracted() const {
+	if (!sceneGraph_ || extractedSubmeshes_.size() < static_cast<size_t>(totalMeshCount_)) {
+		return false;
+	}
+	size_t samplerCount = 0;
+	for (const auto& samplers : sceneGraph_->animationSamplers) {
+		samplerCount += samplers.size();
+	}
+	return extractedSamplers_.size() >= samplerCount;
+}
+
+void glTFFileLoader::releaseModelData() {
+	if (std::filesystem::path(path_).extension() != ".glb") {
+		return;
+	}
+	if (allDataExtracted()) {
+		// The scenegraph and mesh count are kept, the model is parsed again if data is requested again.
+		LOG_DEBUG(log_system::MESH_LOADER, "Release glTF model of: {}", path_);
+		importer_.reset();
+		scene_.reset(new tinygltf::Model);
+		extractedSubmeshes_.clear();
+		extractedSamplers_.clear();
+		binChunkReleased_ = false;
+	} else if (mappedFile_) {
+		// Parsing the model again is not needed: it stays valid as long as the file is unchanged.
+		binChunkReleased_ = true;
+	}
+	mappedFile_.reset();
+	binChunk_ = nullptr;
+}
+
 void glTFFileLoader::importAnimations() {
 	sceneGraph_->animations.resize(scene_->animations.size(), raco::core::MeshAnimation{});
 	sceneGraph_->animationSamplers.resize(scene_->animations.size());
@@ -213,28 +361,29 @@ raco::core::MeshScenegraph* glTFFileLoader::getScenegraph(const std::string& abs
 	if (!importglTFScene(absPath)) {
 		return nullptr;
 	}
+	if (mappedFile_) {
+		// Don't keep the file mapped until the next extraction.
+		releaseModelData();
+	}
 	return sceneGraph_.get();
 }
 
 int glTFFileLoader::getTotalMeshCount() {
-	auto primitiveCount = 0;
-	for (const auto& mesh : scene_->meshes) {
-		primitiveCount += mesh.primitives.size();
-	}
-
-	return primitiveCount;
+	return totalMeshCount_;
 }
 
 std::shared_ptr<raco::core::MeshAnimationSamplerData> glTFFileLoader::getAnimationSamplerData(const std::string& absPath, int animIndex, int samplerIndex) {
-	if (!importglTFScene(absPath)) {
+	if (!importglTFModel(absPath)) {
 		return {};
 	}
 
 	if (animIndex < 0 || animIndex >= sceneGraph_->animations.size()) {
+		releaseModelData();
 		return {};
 	}
 
 	if (samplerIndex < 0 || samplerIndex >= sceneGraph_->animationSamplers[animIndex].size()) {
+		releaseModelData();
 		return {};
 	}
 
@@ -253,91 +402,62 @@ std::shared_ptr<raco::core::MeshAnimationSamplerData> glTFFileLoader::getAnimati
 		LOG_ERROR(log_system::MESH_LOADER, "animation sampler at index {}.{} has no valid interpolation type. Using linear interpolation as a fallback.", animIndex, samplerIndex);
 	}
 
-	auto inputData = glTFBufferData(*scene_, sampler.input, {TINYGLTF_COMPONENT_TYPE_FLOAT});
-	for (auto count = 0; count < inputData.accessor_.count; ++count) {
-		input.emplace_back(inputData.getDataAt<float>(count).front());
-	}
-
-	auto outputData = glTFBufferData(*scene_, sampler.output, {TINYGLTF_COMPONENT_TYPE_FLOAT, TINYGLTF_COMPONENT_TYPE_BYTE, TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE, TINYGLTF_COMPONENT_TYPE_SHORT, TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT});
-	for (auto count = 0; count < outputData.accessor_.count; ++count) {
-		switch (outputData.accessor_.componentType) {
-			case TINYGLTF_COMPONENT_TYPE_FLOAT: {
-				auto data = outputData.getDataAt<float>(count);
-
-				output.emplace_back(data);
-				break;
-			}
-			// use int-to-float conversion from glTF spec
-			// https://github.com/KhronosGroup/glTF/blob/main/specification/2.0/Specification.adoc#311-animations
-			case TINYGLTF_COMPONENT_TYPE_BYTE: {
-				auto data = outputData.getDataAt<char>(count);
-				std::vector<float> convertedData(data.size());
-				for (auto i = 0; i < data.size(); ++i) {
-					convertedData[i] = std::max(data[i] / 127.0F, -1.0F);
-				}
-
-				output.emplace_back(convertedData);
-				break;
-			}
-			case TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE: {
-				auto data = outputData.getDataAt<unsigned char>(count);
-				std::vector<float> convertedData(data.size());
-				for (auto i = 0; i < data.size(); ++i) {
-					convertedData[i] = data[i] / 255.0F;
-				}
-
-				output.emplace_back(convertedData);
-				break;
-			}
-			case TINYGLTF_COMPONENT_TYPE_SHORT: {
-				auto data = outputData.getDataAt<short>(count);
-				std::vector<float> convertedData(data.size());
-				for (auto i = 0; i < data.size(); ++i) {
-					convertedData[i] = std::max(data[i] / 32767.0F, -1.0F);
-				}
-
-				output.emplace_back(convertedData);
-				break;
-			}
-			case TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT: {
-				auto data = outputData.getDataAt<unsigned short>(count);
-				std::vector<float> convertedData(data.size());
-				for (auto i = 0; i < data.size(); ++i) {
-					convertedData[i] = data[i] / 65535.0F;
-				}
-
-				output.emplace_back(convertedData);
-				break;
-			}
-			default:
-				LOG_ERROR(log_system::MESH_LOADER, "animation sampler at index {}.{} has invalid component type", animIndex, samplerIndex);
-				continue;
+	auto inputData = glTFBufferData(*scene_, sampler.input, {TINYGLTF_COMPONENT_TYPE_FLOAT}, binChunk_);
+	input.resize(inputData.count());
+	inputData.readFloats(input.data(), input.size(), 1);
+
+	// Integer output values are converted with the int-to-float conversion from the glTF spec
+	// https://github.com/KhronosGroup/glTF/blob/main/specification/2.0/Specification.adoc#311-animations
+	auto outputData = glTFBufferData(*scene_, sampler.output, {TINYGLTF_COMPONENT_TYPE_FLOAT, TINYGLTF_COMPONENT_TYPE_BYTE, TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE, TINYGLTF_COMPONENT_TYPE_SHORT, TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT}, binChunk_);
+	auto components = outputData.components();
+	std::vector<float> outputValues(outputData.count() * components);
+	if (outputData.readFloats(outputValues.data(), outputData.count(), components)) {
+		output.reserve(outputData.count());
+		for (auto it = outputValues.begin(); it != outputValues.end(); it += components) {
+			output.emplace_back(it, it + components);
 		}
+	} else {
+		LOG_ERROR(log_system::MESH_LOADER, "animation sampler at index {}.{} has invalid component type", animIndex, samplerIndex);
 	}
 
-	return std::make_shared<raco::core::MeshAnimationSamplerData>(raco::core::MeshAnimationSamplerData{interpolation, input, output});
+	auto samplerData = std::make_shared<raco::core::MeshAnimationSamplerData>(raco::core::MeshAnimationSamplerData{interpolation, std::move(input), std::move(output)});
+	extractedSamplers_.emplace(animIndex, samplerIndex);
+	releaseModelData();
+	return samplerData;
 }
 
 raco::core::SharedMeshData glTFFileLoader::loadMesh(const core::MeshDescriptor& descriptor) {
-	if (!importglTFScene(descriptor.absPath)) {
+	if (!importglTFModel(descriptor.absPath)) {
 		return raco::core::SharedMeshData();
 	}
 	auto meshCount = getTotalMeshCount();
 	if (meshCount == 0) {
 		error_ = "Mesh file contains no valid submeshes to select";
+		releaseModelData();
 		return raco::core::SharedMeshData();
 	} else if (descriptor.bakeAllSubmeshes) {
 		if (std::all_of(sceneGraph_->nodes.begin(), sceneGraph_->nodes.end(), [](const auto& node) { return node->subMeshIndeces.empty(); })) {
 			error_ = "Mesh file contains no bakeable submeshes.\nSubmeshes should be referenced by nodes to be bakeable.";
+			releaseModelData();
 			return raco::core::SharedMeshData();
 		}
 	}
 	if (!descriptor.bakeAllSubmeshes && (descriptor.submeshIndex < 0 || descriptor.submeshIndex >= meshCount)) {
 		error_ = "Selected submesh index is out of valid submesh index range [0," + std::to_string(meshCount - 1) + "]";
+		releaseModelData();
 		return raco::core::SharedMeshData();
 	}
 
-	return std::make_shared<glTFMesh>(*scene_, *sceneGraph_, descriptor);
+	auto mesh = std::make_shared<glTFMesh>(*scene_, *sceneGraph_, descriptor, binChunk_);
+	if (descriptor.bakeAllSubmeshes) {
+		for (int index = 0; index < meshCount; ++index) {
+			extractedSubmeshes_.insert(index);
+		}
+	} else {
+		extractedSubmeshes_.insert(descriptor.submeshIndex);
+	}
+	releaseModelData();
+	return mesh;
 }
 
 std::string glTFFileLoader::getError() {
@@ -11,7 +11,11 @@
 
 #include "mesh_loader/glTFMesh.h"
 
+#include "mesh_loader/MeshOptimizer.h"
 #include "mesh_loader/glTFBufferData.h"
+#include "utils/ParallelUtils.h"
+#include <algorithm>
+#include <array>
 #include <glm/ext/matrix_transform.hpp>
 #include <glm/gtx/transform.hpp>
 #include <glm/vec3.hpp>
@@ -20,131 +24,243 @@
 #include <stdexcept>
 #include <vector>
 
+namespace {
+
+// Primitives are read on a single thread if the mesh has less vertices.
+constexpr size_t MIN_VERTICES_FOR_THREADS = 1 << 16;
+
+// Writes `vertexCount` elements of `components` floats read from `data` to `out`. Elements missing in `data` are left unchanged.
+bool readFloats(const glTFBufferData &data, size_t vertexCount, size_t components, float *out, float fill = 0.0F) {
+	if (data.count() < vertexCount) {
+		LOG_ERROR(raco::log_system::MESH_LOADER, "glTF buffer accessor '{}' has less elements than the primitive has vertices", data.accessor_.name);
+	}
+	if (!data.readFloats(out, std::min(vertexCount, data.count()), components, fill)) {
+		LOG_ERROR(raco::log_system::MESH_LOADER, "glTF buffer accessor '{}' has unsupported data type {}", data.accessor_.name, data.accessor_.componentType);
+		return false;
+	}
+	return true;
+}
+
+template <typename T>
+void readIndices(const glTFAccessorView<T> &view, uint32_t firstVertex, uint32_t *out) {
+	if (view.size() > 0 && view.contiguous()) {
+		const T *values = view[0];
+		for (size_t index = 0; index < view.size(); index++) {
+			out[index] = values[index] + firstVertex;
+		}
+	} else {
+		for (size_t index = 0; index < view.size(); index++) {
+			out[index] = *view[index] + firstVertex;
+		}
+	}
+}
+
+// Transforms `count` positions of 3 floats in place. Single precision without branches, so that the compiler can vectorize the loop.
+void transformPositions(float *positions, size_t count, const glm::mat4 &matrix) {
+	const float m00 = matrix[0][0], m01 = matrix[0][1], m02 = matrix[0][2];
+	const float m10 = matrix[1][0], m11 = matrix[1][1], m12 = matrix[1][2];
+	const float m20 = matrix[2][0], m21 = matrix[2][1], m22 = matrix[2][2];
+	const float m30 = matrix[3][0], m31 = matrix[3][1], m32 = matrix[3][2];
+	for (size_t index = 0; index < count; index++) {
+		float *position = positions + 3 * index;
+		const float x = position[0];
+		const float y = position[1];
+		const float z = position[2];
+		position[0] = m00 * x + m10 * y + m20 * z + m30;
+		position[1] = m01 * x + m11 * y + m21 * z + m31;
+		position[2] = m02 * x + m12 * y + m22 * z + m32;
+	}
+}
+
+glm::dmat4x4 localTransformation(const raco::core::MeshScenegraphNode &node) {
+	auto trafoMatrix = glm::identity<glm::dmat4x4>();
+	trafoMatrix = glm::translate(trafoMatrix, glm::dvec3(node.transformations.translation[0], node.transformations.translation[1], node.transformations.translation[2]));
+	auto rotationRadians = glm::radians(glm::dvec3{node.transformations.rotation[0], node.transformations.rotation[1], node.transformations.rotation[2]});
+	trafoMatrix = glm::rotate(trafoMatrix, rotationRadians.x, {1, 0, 0});
+	trafoMatrix = glm::rotate(trafoMatrix, rotationRadians.y, {0, 1, 0});
+	trafoMatrix = glm::rotate(trafoMatrix, rotationRadians.z, {0, 0, 1});
+	trafoMatrix = glm::scale(trafoMatrix, {node.transformations.scale[0], node.transformations.scale[1], node.transformations.scale[2]});
+
+	return trafoMatrix;
+}
+
+// Global transformations of all nodes, see https://github.com/KhronosGroup/glTF-Tutorials/blob/master/gltfTutorial/gltfTutorial_004_ScenesNodes.md#global-transforms-of-nodes
+// Each node is computed once, after its parent, independent of the order of the nodes in the scenegraph.
+std::vector<glm::dmat4x4> globalTransformations(const raco::core::MeshScenegraph &sceneGraph) {
+	auto nodeCount = sceneGraph.nodes.size();
+	std::vector<glm::dmat4x4> transformations(nodeCount);
+	std::vector<bool> done(nodeCount, false);
+	std::vector<size_t> ancestors;
+	for (size_t nodeIndex = 0; nodeIndex < nodeCount; ++nodeIndex) {
+		// Collect the node and its ancestors not computed yet, bounded in case of a parent cycle in an invalid file.
+		ancestors.clear();
+		for (auto current = static_cast<int>(nodeIndex); current != raco::core::MeshScenegraphNode::NO_PARENT && !done[current] && ancestors.size() < nodeCount; current = sceneGraph.nodes[current]->parentIndex) {
+			ancestors.emplace_back(current);
+		}
+		for (auto it = ancestors.rbegin(); it != ancestors.rend(); ++it) {
+			const auto &node = sceneGraph.nodes[*it].value();
+			auto parent = node.parentIndex;
+			transformations[*it] = parent == raco::core::MeshScenegraphNode::NO_PARENT || !done[parent] ? localTransformation(node) : transformations[parent] * localTransformation(node);
+			done[*it] = true;
+		}
+	}
+	return transformations;
+}
+
+}  // namespace
+
 namespace raco::mesh_loader {
 
 using namespace raco::core;
 
+// Offsets of the data of a primitive in the buffers of the mesh, or the total buffer sizes.
+struct glTFMesh::BufferOffsets {
+	size_t vertex = 0;
+	size_t normal = 0;
+	size_t tangent = 0;
+	size_t bitangent = 0;
+	std::array<size_t, MAX_NUMBER_TEXTURECOORDS> uv{};
+	std::array<size_t, MAX_NUMBER_COLORS> color{};
+	size_t index = 0;
+	uint32_t firstVertex = 0;
+};
+
+struct glTFMesh::VertexBuffers {
+	std::vector<float> vertex;
+	std::vector<float> normal;
+	std::vector<float> tangent;
+	std::vector<float> bitangent;
+	std::array<std::vector<float>, MAX_NUMBER_TEXTURECOORDS> uv;
+	std::array<std::vector<float>, MAX_NUMBER_COLORS> color;
+};
+
+// Accessors of a primitive and where to put its data, see glTFMesh::addPrimitive.
+struct glTFMesh::PrimitiveData {
+	const tinygltf::Primitive *primitive;
+	// Baking transformation of the positions, if any.
+	std::optional<glm::mat4> transformation;
+	size_t vertexCount;
+	std::optional<glTFBufferData> positionData;
+	std::optional<glTFBufferData> normalData;
+	std::optional<glTFBufferData> tangentData;
+	std::array<std::optional<glTFBufferData>, MAX_NUMBER_TEXTURECOORDS> texCoordDatas;
+	std::array<std::optional<glTFBufferData>, MAX_NUMBER_COLORS> colorDatas;
+	std::optional<glTFBufferData> indexData;
+	BufferOffsets offsets;
+};
 
-glTFMesh::glTFMesh(const tinygltf::Model &scene, const core::MeshScenegraph &sceneGraph, const core::MeshDescriptor &descriptor) : numTriangles_(0), numVertices_(0) {
+glTFMesh::glTFMesh(const tinygltf::Model &scene, const core::MeshScenegraph &sceneGraph, const core::MeshDescriptor &descriptor, const unsigned char *binChunk) : numTriangles_(0), numVertices_(0) {
 	// Not included: Bones, textures, materials, node structure, etc.
 
-	// set up buffers we are going to fill in the loop
-	std::vector<float> vertexBuffer{};
-	std::vector<float> normalBuffer{};
-	std::vector<float> tangentBuffer{};
-	std::vector<float> bitangentBuffer{};
-	std::vector<std::vector<float>> uvBuffers(MAX_NUMBER_TEXTURECOORDS);
-	std::vector<std::vector<float>> colorBuffers(MAX_NUMBER_COLORS);
-
-	std::vector<tinygltf::Primitive> flattenedPrimitiveList;
+	std::vector<const tinygltf::Primitive *> flattenedPrimitiveList;
 
 	for (const auto &mesh : scene.meshes) {
 		for (const auto &prim : mesh.primitives) {
-			flattenedPrimitiveList.emplace_back(prim);
+			flattenedPrimitiveList.emplace_back(&prim);
 		}
 	}
 
-	// Collect all meshes or selected mesh.
+	// Collect all meshes or selected mesh and determine where their data goes in the mesh buffers.
+	std::vector<PrimitiveData> primitives;
+	BufferOffsets sizes;
 	if (!descriptor.bakeAllSubmeshes) {
 		for (auto primitiveIndex = descriptor.submeshIndex; primitiveIndex < descriptor.submeshIndex + 1; ++primitiveIndex) {
-			auto primitive = flattenedPrimitiveList[primitiveIndex];
-
 			// TODO enable this again once we have meshnode submesh support:
 			//materials_.emplace_back(scene.materials[primitive.material].name);
 
-			loadPrimitiveData(primitive, scene, vertexBuffer, normalBuffer, tangentBuffer, bitangentBuffer, uvBuffers, colorBuffers);
+			addPrimitive(*flattenedPrimitiveList[primitiveIndex], scene, binChunk, std::nullopt, primitives, sizes);
 		}
 	} else {
-		// calculate local node transformations to later transfer them to the node's vertex positions
-		// see: https://github.com/KhronosGroup/glTF-Tutorials/blob/master/gltfTutorial/gltfTutorial_004_ScenesNodes.md#global-transforms-of-nodes
-
-		auto generateTrafoMatrix = [](const core::MeshScenegraphNode &node) {
-			auto trafoMatrix = glm::identity<glm::dmat4x4>();
-			trafoMatrix = glm::translate(trafoMatrix, glm::dvec3(node.transformations.translation[0], node.transformations.translation[1], node.transformations.translation[2]));
-			auto rotationRadians = glm::radians(glm::dvec3{node.transformations.rotation[0], node.transformations.rotation[1], node.transformations.rotation[2]});
-			trafoMatrix = glm::rotate(trafoMatrix, rotationRadians.x, {1, 0, 0});
-			trafoMatrix = glm::rotate(trafoMatrix, rotationRadians.y, {0, 1, 0});
-			trafoMatrix = glm::rotate(trafoMatrix, rotationRadians.z, {0, 0, 1});
-			trafoMatrix = glm::scale(trafoMatrix, {node.transformations.scale[0], node.transformations.scale[1], node.transformations.scale[2]});
-
-			return trafoMatrix;
-		};
-
-		std::vector<glm::dmat4x4> nodeTrafos(sceneGraph.nodes.size());
-		for (auto i = 0; i < sceneGraph.nodes.size(); ++i) {
-			auto &node = sceneGraph.nodes[i].value();
-			nodeTrafos[i] = generateTrafoMatrix(node);
-		}
-
-
-		for (auto nodeIndex = 0; nodeIndex < sceneGraph.nodes.size(); ++nodeIndex) {		
-			const auto &node = sceneGraph.nodes[nodeIndex].value();
-			if (node.subMeshIndeces.empty()) {
-				continue;
-			}
-
-			auto globalTransformation = glm::identity<glm::dmat4x4>();
-
-			auto currentIndex = nodeIndex;
-			while (currentIndex != -1) {
-				globalTransformation = nodeTrafos[currentIndex] * globalTransformation;
-				currentIndex = sceneGraph.nodes[currentIndex]->parentIndex;
-			}
+		// Node transformations are transferred to the vertex positions.
+		auto nodeTrafos = globalTransformations(sceneGraph);
 
+		for (size_t nodeIndex = 0; nodeIndex < sceneGraph.nodes.size(); ++nodeIndex) {
 			for (const auto &primitiveIndex : sceneGraph.nodes[nodeIndex]->subMeshIndeces) {
-				auto primitive = flattenedPrimitiveList[*primitiveIndex];
-				loadPrimitiveData(primitive, scene, vertexBuffer, normalBuffer, tangentBuffer, bitangentBuffer, uvBuffers, colorBuffers, &globalTransformation);
+				addPrimitive(*flattenedPrimitiveList[*primitiveIndex], scene, binChunk, glm::mat4(nodeTrafos[nodeIndex]), primitives, sizes);
 			}
 		}
 	}
 
+	// Read all primitives into their ranges of the preallocated buffers, on multiple threads for large meshes.
+	VertexBuffers buffers;
+	buffers.vertex.resize(sizes.vertex);
+	buffers.normal.resize(sizes.normal);
+	buffers.tangent.resize(sizes.tangent);
+	buffers.bitangent.resize(sizes.bitangent);
+	for (size_t uvChannel = 0; uvChannel < buffers.uv.size(); ++uvChannel) {
+		buffers.uv[uvChannel].resize(sizes.uv[uvChannel]);
+	}
+	for (size_t colorChannel = 0; colorChannel < buffers.color.size(); ++colorChannel) {
+		// RGB colors get an alpha of 1.
+		buffers.color[colorChannel].resize(sizes.color[colorChannel], 1.0F);
+	}
+	indexBuffer_.resize(sizes.index);
+
+	auto minChunkSize = numVertices_ < MIN_VERTICES_FOR_THREADS ? std::max<size_t>(primitives.size(), 1) : 1;
+	raco::utils::parallel::forEachChunk(primitives.size(), minChunkSize, [this, &primitives, &buffers](size_t, size_t begin, size_t end) {
+		for (auto index = begin; index < end; ++index) {
+			loadPrimitiveData(primitives[index], buffers);
+		}
+	});
+
 	// TODO: only single material mesh right now; use full information from loop above when we have submesh support in meshnode
 	submeshIndexBufferRanges_ = {{0, static_cast<uint32_t>(indexBuffer_.size())}};
 	materials_ = {"material"};
 
+	auto vertexCount = buffers.vertex.size() / 3;
+
 	// Add the vertices
 	attributes_.emplace_back(Attribute{
 		ATTRIBUTE_POSITION,
 		VertexAttribDataType::VAT_Float3,
-		vertexBuffer});
+		std::move(buffers.vertex)});
 
 	// Add the normals
-	if (!normalBuffer.empty()) {
+	if (!buffers.normal.empty()) {
 		attributes_.emplace_back(Attribute{
 			ATTRIBUTE_NORMAL,
 			VertexAttribDataType::VAT_Float3,
-			normalBuffer});
+			std::move(buffers.normal)});
 	}
 
-	if (!tangentBuffer.empty() && tangentBuffer.size() == bitangentBuffer.size() && tangentBuffer.size() == vertexBuffer.size()) {
-		attributes_.emplace_back(Attribute{ATTRIBUTE_TANGENT, VertexAttribDataType::VAT_Float3, tangentBuffer});
-		attributes_.emplace_back(Attribute{ATTRIBUTE_BITANGENT, VertexAttribDataType::VAT_Float3, bitangentBuffer});
+	if (!buffers.tangent.empty() && buffers.tangent.size() == buffers.bitangent.size() && buffers.tangent.size() == vertexCount * 3) {
+		attributes_.emplace_back(Attribute{ATTRIBUTE_TANGENT, VertexAttribDataType::VAT_Float3, std::move(buffers.tangent)});
+		attributes_.emplace_back(Attribute{ATTRIBUTE_BITANGENT, VertexAttribDataType::VAT_Float3, std::move(buffers.bitangent)});
 	}
 
 	// Add the UV maps
-	for (int bufferIndex = 0; bufferIndex < uvBuffers.size(); ++bufferIndex) {
+	for (size_t bufferIndex = 0; bufferIndex < buffers.uv.size(); ++bufferIndex) {
 		const std::string indexCharacter = (bufferIndex == 0) ? "" : std::to_string(bufferIndex);
 
 		// Check that uv buffer uses the same number of vertices as the vertex buffers;
-		if (vertexBuffer.size() / 3 == uvBuffers[bufferIndex].size() / 2) {
+		if (vertexCount == buffers.uv[bufferIndex].size() / 2) {
 			attributes_.emplace_back(Attribute{
 				std::string{ATTRIBUTE_UVMAP} + indexCharacter,
 				VertexAttribDataType::VAT_Float2,
-				uvBuffers[bufferIndex]});
+				std::move(buffers.uv[bufferIndex])});
 		}
 	}
 
-	for (unsigned colorChannelIndex = 0; colorChannelIndex < colorBuffers.size(); ++colorChannelIndex) {
+	for (size_t colorChannelIndex = 0; colorChannelIndex < buffers.color.size(); ++colorChannelIndex) {
 		const std::string indexCharacter = (colorChannelIndex == 0) ? "" : std::to_string(colorChannelIndex);
 
 		// Check that color buffer uses the same number of vertices as the vertex buffers;
-		if (vertexBuffer.size() / 3 == colorBuffers[colorChannelIndex].size() / 4) {
+		if (vertexCount == buffers.color[colorChannelIndex].size() / 4) {
 			attributes_.emplace_back(Attribute{
 				std::string(ATTRIBUTE_COLOR) + indexCharacter,
 				VertexAttribDataType::VAT_Float4,
-				colorBuffers[colorChannelIndex]});
+				std::move(buffers.color[colorChannelIndex])});
 		}
 	}
+
+	if (descriptor.optimize) {
+		std::vector<MeshOptimizerAttribute> optimizerAttributes;
+		for (auto &attribute : attributes_) {
+			optimizerAttributes.emplace_back(MeshOptimizerAttribute{&attribute.data, attributeComponents(attribute.type)});
+		}
+		numVertices_ = optimizeMesh(indexBuffer_, submeshIndexBufferRanges_, optimizerAttributes, numVertices_);
+		indexBuffer16_ = narrowIndices(indexBuffer_, numVertices_);
+	}
 }
 
 uint32_t glTFMesh::numSubmeshes() const {
@@ -167,6 +283,10 @@ const std::vector<uint32_t> &glTFMesh::getIndices() const {
 	return indexBuffer_;
 }
 
+const std::vector<uint16_t> &glTFMesh::getIndices16() const {
+	return indexBuffer16_;
+}
+
 const std::vector<MeshData::IndexBufferRangeInfo> &glTFMesh::submeshIndexBufferRanges() const {
 	return submeshIndexBufferRanges_;
 }
@@ -206,190 +326,162 @@ const char *glTFMesh::attribBuffer(int attribute_index) const {
 	return reinterpret_cast<const char *>(attributes_.at(attribute_index).data.data());
 }
 
-void glTFMesh::loadPrimitiveData(const tinygltf::Primitive &primitive, const tinygltf::Model &scene, std::vector<float> &vertexBuffer, std::vector<float> &normalBuffer, std::vector<float> &tangentBuffer, std::vector<float> &bitangentBuffer, std::vector<std::vector<float>> &uvBuffers, std::vector<std::vector<float>> &colorBuffers, glm::dmat4 *rootTrafoMatrix) {
+void glTFMesh::addPrimitive(const tinygltf::Primitive &primitive, const tinygltf::Model &scene, const unsigned char *binChunk, const std::optional<glm::mat4> &transformation, std::vector<PrimitiveData> &primitives, BufferOffsets &sizes) {
 	if (primitive.attributes.find("POSITION") == primitive.attributes.end()) {
 		LOG_ERROR(log_system::MESH_LOADER, "primitive has no position attributes defined");
 		return;
 	}
 
-	std::optional<glTFBufferData> normalData;
-	std::optional<glTFBufferData> tangentData;
-	std::array<std::optional<glTFBufferData>, MAX_NUMBER_TEXTURECOORDS> bufferTexCoordDatas;
-	std::array<std::optional<glTFBufferData>, MAX_NUMBER_COLORS> bufferColorDatas;
+	auto &data = primitives.emplace_back(PrimitiveData{&primitive, transformation});
 
 	if (primitive.attributes.find("NORMAL") != primitive.attributes.end()) {
-		normalData.emplace(scene, primitive.attributes.at("NORMAL"), std::set<int>{TINYGLTF_COMPONENT_TYPE_FLOAT});
+		data.normalData.emplace(scene, primitive.attributes.at("NORMAL"), std::set<int>{TINYGLTF_COMPONENT_TYPE_FLOAT}, binChunk);
 
 		if (primitive.attributes.find("TANGENT") != primitive.attributes.end()) {
-			tangentData.emplace(scene, primitive.attributes.at("TANGENT"), std::set<int>{TINYGLTF_COMPONENT_TYPE_FLOAT});
+			data.tangentData.emplace(scene, primitive.attributes.at("TANGENT"), std::set<int>{TINYGLTF_COMPONENT_TYPE_FLOAT}, binChunk);
 		}
 	}
 
 	for (auto uvChannel = 0; uvChannel < MAX_NUMBER_TEXTURECOORDS; ++uvChannel) {
 		auto texCoordName = fmt::format("TEXCOORD_{}", uvChannel);
 		if (primitive.attributes.find(texCoordName) != primitive.attributes.end()) {
-			bufferTexCoordDatas[uvChannel].emplace(scene, primitive.attributes.at(texCoordName), std::set<int>{TINYGLTF_COMPONENT_TYPE_FLOAT, TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE, TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT});
+			data.texCoordDatas[uvChannel].emplace(scene, primitive.attributes.at(texCoordName), std::set<int>{TINYGLTF_COMPONENT_TYPE_FLOAT, TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE, TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT}, binChunk);
 		}
 	}
 
 	for (auto colorChannel = 0; colorChannel < MAX_NUMBER_COLORS; ++colorChannel) {
 		auto colorName = fmt::format("COLOR_{}", colorChannel);
 		if (primitive.attributes.find(colorName) != primitive.attributes.end()) {
-			bufferColorDatas[colorChannel].emplace(scene,primitive.attributes.at(colorName), std::set<int>{TINYGLTF_COMPONENT_TYPE_FLOAT, TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE, TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT});
+			data.colorDatas[colorChannel].emplace(scene, primitive.attributes.at(colorName), std::set<int>{TINYGLTF_COMPONENT_TYPE_FLOAT, TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE, TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT}, binChunk);
 		}
 	}
 
-	glTFBufferData posData(scene, primitive.attributes.at("POSITION"), std::set<int>{TINYGLTF_COMPONENT_TYPE_FLOAT});
+	data.positionData.emplace(scene, primitive.attributes.at("POSITION"), std::set<int>{TINYGLTF_COMPONENT_TYPE_FLOAT}, binChunk);
+	auto vertexCount = data.positionData->count();
+	data.vertexCount = vertexCount;
+
+	data.offsets = sizes;
+	data.offsets.firstVertex = numVertices_;
+
+	sizes.vertex += vertexCount * 3;
+	if (data.normalData) {
+		sizes.normal += vertexCount * 3;
+		if (data.tangentData) {
+			auto tangentSize = data.tangentData->components();
+			// Tangents and bitangents are zero if not available in the file.
+			sizes.tangent += vertexCount * 3;
+			if (tangentSize < 3) {
+				LOG_ERROR(log_system::MESH_LOADER, "glTF tangent data is not in XYZ format - tangents will not be imported");
+			} else {
+				if (tangentSize == 3) {
+					LOG_ERROR(log_system::MESH_LOADER, "glTF tangent data is not in XYZW format - bitangents will not be imported");
+				}
+				sizes.bitangent += vertexCount * 3;
+			}
+		}
+	}
+	for (auto uvChannel = 0; uvChannel < MAX_NUMBER_TEXTURECOORDS; ++uvChannel) {
+		if (data.texCoordDatas[uvChannel]) {
+			sizes.uv[uvChannel] += vertexCount * 2;
+		}
+	}
+	for (auto colorChannel = 0; colorChannel < MAX_NUMBER_COLORS; ++colorChannel) {
+		if (data.colorDatas[colorChannel]) {
+			sizes.color[colorChannel] += vertexCount * 4;
+		}
+	}
 
-	for (size_t vertexIndex = 0; vertexIndex < posData.accessor_.count; vertexIndex++) {
-		auto position = posData.getDataAt<float>(vertexIndex);
-		if (rootTrafoMatrix) {
-			auto transformedVerts = *rootTrafoMatrix * glm::dvec4(position[0], position[1], position[2], 1);
-			vertexBuffer.insert(vertexBuffer.end(), {static_cast<float>(transformedVerts.x), static_cast<float>(transformedVerts.y), static_cast<float>(transformedVerts.z)});
-		} else {
-			vertexBuffer.insert(vertexBuffer.end(), {position[0], position[1], position[2]});
+	size_t indexCount = vertexCount;
+	if (primitive.indices > -1) {
+		data.indexData.emplace(scene, primitive.indices, std::set<int>{TINYGLTF_PARAMETER_TYPE_UNSIGNED_INT, TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT, TINYGLTF_TEXTURE_TYPE_UNSIGNED_BYTE}, binChunk);
+		switch (data.indexData->accessor_.componentType) {
+			case TINYGLTF_PARAMETER_TYPE_UNSIGNED_INT:
+			case TINYGLTF_PARAMETER_TYPE_UNSIGNED_SHORT:
+			case TINYGLTF_PARAMETER_TYPE_UNSIGNED_BYTE:
+				break;
+			default:
+				throw std::range_error("No valid primitive index attribute type found.");
 		}
+		indexCount = data.indexData->count();
+	}
+	sizes.index += indexCount;
+	numTriangles_ += static_cast<uint32_t>(indexCount / 3);
+	numVertices_ += static_cast<uint32_t>(vertexCount);
+}
 
-		if (normalData) {
-			auto currentNormal = normalData->getDataAt<float>(vertexIndex);
-			normalBuffer.insert(normalBuffer.end(), currentNormal.begin(), currentNormal.end());
-
-			if (tangentData) {
-				auto tangent = tangentData->getDataAt<float>(vertexIndex);
-				auto tangentSize = tangent.size();
-
-				if (tangentSize >= 3) {
-					tangentBuffer.insert(tangentBuffer.end(), tangent.begin(), tangent.begin() + 3);
-
-					if (tangentSize == 4) {
-						const auto &tangentX = tangent[0];
-						const auto &tangentY = tangent[1];
-						const auto &tangentZ = tangent[2];
-						const auto &tangentW = tangent[3];
-
-						auto bitangent = glm::cross(glm::vec3{currentNormal[0], currentNormal[1], currentNormal[2]}, glm::vec3{tangentX, tangentY, tangentZ}) * tangentW;
-						bitangentBuffer.insert(bitangentBuffer.end(), {bitangent.x, bitangent.y, bitangent.z});
-					} else {
-						LOG_ERROR(log_system::MESH_LOADER, "glTF tangent data is not in XYZW format - bitangent at vertexIndex {} will not be imported", vertexIndex);
-						bitangentBuffer.insert(bitangentBuffer.end(), {0, 0, 0});
-					}
-
-				} else {
-					LOG_ERROR(log_system::MESH_LOADER, "glTF tangent data is not in XYZ format - tangent at vertexIndex {} will not be imported", vertexIndex);
-					tangentBuffer.insert(tangentBuffer.end(), {0, 0, 0});
-				}
+void glTFMesh::loadPrimitiveData(const PrimitiveData &data, VertexBuffers &buffers) {
+	const auto &primitive = *data.primitive;
+	const auto &offsets = data.offsets;
+	auto vertexCount = data.vertexCount;
+
+	float *positions = buffers.vertex.data() + offsets.vertex;
+	readFloats(*data.positionData, vertexCount, 3, positions);
+	if (data.transformation) {
+		transformPositions(positions, vertexCount, *data.transformation);
+	}
+
+	if (data.normalData) {
+		float *normals = buffers.normal.data() + offsets.normal;
+		readFloats(*data.normalData, vertexCount, 3, normals);
+
+		if (data.tangentData && data.tangentData->components() >= 3) {
+			std::vector<float> tangents(vertexCount * 4);
+			readFloats(*data.tangentData, vertexCount, 4, tangents.data());
+
+			float *tangentOut = buffers.tangent.data() + offsets.tangent;
+			for (size_t vertexIndex = 0; vertexIndex < vertexCount; vertexIndex++) {
+				std::copy_n(&tangents[vertexIndex * 4], 3, tangentOut + vertexIndex * 3);
 			}
-		}
 
-		for (auto uvChannel = 0; uvChannel < MAX_NUMBER_TEXTURECOORDS; ++uvChannel) {
-			if (bufferTexCoordDatas[uvChannel]) {
-				std::vector<float> &uvBuffer{uvBuffers[uvChannel]};
-				auto textureData = bufferTexCoordDatas[uvChannel]->getDataAt<float>(vertexIndex);
-				assert(textureData.size() == 2);
+			if (data.tangentData->components() == 4) {
+				float *bitangentOut = buffers.bitangent.data() + offsets.bitangent;
+				for (size_t vertexIndex = 0; vertexIndex < vertexCount; vertexIndex++) {
+					const float *normal = normals + vertexIndex * 3;
+					const float *tangent = &tangents[vertexIndex * 4];
 
-				uvBuffer.insert(uvBuffer.end(), textureData.begin(), textureData.end());
+					auto bitangent = glm::cross(glm::vec3{normal[0], normal[1], normal[2]}, glm::vec3{tangent[0], tangent[1], tangent[2]}) * tangent[3];
+					bitangentOut[vertexIndex * 3] = bitangent.x;
+					bitangentOut[vertexIndex * 3 + 1] = bitangent.y;
+					bitangentOut[vertexIndex * 3 + 2] = bitangent.z;
+				}
 			}
 		}
+	}
 
-		for (auto colorChannel = 0; colorChannel < MAX_NUMBER_COLORS; ++colorChannel) {
-			if (bufferColorDatas[colorChannel]) {
-				std::vector<float> &colorBuffer{colorBuffers[colorChannel]};
-				std::vector<float> colorData(4, 1.0F);
-
-				switch (bufferColorDatas[colorChannel]->accessor_.componentType) {
-					case TINYGLTF_PARAMETER_TYPE_FLOAT: {
-						auto floatColorData = bufferColorDatas[colorChannel]->getDataAt<float>(vertexIndex);
-						assert(floatColorData.size() % 3 == 0 || floatColorData.size() % 4 == 0);
-
-						colorData.resize(floatColorData.size(), 1.0F);
-						for (auto i = 0; i < floatColorData.size(); ++i) {
-							colorData[i] = floatColorData[i];
-						}
-
-						break;
-					}
-					case TINYGLTF_PARAMETER_TYPE_UNSIGNED_BYTE: {
-						auto byteColorData = bufferColorDatas[colorChannel]->getDataAt<uint8_t>(vertexIndex);
-						assert(byteColorData.size() % 3 == 0 || byteColorData.size() % 4 == 0);
-
-						colorData.resize(byteColorData.size(), 1.0F);
-						for (auto i = 0; i < byteColorData.size(); ++i) {
-							colorData[i] = byteColorData[i] / (0.0F + std::numeric_limits<uint8_t>().max());
-						}
-
-						break;
-					}
-					case TINYGLTF_PARAMETER_TYPE_UNSIGNED_SHORT: {
-						auto shortColorData = bufferColorDatas[colorChannel]->getDataAt<uint16_t>(vertexIndex);
-						assert(shortColorData.size() % 3 == 0 || shortColorData.size() % 4 == 0);
-
-						colorData.resize(shortColorData.size(), 1.0F);
-						for (auto i = 0; i < shortColorData.size(); ++i) {
-							colorData[i] = shortColorData[i] / (0.0F + std::numeric_limits<uint16_t>().max());
-						}
-						break;
-					}
-					default: {
-						throw std::range_error("No valid color attribute type found.");
-						return;
-					}
-				}
+	for (auto uvChannel = 0; uvChannel < MAX_NUMBER_TEXTURECOORDS; ++uvChannel) {
+		if (data.texCoordDatas[uvChannel]) {
+			readFloats(*data.texCoordDatas[uvChannel], vertexCount, 2, buffers.uv[uvChannel].data() + offsets.uv[uvChannel]);
+		}
+	}
 
-				colorBuffer.insert(colorBuffer.end(), colorData.begin(), colorData.end());
+	for (auto colorChannel = 0; colorChannel < MAX_NUMBER_COLORS; ++colorChannel) {
+		if (data.colorDatas[colorChannel]) {
+			// RGB colors get an alpha of 1.
+			if (!readFloats(*data.colorDatas[colorChannel], vertexCount, 4, buffers.color[colorChannel].data() + offsets.color[colorChannel], 1.0F)) {
+				throw std::range_error("No valid color attribute type found.");
 			}
 		}
 	}
 
 	// Collect our faces/indexes
-	// Note: we build the correct submesh ranges here in anticipation of submesh support in the meshnode.
-	IndexBufferRangeInfo bufferRange = {static_cast<uint32_t>(indexBuffer_.size()), 0};
-
-	if (primitive.indices > -1) {
-		glTFBufferData indexBufferData(scene, primitive.indices, {TINYGLTF_PARAMETER_TYPE_UNSIGNED_INT, TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT, TINYGLTF_TEXTURE_TYPE_UNSIGNED_BYTE});
-		auto indexAccessorCount = indexBufferData.accessor_.count;
-
-		switch (indexBufferData.accessor_.componentType) {
-			case TINYGLTF_PARAMETER_TYPE_UNSIGNED_INT: {
-				for (size_t index = 0; index < indexAccessorCount; index++) {
-					auto data = indexBufferData.getDataAt<uint32_t>(index, false).front();
-					indexBuffer_.emplace_back(data + numVertices_);
-				}
+	uint32_t *indices = indexBuffer_.data() + offsets.index;
+	if (data.indexData) {
+		switch (data.indexData->accessor_.componentType) {
+			case TINYGLTF_PARAMETER_TYPE_UNSIGNED_INT:
+				readIndices(data.indexData->view<uint32_t>(), offsets.firstVertex, indices);
 				break;
-			}
-			case TINYGLTF_PARAMETER_TYPE_UNSIGNED_SHORT: {
-				for (size_t index = 0; index < indexAccessorCount; index++) {
-					auto data = indexBufferData.getDataAt<uint16_t>(index, false).front();
-					indexBuffer_.emplace_back(data + numVertices_);
-				}
+			case TINYGLTF_PARAMETER_TYPE_UNSIGNED_SHORT:
+				readIndices(data.indexData->view<uint16_t>(), offsets.firstVertex, indices);
 				break;
-			}
-			case TINYGLTF_PARAMETER_TYPE_UNSIGNED_BYTE: {
-				for (size_t index = 0; index < indexAccessorCount; index++) {
-					auto data = indexBufferData.getDataAt<uint8_t>(index, false).front();
-					indexBuffer_.emplace_back(data + numVertices_);
-				}
+			case TINYGLTF_PARAMETER_TYPE_UNSIGNED_BYTE:
+				readIndices(data.indexData->view<uint8_t>(), offsets.firstVertex, indices);
 				break;
-			}
-			default: {
-				throw std::range_error("No valid primitive index attribute type found.");
-				return;
-			}
 		}
-		bufferRange.count += indexAccessorCount;
-		numTriangles_ += indexAccessorCount / 3;
 	} else {
-		auto indexCount = posData.accessor_.count;
-
-		for (auto index = 0; index < indexCount; ++index) {
-			indexBuffer_.emplace_back(index + numVertices_);
+		for (size_t index = 0; index < vertexCount; ++index) {
+			indices[index] = static_cast<uint32_t>(index) + offsets.firstVertex;
 		}
-
-		bufferRange.count += indexCount;
-		numTriangles_ += indexCount / 3;
 	}
-	submeshIndexBufferRanges_.push_back(bufferRange);
-
-	numVertices_ += posData.accessor_.count;
 }
 
 }  // namespace raco::mesh_loader
@@ -12,7 +12,10 @@
 #include "mesh_loader/glTFFileLoader.h"
 #include "testing/RacoBaseTest.h"
 #include "testing/TestEnvironmentCore.h"
+#include "utils/FileUtils.h"
 
+#include <glm/ext/matrix_transform.hpp>
+#include <glm/gtx/transform.hpp>
 
 using namespace raco;
 
@@ -150,4 +153,135 @@ TEST_F(MeshLoaderTest, glTFWithTangentsAndBitangents) {
 
 	ASSERT_NE(mesh->attribIndex(mesh->ATTRIBUTE_TANGENT), -1);
 	ASSERT_NE(mesh->attribIndex(mesh->ATTRIBUTE_BITANGENT), -1);
-}
\ No newline at end of file
+}
+
+TEST_F(MeshLoaderTest, glTFBakedPositionsMatchTransformedSubmeshes) {
+	// Reference: transform the positions of each submesh with the global transformation of its node in double precision.
+	auto localTransformation = [](const core::MeshScenegraphNode &node) {
+		auto trafoMatrix = glm::translate(glm::identity<glm::dmat4x4>(), glm::dvec3(node.transformations.translation[0], node.transformations.translation[1], node.transformations.translation[2]));
+		auto rotationRadians = glm::radians(glm::dvec3{node.transformations.rotation[0], node.transformations.rotation[1], node.transformations.rotation[2]});
+		trafoMatrix = glm::rotate(trafoMatrix, rotationRadians.x, {1, 0, 0});
+		trafoMatrix = glm::rotate(trafoMatrix, rotationRadians.y, {0, 1, 0});
+		trafoMatrix = glm::rotate(trafoMatrix, rotationRadians.z, {0, 0, 1});
+		return glm::scale(trafoMatrix, {node.transformations.scale[0], node.transformations.scale[1], node.transformations.scale[2]});
+	};
+
+	for (const auto &file : {"meshes/CesiumMilkTruck/CesiumMilkTruck.gltf", "meshes/ToyCar/ToyCar.gltf", "meshes/RiggedFigure/RiggedFigure.gltf"}) {
+		core::MeshDescriptor desc;
+		desc.absPath = cwd_path().append(file).string();
+		desc.bakeAllSubmeshes = true;
+
+		mesh_loader::glTFFileLoader fileloader(desc.absPath);
+		auto bakedPositions = getPositionData(fileloader.loadMesh(desc));
+		const auto &nodes = fileloader.getScenegraph(desc.absPath)->nodes;
+
+		std::vector<float> expectedPositions;
+		desc.bakeAllSubmeshes = false;
+		for (size_t nodeIndex = 0; nodeIndex < nodes.size(); ++nodeIndex) {
+			auto globalTransformation = glm::identity<glm::dmat4x4>();
+			for (auto current = static_cast<int>(nodeIndex); current != core::MeshScenegraphNode::NO_PARENT; current = nodes[current]->parentIndex) {
+				globalTransformation = localTransformation(*nodes[current]) * globalTransformation;
+			}
+			for (const auto &submeshIndex : nodes[nodeIndex]->subMeshIndeces) {
+				desc.submeshIndex = *submeshIndex;
+				auto positions = getPositionData(fileloader.loadMesh(desc));
+				for (size_t index = 0; index < positions.size(); index += 3) {
+					auto transformed = globalTransformation * glm::dvec4(positions[index], positions[index + 1], positions[index + 2], 1);
+					expectedPositions.insert(expectedPositions.end(), {static_cast<float>(transformed.x), static_cast<float>(transformed.y), static_cast<float>(transformed.z)});
+				}
+			}
+		}
+
+		ASSERT_EQ(bakedPositions.size(), expectedPositions.size()) << file;
+		for (size_t index = 0; index < bakedPositions.size(); ++index) {
+			ASSERT_NEAR(bakedPositions[index], expectedPositions[index], 1e-4 * std::max(1.0F, std::abs(expectedPositions[index]))) << file << " at " << index;
+		}
+	}
+}
+
+TEST_F(MeshLoaderTest, glTFLoadOptimized) {
+	core::MeshDescriptor desc;
+	desc.absPath = cwd_path().append("meshes/CesiumMilkTruck/CesiumMilkTruck.gltf").string();
+	desc.bakeAllSubmeshes = true;
+
+	mesh_loader::glTFFileLoader fileloader(desc.absPath);
+	auto mesh = fileloader.loadMesh(desc);
+	ASSERT_TRUE(mesh->getIndices16().empty());
+
+	desc.optimize = true;
+	auto optimizedMesh = fileloader.loadMesh(desc);
+	ASSERT_EQ(optimizedMesh->numTriangles(), mesh->numTriangles());
+	ASSERT_EQ(optimizedMesh->getIndices().size(), mesh->getIndices().size());
+	ASSERT_LE(optimizedMesh->numVertices(), mesh->numVertices());
+	ASSERT_EQ(optimizedMesh->numAttributes(), mesh->numAttributes());
+	for (uint32_t i = 0; i < optimizedMesh->numAttributes(); i++) {
+		ASSERT_EQ(optimizedMesh->attribElementCount(i), optimizedMesh->numVertices());
+	}
+
+	const auto &indices16 = optimizedMesh->getIndices16();
+	ASSERT_EQ(std::vector<uint32_t>(indices16.begin(), indices16.end()), optimizedMesh->getIndices());
+	ASSERT_TRUE(std::all_of(indices16.begin(), indices16.end(), [&optimizedMesh](uint16_t index) { return index < optimizedMesh->numVertices(); }));
+}
+
+TEST_F(MeshLoaderTest, glbLoadedAgainAfterRelease) {
+	core::MeshDescriptor desc;
+	desc.absPath = cwd_path().append("meshes/Duck.glb").string();
+	desc.bakeAllSubmeshes = false;
+	desc.submeshIndex = 0;
+
+	mesh_loader::glTFFileLoader fileloader(desc.absPath);
+	auto firstMesh = fileloader.loadMesh(desc);
+	ASSERT_NE(firstMesh, nullptr);
+	auto sceneGraph = fileloader.getScenegraph(desc.absPath);
+
+	// The only submesh has been extracted, so the model is released. The scenegraph and mesh count are kept.
+	ASSERT_EQ(fileloader.getTotalMeshCount(), 1);
+	ASSERT_EQ(fileloader.getScenegraph(desc.absPath), sceneGraph);
+
+	auto secondMesh = fileloader.loadMesh(desc);
+	ASSERT_NE(secondMesh, nullptr);
+	ASSERT_EQ(getPositionData(firstMesh), getPositionData(secondMesh));
+	ASSERT_EQ(firstMesh->getIndices(), secondMesh->getIndices());
+}
+
+TEST_F(MeshLoaderTest, glbRewrittenAfterLoad) {
+	auto path = (cwd_path() / "rewritten.glb").string();
+	std::filesystem::copy_file(cwd_path() / "meshes/Duck.glb", path, std::filesystem::copy_options::overwrite_existing);
+
+	core::MeshDescriptor desc;
+	desc.absPath = path;
+	desc.bakeAllSubmeshes = false;
+	desc.submeshIndex = 0;
+
+	mesh_loader::glTFFileLoader fileloader(desc.absPath);
+	auto mesh = fileloader.loadMesh(desc);
+	ASSERT_NE(mesh, nullptr);
+
+	// The file is not mapped between loads: it can be replaced and is parsed again.
+	raco::utils::file::write(path, "invalid");
+	ASSERT_EQ(fileloader.loadMesh(desc), nullptr);
+	ASSERT_FALSE(fileloader.getError().empty());
+
+	std::filesystem::copy_file(cwd_path() / "meshes/Duck.glb", path, std::filesystem::copy_options::overwrite_existing);
+	auto reloadedMesh = fileloader.loadMesh(desc);
+	ASSERT_NE(reloadedMesh, nullptr);
+	ASSERT_EQ(getPositionData(mesh), getPositionData(reloadedMesh));
+}
+
+TEST_F(MeshLoaderTest, glTFAnimationSamplerLoadedAgainAfterRelease) {
+	core::MeshDescriptor desc;
+	desc.absPath = cwd_path().append("meshes/AnimatedMorphCube/AnimatedMorphCube.gltf").string();
+	desc.bakeAllSubmeshes = false;
+	desc.submeshIndex = 0;
+
+	mesh_loader::glTFFileLoader fileloader(desc.absPath);
+	ASSERT_NE(fileloader.loadMesh(desc), nullptr);
+
+	auto firstSampler = fileloader.getAnimationSamplerData(desc.absPath, 0, 0);
+	ASSERT_NE(firstSampler, nullptr);
+	auto secondSampler = fileloader.getAnimationSamplerData(desc.absPath, 0, 0);
+	ASSERT_NE(secondSampler, nullptr);
+	ASSERT_EQ(firstSampler->input, secondSampler->input);
+	ASSERT_EQ(firstSampler->output, secondSampler->output);
+	ASSERT_NE(fileloader.loadMesh(desc), nullptr);
+}
@@ -0,0 +1,154 @@
+/*
+ * SPDX-License-Identifier: MPL-2.0
+ *
+ * This file is part of Ramses Composer
+ * (see https://github.com/GENIVI/ramses-composer).
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include <gtest/gtest.h>
+
+#include "mesh_loader/MeshOptimizer.h"
+
+#include <algorithm>
+#include <array>
+#include <set>
+
+using namespace raco::mesh_loader;
+
+namespace {
+
+using Triangle = std::array<float, 9>;
+
+// Positions of the corners of all triangles, so that the result can be compared independent of vertex and triangle order.
+std::multiset<Triangle> trianglePositions(const std::vector<uint32_t>& indices, const std::vector<float>& positions) {
+	std::multiset<Triangle> triangles;
+	for (size_t index = 0; index + 2 < indices.size(); index += 3) {
+		Triangle triangle;
+		for (size_t corner = 0; corner < 3; corner++) {
+			std::copy_n(&positions[indices[index + corner] * 3], 3, &triangle[corner * 3]);
+		}
+		// Rotate the corners so that the smallest one is first, keeping the winding order.
+		std::array<std::array<float, 3>, 3> corners{{{triangle[0], triangle[1], triangle[2]}, {triangle[3], triangle[4], triangle[5]}, {triangle[6], triangle[7], triangle[8]}}};
+		std::rotate(corners.begin(), std::min_element(corners.begin(), corners.end()), corners.end());
+		for (size_t corner = 0; corner < 3; corner++) {
+			std::copy_n(corners[corner].data(), 3, &triangle[corner * 3]);
+		}
+		triangles.insert(triangle);
+	}
+	return triangles;
+}
+
+// Average number of vertex cache misses per triangle for a FIFO cache of `cacheSize` entries.
+float averageCacheMissRatio(const std::vector<uint32_t>& indices, size_t cacheSize) {
+	std::vector<uint32_t> cache;
+	size_t misses = 0;
+	for (auto index : indices) {
+		if (std::find(cache.begin(), cache.end(), index) == cache.end()) {
+			++misses;
+			cache.insert(cache.begin(), index);
+			if (cache.size() > cacheSize) {
+				cache.pop_back();
+			}
+		}
+	}
+	return static_cast<float>(misses) / static_cast<float>(indices.size() / 3);
+}
+
+// Unwelded grid of `size` x `size` quads with 4 vertices per quad, with the triangles in a scattered order.
+void makeGrid(size_t size, std::vector<uint32_t>& indices, std::vector<float>& positions) {
+	for (size_t row = 0; row < size; row++) {
+		for (size_t column = 0; column < size; column++) {
+			auto first = static_cast<uint32_t>(positions.size() / 3);
+			for (auto [x, y] : std::array<std::pair<size_t, size_t>, 4>{{{column, row}, {column + 1, row}, {column + 1, row + 1}, {column, row + 1}}}) {
+				positions.insert(positions.end(), {static_cast<float>(x), static_cast<float>(y), 0.0F});
+			}
+			indices.insert(indices.end(), {first, first + 1, first + 2, first, first + 2, first + 3});
+		}
+	}
+	// Interleave the triangles of the first and second half of the grid.
+	std::vector<uint32_t> scattered;
+	auto half = indices.size() / 6 * 3;
+	for (size_t index = 0; index < half; index += 3) {
+		scattered.insert(scattered.end(), indices.begin() + index, indices.begin() + index + 3);
+		scattered.insert(scattered.end(), indices.begin() + half + index, indices.begin() + half + index + 3);
+	}
+	scattered.insert(scattered.end(), indices.begin() + 2 * half, indices.end());
+	indices = scattered;
+}
+
+}  // namespace
+
+TEST(MeshOptimizerTest, findDuplicateVertices) {
+	std::vector<float> positions{0, 0, 0, 1, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0};
+	std::vector<float> uvs{0, 0, 1, 0, 0, 0, 1, 1, 0.5, 0};
+	EXPECT_EQ(findDuplicateVertices(5, {{&positions, 3}}), (std::vector<uint32_t>{0, 1, 0, 1, 0}));
+	EXPECT_EQ(findDuplicateVertices(5, {{&positions, 3}, {&uvs, 2}}), (std::vector<uint32_t>{0, 1, 0, 3, 4}));
+}
+
+TEST(MeshOptimizerTest, optimizeVertexCache_keeps_triangles) {
+	std::vector<uint32_t> indices;
+	std::vector<float> positions;
+	makeGrid(16, indices, positions);
+	auto triangles = trianglePositions(indices, positions);
+
+	optimizeVertexCache(indices.data(), indices.size(), static_cast<uint32_t>(positions.size() / 3));
+	EXPECT_EQ(trianglePositions(indices, positions), triangles);
+}
+
+TEST(MeshOptimizerTest, optimizeMesh_welds_and_reorders) {
+	std::vector<uint32_t> indices;
+	std::vector<float> positions;
+	makeGrid(32, indices, positions);
+	std::vector<float> normals(positions.size());
+	for (size_t index = 2; index < normals.size(); index += 3) {
+		normals[index] = 1.0F;
+	}
+	auto triangles = trianglePositions(indices, positions);
+	auto vertexCount = static_cast<uint32_t>(positions.size() / 3);
+
+	std::vector<uint32_t> welded(indices);
+	auto weldedVertexCount = optimizeMesh(welded, {{0, static_cast<uint32_t>(welded.size())}}, {{&positions, 3}, {&normals, 3}}, vertexCount);
+
+	EXPECT_EQ(weldedVertexCount, 33u * 33u);
+	EXPECT_EQ(positions.size(), weldedVertexCount * 3);
+	EXPECT_EQ(normals.size(), weldedVertexCount * 3);
+	EXPECT_EQ(welded.size(), indices.size());
+	EXPECT_EQ(trianglePositions(welded, positions), triangles);
+	EXPECT_TRUE(std::all_of(welded.begin(), welded.end(), [weldedVertexCount](uint32_t index) { return index < weldedVertexCount; }));
+	EXPECT_LT(averageCacheMissRatio(welded, 16), 1.0F);
+
+	// Vertices are numbered in the order of their first use.
+	uint32_t next = 0;
+	for (auto index : welded) {
+		ASSERT_LE(index, next);
+		next = std::max(next, index + 1);
+	}
+}
+
+TEST(MeshOptimizerTest, optimizeMesh_keeps_distinct_attributes) {
+	std::vector<float> positions{0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 1, 0};
+	std::vector<float> uvs{0, 0, 1, 0, 0, 1, 0.5, 0.5, 1, 0, 0, 1};
+	std::vector<uint32_t> indices{0, 1, 2, 3, 4, 5};
+	EXPECT_EQ(optimizeMesh(indices, {{0, 6}}, {{&positions, 3}, {&uvs, 2}}, 6), 4u);
+	EXPECT_EQ(uvs.size(), 8u);
+}
+
+TEST(MeshOptimizerTest, optimizeMesh_leaves_invalid_mesh_unchanged) {
+	std::vector<float> positions{0, 0, 0, 1, 0, 0, 0, 1, 0};
+	std::vector<float> uvs{0, 0, 1, 0};
+	std::vector<uint32_t> indices{0, 1, 2};
+	EXPECT_EQ(optimizeMesh(indices, {{0, 3}}, {{&positions, 3}, {&uvs, 2}}, 3), 3u);
+	EXPECT_EQ(positions.size(), 9u);
+
+	std::vector<uint32_t> outOfRange{0, 1, 3};
+	EXPECT_EQ(optimizeMesh(outOfRange, {{0, 3}}, {{&positions, 3}}, 3), 3u);
+	EXPECT_EQ(outOfRange, (std::vector<uint32_t>{0, 1, 3}));
+}
+
+TEST(MeshOptimizerTest, narrowIndices) {
+	std::vector<uint32_t> indices{0, 65535, 7};
+	EXPECT_EQ(narrowIndices(indices, 65536), (std::vector<uint16_t>{0, 65535, 7}));
+	EXPECT_TRUE(narrowIndices(indices, 65537).empty());
+}
@@ -0,0 +1,114 @@
+/*
+ * SPDX-License-Identifier: MPL-2.0
+ *
+ * This file is part of Ramses Composer
+ * (see https://github.com/GENIVI/ramses-composer).
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include <gtest/gtest.h>
+
+#include "mesh_loader/glTFBufferData.h"
+
+#include <cstring>
+
+class glTFBufferDataTest : public ::testing::Test {
+protected:
+	// Two vertices with interleaved VEC3 float positions and normalized VEC4 unsigned byte colors.
+	struct Vertex {
+		float position[3];
+		uint8_t color[4];
+	};
+
+	glTFBufferDataTest() {
+		Vertex vertices[2] = {{{1.0F, 2.0F, 3.0F}, {0, 51, 255, 255}}, {{4.0F, 5.0F, 6.0F}, {255, 102, 0, 0}}};
+		tinygltf::Buffer buffer;
+		buffer.data.resize(sizeof(vertices));
+		std::memcpy(buffer.data.data(), vertices, sizeof(vertices));
+		scene.buffers.emplace_back(buffer);
+
+		tinygltf::BufferView view;
+		view.buffer = 0;
+		view.byteLength = sizeof(vertices);
+		view.byteStride = sizeof(Vertex);
+		scene.bufferViews.emplace_back(view);
+
+		scene.accessors.emplace_back(accessor(0, TINYGLTF_COMPONENT_TYPE_FLOAT, TINYGLTF_TYPE_VEC3));
+		scene.accessors.emplace_back(accessor(offsetof(Vertex, color), TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE, TINYGLTF_TYPE_VEC4));
+	}
+
+	static tinygltf::Accessor accessor(size_t byteOffset, int componentType, int type) {
+		tinygltf::Accessor accessor;
+		accessor.bufferView = 0;
+		accessor.byteOffset = byteOffset;
+		accessor.componentType = componentType;
+		accessor.type = type;
+		accessor.count = 2;
+		return accessor;
+	}
+
+	tinygltf::Model scene;
+};
+
+TEST_F(glTFBufferDataTest, view_of_interleaved_data) {
+	glTFBufferData positions(scene, 0);
+	auto view = positions.view<float>();
+	ASSERT_EQ(view.size(), 2u);
+	EXPECT_EQ(view.components(), 3u);
+	EXPECT_EQ(view.stride(), sizeof(Vertex));
+	EXPECT_FALSE(view.contiguous());
+	EXPECT_EQ(view[1][0], 4.0F);
+	EXPECT_EQ(view[1][2], 6.0F);
+}
+
+TEST_F(glTFBufferDataTest, readFloats_interleaved) {
+	std::vector<float> positions(6);
+	ASSERT_TRUE(glTFBufferData(scene, 0).readFloats(positions.data(), 2, 3));
+	EXPECT_EQ(positions, (std::vector<float>{1.0F, 2.0F, 3.0F, 4.0F, 5.0F, 6.0F}));
+}
+
+TEST_F(glTFBufferDataTest, readFloats_normalized_unsigned_byte) {
+	std::vector<float> colors(8);
+	ASSERT_TRUE(glTFBufferData(scene, 1).readFloats(colors.data(), 2, 4));
+	EXPECT_EQ(colors, (std::vector<float>{0.0F, 51 / 255.0F, 1.0F, 1.0F, 1.0F, 102 / 255.0F, 0.0F, 0.0F}));
+}
+
+TEST_F(glTFBufferDataTest, readFloats_pads_and_drops_components) {
+	std::vector<float> padded(8);
+	ASSERT_TRUE(glTFBufferData(scene, 0).readFloats(padded.data(), 2, 4, 1.0F));
+	EXPECT_EQ(padded, (std::vector<float>{1.0F, 2.0F, 3.0F, 1.0F, 4.0F, 5.0F, 6.0F, 1.0F}));
+
+	std::vector<float> dropped(2);
+	ASSERT_TRUE(glTFBufferData(scene, 0).readFloats(dropped.data(), 2, 1));
+	EXPECT_EQ(dropped, (std::vector<float>{1.0F, 4.0F}));
+}
+
+TEST_F(glTFBufferDataTest, readFloats_contiguous_signed_short) {
+	int16_t values[4] = {0, 32767, -32767, -32768};
+	tinygltf::Buffer buffer;
+	buffer.data.resize(sizeof(values));
+	std::memcpy(buffer.data.data(), values, sizeof(values));
+	scene.buffers.emplace_back(buffer);
+
+	tinygltf::BufferView view;
+	view.buffer = 1;
+	view.byteLength = sizeof(values);
+	scene.bufferViews.emplace_back(view);
+
+	auto shortAccessor = accessor(0, TINYGLTF_COMPONENT_TYPE_SHORT, TINYGLTF_TYPE_VEC2);
+	shortAccessor.bufferView = 1;
+	scene.accessors.emplace_back(shortAccessor);
+
+	glTFBufferData data(scene, 2);
+	EXPECT_TRUE(data.view<int16_t>().contiguous());
+	std::vector<float> converted(4);
+	ASSERT_TRUE(data.readFloats(converted.data(), 2, 2));
+	EXPECT_EQ(converted, (std::vector<float>{0.0F, 1.0F, -1.0F, -1.0F}));
+}
+
+TEST_F(glTFBufferDataTest, readFloats_unsupported_component_type) {
+	scene.accessors[0].componentType = TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT;
+	std::vector<float> values(6);
+	EXPECT_FALSE(glTFBufferData(scene, 0).readFloats(values.data(), 2, 3));
+}
@@ -14,7 +14,11 @@
 #include "ramses_base/LogicEngine.h"
 #include "ramses_base/RamsesHandles.h"
 #include "components/DataChangeDispatcher.h"
+#include "core/MeshCacheInterface.h"
+#include "user_types/Mesh.h"
 #include <map>
+#include <optional>
+#include <unordered_map>
 #include "core/Link.h"
 
 namespace raco::ramses_adaptor {
@@ -49,6 +53,18 @@ public:
 	ObjectAdaptor* lookupAdaptor(const core::SEditorObject& editorObject) const;
 	Project& project() const;
 
+	// Ramses array resources created from one MeshData, shared by all Mesh adaptors using the same MeshData.
+	// The resources are named after their owner, the Mesh which created them. Once the owner has been deleted
+	// `owner` is nullptr and the next Mesh using the resources becomes the owner.
+	struct MeshResources {
+		ramses_base::RamsesArrayResource indices;
+		std::unordered_map<std::string, ramses_base::RamsesArrayResource> vertexData;
+		core::SEditorObject owner;
+	};
+	// Resources previously registered with setMeshResources for `meshData` if they are all still in use.
+	std::optional<MeshResources> meshResources(const core::SharedMeshData& meshData);
+	void setMeshResources(const core::SharedMeshData& meshData, const MeshResources& resources);
+
 	template <class T>
 	T* lookup(const core::SEditorObject& editorObject) const {
 		return dynamic_cast<T*>(lookupAdaptor(editorObject));
@@ -65,6 +81,8 @@ private:
 	void removeLink(const core::LinkDescriptor& link);
 	void createAdaptor(SEditorObject obj);
 	void removeAdaptor(SEditorObject obj);
+	// Clear the owner of the resources created by a deleted Mesh.
+	void releaseMeshResources(const user_types::SMesh& mesh);
 
 	void performBulkEngineUpdate(const core::SEditorObjectSet& changedObjects);
 
@@ -102,6 +120,17 @@ private:
 	raco::ramses_base::RamsesAnimationChannelHandle defaultAnimChannel_{};
 
 	std::map<SEditorObject, std::unique_ptr<ObjectAdaptor>> adaptors_{};
+
+	// Only weak references: the resources are owned by the Mesh adaptors and deleted with the last one using them.
+	struct CachedMeshResources {
+		std::weak_ptr<core::MeshData> meshData;
+		std::weak_ptr<ramses::ArrayResource> indices;
+		std::unordered_map<std::string, std::weak_ptr<ramses::ArrayResource>> vertexData;
+		std::weak_ptr<core::EditorObject> owner;
+	};
+	std::unordered_map<const core::MeshData*, CachedMeshResources> meshResources_{};
+	static constexpr size_t MIN_MESH_RESOURCES_PRUNE_SIZE = 16;
+	size_t meshResourcesPruneSize_ = MIN_MESH_RESOURCES_PRUNE_SIZE;
 	
 	struct LinkAdaptorContainer {
 		std::map<std::string, std::map<core::LinkDescriptor, SharedLinkAdaptor>> linksByStart_{};
@@ -50,18 +50,40 @@ bool MeshAdaptor::sync(core::Errors* errors) {
 	LOG_TRACE(raco::log_system::RAMSES_ADAPTOR, "{}", isValid());
 	if (isValid()) {
 		auto mesh = editorObject_->meshData();
-		auto indices = mesh->getIndices();
-		indices_ = ramsesArrayResource(sceneAdaptor_->scene(), ramses::EDataType::UInt32, static_cast<uint32_t>(indices.size()), indices.data());
-		indices_->setName(std::string(this->editorObject_->objectName() + "_MeshIndexData").c_str());
-
+		auto resources = sceneAdaptor_->meshResources(mesh);
+		if (!resources) {
+			// First Mesh using this mesh data: create the resources and let other Meshes with identical settings reuse them.
+			resources = SceneAdaptor::MeshResources{};
+			const auto& indices16 = mesh->getIndices16();
+			if (!indices16.empty()) {
+				resources->indices = ramsesArrayResource(sceneAdaptor_->scene(), ramses::EDataType::UInt16, static_cast<uint32_t>(indices16.size()), indices16.data());
+			} else {
+				const auto& indices = mesh->getIndices();
+				resources->indices = ramsesArrayResource(sceneAdaptor_->scene(), ramses::EDataType::UInt32, static_cast<uint32_t>(indices.size()), indices.data());
+			}
+			for (uint32_t i{0}; i < mesh->numAttributes(); i++) {
+				auto name = mesh->attribName(i);
+				auto type = mesh->attribDataType(i);
+				auto buffer = mesh->attribBuffer(i);
+				auto elementCount = mesh->attribElementCount(i);
+				resources->vertexData[name] = ramsesArrayResource(sceneAdaptor_->scene(), convert(type), elementCount, buffer);
+			}
+			resources->owner = editorObject_;
+			sceneAdaptor_->setMeshResources(mesh, *resources);
+		} else if (!resources->owner) {
+			// The Mesh which created the resources has been deleted: take over naming them.
+			resources->owner = editorObject_;
+			sceneAdaptor_->setMeshResources(mesh, *resources);
+		}
 
-		for (uint32_t i{0}; i < mesh->numAttributes(); i++) {
-			auto name = mesh->attribName(i);
-			auto type = mesh->attribDataType(i);
-			auto buffer = mesh->attribBuffer(i);
-			auto elementCount = mesh->attribElementCount(i);
-			vertexDataMap_[name] = ramsesArrayResource(sceneAdaptor_->scene(), convert(type), elementCount, buffer);
-			vertexDataMap_[name]->setName(std::string(this->editorObject_->objectName() + "_MeshVertexData_" + name).c_str());
+		indices_ = resources->indices;
+		vertexDataMap_ = resources->vertexData;
+		// Only the Mesh which created the resources names them, so the names don't depend on the sync order of the other Meshes.
+		if (resources->owner == editorObject_) {
+			indices_->setName(std::string(this->editorObject_->objectName() + "_MeshIndexData").c_str());
+			for (const auto& [name, vertexData] : vertexDataMap_) {
+				vertexData->setName(std::string(this->editorObject_->objectName() + "_MeshVertexData_" + name).c_str());
+			}
 		}
 	} else {
 		vertexDataMap_.clear();
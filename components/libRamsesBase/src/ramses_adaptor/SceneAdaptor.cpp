@@ -169,6 +169,9 @@ void SceneAdaptor::createAdaptor(SEditorObject obj) {
 void SceneAdaptor::removeAdaptor(SEditorObject obj) {
 	auto adaptorWasLogicProvider = dynamic_cast<ILogicPropertyProvider*>(lookupAdaptor(obj)) != nullptr;
 	adaptors_.erase(obj);
+	if (auto mesh = obj->as<user_types::Mesh>()) {
+		releaseMeshResources(mesh);
+	}
 	deleteUnusedDefaultResources();
 	if (adaptorWasLogicProvider) {
 		updateRuntimeErrorList();
@@ -378,6 +381,67 @@ ObjectAdaptor* SceneAdaptor::lookupAdaptor(const core::SEditorObject& editorObje
 	return nullptr;
 }
 
+std::optional<SceneAdaptor::MeshResources> SceneAdaptor::meshResources(const core::SharedMeshData& meshData) {
+	// Entries of deleted mesh data or resources are removed when they are looked up. Entries which are never
+	// looked up again are pruned once the map has doubled in size since the last pruning.
+	if (meshResources_.size() >= meshResourcesPruneSize_) {
+		for (auto it = meshResources_.begin(); it != meshResources_.end();) {
+			if (it->second.meshData.expired() || it->second.indices.expired()) {
+				it = meshResources_.erase(it);
+			} else {
+				++it;
+			}
+		}
+		meshResourcesPruneSize_ = std::max<size_t>(MIN_MESH_RESOURCES_PRUNE_SIZE, 2 * meshResources_.size());
+	}
+
+	auto it = meshResources_.find(meshData.get());
+	if (it == meshResources_.end()) {
+		return std::nullopt;
+	}
+	// The address may have been reused by a new MeshData after the cached one was deleted.
+	if (it->second.meshData.lock() != meshData) {
+		meshResources_.erase(it);
+		return std::nullopt;
+	}
+	MeshResources resources{it->second.indices.lock(), {}, it->second.owner.lock()};
+	bool valid = resources.indices != nullptr;
+	for (const auto& [name, weakResource] : it->second.vertexData) {
+		auto resource = weakResource.lock();
+		valid = valid && resource;
+		resources.vertexData[name] = resource;
+	}
+	if (!valid) {
+		meshResources_.erase(it);
+		return std::nullopt;
+	}
+	return resources;
+}
+
+void SceneAdaptor::setMeshResources(const core::SharedMeshData& meshData, const MeshResources& resources) {
+	CachedMeshResources cached{meshData, resources.indices, {}, resources.owner};
+	for (const auto& [name, resource] : resources.vertexData) {
+		cached.vertexData[name] = resource;
+	}
+	meshResources_[meshData.get()] = cached;
+}
+
+void SceneAdaptor::releaseMeshResources(const user_types::SMesh& mesh) {
+	auto it = meshResources_.find(mesh->meshData().get());
+	if (it == meshResources_.end() || it->second.owner.lock() != mesh) {
+		return;
+	}
+	it->second.owner.reset();
+	// Let another Mesh using the resources take them over, so they are not left named after the deleted Mesh.
+	for (const auto& [object, adaptor] : adaptors_) {
+		auto other = object->as<user_types::Mesh>();
+		if (other && other->meshData() == mesh->meshData()) {
+			adaptor->tagDirty();
+			return;
+		}
+	}
+}
+
 raco::core::Project& SceneAdaptor::project() const {
 	return *project_;
 }
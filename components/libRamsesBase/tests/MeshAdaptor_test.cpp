@@ -76,4 +76,68 @@ TEST_F(MeshAdaptorTest, gltf_with_meshes_but_no_mesh_refs_unbaked) {
 	ASSERT_TRUE(isRamsesNameInArray("Mesh Name_MeshVertexData_a_Normal", meshStuff));
 	ASSERT_TRUE(isRamsesNameInArray("Mesh Name_MeshVertexData_a_TextureCoordinate", meshStuff));
 	ASSERT_EQ(context.errors().getError(mesh).level(), raco::core::ErrorLevel::INFORMATION);
-}
\ No newline at end of file
+}
+
+TEST_F(MeshAdaptorTest, optimized_mesh_uses_16_bit_indices) {
+	auto mesh = context.createObject(raco::user_types::Mesh::typeDescription.typeName, "Mesh Name");
+	context.set({mesh, &raco::user_types::Mesh::uri_}, cwd_path().append("meshes/Duck.glb").string());
+
+	dispatch();
+	EXPECT_EQ(select<ramses::ArrayResource>(*sceneContext.scene(), "Mesh Name_MeshIndexData")->getDataType(), ramses::EDataType::UInt32);
+
+	context.set({mesh, &raco::user_types::Mesh::optimizeMesh_}, true);
+	dispatch();
+	EXPECT_EQ(select<ramses::ArrayResource>(*sceneContext.scene(), "Mesh Name_MeshIndexData")->getDataType(), ramses::EDataType::UInt16);
+}
+
+TEST_F(MeshAdaptorTest, meshes_with_same_settings_share_resources) {
+	auto mesh = context.createObject(raco::user_types::Mesh::typeDescription.typeName, "Mesh");
+	auto copy = context.createObject(raco::user_types::Mesh::typeDescription.typeName, "Copy");
+	context.set({mesh, &raco::user_types::Mesh::uri_}, cwd_path().append("meshes/Duck.glb").string());
+	context.set({copy, &raco::user_types::Mesh::uri_}, cwd_path().append("meshes/Duck.glb").string());
+
+	dispatch();
+	EXPECT_EQ(mesh->as<raco::user_types::Mesh>()->meshData(), copy->as<raco::user_types::Mesh>()->meshData());
+	EXPECT_EQ(select<ramses::ArrayResource>(*sceneContext.scene(), ramses::ERamsesObjectType::ERamsesObjectType_ArrayResource).size(), 4);
+
+	context.set({copy, &raco::user_types::Mesh::optimizeMesh_}, true);
+	dispatch();
+	EXPECT_EQ(select<ramses::ArrayResource>(*sceneContext.scene(), ramses::ERamsesObjectType::ERamsesObjectType_ArrayResource).size(), 8);
+
+	context.deleteObjects({copy});
+	dispatch();
+	EXPECT_EQ(select<ramses::ArrayResource>(*sceneContext.scene(), ramses::ERamsesObjectType::ERamsesObjectType_ArrayResource).size(), 4);
+}
+
+TEST_F(MeshAdaptorTest, shared_resources_named_after_creating_mesh) {
+	auto mesh = context.createObject(raco::user_types::Mesh::typeDescription.typeName, "Mesh");
+	context.set({mesh, &raco::user_types::Mesh::uri_}, cwd_path().append("meshes/Duck.glb").string());
+	dispatch();
+
+	auto copy = context.createObject(raco::user_types::Mesh::typeDescription.typeName, "Copy");
+	context.set({copy, &raco::user_types::Mesh::uri_}, cwd_path().append("meshes/Duck.glb").string());
+	dispatch();
+
+	// Syncing the other Mesh doesn't rename the shared resources.
+	context.set({copy, &raco::user_types::Mesh::objectName_}, std::string("Renamed Copy"));
+	dispatch();
+	auto meshStuff{select<ramses::ArrayResource>(*sceneContext.scene(), ramses::ERamsesObjectType::ERamsesObjectType_ArrayResource)};
+	EXPECT_EQ(meshStuff.size(), 4);
+	EXPECT_TRUE(isRamsesNameInArray("Mesh_MeshIndexData", meshStuff));
+	EXPECT_TRUE(isRamsesNameInArray("Mesh_MeshVertexData_a_Position", meshStuff));
+	EXPECT_FALSE(isRamsesNameInArray("Renamed Copy_MeshIndexData", meshStuff));
+
+	context.set({mesh, &raco::user_types::Mesh::objectName_}, std::string("Renamed Mesh"));
+	dispatch();
+	meshStuff = select<ramses::ArrayResource>(*sceneContext.scene(), ramses::ERamsesObjectType::ERamsesObjectType_ArrayResource);
+	EXPECT_TRUE(isRamsesNameInArray("Renamed Mesh_MeshIndexData", meshStuff));
+	EXPECT_TRUE(isRamsesNameInArray("Renamed Mesh_MeshVertexData_a_Position", meshStuff));
+
+	// The remaining Mesh takes over the resources of the deleted one.
+	context.deleteObjects({mesh});
+	dispatch();
+	meshStuff = select<ramses::ArrayResource>(*sceneContext.scene(), ramses::ERamsesObjectType::ERamsesObjectType_ArrayResource);
+	EXPECT_EQ(meshStuff.size(), 4);
+	EXPECT_TRUE(isRamsesNameInArray("Renamed Copy_MeshIndexData", meshStuff));
+	EXPECT_TRUE(isRamsesNameInArray("Renamed Copy_MeshVertexData_a_Position", meshStuff));
+}
@@ -0,0 +1,115 @@
+/*
+ * SPDX-License-Identifier: MPL-2.0
+ *
+ * This file is part of Ramses Composer
+ * (see https://github.com/GENIVI/ramses-composer).
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include "core/Serialization.h"
+
+#include <QByteArray>
+#include <QIODevice>
+#include <QJsonDocument>
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace raco::serialization {
+
+/**
+ * Binary encoding of the project documents created by `serializeProject`.
+ *
+ * The encoding holds the same tree of values as the JSON document, so it can be converted to JSON and back without
+ * loss, e.g. to migrate files with an older file version. Projects are written directly from the objects by
+ * `writeBinaryProject` and read directly into objects by `BinaryProject::deserialize`, without a JSON document.
+ *
+ * Layout; `varint` is an unsigned LEB128 number, other integers are little endian:
+ * - magic bytes `BINARY_PROJECT_MAGIC` followed by the format version as a single byte,
+ * - the document root as a single value,
+ * - the name table: varint count, then every name as varint byte count and UTF-8 bytes,
+ * - the object ID table, encoded like the name table,
+ * - the file offset of the name table as 8 byte integer.
+ * The name table holds the object keys, i.e. the property names, and the type names. The object ID table holds the
+ * values of the `objectID` properties and of references. Every value starts with a `BinaryTag` byte, followed by:
+ * - Int: the zig-zag encoded number as varint. Integral Double values are written as Int as well.
+ * - Double: the 8 byte IEEE 754 number.
+ * - String: varint byte count and UTF-8 bytes.
+ * - Name, Id: varint index into the name or object ID table. Both decode to strings.
+ * - Array: the elements, followed by an End tag.
+ * - Object: the members as varint name index + 1 followed by the value, terminated by a 0 byte.
+ */
+constexpr char BINARY_PROJECT_MAGIC[] = "RCAB";
+constexpr uint8_t BINARY_PROJECT_FORMAT_VERSION = 3;
+
+enum class BinaryTag : uint8_t {
+	Null,
+	False,
+	True,
+	Int,
+	Double,
+	String,
+	Name,
+	Id,
+	Array,
+	Object,
+	End
+};
+
+/** Checks the magic bytes only; used to detect the file format on load. */
+bool isBinaryProject(const QByteArray& data);
+
+/**
+ * Writes the binary encoding of `serializeProject(...)` to `device`. The instances are written one at a time,
+ * without creating a JSON document.
+ * @return false if writing to `device` failed.
+ */
+bool writeBinaryProject(QIODevice& device, const std::unordered_map<std::string, std::vector<int>>& fileVersions, const std::vector<SReflectionInterface>& instances, const std::vector<SReflectionInterface>& links, const std::map<std::string, ExternalProjectInfo>& externalProjectsMap, const ResolveReferencedId& resolveReferenceId);
+
+/** Encodes any document, e.g. a migrated one. Strings equal to the `objectID` of an object are stored as object IDs. */
+QByteArray toBinaryProject(const QJsonDocument& document);
+
+/**
+ * @exception std::runtime_error if `data` is truncated, malformed or written by another format version.
+ */
+QJsonDocument fromBinaryProject(const QByteArray& data);
+
+/**
+ * A checked binary project, shared with the QByteArray it was created from.
+ */
+class BinaryProject {
+public:
+	/**
+	 * Reads the tables and checks the structure of all values.
+	 * @exception std::runtime_error if `data` is truncated, malformed or written by another format version.
+	 */
+	explicit BinaryProject(const QByteArray& data);
+
+	// The file version of the document; 0 if there is none, like `deserializeFileVersion`.
+	int fileVersion() const;
+
+	QJsonDocument toJson() const;
+
+	/**
+	 * Same result as `deserializeProject(toJson(), factory)`. The instances are deserialized on multiple threads.
+	 */
+	ProjectDeserializationInfo deserialize(const DeserializationFactory& factory) const;
+
+	const std::vector<std::string>& names() const;
+	const std::vector<std::string>& objectIDs() const;
+
+private:
+	QByteArray data_;
+	size_t rootOffset_ = 0;
+	size_t tableOffset_ = 0;
+	std::vector<std::string> names_;
+	std::unordered_map<std::string, uint32_t> nameIndices_;
+	std::vector<std::string> objectIDs_;
+};
+
+}  // namespace raco::serialization
@@ -13,8 +13,12 @@
 #include "Link.h"
 #include "EditorObject.h"
 
+#include <array>
+#include <cstdint>
 #include <map>
+#include <memory>
 #include <set>
+#include <unordered_map>
 #include <vector>
 
 namespace raco::core {
@@ -41,6 +45,11 @@ public:
 
 class DataChangeRecorder : public DataChangeRecorderInterface {
 public:
+	// Changed values grouped by their root object.
+	// The key pointer is kept alive by the ValueHandles in the mapped set, which is never empty.
+	// The iteration order depends on the object addresses; DataChangeDispatcher sorts the objects by ID.
+	using ChangedValueMap = std::unordered_map<const EditorObject*, std::set<ValueHandle>>;
+
 	void reset() override;
 
 	void recordCreateObject(SEditorObject const& object) override;
@@ -60,6 +69,7 @@ public:
 
 	/**
 	 * #reset() with return of all chanages.
+	 * The recorded changes are moved into the returned recorder.
 	 */
 	DataChangeRecorder release();
 
@@ -69,7 +79,7 @@ public:
 	// Get the set of all changes Values
 	// - added/removed properties inside Tables will be recorded as change of the Table Value.
 	//   No separate add/remove property notification is generated.
-	std::map<std::string, std::set<ValueHandle>> const& getChangedValues() const;
+	ChangedValueMap const& getChangedValues() const;
 
 	bool hasValueChanged(const ValueHandle& handle) const;
 
@@ -81,19 +91,31 @@ public:
 	bool isLinkValidityChanged(SLink link) const;
 
 
-	// Construct set of all objects that have been changed in some way, i.e.
+	// Set of all objects that have been changed in some way, i.e.
 	// that have been created of which contain a changed Value.
-	SEditorObjectSet getAllChangedObjects(bool includePreviewDirty = false, bool includeLinkStart = false, bool includeLinkEnd = false) const;
+	// The set is built on demand and cached until the next modification of the recorder.
+	// A returned set is never modified: later changes and queries build a new set. The reference stays valid
+	// until the recorder is reset or destroyed, so recording changes while iterating over the result is safe.
+	SEditorObjectSet const& getAllChangedObjects(bool includePreviewDirty = false, bool includeLinkStart = false, bool includeLinkEnd = false) const;
+
+	// Incremented whenever the result of getAllChangedObjects may change.
+	// Allows callers to cache data derived from the changed objects.
+	uint64_t changedObjectsVersion() const;
 
-	std::set<ValueHandle> getChangedErrors() const;
+	std::set<ValueHandle> const& getChangedErrors() const;
 
-	SEditorObjectSet getPreviewDirtyObjects() const;
+	SEditorObjectSet const& getPreviewDirtyObjects() const;
 
 	bool externalProjectMapChanged() const;
 
 	void mergeChanges(const DataChangeRecorder& other);
+	// Same as above but moves the contents of other; other is left empty.
+	void mergeChanges(DataChangeRecorder&& other);
 
 private:
+	bool empty() const;
+	void invalidateCachedQueries();
+
 	// private helper class that stores, accesses, updates and erases link descriptor entries with below-linear runtime complexity.
 	class LinkMap {
 	public:
@@ -126,7 +148,7 @@ private:
 	SEditorObjectSet createdObjects_;
 	SEditorObjectSet deletedObjects_;
 	
-	std::map<std::string, std::set<ValueHandle>> changedValues_;
+	ChangedValueMap changedValues_;
 
 	LinkMap addedLinks_;
 	LinkMap changedValidityLinks_;
@@ -136,6 +158,13 @@ private:
 	SEditorObjectSet previewDirty_;
 
 	bool externalProjectMapChanged_ = false;
+
+	// Cached results of getAllChangedObjects, indexed by the bitmask of its flags.
+	mutable std::array<std::shared_ptr<const SEditorObjectSet>, 8> allChangedObjectsCache_;
+	// Results replaced by newer ones; kept until the next reset since callers may still hold references to them.
+	mutable std::vector<std::shared_ptr<const SEditorObjectSet>> outdatedChangedObjects_;
+	mutable uint8_t allChangedObjectsCacheValid_ = 0;
+	uint64_t changedObjectsVersion_ = 0;
 };
 
 class MultiplexedDataChangeRecorder : public DataChangeRecorderInterface {
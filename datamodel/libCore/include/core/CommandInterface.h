@@ -12,6 +12,8 @@
 #include "Handles.h"
 #include "Link.h"
 
+#include <functional>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -26,6 +28,7 @@ struct MeshScenegraph;
 class Project;
 class ExternalProjectsStoreInterface;
 class MeshCache;
+class ObjectsSnapshot;
 class UndoStack;
 class UserObjectFactoryInterface;
 class BaseContext;
@@ -92,6 +95,16 @@ public:
 	 */
 	std::vector<SEditorObject> pasteObjects(const std::string& val, SEditorObject const& target = {}, bool pasteAsExtref = false, bool* outSuccess = nullptr, std::string* outError = nullptr);
 
+	/**
+	 * Same as #copyObjects and #cutObjects but returns an in-memory snapshot of the objects for pasting within the same process.
+	 * #cutObjectsSnapshot returns nullptr if none of the objects can be deleted.
+	 */
+	std::shared_ptr<const ObjectsSnapshot> copyObjectsSnapshot(const std::vector<SEditorObject>& objects, bool deepCopy = false);
+	std::shared_ptr<const ObjectsSnapshot> cutObjectsSnapshot(const std::vector<SEditorObject>& objects, bool deepCut = false);
+
+	// Same as the string version of #pasteObjects for a snapshot created by #copyObjectsSnapshot or #cutObjectsSnapshot.
+	std::vector<SEditorObject> pasteObjects(const ObjectsSnapshot& snapshot, SEditorObject const& target = {}, bool pasteAsExtref = false, bool* outSuccess = nullptr, std::string* outError = nullptr);
+
 	// Link operations
 	SLink addLink(const ValueHandle& start, const ValueHandle& end);
 	void removeLink(const PropertyDescriptor& end);
@@ -99,6 +112,8 @@ public:
 	void deleteUnreferencedResources();
 
 private:
+	std::vector<SEditorObject> pasteWithUndo(const std::function<std::vector<SEditorObject>()>& paste, SEditorObject const& target, bool pasteAsExtref, bool* outSuccess, std::string* outError);
+
 	BaseContext* context_;
 	UndoStack* undoStack_;
 };
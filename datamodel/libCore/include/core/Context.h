@@ -27,6 +27,7 @@ struct MeshScenegraph;
 class Project;
 class ExternalProjectsStoreInterface;
 class MeshCache;
+class ObjectsSnapshot;
 class UndoStack;
 class Errors;
 class UserObjectFactoryInterface;
@@ -109,6 +110,16 @@ public:
 	 */
 	std::vector<SEditorObject> pasteObjects(const std::string& val, SEditorObject const& target = {}, bool pasteAsExtref = false);
 
+	/**
+	 * Same as #copyObjects and #cutObjects but returns an in-memory snapshot of the objects instead of their serialization.
+	 * Pasting the snapshot with #pasteObjects avoids creating and parsing the JSON text within the same process.
+	 */
+	std::shared_ptr<const ObjectsSnapshot> copyObjectsSnapshot(const std::vector<SEditorObject>& objects, bool deepCopy = false);
+	std::shared_ptr<const ObjectsSnapshot> cutObjectsSnapshot(const std::vector<SEditorObject>& objects, bool deepCut = false);
+
+	// Same as the string version of #pasteObjects for a snapshot created by #copyObjectsSnapshot or #cutObjectsSnapshot.
+	std::vector<SEditorObject> pasteObjects(const ObjectsSnapshot& snapshot, SEditorObject const& target = {}, bool pasteAsExtref = false);
+
 	// Delete set of objects
 	// @param gcExternalProjectMap If true the external project map in the Project will be updated and external projects
 	// 	   which are now unused are removed.
@@ -161,6 +172,7 @@ private:
 	friend class PrefabOperations;
 	friend class ExtrefOperations;
 
+	std::vector<SEditorObject> pasteDeserializedObjects(raco::serialization::ObjectsDeserialization& deserialization, SEditorObject const& target, bool pasteAsExtref);
 	void rerootRelativePaths(std::vector<SEditorObject>& newObjects, raco::serialization::ObjectsDeserialization& deserialization);
 	bool extrefPasteDiscardObject(SEditorObject editorObject, raco::serialization::ObjectsDeserialization& deserialization);
 	void adjustExtrefAnnotationsForPaste(std::vector<SEditorObject>& newObjects, raco::serialization::ObjectsDeserialization& deserialization, bool pasteAsExtref);
@@ -171,6 +183,8 @@ private:
 	static bool deleteWithVolatileSideEffects(Project* project, const SEditorObjectSet& objects, Errors& errors, bool gcExternalProjectMap = true);
 
 	void callReferencedObjectChangedHandlers(SEditorObject const& changedObject);
+	// Keep the project name index up to date if the objectName or the children of the object have changed.
+	void updateInstanceNames(ValueHandle const& changedValue);
 	void removeReferencesTo(SEditorObjectSet const& objects);
 
 	template <void (EditorObject::*Handler)(ValueHandle const&) const>
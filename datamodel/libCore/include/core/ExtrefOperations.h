@@ -10,6 +10,7 @@
 
 #pragma once
 
+#include <set>
 #include <string>
 #include <utility>
 #include <vector>
@@ -25,6 +26,9 @@ public:
 	virtual ~ExternalProjectsStoreInterface() = default;
 
 	virtual Project* addExternalProject(const std::string& projectPath, std::vector<std::string>& pathStack) = 0;
+	// Like addExternalProject, but the store may load only the objects with the given IDs and the objects they depend on.
+	// Requesting objects which are not loaded yet may reload the project, invalidating pointers into the previous one.
+	virtual Project* addExternalProjectObjects(const std::string& projectPath, const std::set<std::string>& objectIDs, std::vector<std::string>& pathStack) = 0;
 	virtual void removeExternalProject(const std::string& projectPath) = 0;
 	virtual bool canRemoveExternalProject(const std::string& projectPath) const = 0;
 
@@ -12,6 +12,10 @@
 #include "data_storage/Value.h"
 #include "core/PropertyDescriptor.h"
 
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <initializer_list>
 #include <memory>
 #include <string>
 #include <vector>
@@ -36,6 +40,104 @@ class ValueHandle;
 class EditorObject;
 class ValueTreeIterator;
 
+// Sequence of property indices with inline storage for short sequences.
+// Paths up to INLINE_CAPACITY indices don't allocate; longer paths keep all indices on the heap.
+class PropertyIndexPath {
+public:
+	static constexpr size_t INLINE_CAPACITY = 4;
+
+	PropertyIndexPath() = default;
+	PropertyIndexPath(std::initializer_list<size_t> indices) : PropertyIndexPath(indices.begin(), indices.end()) {
+	}
+	PropertyIndexPath(const std::vector<size_t>& indices) : PropertyIndexPath(indices.data(), indices.data() + indices.size()) {
+	}
+	PropertyIndexPath(const size_t* first, const size_t* last) {
+		size_t count = last - first;
+		if (count > INLINE_CAPACITY) {
+			heap_.assign(first, last);
+		} else {
+			std::copy(first, last, inline_.begin());
+		}
+		size_ = count;
+	}
+
+	size_t size() const {
+		return size_;
+	}
+	bool empty() const {
+		return size_ == 0;
+	}
+
+	const size_t* begin() const {
+		return data();
+	}
+	const size_t* end() const {
+		return data() + size_;
+	}
+
+	size_t operator[](size_t index) const {
+		return data()[index];
+	}
+	size_t front() const {
+		return data()[0];
+	}
+	size_t back() const {
+		return data()[size_ - 1];
+	}
+	size_t& back() {
+		return data()[size_ - 1];
+	}
+
+	void push_back(size_t index) {
+		if (size_ < INLINE_CAPACITY) {
+			inline_[size_] = index;
+		} else {
+			if (size_ == INLINE_CAPACITY) {
+				heap_.assign(inline_.begin(), inline_.end());
+			}
+			heap_.push_back(index);
+		}
+		++size_;
+	}
+
+	void pop_back() {
+		--size_;
+		if (size_ == INLINE_CAPACITY) {
+			std::copy(heap_.begin(), heap_.begin() + INLINE_CAPACITY, inline_.begin());
+			heap_.clear();
+		} else if (size_ > INLINE_CAPACITY) {
+			heap_.pop_back();
+		}
+	}
+
+	void clear() {
+		heap_.clear();
+		size_ = 0;
+	}
+
+	bool operator==(const PropertyIndexPath& other) const {
+		return std::equal(begin(), end(), other.begin(), other.end());
+	}
+	bool operator!=(const PropertyIndexPath& other) const {
+		return !operator==(other);
+	}
+	bool operator<(const PropertyIndexPath& other) const {
+		return std::lexicographical_compare(begin(), end(), other.begin(), other.end());
+	}
+
+private:
+	const size_t* data() const {
+		return size_ > INLINE_CAPACITY ? heap_.data() : inline_.data();
+	}
+	size_t* data() {
+		return size_ > INLINE_CAPACITY ? heap_.data() : inline_.data();
+	}
+
+	size_t size_ = 0;
+	std::array<size_t, INLINE_CAPACITY> inline_{};
+	std::vector<size_t> heap_;
+};
+
 // A ValueHandle is like a pointer to a property inside an EditorObject
 // - properties are Value<T> or Property<T> types and are usually accessed through the ValueBase interface
 // - they are necessary since ValueBase objects don't contain information on the parent EditorObject or Table
@@ -49,6 +151,10 @@ class ValueTreeIterator;
 //   invalidating the ValueHandle. The validity can be checked using the "operator bool()".
 //   Deletion of an object from the Project can not be detected using the ValueHandle alone since it is possible
 //   that the shared pointer of the root object is kept alive elsewhere.
+// - caching: 
+//   If built with RACO_USE_VALUE_HANDLE_CACHE, the pointer to the property is cached after the first lookup and
+//   reused as long as the outermost Table on the path to the property has not been structurally changed since then
+//   (see Table::structureVersion). Changes to other objects or to Tables not on the path don't invalidate the cache.
 class ValueHandle {
 public:
 	ValueHandle(std::shared_ptr<EditorObject> object = nullptr, std::initializer_list<std::string> names = std::initializer_list<std::string>());
@@ -57,6 +163,8 @@ public:
 	ValueHandle(std::shared_ptr<EditorObject> object, std::initializer_list<size_t> indices);
 	ValueHandle(const std::shared_ptr<EditorObject>& object, const std::vector<size_t>& indices) : object_(object), indices_(indices) {
 	}
+	ValueHandle(const std::shared_ptr<EditorObject>& object, const PropertyIndexPath& indices) : object_(object), indices_(indices) {
+	}
 
 	// Construct the ValueHandle using property fields and avoid using the property name. Example:
 	// SMeshNode meshNode = ...;
@@ -209,10 +317,20 @@ private:
 	friend class PrefabOperations;
 
 	ValueBase* valueRef() const;
+	// Looks up the property; `outerTable` is set to the outermost Table on the path or nullptr if there is none.
+	ValueBase* resolveValueRef(const Table** outerTable) const;
 	ReflectionInterface* object() const;
 
 	std::shared_ptr<EditorObject> object_;
-	std::vector<size_t> indices_;
+	PropertyIndexPath indices_;
+
+#ifdef RACO_USE_VALUE_HANDLE_CACHE
+	// Cached result of resolveValueRef; valid if there is no outer Table or cachedStructureVersion_ matches its
+	// current structureVersion. The outer Table is a fixed property of object_ and lives as long as the object.
+	mutable ValueBase* cachedValue_ = nullptr;
+	mutable const Table* cachedTable_ = nullptr;
+	mutable uint64_t cachedStructureVersion_ = 0;
+#endif
 };
 
 
@@ -53,6 +53,8 @@ public:
 	virtual std::vector<std::string> getMaterialNames() const = 0;
 
 	virtual const std::vector<uint32_t>& getIndices() const = 0;
+	// Same indices as getIndices() with 16 bits, if the mesh was optimized at import and has at most 65536 vertices; empty otherwise.
+	virtual const std::vector<uint16_t>& getIndices16() const = 0;
 
 	virtual const std::vector<IndexBufferRangeInfo>& submeshIndexBufferRanges() const = 0;
 
@@ -223,6 +225,8 @@ struct MeshDescriptor {
 	std::string absPath{};
 	int submeshIndex{0};
 	bool bakeAllSubmeshes{true};
+	// Weld identical vertices, reorder the triangles for the vertex cache and use 16-bit indices if possible.
+	bool optimize{false};
 };
 
 // Cache entry for each file.
@@ -0,0 +1,63 @@
+/*
+ * SPDX-License-Identifier: MPL-2.0
+ *
+ * This file is part of Ramses Composer
+ * (see https://github.com/GENIVI/ramses-composer).
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include "core/EditorObject.h"
+#include "core/Link.h"
+#include "core/Serialization.h"
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace raco::core {
+
+class Project;
+class UserObjectFactoryInterface;
+
+/**
+ * In-memory result of a copy or cut operation, used to paste within the same process without creating and parsing
+ * the JSON text returned by BaseContext::copyObjects.
+ *
+ * The snapshot holds clones of the copied objects and links taken at copy time, so later changes of the originals
+ * don't affect it. Like in the JSON text all references are kept as object IDs: the clones never point to other
+ * objects and are never added to a project.
+ */
+class ObjectsSnapshot {
+public:
+	ObjectsSnapshot(const Project& project, const std::vector<SEditorObject>& objects, const std::vector<std::string>& rootObjectIDs, const std::vector<SLink>& links, const std::map<std::string, std::string>& originFolders, UserObjectFactoryInterface& factory);
+
+	// New clones of the objects and links with the same content and references as `serialization::deserializeObjects` returns for `serialize()`.
+	serialization::ObjectsDeserialization deserialize(UserObjectFactoryInterface& factory) const;
+
+	// Same text as BaseContext::copyObjects returns for the copied objects at the time the snapshot was taken.
+	std::string serialize() const;
+
+	size_t size() const;
+
+private:
+	std::vector<SEditorObject> objects_;
+	std::vector<SLink> links_;
+	// Referenced object ID of each non-empty reference property of the clones.
+	std::map<const data_storage::ValueBase*, std::string> references_;
+
+	std::vector<std::string> rootObjectIDs_;
+	std::string originFolder_;
+	std::string originFileName_;
+	std::string originProjectID_;
+	std::string originProjectName_;
+	std::map<std::string, serialization::ExternalProjectInfo> externalProjectsMap_;
+	std::map<std::string, std::string> objectOriginFolders_;
+};
+
+using SObjectsSnapshot = std::shared_ptr<const ObjectsSnapshot>;
+
+}  // namespace raco::core
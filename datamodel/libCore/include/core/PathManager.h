@@ -29,6 +29,7 @@ struct PathManager {
 	static constexpr const char* Q_RECENT_FILES_STORE_NAME = "recent_files.ini";
 	static constexpr const char* DEFAULT_CONFIG_SUB_DIRECTORY = "configfiles";
 	static constexpr const char* DEFAULT_PROJECT_SUB_DIRECTORY = "projects";
+	static constexpr const char* PROJECT_CACHE_SUB_DIRECTORY = "projectcache";
 	
 	enum class FolderTypeKeys {
 		Invalid = 0,
@@ -59,6 +60,8 @@ struct PathManager {
 
 	static std::string preferenceFileLocation();
 
+	static std::string projectCacheDirectory();
+
 	static std::string constructRelativePath(const std::string& absolutePath, const std::string& basePath);
 
 	// Construct absolute paths from base directory and relative  or absolute file path.
@@ -37,6 +37,9 @@ public:
 	
 	static void prefabUpdateOrderDepthFirstSearch(raco::user_types::SPrefab current, std::vector<raco::user_types::SPrefab>& order);
 
+	// Prefabs whose instances may need an update because of the changes, in reverse update order.
+	static std::vector<raco::user_types::SPrefab> prefabUpdateOrder(const Project& project, const DataChangeRecorder& changes);
+
 private:
 	static void updatePrefabInstance(BaseContext& context, const raco::user_types::SPrefab& prefab, raco::user_types::SPrefabInstance instance, bool instanceDirty);
 };
@@ -15,9 +15,9 @@
 #include "core/ProjectSettings.h"
 #include "log_system/log.h"
 #include "core/Serialization.h"
-#include <regex>
 #include <map>
 #include <unordered_map>
+#include <unordered_set>
 
 namespace raco::core {
 
@@ -27,6 +27,48 @@ struct ExtrefError : public std::runtime_error {
 
 class UndoStack;
 
+// Index of the object names used in a set of sibling objects.
+// Unique names for many objects in the same scope can be generated from it without rescanning the siblings for every name:
+// names of the form "<basename> (<n>)" are indexed by basename and the used suffixes n are kept as runs of consecutive numbers.
+class UniqueNameIndex {
+public:
+	UniqueNameIndex() = default;
+
+	template <typename It>
+	UniqueNameIndex(It begin, It end) {
+		for (auto it = begin; it != end; ++it) {
+			addName((*it)->objectName());
+		}
+	}
+
+	void addName(const std::string& name);
+	void removeName(const std::string& name);
+
+	// Find a name not used by any object in the index, see Project::findAvailableUniqueName.
+	// If nameUsedByObject is true one occurrence of name belongs to the object the name is generated for
+	// and does not count as collision.
+	std::string findAvailableName(const std::string& name, bool nameUsedByObject = false) const;
+
+	bool operator==(const UniqueNameIndex& other) const;
+
+	// Split a name of the form "<basename> (<n>)" into basename and n; returns false for other names.
+	static bool splitName(const std::string& name, std::string& basename, int& suffix);
+
+private:
+	void addSuffix(const std::string& basename, int suffix);
+	void removeSuffix(const std::string& basename, int suffix);
+
+	struct Suffixes {
+		// Number of names using each suffix; a plain basename counts as suffix 0.
+		std::unordered_map<int, int> counts;
+		// Runs of consecutive used suffixes as start -> end, both inclusive.
+		std::map<int, int> runs;
+	};
+
+	std::unordered_map<std::string, int> nameCounts_;
+	std::unordered_map<std::string, Suffixes> suffixes_;
+};
+
 class Project {
 public:
 
@@ -35,6 +77,9 @@ public:
 		for (auto obj : instances_) {
 			instanceMap_[obj->objectID()] = obj;
 		}
+		for (auto obj : instances_) {
+			indexInstanceName(obj);
+		}
 	}
 
 	// Remove a set of objects from the instance pool.
@@ -102,43 +147,25 @@ public:
 	bool externalReferenceUpdateFailed() const;
 	void setExternalReferenceUpdateFailed(bool status);
 
+	// Find a name for newObject which is not used by any other object in [begin, end).
+	// Colliding names get a " (<n>)" suffix, e.g. "Node" -> "Node (1)".
 	template <typename It>
 	static std::string findAvailableUniqueName(It begin, It end, SEditorObject newObject, const std::string& name) {
-		if (!(std::find_if(begin, end, [newObject, name](auto obj) {
-				return obj != newObject && obj->objectName() == name;
-			}) != end)) {
-			return name;
-		}
+		UniqueNameIndex index(begin, end);
+		return index.findAvailableName(name, newObject && std::find(begin, end, newObject) != end && newObject->objectName() == name);
+	}
 
-		std::string basename;
-		std::smatch match;
-		if (std::regex_match(name, match, NAMING_PATTERN)) {
-			basename = match[1];
-		} else {
-			basename = name;
-		}
+	// Find a name for newObject which is not used by any other child of parent; parent is nullptr for top level objects.
+	// Uses the name index of the project instead of scanning the siblings.
+	std::string findAvailableUniqueName(SEditorObject const& parent, SEditorObject const& newObject, const std::string& name) const;
 
-		std::set<int> indices;
-		for (auto it = begin; it != end; ++it) {
-			auto currentName = (*it)->objectName();
-			std::smatch m;
-			if (std::regex_match(currentName, m, NAMING_PATTERN)) {
-				if (basename == m[1]) {
-					indices.insert(std::stoi(m[2]));
-				}
-			} else {
-				if (currentName == basename) {
-					indices.insert(0);
-				}
-			}
-		}
+	// Update the name index after the name or the children of the objects have been changed.
+	// addInstance and removeInstances update the index themselves.
+	void updateInstanceNames(SEditorObjectSet const& objects);
 
-		auto it = std::adjacent_find(indices.begin(), indices.end(), [](int l, int r) { return l + 1 < r; });
-		if (it == indices.end()) {
-			--it;
-		}
-		return fmt::format("{} ({})", basename, *it + 1);
-	}
+	// Compare the name index with an index built from a scan of all instances.
+	// Checked in debug builds after every undo stack entry and after loading a project.
+	bool checkInstanceNames() const;
 
 	// Repair project by removing duplicate links
 	void deduplicateLinks();
@@ -152,6 +179,14 @@ private:
 
 	void removeAllLinks();
 
+	void indexInstanceName(SEditorObject const& object);
+	void unindexInstanceName(SEditorObject const& object);
+
+	// Object dependency graph induced by the links.
+	// The graph maintains a topological order of the objects which is updated incrementally when links are added
+	// (Pearce-Kelly algorithm). A new link start -> end can only create a loop if end is not ordered after start,
+	// and the search for a path end -> start only needs to visit objects ordered between the two.
+	// If the links already contain a loop there is no topological order and loop checks fall back to a full search.
 	class LinkGraph {
 	public:
 		LinkGraph(const Project& project);
@@ -164,8 +199,30 @@ private:
 		bool createsLoop(const PropertyDescriptor& start, const PropertyDescriptor& end) const;
 
 	private:
-		bool depthFirstSearch(SEditorObject current, SEditorObject obj, SEditorObjectSet& visited) const;
-		std::map<SEditorObject, SEditorObjectSet> graph;
+		struct Node {
+			SEditorObject object;
+			int64_t order;
+			// Adjacent objects with the number of links between the objects.
+			std::unordered_map<const EditorObject*, int> successors;
+			std::unordered_map<const EditorObject*, int> predecessors;
+		};
+
+		Node& node(const SEditorObject& object);
+		void eraseIfUnlinked(const EditorObject* object);
+
+		// Restore the topological order after adding the edge start -> end with order(end) < order(start).
+		// Returns false if the edge creates a loop.
+		bool reorder(const EditorObject* start, const EditorObject* end);
+		// Recompute the topological order from scratch; returns false if the graph contains a loop.
+		bool sortTopologically() const;
+		bool pathExists(const EditorObject* from, const EditorObject* to, bool useOrder) const;
+
+		// mutable since the order is recomputed lazily in createsLoop
+		mutable std::unordered_map<const EditorObject*, Node> graph_;
+		mutable int64_t nextOrder_ = 0;
+		// False while the graph contains a loop or might still contain one after removing links.
+		mutable bool orderValid_ = true;
+		mutable bool orderRecomputePending_ = false;
 	};
 
 	std::string folder_;
@@ -176,6 +233,20 @@ private:
 	// Instance dictionary using object id as key for faster lookup.
 	std::unordered_map<std::string, SEditorObject> instanceMap_;
 
+	// Name index of the instances grouped by parent; top level objects use the nullptr scope.
+	// Objects are only indexed below parents which are instances themselves, so removing an instance
+	// moves its remaining children to the top level scope.
+	struct NameScope {
+		UniqueNameIndex names;
+		std::unordered_set<SEditorObject> members;
+	};
+	struct IndexedName {
+		const EditorObject* scope;
+		std::string name;
+	};
+	std::unordered_map<const EditorObject*, NameScope> nameScopes_;
+	std::unordered_map<const EditorObject*, IndexedName> indexedNames_;
+
 	// This map contains all the external project used by the current one;
 	// Keys are the project IDs
 	// Values contain the relative file paths and names of the external project files.
@@ -196,9 +267,6 @@ private:
 
 	std::vector<SLink> links_;
 	LinkGraph linkGraph_;
-
-	static inline const std::regex NAMING_PATTERN{"(.*)\\s+\\((\\d+)\\)"};
-
 };
 
 }  // namespace raco::core
\ No newline at end of file
@@ -0,0 +1,73 @@
+/*
+ * SPDX-License-Identifier: MPL-2.0
+ *
+ * This file is part of Ramses Composer
+ * (see https://github.com/GENIVI/ramses-composer).
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include "core/BinarySerialization.h"
+
+#include <QByteArray>
+
+#include <cstdint>
+#include <optional>
+#include <string>
+
+namespace raco::serialization {
+
+/**
+ * On-disk cache of loaded projects, used to skip parsing and migrating unchanged project files.
+ *
+ * Each project file has one entry in the cache directory holding the migrated document in the binary
+ * project format, which is deserialized directly without creating a JSON document. An entry is only used if the absolute path, size, modification time and SHA-1 hash of the
+ * file content as well as the project file version and the binary format version match the values
+ * recorded when the entry was stored. Entries are written atomically, so concurrent processes can share
+ * the directory. Unusable entries are ignored and overwritten by the next store.
+ *
+ * The total size of the entries is limited: when a store exceeds the limit, the least recently used entries
+ * are removed. A successful lookup marks its entry as used by updating its modification time.
+ */
+class ProjectFileCache {
+public:
+	static constexpr char ENTRY_MAGIC[] = "RCAC";
+	static constexpr uint32_t ENTRY_FORMAT_VERSION = 1;
+	static constexpr const char* ENTRY_SUFFIX = ".rcac";
+	static constexpr int64_t DEFAULT_MAX_SIZE = 256 * 1024 * 1024;
+
+	explicit ProjectFileCache(const std::string& directory, int64_t maxSize = DEFAULT_MAX_SIZE);
+
+	const std::string& directory() const;
+	// Upper limit for the total size of the entries in bytes.
+	int64_t maxSize() const;
+
+	// Path of the entry used for the project file `filePath`.
+	std::string entryPath(const std::string& filePath) const;
+
+	/**
+	 * Look up the migrated project for the project file `filePath` with content `fileData`.
+	 * @return the checked binary project or nothing if there is no valid entry.
+	 */
+	std::optional<BinaryProject> lookup(const std::string& filePath, const QByteArray& fileData) const;
+
+	/**
+	 * Store the migrated project for the project file `filePath` with content `fileData`; failures are only logged.
+	 * @param binaryProject the migrated document encoded by `toBinaryProject` or `writeBinaryProject`.
+	 */
+	bool store(const std::string& filePath, const QByteArray& fileData, const QByteArray& binaryProject) const;
+
+	// Remove the entry for the project file `filePath` if there is one.
+	void remove(const std::string& filePath) const;
+
+private:
+	// Remove the least recently used entries until the total size is within maxSize_.
+	void evict() const;
+
+	std::string directory_;
+	int64_t maxSize_;
+};
+
+}  // namespace raco::serialization
@@ -51,7 +51,8 @@ namespace raco::core {
  *     Links from Vec4f to Node::rotation are now allowed
  * 20: Added LuaScriptModule type as well as basic Lua module support
  * 21: Added mipmap flag to textures.
+ * 22: Added mesh optimization flag to meshes [user_types::Mesh].
  */
-constexpr int RAMSES_PROJECT_FILE_VERSION = 21;
+constexpr int RAMSES_PROJECT_FILE_VERSION = 22;
 QJsonDocument migrateProject(const QJsonDocument& doc, std::unordered_map<std::string, std::string>& migrationWarnings);
 }  // namespace raco::core
@@ -14,6 +14,7 @@
 #include "data_storage/Value.h"
 #include "core/CoreAnnotations.h"
 
+#include <QIODevice>
 #include <QJsonArray>
 #include <QJsonDocument>
 #include <functional>
@@ -43,6 +44,17 @@ std::string serializeObject(const SReflectionInterface& object, const std::strin
 std::string serializeObjects(const std::vector<SReflectionInterface>& objects, const std::vector<std::string>& rootObjectIDs, const std::vector<SReflectionInterface>& links, const std::string& originFolder, const std::string& originFilename, const std::string& originProjectID, const std::string& originProjectName, const std::map<std::string, ExternalProjectInfo>& externalProjectsMap, const std::map<std::string, std::string>& originFolders, const ResolveReferencedId& resolveReferenceId);
 QJsonDocument serializeProject(const std::unordered_map<std::string, std::vector<int>>& fileVersions, const std::vector<SReflectionInterface>& instances, const std::vector<SReflectionInterface>& links, const std::map<std::string, ExternalProjectInfo>& externalProjectsMap, const ResolveReferencedId& resolveReferenceId);
 
+// Text of a single instance as written by `writeProject`: the `toJson()` formatting of an element of the instances array without its indentation.
+QByteArray serializeInstanceFragment(const ReflectionInterface& object, const ResolveReferencedId& resolveReferenceId);
+using InstanceFragmentFunction = std::function<QByteArray(const SReflectionInterface& object)>;
+
+/**
+ * Writes the same text as `serializeProject(...).toJson()` to `device` while only holding one serialized instance or link in memory at a time.
+ * The instances are written using `instanceFragment` if given, which must return the same text as `serializeInstanceFragment`.
+ * @return false if writing to `device` failed.
+ */
+bool writeProject(QIODevice& device, const std::unordered_map<std::string, std::vector<int>>& fileVersions, const std::vector<SReflectionInterface>& instances, const std::vector<SReflectionInterface>& links, const std::map<std::string, ExternalProjectInfo>& externalProjectsMap, const ResolveReferencedId& resolveReferenceId, const InstanceFragmentFunction& instanceFragment = {});
+
 using UserTypeFactory = std::function<std::shared_ptr<data_storage::ReflectionInterface>(const std::string&)>;
 using AnnotationFactory = std::function<std::shared_ptr<data_storage::AnnotationBase>(const std::string&)>;
 using ValueBaseFactory = std::function<data_storage::ValueBase*(const std::string&)>;
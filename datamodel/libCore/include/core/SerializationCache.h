@@ -0,0 +1,57 @@
+/*
+ * SPDX-License-Identifier: MPL-2.0
+ *
+ * This file is part of Ramses Composer
+ * (see https://github.com/GENIVI/ramses-composer).
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include "core/Serialization.h"
+
+#include <QByteArray>
+
+#include <memory>
+#include <unordered_map>
+
+namespace raco::core {
+
+class DataChangeRecorder;
+
+/**
+ * Serialized text of the project instances from previous saves, so that saving only serializes the objects
+ * changed since then and copies the cached text of all others.
+ *
+ * The cache doesn't observe the project itself: all changes to the instances must be passed to `invalidate`
+ * before the next `instanceFragment` call. Entries of deleted objects are removed by `invalidate` too.
+ */
+class SerializationCache {
+public:
+	explicit SerializationCache(const serialization::ResolveReferencedId& resolveReferenceId);
+
+	// Same result as serialization::serializeInstanceFragment; serializes and stores the text if not cached.
+	QByteArray instanceFragment(const serialization::SReflectionInterface& object);
+
+	void invalidate(const DataChangeRecorder& changes);
+	void clear();
+
+	size_t size() const;
+
+	// Number of objects serialized because their text was not cached.
+	size_t serializedCount() const;
+
+private:
+	struct Entry {
+		// Guards against a new object allocated at the address of a deleted one.
+		std::weak_ptr<data_storage::ReflectionInterface> object;
+		QByteArray fragment;
+	};
+
+	serialization::ResolveReferencedId resolveReferenceId_;
+	std::unordered_map<const data_storage::ReflectionInterface*, Entry> entries_;
+	size_t serializedCount_ = 0;
+};
+
+}  // namespace raco::core
@@ -11,8 +11,15 @@
 
 #include "core/Project.h"
 
-#include <string>
+#include <cstdint>
 #include <functional>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+class QTemporaryFile;
 
 namespace raco::core {
 
@@ -33,7 +40,12 @@ class UndoStack {
 public:
     using Callback = std::function<void()>;
 
-    UndoStack(BaseContext *context, const Callback& onChange = []() {});
+    UndoStack(BaseContext *context, const Callback& onChange = []() {}, bool enabled = true);
+	~UndoStack();
+
+	// A disabled stack keeps no copy of the project state and ignores push and reset.
+	// Used for read-only projects which are never modified through commands.
+	bool enabled() const noexcept;
 
     // Add another undo stack entry.
 	void push(const std::string& description, std::string mergeId = std::string());
@@ -59,26 +71,107 @@ public:
 
 	void reset();
 
+	// Estimated memory in bytes used by the delta stored in a single entry.
+	size_t entryMemoryUsage(size_t index) const;
+
+	// Estimated memory in bytes used by all entries together with the project state at the current index.
+	size_t memoryUsage() const;
+
+	// Upper limit for the memory used by the entries in bytes; zero means unlimited.
+	// When the limit is exceeded after a push the oldest entries are evicted.
+	void setMemoryBudget(size_t bytes);
+	size_t memoryBudget() const;
+
+	// Entries more than this number of steps below the current index are written to a temporary file
+	// and loaded again when the index is moved back to them; zero disables spilling.
+	void setSpillDepth(size_t depth);
+	size_t spillDepth() const;
+
+	// Check if the delta of an entry is currently stored in the temporary file.
+	bool entrySpilled(size_t index) const;
+
+	// Size of the temporary file holding the spilled entries in bytes.
+	int64_t spillFileSize() const;
+
 protected:
-    void saveProjectState(const Project *src, Project *dest, Project *ref, const DataChangeRecorder &changes, UserObjectFactoryInterface &factory);
-	void updateProjectState(const Project *src, Project *dest, const DataChangeRecorder &changes, UserObjectFactoryInterface &factory);
+	struct Entry;
+	struct ValueChange;
+
+	void saveProjectState(const Project *src, UserObjectFactoryInterface &factory);
+	void saveProjectState(const Project *src, Entry &entry, const DataChangeRecorder &changes, UserObjectFactoryInterface &factory);
+	void updateProjectState(const Project *src, Entry &entry, const DataChangeRecorder &changes, UserObjectFactoryInterface &factory);
 
-    void restoreProjectState(Project *src, Project *dest, BaseContext &context, UserObjectFactoryInterface &factory);
+	void applyEntry(Entry &entry, bool redo);
+	void applyValueChange(ValueChange &change);
+
+	// Synchronize dest with src, only visiting the objects with the given IDs and the links ending on the given object IDs.
+	void restoreProjectState(Project *src, Project *dest, BaseContext &context, UserObjectFactoryInterface &factory, const std::set<std::string> &objectIDs, const std::set<std::string> &linkEndObjectIDs);
 
 	bool canMerge(const DataChangeRecorder &changes);
 
+	void evictEntries();
+
+	void spillEntries();
+	bool spillEntry(Entry &entry);
+	bool writeSpilledEntry(Entry &entry);
+	void loadSpilledEntry(Entry &entry);
+	// Drop the parts of the spill file not used by any entry anymore, e.g. after the stack has been truncated.
+	void trimSpillFile();
+
 	BaseContext* context_;
 	Callback onChange_;
 
+	// Property value inside an object of state_ changed by an entry.
+	// The value is the property value on the other side of the entry: the value before the entry if
+	// state_ is at or after the entry and the value after the entry otherwise. Applying the entry swaps the values.
+	struct ValueChange {
+		SEditorObject object;
+		std::vector<std::string> propertyPath;
+		std::unique_ptr<ValueBase> value;
+	};
+
+	// Each entry stores the delta relative to the previous entry.
+	// All objects and links referenced by the entries are objects and links of state_.
     struct Entry {
 		Entry(std::string description = std::string(), std::string mergeId = std::string());
+		size_t estimateMemoryUsage() const;
+		// Collect the IDs of all objects modified by the entry and of the end objects of all links modified by the entry.
+		void collectModifiedIDs(std::set<std::string> &objectIDs, std::set<std::string> &linkEndObjectIDs) const;
+
 		std::string description;
 		std::string mergeId;
-		Project state;
+
+		std::vector<SEditorObject> createdObjects;
+		std::vector<SEditorObject> deletedObjects;
+		std::vector<ValueChange> changedValues;
+
+		std::vector<SLink> addedLinks;
+		std::vector<SLink> removedLinks;
+		std::vector<SLink> validityChangedLinks;
+
+		// External project map on the other side of the entry; only valid if externalProjectsMapChanged is set.
+		bool externalProjectsMapChanged = false;
+		std::map<std::string, serialization::ExternalProjectInfo> externalProjectsMap;
+
+		size_t memoryUsage = 0;
+
+		// Location of the delta in the spill file; spillSize is zero if the file holds no copy of it.
+		// The location is kept when the entry is loaded again, so it is not written again when spilled again.
+		bool spilled = false;
+		int64_t spillOffset = 0;
+		int64_t spillSize = 0;
     };
 
+	// Project state at the current index.
+	Project state_;
+	bool enabled_;
+
     std::vector<std::unique_ptr<Entry>> stack_;
 	size_t index_ = 0;
+	size_t memoryBudget_ = 0;
+
+	size_t spillDepth_ = 0;
+	std::unique_ptr<QTemporaryFile> spillFile_;
 };
 
 }  // namespace raco::core
\ No newline at end of file
@@ -0,0 +1,1334 @@
+/*
+ * SPDX-License-Identifier: MPL-2.0
+ *
+ * This file is part of Ramses Composer
+ * (see https://github.com/GENIVI/ramses-composer).
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "core/BinarySerialization.h"
+
+#include "core/CoreAnnotations.h"
+#include "core/SerializationKeys.h"
+#include "data_storage/Table.h"
+#include "log_system/log.h"
+#include "utils/ParallelUtils.h"
+
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QJsonValue>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <stdexcept>
+#include <string_view>
+#include <unordered_set>
+
+namespace {
+
+using namespace raco::serialization;
+using raco::data_storage::Table;
+
+constexpr size_t MAGIC_SIZE = sizeof(BINARY_PROJECT_MAGIC) - 1;
+constexpr size_t HEADER_SIZE = MAGIC_SIZE + 1;
+constexpr size_t TRAILER_SIZE = 8;
+
+// Only corrupted files nest deeper; limits the recursion while checking the structure.
+constexpr int MAX_DEPTH = 1024;
+
+// The instances written so far are passed on to the device once this many bytes are buffered.
+constexpr size_t FLUSH_SIZE = 1 << 20;
+
+// Below this number of objects per thread, starting a thread costs more than it saves.
+constexpr size_t MIN_OBJECTS_PER_THREAD = 500;
+
+// Values of this property of the serialized objects are stored in the object ID table.
+constexpr const char* OBJECT_ID_PROPERTY = "objectID";
+
+// Integral doubles up to 2^53 are exact and are written as integers.
+constexpr double MAX_EXACT_INTEGER = 9007199254740992.0;
+
+bool isExactInteger(double value) {
+	return std::isfinite(value) && std::trunc(value) == value && std::abs(value) <= MAX_EXACT_INTEGER && !(value == 0.0 && std::signbit(value));
+}
+
+[[noreturn]] void fail(const std::string& reason) {
+	throw std::runtime_error("Invalid binary project file: " + reason);
+}
+
+uint64_t zigZag(int64_t value) {
+	return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+int64_t unZigZag(uint64_t value) {
+	return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+void appendVarint(std::string& buffer, uint64_t value) {
+	while (value >= 0x80) {
+		buffer.push_back(static_cast<char>((value & 0x7f) | 0x80));
+		value >>= 7;
+	}
+	buffer.push_back(static_cast<char>(value));
+}
+
+void appendFixed(std::string& buffer, uint64_t value) {
+	for (int byte = 0; byte < 8; byte++) {
+		buffer.push_back(static_cast<char>(value >> (8 * byte)));
+	}
+}
+
+/** Interns strings in the order they are first used. */
+class StringTable {
+public:
+	uint64_t intern(const std::string& value) {
+		auto [it, inserted] = indices_.try_emplace(value, strings_.size());
+		if (inserted) {
+			strings_.emplace_back(&it->first);
+		}
+		return it->second;
+	}
+
+	void append(std::string& buffer) const {
+		appendVarint(buffer, strings_.size());
+		for (auto string : strings_) {
+			appendVarint(buffer, string->size());
+			buffer.append(*string);
+		}
+	}
+
+private:
+	std::unordered_map<std::string, uint64_t> indices_;
+	std::vector<const std::string*> strings_;
+};
+
+/** Writes values into a buffer; the buffer can be passed on in pieces between complete values. */
+class Encoder {
+public:
+	std::string& buffer() {
+		return buffer_;
+	}
+
+	size_t position() const {
+		return buffer_.size();
+	}
+
+	// Remove everything written after `position`. Strings interned in the meantime stay in the tables.
+	void rollback(size_t position) {
+		buffer_.resize(position);
+	}
+
+	void writeNull() {
+		writeTag(BinaryTag::Null);
+	}
+
+	void writeBool(bool value) {
+		writeTag(value ? BinaryTag::True : BinaryTag::False);
+	}
+
+	void writeInt(int64_t value) {
+		writeTag(BinaryTag::Int);
+		appendVarint(buffer_, zigZag(value));
+	}
+
+	void writeDouble(double value) {
+		if (isExactInteger(value)) {
+			writeInt(static_cast<int64_t>(value));
+		} else {
+			uint64_t bits;
+			std::memcpy(&bits, &value, sizeof(bits));
+			writeTag(BinaryTag::Double);
+			appendFixed(buffer_, bits);
+		}
+	}
+
+	void writeString(std::string_view value) {
+		writeTag(BinaryTag::String);
+		appendVarint(buffer_, value.size());
+		buffer_.append(value.data(), value.size());
+	}
+
+	void writeName(const std::string& name) {
+		writeTag(BinaryTag::Name);
+		appendVarint(buffer_, names_.intern(name));
+	}
+
+	void writeId(const std::string& id) {
+		writeTag(BinaryTag::Id);
+		appendVarint(buffer_, ids_.intern(id));
+	}
+
+	void beginArray() {
+		writeTag(BinaryTag::Array);
+	}
+
+	void endArray() {
+		writeTag(BinaryTag::End);
+	}
+
+	void beginObject() {
+		writeTag(BinaryTag::Object);
+	}
+
+	void writeKey(const std::string& name) {
+		appendVarint(buffer_, names_.intern(name) + 1);
+	}
+
+	void endObject() {
+		appendVarint(buffer_, 0);
+	}
+
+	// The tables and the trailer, to be written after the document root which ends at file offset `tableOffset`.
+	std::string tables(uint64_t tableOffset) const {
+		std::string result;
+		names_.append(result);
+		ids_.append(result);
+		appendFixed(result, tableOffset);
+		return result;
+	}
+
+private:
+	void writeTag(BinaryTag tag) {
+		buffer_.push_back(static_cast<char>(tag));
+	}
+
+	std::string buffer_;
+	StringTable names_;
+	StringTable ids_;
+};
+
+class Decoder {
+public:
+	Decoder(const char* data, size_t begin, size_t end) : data_(data), position_(begin), end_(end) {
+	}
+
+	size_t position() const {
+		return position_;
+	}
+
+	bool atEnd() const {
+		return position_ == end_;
+	}
+
+	size_t remaining() const {
+		return end_ - position_;
+	}
+
+	uint8_t peekByte() const {
+		if (position_ >= end_) {
+			fail("unexpected end of data");
+		}
+		return static_cast<uint8_t>(data_[position_]);
+	}
+
+	uint8_t readByte() {
+		auto byte = peekByte();
+		++position_;
+		return byte;
+	}
+
+	BinaryTag readTag() {
+		auto tag = readByte();
+		if (tag > static_cast<uint8_t>(BinaryTag::End)) {
+			fail("unknown value tag " + std::to_string(tag));
+		}
+		return static_cast<BinaryTag>(tag);
+	}
+
+	uint64_t readVarint() {
+		uint64_t result = 0;
+		for (int shift = 0; shift < 64; shift += 7) {
+			auto byte = readByte();
+			result |= static_cast<uint64_t>(byte & 0x7f) << shift;
+			if ((byte & 0x80) == 0) {
+				return result;
+			}
+		}
+		fail("invalid number");
+	}
+
+	uint64_t readFixed() {
+		auto bytes = readBytes(8);
+		uint64_t result = 0;
+		for (int byte = 0; byte < 8; byte++) {
+			result |= static_cast<uint64_t>(static_cast<uint8_t>(bytes[byte])) << (8 * byte);
+		}
+		return result;
+	}
+
+	double readDouble() {
+		auto bits = readFixed();
+		double value;
+		std::memcpy(&value, &bits, sizeof(value));
+		return value;
+	}
+
+	std::string_view readBytes(uint64_t count) {
+		if (count > end_ - position_) {
+			fail("unexpected end of data");
+		}
+		std::string_view result{data_ + position_, static_cast<size_t>(count)};
+		position_ += static_cast<size_t>(count);
+		return result;
+	}
+
+	uint64_t readIndex(size_t tableSize) {
+		auto index = readVarint();
+		if (index >= tableSize) {
+			fail("invalid table index");
+		}
+		return index;
+	}
+
+	// Returns 0 at the end of the object.
+	uint64_t readKey(size_t nameCount) {
+		auto key = readVarint();
+		if (key > nameCount) {
+			fail("invalid table index");
+		}
+		return key;
+	}
+
+private:
+	const char* data_;
+	size_t position_;
+	size_t end_;
+};
+
+void readStringTable(Decoder& decoder, std::vector<std::string>& strings) {
+	auto count = decoder.readVarint();
+	// Every string takes at least one byte; a larger count can only come from corrupted data.
+	if (count > decoder.remaining()) {
+		fail("invalid table size");
+	}
+	strings.reserve(static_cast<size_t>(count));
+	for (uint64_t index = 0; index < count; index++) {
+		auto string = decoder.readBytes(decoder.readVarint());
+		strings.emplace_back(string);
+	}
+}
+
+void checkValue(Decoder& decoder, size_t nameCount, size_t idCount, int depth) {
+	if (depth > MAX_DEPTH) {
+		fail("values nested too deep");
+	}
+	switch (decoder.readTag()) {
+		case BinaryTag::Null:
+		case BinaryTag::False:
+		case BinaryTag::True:
+			break;
+		case BinaryTag::Int:
+			decoder.readVarint();
+			break;
+		case BinaryTag::Double:
+			decoder.readFixed();
+			break;
+		case BinaryTag::String:
+			decoder.readBytes(decoder.readVarint());
+			break;
+		case BinaryTag::Name:
+			decoder.readIndex(nameCount);
+			break;
+		case BinaryTag::Id:
+			decoder.readIndex(idCount);
+			break;
+		case BinaryTag::Array:
+			while (decoder.peekByte() != static_cast<uint8_t>(BinaryTag::End)) {
+				checkValue(decoder, nameCount, idCount, depth + 1);
+			}
+			decoder.readByte();
+			break;
+		case BinaryTag::Object:
+			while (decoder.readKey(nameCount) != 0) {
+				checkValue(decoder, nameCount, idCount, depth + 1);
+			}
+			break;
+		case BinaryTag::End:
+			fail("unexpected end of array");
+	}
+}
+
+// Skips a value checked by `checkValue` before.
+void skipValue(Decoder& decoder) {
+	switch (decoder.readTag()) {
+		case BinaryTag::Int:
+		case BinaryTag::Name:
+		case BinaryTag::Id:
+			decoder.readVarint();
+			break;
+		case BinaryTag::Double:
+			decoder.readFixed();
+			break;
+		case BinaryTag::String:
+			decoder.readBytes(decoder.readVarint());
+			break;
+		case BinaryTag::Array:
+			while (decoder.peekByte() != static_cast<uint8_t>(BinaryTag::End)) {
+				skipValue(decoder);
+			}
+			decoder.readByte();
+			break;
+		case BinaryTag::Object:
+			while (decoder.readVarint() != 0) {
+				skipValue(decoder);
+			}
+			break;
+		default:
+			break;
+	}
+}
+
+// Tables of a binary project and the name indices of the keys used by the deserialization; 0 if a key is not used.
+struct Tables {
+	Tables(const std::vector<std::string>& names, const std::unordered_map<std::string, uint32_t>& nameIndices, const std::vector<std::string>& ids)
+		: names(names), nameIndices(nameIndices), ids(ids) {
+	}
+
+	uint64_t key(const std::string& name) const {
+		auto it = nameIndices.find(name);
+		return it != nameIndices.end() ? it->second + 1 : 0;
+	}
+
+	const std::vector<std::string>& names;
+	const std::unordered_map<std::string, uint32_t>& nameIndices;
+	const std::vector<std::string>& ids;
+
+	const uint64_t typeNameKey{key(keys::TYPENAME)};
+	const uint64_t propertiesKey{key(keys::PROPERTIES)};
+	const uint64_t annotationsKey{key(keys::ANNOTATIONS)};
+	const uint64_t orderKey{key(keys::ORDER)};
+	const uint64_t valueKey{key(keys::VALUE)};
+};
+
+QJsonValue decodeJson(Decoder& decoder, const Tables& tables) {
+	switch (decoder.readTag()) {
+		case BinaryTag::False:
+			return false;
+		case BinaryTag::True:
+			return true;
+		case BinaryTag::Int:
+			return static_cast<qint64>(unZigZag(decoder.readVarint()));
+		case BinaryTag::Double:
+			return decoder.readDouble();
+		case BinaryTag::String: {
+			auto bytes = decoder.readBytes(decoder.readVarint());
+			return QString::fromUtf8(bytes.data(), static_cast<int>(bytes.size()));
+		}
+		case BinaryTag::Name:
+			return QString::fromStdString(tables.names[decoder.readIndex(tables.names.size())]);
+		case BinaryTag::Id:
+			return QString::fromStdString(tables.ids[decoder.readIndex(tables.ids.size())]);
+		case BinaryTag::Array: {
+			QJsonArray array;
+			while (decoder.peekByte() != static_cast<uint8_t>(BinaryTag::End)) {
+				array.append(decodeJson(decoder, tables));
+			}
+			decoder.readByte();
+			return array;
+		}
+		case BinaryTag::Object: {
+			QJsonObject object;
+			while (auto key = decoder.readKey(tables.names.size())) {
+				object.insert(QString::fromStdString(tables.names[key - 1]), decodeJson(decoder, tables));
+			}
+			return object;
+		}
+		default:
+			return QJsonValue::Null;
+	}
+}
+
+enum class StringKind {
+	Plain,
+	Name,
+	NameArray
+};
+
+void collectObjectIDs(const QJsonValue& value, std::unordered_set<std::string>& ids) {
+	if (value.isArray()) {
+		for (const auto& element : value.toArray()) {
+			collectObjectIDs(element, ids);
+		}
+	} else if (value.isObject()) {
+		const auto object = value.toObject();
+		for (auto it = object.begin(); it != object.end(); ++it) {
+			if (it.key() == OBJECT_ID_PROPERTY && it.value().isString()) {
+				ids.insert(it.value().toString().toStdString());
+			} else {
+				collectObjectIDs(it.value(), ids);
+			}
+		}
+	}
+}
+
+void encodeJson(Encoder& encoder, const QJsonValue& value, const std::unordered_set<std::string>& ids, StringKind kind) {
+	switch (value.type()) {
+		case QJsonValue::Bool:
+			encoder.writeBool(value.toBool());
+			break;
+		case QJsonValue::Double:
+			encoder.writeDouble(value.toDouble());
+			break;
+		case QJsonValue::String: {
+			auto string = value.toString().toStdString();
+			if (kind == StringKind::Name) {
+				encoder.writeName(string);
+			} else if (ids.find(string) != ids.end()) {
+				encoder.writeId(string);
+			} else {
+				encoder.writeString(string);
+			}
+			break;
+		}
+		case QJsonValue::Array:
+			encoder.beginArray();
+			for (const auto& element : value.toArray()) {
+				encodeJson(encoder, element, ids, kind == StringKind::NameArray ? StringKind::Name : StringKind::Plain);
+			}
+			encoder.endArray();
+			break;
+		case QJsonValue::Object: {
+			const auto object = value.toObject();
+			encoder.beginObject();
+			for (auto it = object.begin(); it != object.end(); ++it) {
+				encoder.writeKey(it.key().toStdString());
+				auto memberKind = it.key() == keys::TYPENAME ? StringKind::Name : (it.key() == keys::ORDER ? StringKind::NameArray : StringKind::Plain);
+				encodeJson(encoder, it.value(), ids, memberKind);
+			}
+			encoder.endObject();
+			break;
+		}
+		default:
+			encoder.writeNull();
+			break;
+	}
+}
+
+QByteArray header() {
+	QByteArray result;
+	result.append(BINARY_PROJECT_MAGIC, static_cast<int>(MAGIC_SIZE));
+	result.append(static_cast<char>(BINARY_PROJECT_FORMAT_VERSION));
+	return result;
+}
+
+// Writing objects: the functions below write the same values as the corresponding JSON functions in Serialization.cpp.
+
+bool writeValueBase(Encoder& encoder, const ValueBase& value, const ResolveReferencedId& resolveReferenceId, bool dynamicallyTyped);
+void writeTypedObject(Encoder& encoder, const ReflectionInterface& object, const ResolveReferencedId& resolveReferenceId);
+
+void writePrimitiveValue(Encoder& encoder, const ValueBase& value, const ResolveReferencedId& resolveReferenceId, bool isObjectID) {
+	switch (value.type()) {
+		case PrimitiveType::Bool:
+			encoder.writeBool(value.asBool());
+			break;
+		case PrimitiveType::Double:
+			encoder.writeDouble(value.asDouble());
+			break;
+		case PrimitiveType::Int:
+			encoder.writeInt(value.asInt());
+			break;
+		case PrimitiveType::String:
+			if (isObjectID) {
+				encoder.writeId(value.asString());
+			} else {
+				encoder.writeString(value.asString());
+			}
+			break;
+		case PrimitiveType::Ref:
+			if (const auto id{resolveReferenceId(value)}) {
+				encoder.writeId(id.value());
+			} else {
+				encoder.writeNull();
+			}
+			break;
+		default:
+			encoder.writeNull();
+			break;
+	}
+}
+
+// Like `serializeArrayProperties`; returns false if the JSON function returns no array.
+bool writeArrayProperties(Encoder& encoder, const ReflectionInterface& arrayInterface, const ResolveReferencedId& resolveReferenceId, bool dynamicallyTyped) {
+	encoder.beginArray();
+	size_t count = 0;
+	for (size_t i{0}; i < arrayInterface.size(); i++) {
+		auto start = encoder.position();
+		if (writeValueBase(encoder, *arrayInterface.get(i), resolveReferenceId, dynamicallyTyped)) {
+			++count;
+		} else {
+			encoder.rollback(start);
+		}
+	}
+	encoder.endArray();
+	return count > 0;
+}
+
+// Like `serializeObjectProperties`; returns false if the JSON function returns no object.
+bool writeObjectProperties(Encoder& encoder, const ReflectionInterface& objectInterface, const ResolveReferencedId& resolveReferenceId, bool dynamicallyTyped, bool typedObject = false) {
+	encoder.beginObject();
+	size_t count = 0;
+	for (size_t i{0}; i < objectInterface.size(); i++) {
+		const auto& name = objectInterface.name(i);
+		const auto& property = *objectInterface.get(i);
+		auto start = encoder.position();
+		encoder.writeKey(name);
+		bool written = true;
+		if (typedObject && name == OBJECT_ID_PROPERTY && property.type() == PrimitiveType::String) {
+			writePrimitiveValue(encoder, property, resolveReferenceId, true);
+		} else {
+			written = writeValueBase(encoder, property, resolveReferenceId, dynamicallyTyped);
+		}
+		if (written) {
+			++count;
+		} else {
+			encoder.rollback(start);
+		}
+	}
+	encoder.endObject();
+	return count > 0;
+}
+
+// Like `serializeValueBase`; returns false if the JSON function returns no value.
+bool writeValueBase(Encoder& encoder, const ValueBase& value, const ResolveReferencedId& resolveReferenceId, bool dynamicallyTyped) {
+	bool childrenDynamicallyTyped{value.type() == PrimitiveType::Table};
+	bool valueIsClassType{hasTypeSubstructure(value.type())};
+	const auto& annotations{value.baseAnnotationPtrs()};
+	bool hasAnnotations = std::any_of(annotations.begin(), annotations.end(), [dynamicallyTyped](auto anno) {
+		return anno->serializationRequired() || dynamicallyTyped;
+	});
+	if (dynamicallyTyped || hasAnnotations || childrenDynamicallyTyped) {
+		encoder.beginObject();
+		size_t count = 0;
+		if (dynamicallyTyped) {
+			encoder.writeKey(keys::TYPENAME);
+			encoder.writeName(value.typeName());
+			++count;
+		}
+		if (valueIsClassType) {
+			auto start = encoder.position();
+			encoder.writeKey(keys::PROPERTIES);
+			if (value.query<raco::core::ArraySemanticAnnotation>()) {
+				if (writeArrayProperties(encoder, value.getSubstructure(), resolveReferenceId, childrenDynamicallyTyped)) {
+					++count;
+				} else {
+					encoder.rollback(start);
+				}
+			} else if (writeObjectProperties(encoder, value.getSubstructure(), resolveReferenceId, childrenDynamicallyTyped)) {
+				++count;
+				if (childrenDynamicallyTyped) {
+					encoder.writeKey(keys::ORDER);
+					encoder.beginArray();
+					for (size_t i{0}; i < value.getSubstructure().size(); i++) {
+						encoder.writeName(value.getSubstructure().name(i));
+					}
+					encoder.endArray();
+				}
+			} else {
+				encoder.rollback(start);
+			}
+		} else {
+			encoder.writeKey(keys::VALUE);
+			writePrimitiveValue(encoder, value, resolveReferenceId, false);
+			++count;
+		}
+		if (hasAnnotations) {
+			encoder.writeKey(keys::ANNOTATIONS);
+			encoder.beginArray();
+			for (auto anno : annotations) {
+				if (anno->serializationRequired() || dynamicallyTyped) {
+					writeTypedObject(encoder, *anno, resolveReferenceId);
+				}
+			}
+			encoder.endArray();
+			++count;
+		}
+		encoder.endObject();
+		return count > 0;
+	} else if (valueIsClassType) {
+		if (value.query<raco::core::ArraySemanticAnnotation>()) {
+			return writeArrayProperties(encoder, value.getSubstructure(), resolveReferenceId, false);
+		} else {
+			return writeObjectProperties(encoder, value.getSubstructure(), resolveReferenceId, false);
+		}
+	} else {
+		writePrimitiveValue(encoder, value, resolveReferenceId, false);
+		return true;
+	}
+}
+
+// Like `serializeTypedObject`.
+void writeTypedObject(Encoder& encoder, const ReflectionInterface& object, const ResolveReferencedId& resolveReferenceId) {
+	encoder.beginObject();
+	encoder.writeKey(keys::TYPENAME);
+	encoder.writeName(object.serializationTypeName());
+
+	auto cwrm = dynamic_cast<const ClassWithReflectedMembers*>(&object);
+	if (cwrm && !cwrm->annotations().empty()) {
+		encoder.writeKey(keys::ANNOTATIONS);
+		encoder.beginArray();
+		for (const auto& anno : cwrm->annotations()) {
+			writeTypedObject(encoder, *anno, resolveReferenceId);
+		}
+		encoder.endArray();
+	}
+
+	auto start = encoder.position();
+	encoder.writeKey(keys::PROPERTIES);
+	if (!writeObjectProperties(encoder, object, resolveReferenceId, false, true)) {
+		encoder.rollback(start);
+	}
+	encoder.endObject();
+}
+
+void writeVersion(Encoder& encoder, const char* key, const std::vector<int>& version) {
+	encoder.writeKey(key);
+	encoder.beginArray();
+	for (size_t i = 0; i < 3; i++) {
+		encoder.writeInt(version[i]);
+	}
+	encoder.endArray();
+}
+
+// Reading objects: a subtree of values is decoded into an array of nodes first, which allows the lookup of object
+// members by key like in a QJsonObject.
+
+struct Node {
+	BinaryTag tag;
+	// Name index + 1 of object members, 0 otherwise.
+	uint32_t key = 0;
+	// Index after the last node of the subtree.
+	uint32_t end = 0;
+	// Byte count of strings.
+	uint32_t size = 0;
+	union {
+		int64_t integer;
+		double number;
+		// File offset of strings, table index of names and object IDs.
+		uint64_t offset;
+	};
+};
+
+class ValueTree {
+public:
+	ValueTree(const char* data, const Tables& tables) : data_(data), tables_(tables) {
+	}
+
+	void decode(Decoder& decoder) {
+		nodes_.clear();
+		add(decoder, 0);
+	}
+
+	const Node& node(uint32_t index) const {
+		return nodes_[index];
+	}
+
+	const Tables& tables() const {
+		return tables_;
+	}
+
+	std::string string(const Node& node) const {
+		switch (node.tag) {
+			case BinaryTag::String:
+				return std::string(data_ + node.offset, node.size);
+			case BinaryTag::Name:
+				return tables_.names[node.offset];
+			case BinaryTag::Id:
+				return tables_.ids[node.offset];
+			default:
+				return std::string();
+		}
+	}
+
+private:
+	void add(Decoder& decoder, uint64_t key) {
+		auto index = nodes_.size();
+		auto& node = nodes_.emplace_back();
+		node.tag = decoder.readTag();
+		node.key = static_cast<uint32_t>(key);
+		node.integer = 0;
+		switch (node.tag) {
+			case BinaryTag::Int:
+				node.integer = unZigZag(decoder.readVarint());
+				break;
+			case BinaryTag::Double:
+				node.number = decoder.readDouble();
+				break;
+			case BinaryTag::String: {
+				auto size = decoder.readVarint();
+				node.offset = decoder.position();
+				node.size = static_cast<uint32_t>(decoder.readBytes(size).size());
+				break;
+			}
+			case BinaryTag::Name:
+				node.offset = decoder.readIndex(tables_.names.size());
+				break;
+			case BinaryTag::Id:
+				node.offset = decoder.readIndex(tables_.ids.size());
+				break;
+			case BinaryTag::Array:
+				while (decoder.peekByte() != static_cast<uint8_t>(BinaryTag::End)) {
+					add(decoder, 0);
+				}
+				decoder.readByte();
+				break;
+			case BinaryTag::Object:
+				while (auto memberKey = decoder.readKey(tables_.names.size())) {
+					add(decoder, memberKey);
+				}
+				break;
+			default:
+				break;
+		}
+		// `node` may be invalidated by adding the children.
+		nodes_[index].end = static_cast<uint32_t>(nodes_.size());
+	}
+
+	const char* data_;
+	const Tables& tables_;
+	std::vector<Node> nodes_;
+};
+
+/** A value of a ValueTree, with the conversions of QJsonValue. A missing value behaves like an undefined QJsonValue. */
+class Value {
+public:
+	Value() = default;
+	Value(const ValueTree* tree, uint32_t index) : tree_(tree), index_(index) {
+	}
+
+	bool exists() const {
+		return tree_ != nullptr;
+	}
+
+	bool isNull() const {
+		return exists() && node().tag == BinaryTag::Null;
+	}
+
+	bool isArray() const {
+		return exists() && node().tag == BinaryTag::Array;
+	}
+
+	bool isObject() const {
+		return exists() && node().tag == BinaryTag::Object;
+	}
+
+	// Like QJsonValue::toArray/toObject: other values become empty arrays/objects.
+	Value toArray() const {
+		return isArray() ? *this : Value{};
+	}
+
+	Value toObject() const {
+		return isObject() ? *this : Value{};
+	}
+
+	// Calls `function` for the elements of an array or the members of an object.
+	template <typename Function>
+	void forEach(Function&& function) const {
+		if (isArray() || isObject()) {
+			for (uint32_t child = index_ + 1; child < node().end; child = tree_->node(child).end) {
+				function(Value{tree_, child});
+			}
+		}
+	}
+
+	size_t size() const {
+		size_t count = 0;
+		forEach([&count](Value) { ++count; });
+		return count;
+	}
+
+	Value at(size_t index) const {
+		Value result;
+		size_t current = 0;
+		forEach([&result, &current, index](Value element) {
+			if (current++ == index) {
+				result = element;
+			}
+		});
+		return result;
+	}
+
+	// Member of an object by name index + 1 as returned by `Tables::key`.
+	Value member(uint64_t key) const {
+		Value result;
+		if (key != 0 && isObject()) {
+			for (uint32_t child = index_ + 1; child < node().end; child = tree_->node(child).end) {
+				if (tree_->node(child).key == key) {
+					return Value{tree_, child};
+				}
+			}
+		}
+		return result;
+	}
+
+	// Member by one of the keys of `Tables`, e.g. `&Tables::typeNameKey`.
+	Value member(const uint64_t Tables::*key) const {
+		return exists() ? member(tree_->tables().*key) : Value{};
+	}
+
+	Value member(const std::string& name) const {
+		return exists() ? member(tree_->tables().key(name)) : Value{};
+	}
+
+	// Name of an object member.
+	const std::string& name() const {
+		return tree_->tables().names[node().key - 1];
+	}
+
+	bool toBool() const {
+		return exists() && node().tag == BinaryTag::True;
+	}
+
+	double toDouble() const {
+		if (exists() && node().tag == BinaryTag::Int) {
+			return static_cast<double>(node().integer);
+		} else if (exists() && node().tag == BinaryTag::Double) {
+			return node().number;
+		}
+		return 0.0;
+	}
+
+	int toInt() const {
+		if (exists() && node().tag == BinaryTag::Int) {
+			auto value = node().integer;
+			return value >= std::numeric_limits<int>::min() && value <= std::numeric_limits<int>::max() ? static_cast<int>(value) : 0;
+		} else if (exists() && node().tag == BinaryTag::Double) {
+			auto value = node().number;
+			return value >= std::numeric_limits<int>::min() && value <= std::numeric_limits<int>::max() && static_cast<int>(value) == value ? static_cast<int>(value) : 0;
+		}
+		return 0;
+	}
+
+	std::string toString() const {
+		return exists() ? tree_->string(node()) : std::string();
+	}
+
+private:
+	const Node& node() const {
+		return tree_->node(index_);
+	}
+
+	const ValueTree* tree_ = nullptr;
+	uint32_t index_ = 0;
+};
+
+// The functions below read the values like the corresponding JSON functions in Serialization.cpp.
+
+void deserializeObjectProperties(Value properties, ReflectionInterface& objectInterface, References& references, const DeserializationFactory& factory, bool dynamicallyTyped);
+void deserializeArrayProperties(Value properties, ReflectionInterface& arrayInterface, References& references, const DeserializationFactory& factory, bool dynamicallyTyped);
+
+void deserializePrimitiveValue(Value jsonValue, ValueBase& value, References& references) {
+	switch (value.type()) {
+		case PrimitiveType::Bool:
+			value = jsonValue.toBool();
+			break;
+		case PrimitiveType::Double:
+			value = jsonValue.toDouble();
+			break;
+		case PrimitiveType::Int:
+			value = jsonValue.toInt();
+			break;
+		case PrimitiveType::String:
+			value = jsonValue.toString();
+			break;
+		case PrimitiveType::Ref:
+			if (!jsonValue.isNull()) {
+				references[&value] = jsonValue.toString();
+			}
+			break;
+		default:
+			break;
+	}
+}
+
+void deserializeAnnotations(Value annotations, const ValueBase& value, References& references, const DeserializationFactory& factory) {
+	annotations.forEach([&value, &references, &factory](Value annotation) {
+		auto typeName = annotation.toObject().member(&Tables::typeNameKey).toString();
+		auto it = std::find_if(value.baseAnnotationPtrs().begin(), value.baseAnnotationPtrs().end(), [&typeName](const raco::data_storage::AnnotationBase* annoBase) {
+			return annoBase->getTypeDescription().typeName == typeName;
+		});
+		if (it != value.baseAnnotationPtrs().end()) {
+			deserializeObjectProperties(annotation.toObject().member(&Tables::propertiesKey).toObject(), **it, references, factory, false);
+		}
+	});
+}
+
+void deserializeObjectAnnotations(Value annotations, ClassWithReflectedMembers* object, References& references, const DeserializationFactory& factory) {
+	annotations.forEach([object, &references, &factory](Value annotation) {
+		auto jsonObject = annotation.toObject();
+		auto anno{factory.createAnnotation(jsonObject.member(&Tables::typeNameKey).toString())};
+		deserializeObjectProperties(jsonObject.member(&Tables::propertiesKey).toObject(), *anno.get(), references, factory, false);
+		object->addAnnotation(anno);
+	});
+}
+
+void createMissingProperties(Value order, Value jsonObject, Table& table, const DeserializationFactory& factory) {
+	order.forEach([&jsonObject, &table, &factory](Value qPropertyName) {
+		const std::string propertyName{qPropertyName.toString()};
+		if (!table.hasProperty(propertyName)) {
+			const std::string typeName{jsonObject.member(propertyName).toObject().member(&Tables::typeNameKey).toString()};
+			if (raco::data_storage::isPrimitiveTypeName(typeName)) {
+				table.addProperty(propertyName, raco::data_storage::toPrimitiveType(typeName));
+			} else {
+				table.addProperty(propertyName, factory.createValueBase(typeName));
+			}
+		}
+	});
+}
+
+void createMissingProperties(Value jsonArray, Table& table, const DeserializationFactory& factory) {
+	size_t i{0};
+	jsonArray.forEach([&i, &table, &factory](Value element) {
+		if (!table[i]) {
+			const std::string typeName{element.toObject().member(&Tables::typeNameKey).toString()};
+			if (raco::data_storage::isPrimitiveTypeName(typeName)) {
+				table.addProperty(raco::data_storage::toPrimitiveType(typeName));
+			} else {
+				table.addProperty(factory.createValueBase(typeName));
+			}
+		}
+		++i;
+	});
+}
+
+void deserializeValueBase(Value property, ValueBase& value, References& references, const DeserializationFactory& factory, bool dynamicallyTyped = false) {
+	bool childrenDynamicallyTyped{value.type() == PrimitiveType::Table};
+	auto valueIsClassType{hasTypeSubstructure(value.type())};
+	auto propertyAsObject{property.toObject()};
+	auto hasAnnotations{propertyAsObject.member(&Tables::annotationsKey).exists()};
+
+	if (dynamicallyTyped || hasAnnotations || childrenDynamicallyTyped) {
+		auto properties = propertyAsObject.member(&Tables::propertiesKey);
+		if (valueIsClassType) {
+			if (properties.isArray()) {
+				if (value.type() == PrimitiveType::Table) {
+					createMissingProperties(properties, value.asTable(), factory);
+				}
+				deserializeArrayProperties(properties, value.getSubstructure(), references, factory, childrenDynamicallyTyped);
+			} else {
+				if (value.type() == PrimitiveType::Table) {
+					createMissingProperties(propertyAsObject.member(&Tables::orderKey).toArray(), properties.toObject(), value.asTable(), factory);
+				}
+				deserializeObjectProperties(properties.toObject(), value.getSubstructure(), references, factory, childrenDynamicallyTyped);
+			}
+		} else {
+			deserializePrimitiveValue(propertyAsObject.member(&Tables::valueKey), value, references);
+		}
+		if (hasAnnotations) {
+			deserializeAnnotations(propertyAsObject.member(&Tables::annotationsKey).toArray(), value, references, factory);
+		}
+	} else if (valueIsClassType) {
+		if (property.isArray()) {
+			deserializeArrayProperties(property, value.getSubstructure(), references, factory, false);
+		} else {
+			deserializeObjectProperties(property.toObject(), value.getSubstructure(), references, factory, false);
+		}
+	} else {
+		deserializePrimitiveValue(property, value, references);
+	}
+}
+
+void deserializeArrayProperties(Value properties, ReflectionInterface& arrayInterface, References& references, const DeserializationFactory& factory, bool dynamicallyTyped) {
+	size_t i{0};
+	properties.forEach([&](Value element) {
+		if (auto value = arrayInterface.get(i++)) {
+			deserializeValueBase(element.toObject(), *value, references, factory, dynamicallyTyped);
+		}
+	});
+}
+
+void deserializeObjectProperties(Value properties, ReflectionInterface& objectInterface, References& references, const DeserializationFactory& factory, bool dynamicallyTyped) {
+	properties.forEach([&](Value property) {
+		const auto& name = property.name();
+		if (auto value = objectInterface.get(name)) {
+			deserializeValueBase(property, *value, references, factory, dynamicallyTyped);
+		} else {
+			LOG_WARNING(raco::log_system::DESERIALIZATION, "Dropping unsupported or deprecated property {}", name);
+		}
+	});
+}
+
+SReflectionInterface deserializeTypedObject(Value jsonObject, const DeserializationFactory& factory, References& references) {
+	auto object{factory.createUserType(jsonObject.member(&Tables::typeNameKey).toString())};
+
+	auto annotations = jsonObject.member(&Tables::annotationsKey);
+	if (annotations.exists()) {
+		deserializeObjectAnnotations(annotations.toArray(),
+			std::dynamic_pointer_cast<raco::data_storage::ClassWithReflectedMembers>(object).get(),
+			references, factory);
+	}
+
+	deserializeObjectProperties(jsonObject.member(&Tables::propertiesKey).toObject(), *object.get(), references, factory, false);
+	return object;
+}
+
+// Like `deserializeVersionNumberArray`.
+DeserializedVersion deserializeVersionNumberArray(Value version, const char* whichVersion) {
+	std::array<int, 3> versionNums{ProjectDeserializationInfo::NO_VERSION, ProjectDeserializationInfo::NO_VERSION, ProjectDeserializationInfo::NO_VERSION};
+
+	if (!version.exists()) {
+		LOG_WARNING(raco::log_system::DESERIALIZATION, "{} version is not saved in project file", whichVersion);
+	} else {
+		auto deserializedVersionNums = version.toArray();
+		auto size = deserializedVersionNums.size();
+		if (size < 3) {
+			LOG_WARNING(raco::log_system::DESERIALIZATION, "{} version has not been saved correctly in project file - not enough version values", whichVersion);
+		} else if (size > 3) {
+			LOG_WARNING(raco::log_system::DESERIALIZATION, "{} version has not been saved correctly in project file - too many version values", whichVersion);
+		}
+
+		for (size_t i = 0; i < std::min(size, versionNums.size()); ++i) {
+			versionNums[i] = deserializedVersionNums.at(i).toInt();
+		}
+	}
+
+	LOG_INFO(raco::log_system::DESERIALIZATION, "{} version from project file is {}.{}.{}", whichVersion, versionNums[0], versionNums[1], versionNums[2]);
+	return DeserializedVersion{versionNums[0], versionNums[1], versionNums[2]};
+}
+
+}  // namespace
+
+namespace raco::serialization {
+
+bool isBinaryProject(const QByteArray& data) {
+	return data.size() >= static_cast<int>(MAGIC_SIZE) && std::memcmp(data.constData(), BINARY_PROJECT_MAGIC, MAGIC_SIZE) == 0;
+}
+
+bool writeBinaryProject(QIODevice& device, const std::unordered_map<std::string, std::vector<int>>& fileVersions, const std::vector<SReflectionInterface>& instances, const std::vector<SReflectionInterface>& links,
+	const std::map<std::string, ExternalProjectInfo>& externalProjectsMap,
+	const ResolveReferencedId& resolveReferenceId) {
+	Encoder encoder;
+	uint64_t written = HEADER_SIZE;
+	bool success = device.write(header()) != -1;
+	auto flush = [&device, &encoder, &written, &success]() {
+		auto& buffer = encoder.buffer();
+		success = success && device.write(buffer.data(), static_cast<qint64>(buffer.size())) != -1;
+		written += buffer.size();
+		buffer.clear();
+	};
+
+	encoder.beginObject();
+	encoder.writeKey(keys::FILE_VERSION);
+	encoder.writeInt(fileVersions.at(keys::FILE_VERSION)[0]);
+	writeVersion(encoder, keys::RAMSES_VERSION, fileVersions.at(keys::RAMSES_VERSION));
+	writeVersion(encoder, keys::RAMSES_LOGIC_ENGINE_VERSION, fileVersions.at(keys::RAMSES_LOGIC_ENGINE_VERSION));
+	writeVersion(encoder, keys::RAMSES_COMPOSER_VERSION, fileVersions.at(keys::RAMSES_COMPOSER_VERSION));
+
+	encoder.writeKey(keys::EXTERNAL_PROJECTS);
+	encoder.beginObject();
+	for (const auto& [id, info] : externalProjectsMap) {
+		encoder.writeKey(id);
+		encoder.beginObject();
+		encoder.writeKey(keys::EXTERNAL_PROJECT_PATH);
+		encoder.writeString(info.path);
+		encoder.writeKey(keys::EXTERNAL_PROJECT_NAME);
+		encoder.writeString(info.name);
+		encoder.endObject();
+	}
+	encoder.endObject();
+
+	for (const auto& [key, objects] : {std::make_pair(keys::INSTANCES, &instances), std::make_pair(keys::LINKS, &links)}) {
+		encoder.writeKey(key);
+		encoder.beginArray();
+		for (const auto& object : *objects) {
+			writeTypedObject(encoder, *object, resolveReferenceId);
+			if (encoder.position() >= FLUSH_SIZE) {
+				flush();
+			}
+		}
+		encoder.endArray();
+	}
+	encoder.endObject();
+	flush();
+
+	auto tables = encoder.tables(written);
+	return success && device.write(tables.data(), static_cast<qint64>(tables.size())) != -1;
+}
+
+QByteArray toBinaryProject(const QJsonDocument& document) {
+	QJsonValue root = document.isArray() ? QJsonValue{document.array()} : (document.isObject() ? QJsonValue{document.object()} : QJsonValue{});
+	std::unordered_set<std::string> ids;
+	collectObjectIDs(root, ids);
+
+	Encoder encoder;
+	encodeJson(encoder, root, ids, StringKind::Plain);
+
+	auto result = header();
+	const auto& body = encoder.buffer();
+	result.append(body.data(), static_cast<int>(body.size()));
+	auto tables = encoder.tables(HEADER_SIZE + body.size());
+	result.append(tables.data(), static_cast<int>(tables.size()));
+	return result;
+}
+
+QJsonDocument fromBinaryProject(const QByteArray& data) {
+	return BinaryProject{data}.toJson();
+}
+
+BinaryProject::BinaryProject(const QByteArray& data) : data_(data) {
+	if (!isBinaryProject(data_)) {
+		fail("missing header");
+	}
+	const auto size = static_cast<size_t>(data_.size());
+	if (size == MAGIC_SIZE) {
+		fail("unexpected end of data");
+	}
+	auto version = static_cast<uint8_t>(data_[static_cast<int>(MAGIC_SIZE)]);
+	if (version != BINARY_PROJECT_FORMAT_VERSION) {
+		throw std::runtime_error("Binary project format version " + std::to_string(version) + " is not supported by this version of Ramses Composer");
+	}
+	if (size < HEADER_SIZE + TRAILER_SIZE) {
+		fail("unexpected end of data");
+	}
+
+	const auto* bytes = data_.constData();
+	Decoder trailer{bytes, size - TRAILER_SIZE, size};
+	auto tableOffset = trailer.readFixed();
+	if (tableOffset < HEADER_SIZE || tableOffset > size - TRAILER_SIZE) {
+		fail("invalid table offset");
+	}
+	tableOffset_ = static_cast<size_t>(tableOffset);
+
+	Decoder tables{bytes, tableOffset_, size - TRAILER_SIZE};
+	readStringTable(tables, names_);
+	readStringTable(tables, objectIDs_);
+	if (!tables.atEnd()) {
+		fail("unexpected data after tables");
+	}
+	for (size_t index = 0; index < names_.size(); index++) {
+		nameIndices_.emplace(names_[index], static_cast<uint32_t>(index));
+	}
+
+	rootOffset_ = HEADER_SIZE;
+	Decoder body{bytes, rootOffset_, tableOffset_};
+	checkValue(body, names_.size(), objectIDs_.size(), 0);
+	if (!body.atEnd()) {
+		fail("unexpected data after document root");
+	}
+}
+
+int BinaryProject::fileVersion() const {
+	Tables tables{names_, nameIndices_, objectIDs_};
+	ValueTree tree{data_.constData(), tables};
+	Decoder decoder{data_.constData(), rootOffset_, tableOffset_};
+	if (decoder.readTag() == BinaryTag::Object) {
+		auto fileVersionKey = tables.key(keys::FILE_VERSION);
+		while (auto key = decoder.readVarint()) {
+			if (key == fileVersionKey) {
+				tree.decode(decoder);
+				return Value{&tree, 0}.toInt();
+			}
+			skipValue(decoder);
+		}
+	}
+	return 0;
+}
+
+QJsonDocument BinaryProject::toJson() const {
+	Tables tables{names_, nameIndices_, objectIDs_};
+	Decoder decoder{data_.constData(), rootOffset_, tableOffset_};
+	auto root = decodeJson(decoder, tables);
+	if (root.isObject()) {
+		return QJsonDocument{root.toObject()};
+	} else if (root.isArray()) {
+		return QJsonDocument{root.toArray()};
+	} else if (!root.isNull()) {
+		fail("document root is neither object nor array");
+	}
+	return {};
+}
+
+ProjectDeserializationInfo BinaryProject::deserialize(const DeserializationFactory& factory) const {
+	Tables tables{names_, nameIndices_, objectIDs_};
+	const auto* bytes = data_.constData();
+
+	// Only the versions and the external projects are decoded into trees; the instances and links are decoded one at a time.
+	ValueTree ramsesVersion{bytes, tables};
+	ValueTree logicEngineVersion{bytes, tables};
+	ValueTree raCoVersion{bytes, tables};
+	ValueTree externalProjects{bytes, tables};
+	std::map<uint64_t, ValueTree*> decodedMembers{
+		{tables.key(keys::RAMSES_VERSION), &ramsesVersion},
+		{tables.key(keys::RAMSES_LOGIC_ENGINE_VERSION), &logicEngineVersion},
+		{tables.key(keys::RAMSES_COMPOSER_VERSION), &raCoVersion},
+		{tables.key(keys::EXTERNAL_PROJECTS), &externalProjects}};
+	std::map<ValueTree*, bool> decoded;
+	std::vector<size_t> instanceOffsets;
+	std::vector<size_t> linkOffsets;
+	auto instancesKey = tables.key(keys::INSTANCES);
+	auto linksKey = tables.key(keys::LINKS);
+
+	Decoder decoder{bytes, rootOffset_, tableOffset_};
+	if (decoder.readTag() == BinaryTag::Object) {
+		while (auto key = decoder.readVarint()) {
+			auto treeIt = decodedMembers.find(key);
+			if (treeIt != decodedMembers.end()) {
+				treeIt->second->decode(decoder);
+				decoded[treeIt->second] = true;
+			} else if ((key == instancesKey || key == linksKey) && decoder.peekByte() == static_cast<uint8_t>(BinaryTag::Array)) {
+				auto& offsets = key == instancesKey ? instanceOffsets : linkOffsets;
+				offsets.clear();
+				decoder.readByte();
+				while (decoder.peekByte() != static_cast<uint8_t>(BinaryTag::End)) {
+					offsets.emplace_back(decoder.position());
+					skipValue(decoder);
+				}
+				decoder.readByte();
+			} else {
+				skipValue(decoder);
+			}
+		}
+	}
+	auto root = [&decoded](ValueTree& tree) {
+		return decoded[&tree] ? Value{&tree, 0} : Value{};
+	};
+
+	ProjectDeserializationInfo deserializedProjectInfo;
+	deserializedProjectInfo.ramsesVersion = deserializeVersionNumberArray(root(ramsesVersion), "Ramses");
+	deserializedProjectInfo.ramsesLogicEngineVersion = deserializeVersionNumberArray(root(logicEngineVersion), "Ramses Logic Engine");
+	deserializedProjectInfo.raCoVersion = deserializeVersionNumberArray(root(raCoVersion), "Ramses Composer");
+
+	root(externalProjects).toObject().forEach([&deserializedProjectInfo](Value project) {
+		auto info = project.toObject();
+		deserializedProjectInfo.objectsDeserialization.externalProjectsMap[project.name()] = ExternalProjectInfo{
+			info.member(std::string(keys::EXTERNAL_PROJECT_PATH)).toString(),
+			info.member(std::string(keys::EXTERNAL_PROJECT_NAME)).toString()};
+	});
+
+	// Like `deserializeTypedObjects` in Serialization.cpp; every thread decodes its objects into its own tree.
+	auto deserializeTypedObjects = [this, bytes, &tables, &factory](const std::vector<size_t>& offsets, References& references) {
+		const auto count = offsets.size();
+		std::vector<SReflectionInterface> objects(count);
+		std::vector<References> chunkReferences(raco::utils::parallel::chunkCount(count, MIN_OBJECTS_PER_THREAD));
+		raco::utils::parallel::forEachChunk(count, MIN_OBJECTS_PER_THREAD, [this, bytes, &tables, &factory, &offsets, &objects, &chunkReferences](size_t chunk, size_t begin, size_t end) {
+			ValueTree tree{bytes, tables};
+			for (size_t index = begin; index < end; index++) {
+				Decoder decoder{bytes, offsets[index], tableOffset_};
+				tree.decode(decoder);
+				objects[index] = deserializeTypedObject(Value{&tree, 0}.toObject(), factory, chunkReferences[chunk]);
+			}
+		});
+		for (auto& chunk : chunkReferences) {
+			references.merge(chunk);
+		}
+		return objects;
+	};
+	auto& objectsDeserialization = deserializedProjectInfo.objectsDeserialization;
+	objectsDeserialization.objects = deserializeTypedObjects(instanceOffsets, objectsDeserialization.references);
+	objectsDeserialization.links = deserializeTypedObjects(linkOffsets, objectsDeserialization.references);
+	return deserializedProjectInfo;
+}
+
+const std::vector<std::string>& BinaryProject::names() const {
+	return names_;
+}
+
+const std::vector<std::string>& BinaryProject::objectIDs() const {
+	return objectIDs_;
+}
+
+}  // namespace raco::serialization
@@ -21,7 +21,7 @@ bool DataChangeRecorder::LinkMap::contains(SLink link) const {
 	auto linkEndObjIt = linkMap_.find((*link->endObject_)->objectID());
 	if (linkEndObjIt != linkMap_.end()) {
 		auto desc = link->descriptor();
-		auto linkEndObjs = linkEndObjIt->second;
+		const auto& linkEndObjs = linkEndObjIt->second;
 		return linkEndObjs.find(desc) != linkEndObjs.end();
 	}
 	return false;
@@ -97,6 +97,16 @@ bool DataChangeRecorder::LinkMap::updateLinkIfSaved(const LinkDescriptor& link)
 	return false;
 }
 
+bool DataChangeRecorder::empty() const {
+	return createdObjects_.empty() && deletedObjects_.empty() && changedValues_.empty() && changedErrors_.empty() && previewDirty_.empty() &&
+		   addedLinks_.savedLinks().empty() && removedLinks_.savedLinks().empty() && changedValidityLinks_.savedLinks().empty() && !externalProjectMapChanged_;
+}
+
+void DataChangeRecorder::invalidateCachedQueries() {
+	allChangedObjectsCacheValid_ = 0;
+	++changedObjectsVersion_;
+}
+
 void DataChangeRecorder::reset() {
 	createdObjects_.clear();
 	deletedObjects_.clear();
@@ -107,16 +117,21 @@ void DataChangeRecorder::reset() {
 	removedLinks_.clear();
 	changedValidityLinks_.clear();
 	externalProjectMapChanged_ = false;
+	allChangedObjectsCache_ = {};
+	outdatedChangedObjects_.clear();
+	invalidateCachedQueries();
 }
 
 DataChangeRecorder DataChangeRecorder::release() {
-	DataChangeRecorder copy{*this};
+	DataChangeRecorder result{std::move(*this)};
 	reset();
-	return copy;
+	return result;
 }
 
 void DataChangeRecorder::recordCreateObject(SEditorObject const& object) {
-	createdObjects_.insert(object);
+	if (createdObjects_.insert(object).second) {
+		invalidateCachedQueries();
+	}
 }
 
 void DataChangeRecorder::recordDeleteObject(SEditorObject const& object) {
@@ -129,34 +144,40 @@ void DataChangeRecorder::recordDeleteObject(SEditorObject const& object) {
 	}
 
 	// Remove all value changed items for object
-	changedValues_.erase(object->objectID());
+	changedValues_.erase(object.get());
+	invalidateCachedQueries();
 }
 
 void DataChangeRecorder::recordValueChanged(ValueHandle const& value) {
-	// Remove existing changed values nested inside value
-	const auto& objectID = value.rootObject()->objectID();
+	const EditorObject* object = value.rootObject().get();
 
-	auto contIt = changedValues_.find(objectID);
-	if (contIt != changedValues_.end()) {
+	auto contIt = changedValues_.find(object);
+	if (contIt == changedValues_.end()) {
+		// Only a new object changes the result of getAllChangedObjects
+		changedValues_[object].insert(value);
+		invalidateCachedQueries();
+	} else {
 		auto& cont = contIt->second;
-		auto it = cont.begin();
-		while (it != cont.end()) {
-			if (value.contains(*it)) {
-				it = cont.erase(it);
-			} else if (it->contains(value)) {
-				// Discard values nested inside existing change records
+		// Discard values nested inside existing change records
+		for (ValueHandle parent = value; parent.depth() > 0;) {
+			parent = parent.parent();
+			if (cont.find(parent) != cont.end()) {
 				return;
-			} else {
-				++it;
 			}
 		}
+		// Remove existing changed values nested inside value; the handles are ordered by their index path,
+		// so these directly follow value.
+		auto it = cont.upper_bound(value);
+		while (it != cont.end() && value.contains(*it)) {
+			it = cont.erase(it);
+		}
+		cont.insert(value);
 	}
-
-	changedValues_[objectID].insert(value);
 }
 
 void DataChangeRecorder::recordAddLink(const LinkDescriptor& link) {
 	addedLinks_.insertOrUpdateLink(link);
+	invalidateCachedQueries();
 }
 
 void DataChangeRecorder::recordChangeValidityOfLink(const LinkDescriptor& link) {
@@ -166,6 +187,7 @@ void DataChangeRecorder::recordChangeValidityOfLink(const LinkDescriptor& link)
 	}
 
 	changedValidityLinks_.insertOrUpdateLink(link);
+	invalidateCachedQueries();
 }
 
 void DataChangeRecorder::recordRemoveLink(const LinkDescriptor& link) {
@@ -173,6 +195,7 @@ void DataChangeRecorder::recordRemoveLink(const LinkDescriptor& link) {
 	// There can be multiple invalid links ending on the same property but starting on different properties,
 	// so we search for identical start and end points.
 	changedValidityLinks_.eraseLink(link);
+	invalidateCachedQueries();
 
 	// Remove addedLinks entry starting and ending on the same property
 	// There can also be multiple added links ending on the same property
@@ -191,7 +214,9 @@ void DataChangeRecorder::recordErrorChanged(const ValueHandle& value) {
 }
 
 void DataChangeRecorder::recordPreviewDirty(const SEditorObject& object) {
-	previewDirty_.insert(object);
+	if (previewDirty_.insert(object).second) {
+		invalidateCachedQueries();
+	}
 }
 
 void DataChangeRecorder::recordExternalProjectMapChanged() {
@@ -236,6 +261,28 @@ void DataChangeRecorder::mergeChanges(const DataChangeRecorder& other) {
 	}
 }
 
+void DataChangeRecorder::mergeChanges(DataChangeRecorder&& other) {
+	if (empty()) {
+		// Nothing to combine: take over the containers of other directly.
+		// The version must still increase since it may have been observed before.
+		// Sets returned by getAllChangedObjects must stay valid.
+		auto version = changedObjectsVersion_;
+		auto outdated = std::move(outdatedChangedObjects_);
+		for (auto& objects : allChangedObjectsCache_) {
+			if (objects) {
+				outdated.emplace_back(std::move(objects));
+			}
+		}
+		*this = std::move(other);
+		changedObjectsVersion_ = std::max(version, changedObjectsVersion_);
+		outdatedChangedObjects_.insert(outdatedChangedObjects_.end(), std::make_move_iterator(outdated.begin()), std::make_move_iterator(outdated.end()));
+		invalidateCachedQueries();
+	} else {
+		mergeChanges(static_cast<const DataChangeRecorder&>(other));
+	}
+	other.reset();
+}
+
 SEditorObjectSet const& DataChangeRecorder::getCreatedObjects() const {
 	return createdObjects_;
 }
@@ -244,12 +291,12 @@ SEditorObjectSet const& DataChangeRecorder::getDeletedObjects() const {
 	return deletedObjects_;
 }
 
-std::map<std::string, std::set<ValueHandle>> const& DataChangeRecorder::getChangedValues() const {
+DataChangeRecorder::ChangedValueMap const& DataChangeRecorder::getChangedValues() const {
 	return changedValues_;
 }
 
 bool DataChangeRecorder::hasValueChanged(const ValueHandle& handle) const {
-	auto contIt = changedValues_.find(handle.rootObject()->objectID());
+	auto contIt = changedValues_.find(handle.rootObject().get());
 	if (contIt != changedValues_.end()) {
 		return contIt->second.find(handle) != contIt->second.end();
 	}
@@ -276,37 +323,52 @@ bool DataChangeRecorder::isLinkValidityChanged(SLink link) const {
 	return changedValidityLinks_.contains(link);
 }
 
-SEditorObjectSet DataChangeRecorder::getAllChangedObjects(bool includePreviewDirty, bool includeLinkStart, bool includeLinkEnd) const {
-	SEditorObjectSet objects;
-	std::transform(createdObjects_.begin(), createdObjects_.end(), std::inserter(objects, objects.end()),
+SEditorObjectSet const& DataChangeRecorder::getAllChangedObjects(bool includePreviewDirty, bool includeLinkStart, bool includeLinkEnd) const {
+	const uint8_t cacheIndex = (includePreviewDirty ? 1 : 0) | (includeLinkStart ? 2 : 0) | (includeLinkEnd ? 4 : 0);
+	auto& cached = allChangedObjectsCache_[cacheIndex];
+	if (cached && (allChangedObjectsCacheValid_ & (1 << cacheIndex))) {
+		return *cached;
+	}
+
+	auto objects = std::make_shared<SEditorObjectSet>();
+	std::transform(createdObjects_.begin(), createdObjects_.end(), std::inserter(*objects, objects->end()),
 		[](const ValueHandle& handle) -> SEditorObject {
 			return handle.rootObject();
 		});
-	std::transform(changedValues_.begin(), changedValues_.end(), std::inserter(objects, objects.end()),
+	std::transform(changedValues_.begin(), changedValues_.end(), std::inserter(*objects, objects->end()),
 		[](const auto& item) -> SEditorObject {
 			return item.second.begin()->rootObject();
 		});
 	if (includePreviewDirty) {
-		std::transform(previewDirty_.begin(), previewDirty_.end(), std::inserter(objects, objects.end()),
+		std::transform(previewDirty_.begin(), previewDirty_.end(), std::inserter(*objects, objects->end()),
 			[](const ValueHandle& handle) -> SEditorObject {
 				return handle.rootObject();
 			});
 	}
 
 	if (includeLinkStart || includeLinkEnd) {
-		addedLinks_.insertLinkEndPointObjects(includeLinkStart, includeLinkEnd, objects);
-		changedValidityLinks_.insertLinkEndPointObjects(includeLinkStart, includeLinkEnd, objects);
-		removedLinks_.insertLinkEndPointObjects(includeLinkStart, includeLinkEnd, objects);
+		addedLinks_.insertLinkEndPointObjects(includeLinkStart, includeLinkEnd, *objects);
+		changedValidityLinks_.insertLinkEndPointObjects(includeLinkStart, includeLinkEnd, *objects);
+		removedLinks_.insertLinkEndPointObjects(includeLinkStart, includeLinkEnd, *objects);
 	}
 
-	return objects;
+	if (cached) {
+		outdatedChangedObjects_.emplace_back(std::move(cached));
+	}
+	cached = std::move(objects);
+	allChangedObjectsCacheValid_ |= (1 << cacheIndex);
+	return *cached;
+}
+
+uint64_t DataChangeRecorder::changedObjectsVersion() const {
+	return changedObjectsVersion_;
 }
 
-std::set<ValueHandle> DataChangeRecorder::getChangedErrors() const {
+std::set<ValueHandle> const& DataChangeRecorder::getChangedErrors() const {
 	return changedErrors_;
 }
 
-SEditorObjectSet DataChangeRecorder::getPreviewDirtyObjects() const {
+SEditorObjectSet const& DataChangeRecorder::getPreviewDirtyObjects() const {
 	return previewDirty_;
 }
 
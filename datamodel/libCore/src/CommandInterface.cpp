@@ -181,12 +181,39 @@ std::string CommandInterface::cutObjects(const std::vector<SEditorObject>& objec
 	return std::string();
 }
 
+std::shared_ptr<const ObjectsSnapshot> CommandInterface::copyObjectsSnapshot(const std::vector<SEditorObject>& objects, bool deepCopy) {
+	return context_->copyObjectsSnapshot(objects, deepCopy);
+}
+
+std::shared_ptr<const ObjectsSnapshot> CommandInterface::cutObjectsSnapshot(const std::vector<SEditorObject>& objects, bool deepCut) {
+	auto deletableObjects = Queries::filterForDeleteableObjects(*project(), objects);
+	if (!deletableObjects.empty()) {
+		auto result = context_->cutObjectsSnapshot(deletableObjects, deepCut);
+		PrefabOperations::globalPrefabUpdate(*context_, context_->modelChanges());
+		undoStack_->push(fmt::format("Cut {} objects with deep = {}", deletableObjects.size(), deepCut));
+		return result;
+	}
+	return nullptr;
+}
+
 std::vector<SEditorObject> CommandInterface::pasteObjects(const std::string& val, SEditorObject const& target, bool pasteAsExtref, bool* outSuccess, std::string* outError) {
+	return pasteWithUndo([this, &val, &target, pasteAsExtref]() {
+		return context_->pasteObjects(val, target, pasteAsExtref);
+	}, target, pasteAsExtref, outSuccess, outError);
+}
+
+std::vector<SEditorObject> CommandInterface::pasteObjects(const ObjectsSnapshot& snapshot, SEditorObject const& target, bool pasteAsExtref, bool* outSuccess, std::string* outError) {
+	return pasteWithUndo([this, &snapshot, &target, pasteAsExtref]() {
+		return context_->pasteObjects(snapshot, target, pasteAsExtref);
+	}, target, pasteAsExtref, outSuccess, outError);
+}
+
+std::vector<SEditorObject> CommandInterface::pasteWithUndo(const std::function<std::vector<SEditorObject>()>& paste, SEditorObject const& target, bool pasteAsExtref, bool* outSuccess, std::string* outError) {
 	bool success = true;
 	std::vector<SEditorObject> result;
 	if (Queries::canPasteIntoObject(*project(), target)) {
 		try {
-			result = context_->pasteObjects(val, target, pasteAsExtref);
+			result = paste();
 
 			PrefabOperations::globalPrefabUpdate(*context_, context_->modelChanges());
 			undoStack_->push(fmt::format("Paste {} into '{}'",
@@ -18,6 +18,7 @@
 #include "core/Link.h"
 #include "core/PrefabOperations.h"
 #include "core/MeshCacheInterface.h"
+#include "core/ObjectsSnapshot.h"
 #include "core/Project.h"
 #include "core/PropertyDescriptor.h"
 #include "core/Queries.h"
@@ -99,6 +100,14 @@ void BaseContext::callReferencedObjectChangedHandlers(SEditorObject const& chang
 	}
 }
 
+void BaseContext::updateInstanceNames(ValueHandle const& changedValue) {
+	auto object = changedValue.rootObject();
+	ValueHandle childrenHandle{object, &EditorObject::children_};
+	if (changedValue.isObject() || changedValue == ValueHandle{object, &EditorObject::objectName_} || changedValue == childrenHandle || childrenHandle.contains(changedValue)) {
+		project_->updateInstanceNames({object});
+	}
+}
+
 void BaseContext::performExternalFileReload(const std::vector<SEditorObject>& objects) {
 	// TODO: the implementation below is correct but sometimes leads to duplicate work:
 	// Objects implementing both onAfterReferencedObjectChanged and onAfterContextActivated handlers
@@ -120,6 +129,8 @@ void BaseContext::setT(ValueHandle const& handle, T const& value) {
 
 	callReferencedObjectChangedHandlers(handle.object_);
 
+	updateInstanceNames(handle);
+
 	changeMultiplexer_.recordValueChanged(handle);
 }
 
@@ -143,6 +154,8 @@ void BaseContext::setT<SEditorObject>(ValueHandle const& handle, SEditorObject c
 
 	callReferencedObjectChangedHandlers(handle.object_);
 
+	updateInstanceNames(handle);
+
 	changeMultiplexer_.recordValueChanged(handle);
 }
 
@@ -176,6 +189,8 @@ void BaseContext::setT<Table>(ValueHandle const& handle, Table const& value) {
 
 	callReferencedObjectChangedHandlers(handle.object_);
 
+	updateInstanceNames(handle);
+
 	changeMultiplexer_.recordValueChanged(handle);
 }
 
@@ -245,6 +260,8 @@ ValueBase* BaseContext::addProperty(const ValueHandle& handle, std::string name,
 
 	callReferencedObjectChangedHandlers(handle.object_);
 
+	updateInstanceNames(handle);
+
 	changeMultiplexer_.recordValueChanged(handle);
 
 	return newValue;
@@ -302,6 +319,8 @@ void BaseContext::removeProperty(const ValueHandle& handle, size_t index) {
 
 	callReferencedObjectChangedHandlers(handle.object_);
 
+	updateInstanceNames(handle);
+
 	changeMultiplexer_.recordValueChanged(handle);
 }
 
@@ -381,6 +400,18 @@ std::string BaseContext::cutObjects(const std::vector<SEditorObject>& objects, b
 	return serialization;
 }
 
+std::shared_ptr<const ObjectsSnapshot> BaseContext::copyObjectsSnapshot(const std::vector<SEditorObject>& objects, bool deepCopy) {
+	auto allObjects{collectObjectsForCopyOrCutOperations(objects, deepCopy)};
+	return std::make_shared<ObjectsSnapshot>(*project_, allObjects, findRootObjectIDs(allObjects), collectLinksForCopyOrCutOperation(*project_, allObjects), findOriginFolders(*project_, allObjects), *objectFactory_);
+}
+
+std::shared_ptr<const ObjectsSnapshot> BaseContext::cutObjectsSnapshot(const std::vector<SEditorObject>& objects, bool deepCut) {
+	auto allObjects{collectObjectsForCopyOrCutOperations(objects, deepCut)};
+	auto snapshot = std::make_shared<ObjectsSnapshot>(*project_, allObjects, findRootObjectIDs(allObjects), collectLinksForCopyOrCutOperation(*project_, allObjects), findOriginFolders(*project_, allObjects), *objectFactory_);
+	deleteObjects(Queries::filterForDeleteableObjects(*project_, allObjects));
+	return snapshot;
+}
+
 void BaseContext::rerootRelativePaths(std::vector<SEditorObject>& newObjects, raco::serialization::ObjectsDeserialization& deserialization) {
 	for (auto object : newObjects) {
 		if (PathQueries::isPathRelativeToCurrentProject(object)) {
@@ -500,7 +531,15 @@ void BaseContext::restoreReferences(const Project& project, std::vector<SEditorO
 std::vector<SEditorObject> BaseContext::pasteObjects(const std::string& seralizedObjects, const SEditorObject& target, bool pasteAsExtref) {
 	auto deserialization{raco::serialization::deserializeObjects(seralizedObjects, 
 		raco::user_types::UserObjectFactoryInterface::deserializationFactory(objectFactory_))};
+	return pasteDeserializedObjects(deserialization, target, pasteAsExtref);
+}
+
+std::vector<SEditorObject> BaseContext::pasteObjects(const ObjectsSnapshot& snapshot, const SEditorObject& target, bool pasteAsExtref) {
+	auto deserialization{snapshot.deserialize(*objectFactory_)};
+	return pasteDeserializedObjects(deserialization, target, pasteAsExtref);
+}
 
+std::vector<SEditorObject> BaseContext::pasteDeserializedObjects(raco::serialization::ObjectsDeserialization& deserialization, const SEditorObject& target, bool pasteAsExtref) {
 	if (deserialization.objects.size() == 0) {
 		return {};
 	}
@@ -577,17 +616,13 @@ std::vector<SEditorObject> BaseContext::pasteObjects(const std::string& seralize
 			}
 		}
 
-		std::vector<SEditorObject> rootNodes;
-		std::copy_if(project_->instances().begin(), project_->instances().end(), std::back_inserter(rootNodes), [](const SEditorObject& obj) { return obj->getParent() == nullptr; });
-
 		for (const auto& obj : newObjects) {
 			if (!obj->query<ExternalReferenceAnnotation>()) {
-				auto parent = obj->getParent();
-				auto baseName = obj->objectName();
-
-				const std::string uniqueName = parent ? project_->findAvailableUniqueName(parent->begin(), parent->end(), obj, obj->objectName()) : project_->findAvailableUniqueName(rootNodes.begin(), rootNodes.end(), obj, obj->objectName());
-
-				obj->setObjectName(uniqueName);
+				const std::string uniqueName = project_->findAvailableUniqueName(obj->getParent(), obj, obj->objectName());
+				if (uniqueName != obj->objectName()) {
+					obj->setObjectName(uniqueName);
+					project_->updateInstanceNames({obj});
+				}
 			}
 		}
 	}
@@ -830,6 +865,8 @@ void BaseContext::moveScenegraphChildren(std::vector<SEditorObject> const& objec
 
 			callReferencedObjectChangedHandlers(object);
 
+			updateInstanceNames(newParentChildren);
+
 			changeMultiplexer_.recordValueChanged(newParentChildren);
 		}
 
@@ -892,13 +929,8 @@ void BaseContext::insertAssetScenegraph(const raco::core::MeshScenegraph& sceneg
 	LOG_INFO(log_system::CONTEXT, "All meshes imported.");
 
 	LOG_INFO(log_system::CONTEXT, "Importing scenegraph nodes...");
-	std::vector<SEditorObject> topLevelObjects{};
-	std::copy_if(project_->instances().begin(), project_->instances().end(), std::back_inserter(topLevelObjects), [](const SEditorObject& object) {
-		return object->getParent() == nullptr;
-	});
-
 	auto meshPath = std::filesystem::path(relativeFilePath).filename().string();
-	meshPath = project_->findAvailableUniqueName(topLevelObjects.begin(), topLevelObjects.end(), nullptr, meshPath);
+	meshPath = project_->findAvailableUniqueName(nullptr, nullptr, meshPath);
 	auto sceneRootNode = createObject(raco::user_types::Node::typeDescription.typeName, meshPath);
 	if (parent) {
 		moveScenegraphChildren(core::Queries::filterForMoveableScenegraphChildren(*project(), {sceneRootNode}, parent), parent);
@@ -23,6 +23,7 @@
 #include <algorithm>
 #include <cassert>
 #include <map>
+#include <set>
 #include <string>
 
 namespace raco::core {
@@ -158,7 +159,21 @@ void ExtrefOperations::updateExternalObjects(BaseContext& context, Project* proj
 	// walk tree following all references but use objects from correct external project when following references.
 	std::map<std::string, ExternalObjectDescriptor> externalObjects;
 
+	// Request the objects of each external project used here before collecting them: a store which loads only the requested
+	// objects of a project can then (re)load each project before pointers into it are kept in externalObjects.
+	// The objects newly referenced by these objects in the external projects are loaded along with them.
+	std::map<std::string, std::set<std::string>> requestedObjects;
+	for (const auto& [id, object] : localObjects) {
+		requestedObjects[*object->query<ExternalReferenceAnnotation>()->projectID_].insert(id);
+	}
+
 	try {
+		for (const auto& [projectID, objectIDs] : requestedObjects) {
+			if (project->hasExternalProjectMapping(projectID)) {
+				externalProjectsStore.addExternalProjectObjects(project->lookupExternalProjectPath(projectID), objectIDs, pathStack);
+			}
+		}
+
 		for (const auto& [id, object] : localObjects) {
 			if (object->getParent() == nullptr) {
 				collectExternalObjects(project, ExternalObjectDescriptor{object, project}, externalProjectsStore, externalObjects, pathStack, true);
@@ -274,9 +289,13 @@ void ExtrefOperations::updateExternalObjects(BaseContext& context, Project* proj
 	for (const auto& destObj : localChanges.getAllChangedObjects()) {
 		destObj->onAfterDeserialization();
 	}
+	project->updateInstanceNames(localChanges.getAllChangedObjects());
+
+	const auto& changedObjects = localChanges.getAllChangedObjects();
+	std::vector<SEditorObject> reloadObjects{changedObjects.begin(), changedObjects.end()};
 
 	context.modelChanges().mergeChanges(localChanges);
-	context.uiChanges().mergeChanges(localChanges);
+	context.uiChanges().mergeChanges(std::move(localChanges));
 
 	if (extProjectMapCopy != project->externalProjectsMap()) {
 		context.modelChanges().recordExternalProjectMapChanged();
@@ -284,8 +303,7 @@ void ExtrefOperations::updateExternalObjects(BaseContext& context, Project* proj
 	}
 
 	// Sync from external files for new or changed objects
-	auto changedObjects = localChanges.getAllChangedObjects();
-	context.performExternalFileReload({changedObjects.begin(), changedObjects.end()});
+	context.performExternalFileReload(reloadObjects);
 
 	project->setExternalReferenceUpdateFailed(false);
 }
@@ -11,14 +11,14 @@
 #include "core/EditorObject.h"
 #include "core/Iterators.h"
 #include "core/PropertyDescriptor.h"
+#include "data_storage/Table.h"
 
 namespace raco::core {
 
 ValueHandle::ValueHandle(std::shared_ptr<EditorObject> object, std::initializer_list<std::string> names) : ValueHandle(object, std::vector<std::string>(names)) {}
 
 ValueHandle::ValueHandle(const std::shared_ptr<EditorObject>& object, const std::vector<std::string>& names)
-	: object_(object), indices_(names.size()) {
-	indices_.resize(0);
+	: object_(object) {
 	const ReflectionInterface* o = object_.get();
 	for (const auto& name : names) {
 		int index = o->index(name);
@@ -137,7 +137,7 @@ bool ValueHandle::hasProperty(std::string name) const {
 ValueHandle ValueHandle::get(std::string propertyName) const {
 	ValueHandle v(object_, indices_);
 	size_t index = object()->index(propertyName);
-	v.indices_.emplace_back(index);
+	v.indices_.push_back(index);
 	return v;
 }
 
@@ -195,7 +195,8 @@ ValueHandle ValueHandle::parent() const {
 	if (indices_.empty()) {
 		return ValueHandle(nullptr);
 	}
-	ValueHandle v(object_, std::vector<size_t>(indices_.begin(), indices_.begin() + indices_.size() - 1));
+	ValueHandle v(object_, indices_);
+	v.indices_.pop_back();
 	return v;
 }
 
@@ -237,6 +238,21 @@ const ValueBase* ValueHandle::constValueRef() const {
 }
 
 ValueBase* ValueHandle::valueRef() const {
+#ifdef RACO_USE_VALUE_HANDLE_CACHE
+	if (cachedValue_ && (!cachedTable_ || cachedTable_->structureVersion() == cachedStructureVersion_)) {
+		return cachedValue_;
+	}
+	cachedValue_ = resolveValueRef(&cachedTable_);
+	cachedStructureVersion_ = cachedTable_ ? cachedTable_->structureVersion() : 0;
+	return cachedValue_;
+#else
+	const Table* outerTable;
+	return resolveValueRef(&outerTable);
+#endif
+}
+
+ValueBase* ValueHandle::resolveValueRef(const Table** outerTable) const {
+	*outerTable = nullptr;
 	if (!indices_.empty()) {
 		ReflectionInterface* o = object_.get();
 		ValueBase* v = nullptr;
@@ -247,6 +263,9 @@ ValueBase* ValueHandle::valueRef() const {
 					return nullptr;
 				}
 				o = &v->getSubstructure();
+				if (!*outerTable && v->type() == PrimitiveType::Table) {
+					*outerTable = &v->asTable();
+				}
 			}
 			v = (*o)[index];
 			if (!v) {
@@ -279,6 +298,9 @@ bool ValueHandle::operator<(const ValueHandle& right) const {
 
 ValueHandle& ValueHandle::nextSibling() {
 	++indices_.back();
+#ifdef RACO_USE_VALUE_HANDLE_CACHE
+	cachedValue_ = nullptr;
+#endif
 	return *this;
 }
 
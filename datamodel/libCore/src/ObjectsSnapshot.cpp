@@ -0,0 +1,150 @@
+/*
+ * SPDX-License-Identifier: MPL-2.0
+ *
+ * This file is part of Ramses Composer
+ * (see https://github.com/GENIVI/ramses-composer).
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "core/ObjectsSnapshot.h"
+
+#include "core/Project.h"
+#include "core/SerializationFunctions.h"
+#include "core/Undo.h"
+#include "core/UserObjectFactoryInterface.h"
+
+namespace {
+
+using namespace raco::core;
+using raco::data_storage::PrimitiveType;
+using raco::data_storage::ReflectionInterface;
+using raco::data_storage::ValueBase;
+
+template <typename Visitor>
+void visitReferences(const ReflectionInterface& src, ReflectionInterface& dest, const Visitor& visit);
+
+// Calls `visit` for all pairs of corresponding reference properties in `src` and its structural copy `dest`.
+template <typename Visitor>
+void visitReferences(const ValueBase& src, ValueBase& dest, const Visitor& visit) {
+	if (src.type() == PrimitiveType::Ref) {
+		visit(src, dest);
+	} else if (raco::data_storage::hasTypeSubstructure(src.type())) {
+		visitReferences(src.getSubstructure(), dest.getSubstructure(), visit);
+	}
+	const auto& srcAnnotations = src.baseAnnotationPtrs();
+	const auto& destAnnotations = dest.baseAnnotationPtrs();
+	for (size_t index = 0; index < srcAnnotations.size(); index++) {
+		visitReferences(*srcAnnotations[index], *destAnnotations[index], visit);
+	}
+}
+
+template <typename Visitor>
+void visitReferences(const ReflectionInterface& src, ReflectionInterface& dest, const Visitor& visit) {
+	for (size_t index = 0; index < src.size(); index++) {
+		visitReferences(*src.get(index), *dest.get(index), visit);
+	}
+}
+
+template <typename Visitor>
+void visitObjectReferences(const EditorObject& src, EditorObject& dest, const Visitor& visit) {
+	visitReferences(static_cast<const ReflectionInterface&>(src), dest, visit);
+	for (const auto& srcAnnotation : src.annotations()) {
+		if (auto destAnnotation = dest.query(srcAnnotation->serializationTypeName())) {
+			visitReferences(*srcAnnotation, *destAnnotation, visit);
+		}
+	}
+}
+
+SEditorObject nullReference(SEditorObject) {
+	return nullptr;
+}
+
+// Clone with all references set to null, like a freshly deserialized object.
+SEditorObject cloneWithoutReferences(const EditorObject& src, UserObjectFactoryInterface& factory) {
+	auto clone = factory.createObject(src.getTypeDescription().typeName, src.objectName(), src.objectID());
+	updateEditorObject(
+		&src, clone, nullReference, [](const std::string&) { return false; }, factory, nullptr, false);
+	return clone;
+}
+
+}  // namespace
+
+namespace raco::core {
+
+ObjectsSnapshot::ObjectsSnapshot(const Project& project, const std::vector<SEditorObject>& objects, const std::vector<std::string>& rootObjectIDs, const std::vector<SLink>& links, const std::map<std::string, std::string>& originFolders, UserObjectFactoryInterface& factory)
+	: rootObjectIDs_(rootObjectIDs),
+	  originFolder_(project.currentFolder()),
+	  originFileName_(project.currentFileName()),
+	  originProjectID_(project.projectID()),
+	  originProjectName_(project.projectName()),
+	  externalProjectsMap_(project.externalProjectsMap()),
+	  objectOriginFolders_(originFolders) {
+	auto recordReference = [this](const ValueBase& src, ValueBase& dest) {
+		if (auto object = src.asRef()) {
+			references_[&dest] = object->objectID();
+		}
+	};
+
+	objects_.reserve(objects.size());
+	for (const auto& object : objects) {
+		auto clone = cloneWithoutReferences(*object, factory);
+		visitObjectReferences(*object, *clone, recordReference);
+		objects_.emplace_back(clone);
+	}
+	links_.reserve(links.size());
+	for (const auto& link : links) {
+		auto clone = Link::cloneLinkWithTranslation(link, nullReference);
+		visitReferences(*link, *clone, recordReference);
+		links_.emplace_back(clone);
+	}
+}
+
+serialization::ObjectsDeserialization ObjectsSnapshot::deserialize(UserObjectFactoryInterface& factory) const {
+	serialization::ObjectsDeserialization result;
+	result.rootObjectIDs.insert(rootObjectIDs_.begin(), rootObjectIDs_.end());
+	result.originFolder = originFolder_;
+	result.originFileName = originFileName_;
+	result.originProjectID = originProjectID_;
+	result.originProjectName = originProjectName_;
+	result.externalProjectsMap = externalProjectsMap_;
+	result.objectOriginFolders = objectOriginFolders_;
+
+	auto copyReference = [this, &result](const ValueBase& src, ValueBase& dest) {
+		auto it = references_.find(&src);
+		if (it != references_.end()) {
+			result.references[&dest] = it->second;
+		}
+	};
+
+	result.objects.reserve(objects_.size());
+	for (const auto& object : objects_) {
+		auto clone = cloneWithoutReferences(*object, factory);
+		visitObjectReferences(*object, *clone, copyReference);
+		result.objects.emplace_back(clone);
+	}
+	result.links.reserve(links_.size());
+	for (const auto& link : links_) {
+		auto clone = Link::cloneLinkWithTranslation(link, nullReference);
+		visitReferences(*link, *clone, copyReference);
+		result.links.emplace_back(clone);
+	}
+	return result;
+}
+
+std::string ObjectsSnapshot::serialize() const {
+	return serialization::serialize(objects_, rootObjectIDs_, links_, originFolder_, originFileName_, originProjectID_, originProjectName_, externalProjectsMap_, objectOriginFolders_,
+		[this](const ValueBase& value) -> std::optional<std::string> {
+			auto it = references_.find(&value);
+			if (it != references_.end()) {
+				return it->second;
+			}
+			return {};
+		});
+}
+
+size_t ObjectsSnapshot::size() const {
+	return objects_.size();
+}
+
+}  // namespace raco::core
@@ -60,6 +60,10 @@ std::string PathManager::preferenceFileLocation() {
 	return (std::filesystem::path(defaultConfigDirectory()) / Q_PREFERENCES_FILE_NAME).generic_string();
 }
 
+std::string PathManager::projectCacheDirectory() {
+	return (std::filesystem::path(defaultConfigDirectory()) / PROJECT_CACHE_SUB_DIRECTORY).generic_string();
+}
+
 std::string PathManager::defaultProjectFallbackPath() {
 	return (defaultBaseDirectory() / DEFAULT_PROJECT_SUB_DIRECTORY).generic_string();
 }
@@ -19,6 +19,8 @@
 #include "user_types/Prefab.h"
 #include "user_types/PrefabInstance.h"
 
+#include <algorithm>
+#include <unordered_map>
 #include <unordered_set>
 
 namespace raco::core {
@@ -257,13 +259,16 @@ void PrefabOperations::updatePrefabInstance(BaseContext& context, const SPrefab&
 	for (const auto& destObj : localChanges.getAllChangedObjects()) {
 		destObj->onAfterDeserialization();
 	}
+	context.project()->updateInstanceNames(localChanges.getAllChangedObjects());
+
+	const auto& changedObjects = localChanges.getAllChangedObjects();
+	std::vector<SEditorObject> reloadObjects{changedObjects.begin(), changedObjects.end()};
 
 	context.modelChanges().mergeChanges(localChanges);
-	context.uiChanges().mergeChanges(localChanges);
+	context.uiChanges().mergeChanges(std::move(localChanges));
 
 	// Sync from external files for new or changed objects
-	auto changedObjects = localChanges.getAllChangedObjects();
-	context.performExternalFileReload({changedObjects.begin(), changedObjects.end()});
+	context.performExternalFileReload(reloadObjects);
 }
 
 void PrefabOperations::prefabUpdateOrderDepthFirstSearch(SPrefab current, std::vector<SPrefab>& order) {
@@ -281,72 +286,145 @@ void PrefabOperations::prefabUpdateOrderDepthFirstSearch(SPrefab current, std::v
 	}
 }
 
-// Prefab update order
-// - prefab B needs to be updated after prefab A if B contains a prefab instance of A
-// @return reverse update order
-std::vector<SPrefab> prefabUpdateOrder(const Project& project) {
-	std::vector<SPrefab> result;
-	for (auto obj : project.instances()) {
-		if (auto prefab = obj->as<Prefab>()) {
-			PrefabOperations::prefabUpdateOrderDepthFirstSearch(prefab, result);
+namespace {
+
+// Set of prefabs containing changed objects, i.e. the prefabs whose instances need to be updated.
+// The changed objects are bucketed by their containing prefab in a single pass. The buckets are rebuilt only when
+// the changed objects of the recorder change, e.g. when a prefab instance update makes its containing prefab dirty.
+class DirtyPrefabs {
+public:
+	explicit DirtyPrefabs(const DataChangeRecorder& changes) : changes_(changes) {}
+
+	bool contains(const SPrefab& prefab) {
+		return prefabs().find(prefab) != dirtyPrefabs_.end();
+	}
+
+	const std::unordered_set<SPrefab>& prefabs() {
+		if (!valid_ || version_ != changes_.changedObjectsVersion()) {
+			rebuild();
 		}
+		return dirtyPrefabs_;
 	}
-	return result;
-}
 
-bool prefabDirty(const DataChangeRecorder& changes, SPrefab prefab) {
-	for (auto obj : changes.getAllChangedObjects(false, false, true)) {
-		auto parentPrefab = PrefabOperations::findContainingPrefab(obj);
-		if (parentPrefab && parentPrefab == prefab) {
-			return true;
+private:
+	void rebuild() {
+		dirtyPrefabs_.clear();
+		containingPrefab_.clear();
+		for (const auto& obj : changes_.getAllChangedObjects(false, false, true)) {
+			if (auto prefab = containingPrefab(obj)) {
+				dirtyPrefabs_.insert(prefab);
+			}
 		}
+		version_ = changes_.changedObjectsVersion();
+		valid_ = true;
 	}
-	return false;
-}
+
+	// Memoized PrefabOperations::findContainingPrefab: the parent walk stops at the first already visited ancestor.
+	// The map holds the objects to make sure their addresses are not reused while it is alive.
+	SPrefab containingPrefab(const SEditorObject& object) {
+		std::vector<SEditorObject> path;
+		SPrefab result;
+		for (SEditorObject current = object; current; current = current->getParent()) {
+			auto it = containingPrefab_.find(current);
+			if (it != containingPrefab_.end()) {
+				result = it->second;
+				break;
+			}
+			if (auto prefab = current->as<Prefab>()) {
+				result = prefab;
+				containingPrefab_[current] = result;
+				break;
+			}
+			path.emplace_back(current);
+		}
+		for (const auto& visited : path) {
+			containingPrefab_[visited] = result;
+		}
+		return result;
+	}
+
+	const DataChangeRecorder& changes_;
+	bool valid_ = false;
+	uint64_t version_ = 0;
+	std::unordered_set<SPrefab> dirtyPrefabs_;
+	std::unordered_map<SEditorObject, SPrefab> containingPrefab_;
+};
+
+}  // namespace
 
 // Prefab instance is dirty if the template property has changed or the instance was newly created
 bool prefabInstanceDirty(const DataChangeRecorder& changes, SPrefabInstance instance) {
 	auto& createdObjects = changes.getCreatedObjects();
-	if (std::find_if(createdObjects.begin(), createdObjects.end(), [instance](const ValueHandle& handle) {
-			return handle.rootObject() == instance;
-		}) != createdObjects.end()) {
+	if (createdObjects.find(instance) != createdObjects.end()) {
 		return true;
 	}
 	ValueHandle templateHandle(instance, &PrefabInstance::template_);
 	return changes.hasValueChanged(templateHandle);
 }
 
+// Prefab update order
+// - starts from the prefabs containing changed objects and the templates of created instances or instances with a
+//   changed template; only the prefabs containing instances of these, directly or through nested prefabs, follow.
+// - prefab B needs to be updated after prefab A if B contains a prefab instance of A
+// @return reverse update order
+std::vector<SPrefab> PrefabOperations::prefabUpdateOrder(const Project& project, const DataChangeRecorder& changes) {
+	DirtyPrefabs dirtyPrefabs(changes);
+	std::vector<SPrefab> startPrefabs(dirtyPrefabs.prefabs().begin(), dirtyPrefabs.prefabs().end());
+	for (const auto& obj : changes.getAllChangedObjects()) {
+		if (auto inst = obj->as<PrefabInstance>()) {
+			if (*inst->template_ && prefabInstanceDirty(changes, inst)) {
+				startPrefabs.emplace_back(*inst->template_);
+			}
+		}
+	}
+	// Changed prefabs may have been deleted since.
+	startPrefabs.erase(std::remove_if(startPrefabs.begin(), startPrefabs.end(), [&project](const SPrefab& prefab) {
+		return project.getInstanceByID(prefab->objectID()) != prefab;
+	}),
+		startPrefabs.end());
+	// Sort to make the update order independent of the hashing of the changed objects.
+	std::sort(startPrefabs.begin(), startPrefabs.end(), [](const SPrefab& left, const SPrefab& right) {
+		return left->objectID() < right->objectID();
+	});
+
+	std::vector<SPrefab> result;
+	for (const auto& prefab : startPrefabs) {
+		prefabUpdateOrderDepthFirstSearch(prefab, result);
+	}
+	return result;
+}
+
 void PrefabOperations::globalPrefabUpdate(BaseContext& context, DataChangeRecorder& changes) {
-	// Build prefab update order from dependency graph
-	auto order = prefabUpdateOrder(*context.project());
+	// Build prefab update order from the changed objects: instance updates only dirty prefabs downstream of these.
+	auto order = prefabUpdateOrder(*context.project(), changes);
 
 	// Remove children from prefab instances which set the template property to nullptr:
+	// these instances have been created or have a changed template, so only the changed objects need to be checked.
 	std::vector<SPrefabInstance> prefabInstances;
-	for (auto obj : context.project()->instances()) {
+	for (const auto& obj : changes.getAllChangedObjects()) {
 		if (auto inst = obj->as<PrefabInstance>()) {
-			if (prefabInstanceDirty(changes, inst) && *inst->template_ == nullptr && !findContainingPrefabInstance(inst->getParent())) {
+			if (*inst->template_ == nullptr && prefabInstanceDirty(changes, inst) && !findContainingPrefabInstance(inst->getParent())) {
 				prefabInstances.emplace_back(inst);
 			}
 		}
 	}
 	for (auto inst : prefabInstances) {
-		if (std::find(context.project()->instances().begin(), context.project()->instances().end(), inst) != context.project()->instances().end()) {
+		if (context.project()->getInstanceByID(inst->objectID()) == inst) {
 			auto children = inst->children_->asVector<SEditorObject>();
 			context.deleteObjects(children);
 			context.removeAllProperties({inst, &PrefabInstance::mapToInstance_});
 		}
 	}
 
+	DirtyPrefabs dirtyPrefabs(changes);
 	for (auto it = order.rbegin(); it != order.rend(); ++it) {
 		auto prefab = (*it)->as<Prefab>();
-		bool prefab_dirty = prefabDirty(changes, prefab);
+		bool prefab_dirty = dirtyPrefabs.contains(prefab);
 		for (auto weak_inst : prefab->instances_) {
 			if (auto inst = weak_inst.lock()->as<PrefabInstance>()) {
-				if (!findContainingPrefabInstance(inst->getParent())) {
-					bool inst_dirty = prefabInstanceDirty(changes, inst);
-					if (inst_dirty || prefab_dirty) {
-						updatePrefabInstance(context, prefab, inst, inst_dirty);
-					}
+				bool inst_dirty = prefabInstanceDirty(changes, inst);
+				if ((inst_dirty || prefab_dirty) && !findContainingPrefabInstance(inst->getParent())) {
+					updatePrefabInstance(context, prefab, inst, inst_dirty);
 				}
 			}
 		}
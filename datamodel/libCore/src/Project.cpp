@@ -14,15 +14,174 @@
 #include "core/CoreFormatter.h"
 #include "log_system/log.h"
 
+#include <algorithm>
 #include <cctype>
+#include <unordered_set>
 #include "utils/stdfilesystem.h"
 namespace raco::core {
 
+bool UniqueNameIndex::splitName(const std::string& name, std::string& basename, int& suffix) {
+	// Same result as matching the regular expression "(.*)\s+\((\d+)\)"
+	if (name.empty() || name.back() != ')') {
+		return false;
+	}
+	auto open = name.rfind('(');
+	if (open == std::string::npos || open == 0 || open + 2 >= name.size()) {
+		return false;
+	}
+	for (auto pos = open + 1; pos + 1 < name.size(); ++pos) {
+		if (name[pos] < '0' || name[pos] > '9') {
+			return false;
+		}
+	}
+	// The basename ends at the last position which leaves only whitespace before the '(' but
+	// can't extend beyond a line terminator since '.' doesn't match these.
+	auto whitespaceStart = open;
+	while (whitespaceStart > 0 && std::isspace(static_cast<unsigned char>(name[whitespaceStart - 1]))) {
+		--whitespaceStart;
+	}
+	auto basenameEnd = std::min(name.find_first_of("\n\r"), open - 1);
+	if (whitespaceStart == open || basenameEnd < whitespaceStart) {
+		return false;
+	}
+	basename = name.substr(0, basenameEnd);
+	suffix = std::stoi(name.substr(open + 1, name.size() - open - 2));
+	return true;
+}
+
+void UniqueNameIndex::addName(const std::string& name) {
+	++nameCounts_[name];
+	std::string basename;
+	int suffix;
+	if (splitName(name, basename, suffix)) {
+		addSuffix(basename, suffix);
+	} else {
+		addSuffix(name, 0);
+	}
+}
+
+void UniqueNameIndex::removeName(const std::string& name) {
+	auto it = nameCounts_.find(name);
+	if (it == nameCounts_.end()) {
+		return;
+	}
+	if (--it->second == 0) {
+		nameCounts_.erase(it);
+	}
+	std::string basename;
+	int suffix;
+	if (splitName(name, basename, suffix)) {
+		removeSuffix(basename, suffix);
+	} else {
+		removeSuffix(name, 0);
+	}
+}
+
+void UniqueNameIndex::addSuffix(const std::string& basename, int suffix) {
+	auto& entry = suffixes_[basename];
+	if (++entry.counts[suffix] > 1) {
+		return;
+	}
+	// Merge the new suffix with the adjacent runs
+	auto& runs = entry.runs;
+	int start = suffix;
+	int end = suffix;
+	auto next = runs.upper_bound(suffix);
+	if (next != runs.begin()) {
+		auto prev = std::prev(next);
+		if (prev->second + 1 == suffix) {
+			start = prev->first;
+			runs.erase(prev);
+		}
+	}
+	if (next != runs.end() && next->first == suffix + 1) {
+		end = next->second;
+		runs.erase(next);
+	}
+	runs[start] = end;
+}
+
+void UniqueNameIndex::removeSuffix(const std::string& basename, int suffix) {
+	auto entryIt = suffixes_.find(basename);
+	auto& entry = entryIt->second;
+	auto countIt = entry.counts.find(suffix);
+	if (--countIt->second > 0) {
+		return;
+	}
+	entry.counts.erase(countIt);
+	// Split the run containing the suffix
+	auto run = std::prev(entry.runs.upper_bound(suffix));
+	int start = run->first;
+	int end = run->second;
+	entry.runs.erase(run);
+	if (start < suffix) {
+		entry.runs[start] = suffix - 1;
+	}
+	if (suffix < end) {
+		entry.runs[suffix + 1] = end;
+	}
+	if (entry.counts.empty()) {
+		suffixes_.erase(entryIt);
+	}
+}
+
+std::string UniqueNameIndex::findAvailableName(const std::string& name, bool nameUsedByObject) const {
+	auto it = nameCounts_.find(name);
+	int collisions = it != nameCounts_.end() ? it->second : 0;
+	if (nameUsedByObject) {
+		--collisions;
+	}
+	if (collisions <= 0) {
+		return name;
+	}
+
+	std::string basename;
+	int suffix;
+	if (!splitName(name, basename, suffix)) {
+		basename = name;
+	}
+	// The name itself is indexed, so there is at least one run for its basename.
+	// Use the first unused suffix after the first run of used suffixes.
+	const auto& runs = suffixes_.at(basename).runs;
+	return fmt::format("{} ({})", basename, runs.begin()->second + 1);
+}
+
+bool UniqueNameIndex::operator==(const UniqueNameIndex& other) const {
+	if (nameCounts_ != other.nameCounts_ || suffixes_.size() != other.suffixes_.size()) {
+		return false;
+	}
+	for (const auto& [basename, suffixes] : suffixes_) {
+		auto it = other.suffixes_.find(basename);
+		if (it == other.suffixes_.end() || it->second.counts != suffixes.counts || it->second.runs != suffixes.runs) {
+			return false;
+		}
+	}
+	return true;
+}
+
 bool Project::removeInstances(SEditorObjectSet const& objects, bool gcExternalProjectMap) {
+	instances_.erase(std::remove_if(instances_.begin(), instances_.end(), [&objects](const SEditorObject& object) {
+		return objects.find(object) != objects.end();
+	}),
+		instances_.end());
 	for (const auto& object : objects) {
-		instances_.erase(std::find(instances_.begin(), instances_.end(), object));
 		instanceMap_.erase(object->objectID());
 	}
+
+	std::vector<SEditorObject> orphans;
+	for (const auto& object : objects) {
+		unindexInstanceName(object);
+		auto scopeIt = nameScopes_.find(object.get());
+		if (scopeIt != nameScopes_.end()) {
+			orphans.insert(orphans.end(), scopeIt->second.members.begin(), scopeIt->second.members.end());
+		}
+	}
+	for (const auto& orphan : orphans) {
+		if (indexedNames_.find(orphan.get()) != indexedNames_.end()) {
+			indexInstanceName(orphan);
+		}
+	}
+
 	if (gcExternalProjectMap) {
 		return gcExternalProjectMapping();
 	}
@@ -32,6 +191,106 @@ bool Project::removeInstances(SEditorObjectSet const& objects, bool gcExternalPr
 void Project::addInstance(SEditorObject object) {
 	instances_.push_back(object);
 	instanceMap_[object->objectID()] = object;
+	updateInstanceNames({object});
+}
+
+void Project::indexInstanceName(SEditorObject const& object) {
+	const EditorObject* scope = nullptr;
+	auto parent = object->getParent();
+	if (parent && getInstanceByID(parent->objectID()) == parent) {
+		scope = parent.get();
+	}
+
+	auto it = indexedNames_.find(object.get());
+	if (it != indexedNames_.end()) {
+		if (it->second.scope == scope && it->second.name == object->objectName()) {
+			return;
+		}
+		unindexInstanceName(object);
+	}
+
+	auto& nameScope = nameScopes_[scope];
+	nameScope.names.addName(object->objectName());
+	nameScope.members.insert(object);
+	indexedNames_[object.get()] = {scope, object->objectName()};
+}
+
+void Project::unindexInstanceName(SEditorObject const& object) {
+	auto it = indexedNames_.find(object.get());
+	if (it == indexedNames_.end()) {
+		return;
+	}
+	auto scopeIt = nameScopes_.find(it->second.scope);
+	scopeIt->second.names.removeName(it->second.name);
+	scopeIt->second.members.erase(object);
+	if (scopeIt->second.members.empty()) {
+		nameScopes_.erase(scopeIt);
+	}
+	indexedNames_.erase(it);
+}
+
+void Project::updateInstanceNames(SEditorObjectSet const& objects) {
+	for (const auto& object : objects) {
+		if (getInstanceByID(object->objectID()) != object) {
+			continue;
+		}
+		indexInstanceName(object);
+
+		// Children may have been added to or removed from the object: check both the current children
+		// and the objects indexed below the object.
+		for (auto child : *object) {
+			if (child && indexedNames_.find(child.get()) != indexedNames_.end()) {
+				indexInstanceName(child);
+			}
+		}
+		auto scopeIt = nameScopes_.find(object.get());
+		if (scopeIt != nameScopes_.end()) {
+			std::vector<SEditorObject> members(scopeIt->second.members.begin(), scopeIt->second.members.end());
+			for (const auto& member : members) {
+				indexInstanceName(member);
+			}
+		}
+	}
+}
+
+bool Project::checkInstanceNames() const {
+	std::unordered_map<const EditorObject*, NameScope> scopes;
+	for (const auto& object : instances_) {
+		const EditorObject* scope = nullptr;
+		auto parent = object->getParent();
+		if (parent && getInstanceByID(parent->objectID()) == parent) {
+			scope = parent.get();
+		}
+		auto it = indexedNames_.find(object.get());
+		if (it == indexedNames_.end() || it->second.scope != scope || it->second.name != object->objectName()) {
+			return false;
+		}
+		scopes[scope].names.addName(object->objectName());
+		scopes[scope].members.insert(object);
+	}
+	if (indexedNames_.size() != instances_.size() || nameScopes_.size() != scopes.size()) {
+		return false;
+	}
+	for (const auto& [scope, nameScope] : scopes) {
+		auto it = nameScopes_.find(scope);
+		if (it == nameScopes_.end() || it->second.members != nameScope.members || !(it->second.names == nameScope.names)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+std::string Project::findAvailableUniqueName(SEditorObject const& parent, SEditorObject const& newObject, const std::string& name) const {
+	auto scopeIt = nameScopes_.find(parent.get());
+	if (scopeIt == nameScopes_.end()) {
+		return name;
+	}
+	bool nameUsedByObject = false;
+	if (newObject) {
+		auto it = indexedNames_.find(newObject.get());
+		nameUsedByObject = it != indexedNames_.end() && it->second.scope == parent.get() && it->second.name == name;
+	}
+	return scopeIt->second.names.findAvailableName(name, nameUsedByObject);
 }
 
 const std::vector<SEditorObject>& Project::instances() const {
@@ -338,54 +597,210 @@ Project::LinkGraph::LinkGraph(const Project& project) {
 	}
 }
 
+Project::LinkGraph::Node& Project::LinkGraph::node(const SEditorObject& object) {
+	auto it = graph_.find(object.get());
+	if (it == graph_.end()) {
+		// New objects have no links yet and can be appended to the order.
+		it = graph_.emplace(object.get(), Node{object, nextOrder_++, {}, {}}).first;
+	}
+	return it->second;
+}
+
+void Project::LinkGraph::eraseIfUnlinked(const EditorObject* object) {
+	auto it = graph_.find(object);
+	if (it != graph_.end() && it->second.successors.empty() && it->second.predecessors.empty()) {
+		graph_.erase(it);
+	}
+}
+
 void Project::LinkGraph::addLink(SLink link) {
-	graph[*link->startObject_].insert(*link->endObject_);
+	// References to unordered_map elements stay valid when other elements are inserted.
+	auto& startNode = node(*link->startObject_);
+	auto& endNode = node(*link->endObject_);
+	const EditorObject* start = startNode.object.get();
+	const EditorObject* end = endNode.object.get();
+
+	++endNode.predecessors[start];
+	if (startNode.successors[end]++ > 0) {
+		// Parallel link: the graph structure doesn't change.
+		return;
+	}
+
+	if (start == end) {
+		orderValid_ = false;
+	} else if (orderValid_ && endNode.order < startNode.order) {
+		orderValid_ = reorder(start, end);
+	}
 }
 
 void Project::LinkGraph::removeLink(SLink link) {
-	auto it = graph.find(*link->startObject_);
-	if (it != graph.end()) {
-		it->second.erase(*link->endObject_);
-		if (it->second.empty()) {
-			graph.erase(it);
-		}
+	const EditorObject* start = (*link->startObject_).get();
+	const EditorObject* end = (*link->endObject_).get();
+
+	auto startIt = graph_.find(start);
+	auto endIt = graph_.find(end);
+	if (startIt == graph_.end() || endIt == graph_.end()) {
+		return;
+	}
+	auto succIt = startIt->second.successors.find(end);
+	if (succIt == startIt->second.successors.end()) {
+		return;
+	}
+	if (--succIt->second == 0) {
+		startIt->second.successors.erase(succIt);
+	}
+	auto predIt = endIt->second.predecessors.find(start);
+	if (--predIt->second == 0) {
+		endIt->second.predecessors.erase(predIt);
+	}
+	eraseIfUnlinked(start);
+	eraseIfUnlinked(end);
+
+	// Removing links never invalidates a topological order but may remove the last loop.
+	if (!orderValid_) {
+		orderRecomputePending_ = true;
 	}
 }
 
 void Project::LinkGraph::removeAllLinks() {
-	graph.clear();
+	graph_.clear();
+	nextOrder_ = 0;
+	orderValid_ = true;
+	orderRecomputePending_ = false;
+}
+
+bool Project::LinkGraph::reorder(const EditorObject* start, const EditorObject* end) {
+	const int64_t lowerBound = graph_.at(end).order;
+	const int64_t upperBound = graph_.at(start).order;
+
+	// Objects reachable from end which are ordered before start
+	std::vector<const EditorObject*> forward;
+	std::unordered_set<const EditorObject*> visited{end};
+	std::vector<const EditorObject*> stack{end};
+	while (!stack.empty()) {
+		auto current = stack.back();
+		stack.pop_back();
+		forward.emplace_back(current);
+		for (const auto& [succ, count] : graph_.at(current).successors) {
+			if (succ == start) {
+				return false;
+			}
+			if (graph_.at(succ).order < upperBound && visited.insert(succ).second) {
+				stack.emplace_back(succ);
+			}
+		}
+	}
+
+	// Objects reaching start which are ordered after end
+	std::vector<const EditorObject*> backward;
+	visited = {start};
+	stack = {start};
+	while (!stack.empty()) {
+		auto current = stack.back();
+		stack.pop_back();
+		backward.emplace_back(current);
+		for (const auto& [pred, count] : graph_.at(current).predecessors) {
+			if (graph_.at(pred).order > lowerBound && visited.insert(pred).second) {
+				stack.emplace_back(pred);
+			}
+		}
+	}
+
+	// Reassign the orders of both sets: all of backward before all of forward, keeping the relative order inside each set.
+	auto byOrder = [this](const EditorObject* left, const EditorObject* right) {
+		return graph_.at(left).order < graph_.at(right).order;
+	};
+	std::sort(forward.begin(), forward.end(), byOrder);
+	std::sort(backward.begin(), backward.end(), byOrder);
+
+	std::vector<int64_t> orders;
+	orders.reserve(forward.size() + backward.size());
+	for (const auto* objects : {&backward, &forward}) {
+		for (auto obj : *objects) {
+			orders.emplace_back(graph_.at(obj).order);
+		}
+	}
+	std::sort(orders.begin(), orders.end());
+
+	size_t index = 0;
+	for (const auto* objects : {&backward, &forward}) {
+		for (auto obj : *objects) {
+			graph_.at(obj).order = orders[index++];
+		}
+	}
+	return true;
 }
 
-bool Project::LinkGraph::createsLoop(const PropertyDescriptor& start, const PropertyDescriptor& end) const {
-	auto startObj = start.object();
-	auto endObj = end.object();
-	if (startObj == endObj) {
-		return true;
+bool Project::LinkGraph::sortTopologically() const {
+	std::unordered_map<const EditorObject*, size_t> inDegree;
+	std::vector<const EditorObject*> ready;
+	for (const auto& [obj, node] : graph_) {
+		inDegree[obj] = node.predecessors.size();
+		if (node.predecessors.empty()) {
+			ready.emplace_back(obj);
+		}
 	}
-	if (graph.find(endObj) != graph.end()) {
-		SEditorObjectSet visited;
-		return depthFirstSearch(endObj, startObj, visited);
+
+	int64_t order = 0;
+	while (!ready.empty()) {
+		auto current = ready.back();
+		ready.pop_back();
+		auto& node = graph_.at(current);
+		node.order = order++;
+		for (const auto& [succ, count] : node.successors) {
+			if (--inDegree[succ] == 0) {
+				ready.emplace_back(succ);
+			}
+		}
+	}
+	nextOrder_ = order;
+	return order == static_cast<int64_t>(graph_.size());
+}
+
+bool Project::LinkGraph::pathExists(const EditorObject* from, const EditorObject* to, bool useOrder) const {
+	// With a valid topological order objects ordered after the target can't reach it.
+	const int64_t maxOrder = graph_.at(to).order;
+	std::unordered_set<const EditorObject*> visited{from};
+	std::vector<const EditorObject*> stack{from};
+	while (!stack.empty()) {
+		auto current = stack.back();
+		stack.pop_back();
+		for (const auto& [succ, count] : graph_.at(current).successors) {
+			if (succ == to) {
+				return true;
+			}
+			if ((!useOrder || graph_.at(succ).order < maxOrder) && visited.insert(succ).second) {
+				stack.emplace_back(succ);
+			}
+		}
 	}
 	return false;
 }
 
-bool Project::LinkGraph::depthFirstSearch(SEditorObject current, SEditorObject obj, SEditorObjectSet& visited) const {
-	if (current == obj) {
+bool Project::LinkGraph::createsLoop(const PropertyDescriptor& start, const PropertyDescriptor& end) const {
+	auto startObj = start.object();
+	auto endObj = end.object();
+	if (startObj == endObj) {
 		return true;
 	}
-	if (visited.find(current) != visited.end()) {
+	auto startIt = graph_.find(startObj.get());
+	auto endIt = graph_.find(endObj.get());
+	if (startIt == graph_.end() || endIt == graph_.end() || endIt->second.successors.empty()) {
 		return false;
 	}
-	auto it = graph.find(current);
-	if (it != graph.end()) {
-		for (auto depObj : it->second) {
-			if (depthFirstSearch(depObj, obj, visited)) {
-				return true;
-			}
+
+	if (!orderValid_ && orderRecomputePending_) {
+		orderRecomputePending_ = false;
+		orderValid_ = sortTopologically();
+	}
+	if (orderValid_) {
+		// A path end -> start requires end to be ordered before start.
+		if (endIt->second.order > startIt->second.order) {
+			return false;
 		}
+		return pathExists(endObj.get(), startObj.get(), true);
 	}
-	visited.insert(current);
-	return false;
+	return pathExists(endObj.get(), startObj.get(), false);
 }
 
 }  // namespace raco::core
\ No newline at end of file
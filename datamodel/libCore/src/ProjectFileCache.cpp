@@ -0,0 +1,173 @@
+/*
+ * SPDX-License-Identifier: MPL-2.0
+ *
+ * This file is part of Ramses Composer
+ * (see https://github.com/GENIVI/ramses-composer).
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "core/ProjectFileCache.h"
+
+#include "core/BinarySerialization.h"
+#include "core/RamsesProjectMigration.h"
+#include "log_system/log.h"
+#include "utils/stdfilesystem.h"
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+
+using namespace raco::serialization;
+
+constexpr size_t MAGIC_SIZE = sizeof(ProjectFileCache::ENTRY_MAGIC) - 1;
+
+// Everything an entry must match to be used for a project file.
+struct EntryKey {
+	QString path;
+	qint64 size = 0;
+	qint64 modified = 0;
+	QByteArray hash;
+	qint32 fileVersion = 0;
+	quint32 binaryFormatVersion = 0;
+
+	static EntryKey fromFile(const std::string& filePath, const QByteArray& fileData) {
+		QFileInfo info{QString::fromStdString(filePath)};
+		return {
+			info.absoluteFilePath(),
+			fileData.size(),
+			info.lastModified().toMSecsSinceEpoch(),
+			QCryptographicHash::hash(fileData, QCryptographicHash::Sha1),
+			raco::core::RAMSES_PROJECT_FILE_VERSION,
+			BINARY_PROJECT_FORMAT_VERSION};
+	}
+
+	bool operator==(const EntryKey& other) const {
+		return path == other.path && size == other.size && modified == other.modified && hash == other.hash &&
+			   fileVersion == other.fileVersion && binaryFormatVersion == other.binaryFormatVersion;
+	}
+};
+
+QDataStream& operator<<(QDataStream& stream, const EntryKey& key) {
+	return stream << key.path << key.size << key.modified << key.hash << key.fileVersion << key.binaryFormatVersion;
+}
+
+QDataStream& operator>>(QDataStream& stream, EntryKey& key) {
+	return stream >> key.path >> key.size >> key.modified >> key.hash >> key.fileVersion >> key.binaryFormatVersion;
+}
+
+}  // namespace
+
+namespace raco::serialization {
+
+ProjectFileCache::ProjectFileCache(const std::string& directory, int64_t maxSize) : directory_(directory), maxSize_(maxSize) {
+}
+
+const std::string& ProjectFileCache::directory() const {
+	return directory_;
+}
+
+int64_t ProjectFileCache::maxSize() const {
+	return maxSize_;
+}
+
+std::string ProjectFileCache::entryPath(const std::string& filePath) const {
+	auto absolutePath = QFileInfo(QString::fromStdString(filePath)).absoluteFilePath();
+	auto name = QCryptographicHash::hash(absolutePath.toUtf8(), QCryptographicHash::Sha1).toHex().toStdString();
+	return (std::filesystem::path(directory_) / (name + ENTRY_SUFFIX)).generic_string();
+}
+
+std::optional<BinaryProject> ProjectFileCache::lookup(const std::string& filePath, const QByteArray& fileData) const {
+	QFile file{QString::fromStdString(entryPath(filePath))};
+	if (!file.open(QIODevice::ReadOnly)) {
+		return {};
+	}
+
+	QDataStream stream{&file};
+	QByteArray magic(static_cast<int>(MAGIC_SIZE), '\0');
+	quint32 entryVersion = 0;
+	if (stream.readRawData(magic.data(), magic.size()) != magic.size() || std::memcmp(magic.constData(), ENTRY_MAGIC, MAGIC_SIZE) != 0) {
+		return {};
+	}
+	stream >> entryVersion;
+	if (entryVersion != ENTRY_FORMAT_VERSION) {
+		return {};
+	}
+
+	EntryKey key;
+	stream >> key;
+	if (stream.status() != QDataStream::Ok || !(key == EntryKey::fromFile(filePath, fileData))) {
+		LOG_DEBUG(raco::log_system::PROJECT, "Project cache entry for {} is outdated", filePath);
+		return {};
+	}
+
+	QByteArray binaryDocument;
+	stream >> binaryDocument;
+	if (stream.status() != QDataStream::Ok) {
+		return {};
+	}
+	try {
+		BinaryProject project{binaryDocument};
+		// Mark the entry as used for the eviction; changing the file time needs write access on some platforms.
+		file.close();
+		if (file.open(QIODevice::ReadWrite)) {
+			file.setFileTime(QDateTime::currentDateTime(), QFileDevice::FileModificationTime);
+		}
+		return project;
+	} catch (const std::runtime_error& error) {
+		LOG_WARNING(raco::log_system::PROJECT, "Ignoring invalid project cache entry for {}: {}", filePath, error.what());
+		return {};
+	}
+}
+
+bool ProjectFileCache::store(const std::string& filePath, const QByteArray& fileData, const QByteArray& binaryProject) const {
+	if (!QDir().mkpath(QString::fromStdString(directory_))) {
+		LOG_WARNING(raco::log_system::PROJECT, "Can't create project cache directory {}", directory_);
+		return false;
+	}
+
+	QSaveFile file{QString::fromStdString(entryPath(filePath))};
+	if (!file.open(QIODevice::WriteOnly)) {
+		LOG_WARNING(raco::log_system::PROJECT, "Can't write project cache entry for {}: {}", filePath, file.errorString().toStdString());
+		return false;
+	}
+
+	QDataStream stream{&file};
+	stream.writeRawData(ENTRY_MAGIC, static_cast<int>(MAGIC_SIZE));
+	stream << ENTRY_FORMAT_VERSION << EntryKey::fromFile(filePath, fileData) << binaryProject;
+	if (stream.status() != QDataStream::Ok || !file.commit()) {
+		LOG_WARNING(raco::log_system::PROJECT, "Can't write project cache entry for {}: {}", filePath, file.errorString().toStdString());
+		return false;
+	}
+	evict();
+	return true;
+}
+
+void ProjectFileCache::remove(const std::string& filePath) const {
+	QFile::remove(QString::fromStdString(entryPath(filePath)));
+}
+
+void ProjectFileCache::evict() const {
+	QDir dir{QString::fromStdString(directory_)};
+	// Most recently used first
+	auto entries = dir.entryInfoList({QString("*") + ENTRY_SUFFIX}, QDir::Files, QDir::Time);
+	int64_t totalSize = 0;
+	for (const auto& entry : entries) {
+		totalSize += entry.size();
+		if (totalSize > maxSize_) {
+			LOG_DEBUG(raco::log_system::PROJECT, "Removing least recently used project cache entry {}", entry.fileName().toStdString());
+			QFile::remove(entry.absoluteFilePath());
+		}
+	}
+}
+
+}  // namespace raco::serialization
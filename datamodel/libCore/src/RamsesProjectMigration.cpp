@@ -196,6 +196,50 @@ void iterateInstances(QJsonObject& documentObject, std::function<bool(QString co
 	documentObject[raco::serialization::keys::INSTANCES] = instances;
 }
 
+// Change of a single instance needed for files older than `version`. Returns true if the instance properties have been changed.
+struct InstanceMigration {
+	int version;
+	std::function<bool(QString const& instancetype, QJsonObject& instanceproperties)> migrate;
+};
+
+// Instance created by the migration in the format of file version `version`.
+struct CreatedInstance {
+	int version;
+	QJsonObject instance;
+};
+
+// Apply all migrations for versions newer than `fromVersion` to the instance in order. Returns true if the instance has been changed.
+bool migrateInstance(QJsonObject& instance, int fromVersion, const std::vector<InstanceMigration>& migrations) {
+	auto t = instance[raco::serialization::keys::TYPENAME].toString();
+	auto p = instance[raco::serialization::keys::PROPERTIES].toObject();
+	bool changed = false;
+	for (const auto& migration : migrations) {
+		if (fromVersion < migration.version && migration.migrate(t, p)) {
+			changed = true;
+		}
+	}
+	if (changed) {
+		instance[raco::serialization::keys::PROPERTIES] = p;
+	}
+	return changed;
+}
+
+// Migrate all instances of the document in a single traversal and append the created instances after migrating them from their own version.
+void migrateInstances(QJsonObject& documentObject, int documentVersion, const std::vector<InstanceMigration>& migrations, std::vector<CreatedInstance>& createdInstances) {
+	auto instances = documentObject[raco::serialization::keys::INSTANCES].toArray();
+	for (QJsonValueRef instance : instances) {
+		auto o = instance.toObject();
+		if (migrateInstance(o, documentVersion, migrations)) {
+			instance = o;
+		}
+	}
+	for (auto& created : createdInstances) {
+		migrateInstance(created.instance, created.version, migrations);
+		instances.push_back(created.instance);
+	}
+	documentObject[raco::serialization::keys::INSTANCES] = instances;
+}
+
 // Read a property from a JSON block for the properties of a RaCo object. The passed in property parameter must have the exact
 // type the property had when the migrated file version was saved, e. g. "data_storage::Property<data_storage::Vec4i, data_storage::DisplayNameAnnotation> property;"
 // Once the function returns, the value of the property can be extracted using property.as....().
@@ -334,18 +378,28 @@ QJsonDocument migrateProject(const QJsonDocument& document, std::unordered_map<s
 	using LinkEndAnnotation = core::LinkEndAnnotation;
 
 	int const documentVersion = raco::serialization::deserializeFileVersion(document);
+	if (documentVersion >= RAMSES_PROJECT_FILE_VERSION) {
+		return document;
+	}
+
+	// The per-instance changes of all versions are collected first and then applied in a single traversal of the
+	// instances by migrateInstances. Changes to links and scans needing the whole project are done immediately.
+	// They must not depend on instance changes of earlier versions.
+	std::vector<InstanceMigration> instanceMigrations;
+	std::vector<CreatedInstance> createdInstances;
+	auto factoryV9 = deserializationFactoryV9();
+	auto factory = deserializationFactoryV10plus();
+	std::set<std::string> childObjIds;
+	std::map<std::string, std::array<bool, 2>> objectsWithAffectedProperties;
 
 	QJsonObject documentObject{document.object()};
 	if (documentVersion < 2) {
-		auto instances = documentObject[raco::serialization::keys::INSTANCES].toArray();
-		instances.push_back(QJsonDocument::fromJson(serializedProjectSetting().c_str()).object());
-		documentObject[raco::serialization::keys::INSTANCES] = instances;
+		createdInstances.push_back({1, QJsonDocument::fromJson(serializedProjectSetting().c_str()).object()});
 	}
 
 	// No file version number change for this change: added RangeAnnotation to MeshNode instanceCount property
 	if (documentVersion < 2) {
-		auto factory = deserializationFactoryV10plus();
-		iterateInstances(documentObject, [&factory](QString const& instancetype, QJsonObject& instanceproperties) {
+		instanceMigrations.push_back({2, [&factory](QString const& instancetype, QJsonObject& instanceproperties) {
 			if (instancetype == "MeshNode") {
 				Property<int, DisplayNameAnnotation> oldInstanceCount;
 				extractprop(factory, instanceproperties, u"instanceCount", oldInstanceCount);
@@ -355,18 +409,18 @@ QJsonDocument migrateProject(const QJsonDocument& document, std::unordered_map<s
 				return true;
 			}
 			return false;
-		});
+		}});
 	}
 
 	// File Version 3: added ProjectSettings viewport property
 	if (documentVersion < 3) {
-		iterateInstances(documentObject, [](QString const& instancetype, QJsonObject& instanceproperties) {
+		instanceMigrations.push_back({3, [](QString const& instancetype, QJsonObject& instanceproperties) {
 			if (instancetype == "ProjectSettings") {
 				addprop(instanceproperties, u"viewport", Property<Vec2i, DisplayNameAnnotation>{{{1440, 720}, 0, 4096}, {"Viewport"}});
 				return true;
 			}
 			return false;
-		});
+		}});
 	}
 
 
@@ -379,21 +433,20 @@ QJsonDocument migrateProject(const QJsonDocument& document, std::unordered_map<s
 
 	// Added without file version number change somewhere before V10.
 	if (documentVersion < 10) {
-		iterateInstances(documentObject, [](QString const& instancetype, QJsonObject& instanceproperties) {
+		instanceMigrations.push_back({10, [](QString const& instancetype, QJsonObject& instanceproperties) {
 			if (instancetype == "ProjectSettings") {
 				addprop(instanceproperties, u"enableTimerFlag", Property<bool, HiddenProperty>{false, HiddenProperty()});
 				addprop(instanceproperties, u"runTimer", Property<bool, HiddenProperty>{false, HiddenProperty()});
 				return true;
 			}
 			return false;
-		});
+		}});
 	}
 
 
 	// File Version 10: cameras store viewport as four individual integers instead of a vec4i (for camera bindings).
 	if (documentVersion < 10) {
-		auto factory = deserializationFactoryV9();
-		iterateInstances(documentObject, [&factory](QString const& instancetype, QJsonObject& instanceproperties) {
+		instanceMigrations.push_back({10, [&factoryV9](QString const& instancetype, QJsonObject& instanceproperties) {
 			if (instancetype != "PerspectiveCamera" && instancetype != "OrthographicCamera") {
 				return false;
 			}
@@ -406,18 +459,18 @@ QJsonDocument migrateProject(const QJsonDocument& document, std::unordered_map<s
 			addprop(instanceproperties, u"viewPortWidth", data_storage::Property<int, RangeAnnotation<int>, data_storage::DisplayNameAnnotation, core::LinkEndAnnotation>{oldviewportprop.asVec4i().i3_.asInt(), {0, 7680}, {"Viewport Width"}, {}});
 			addprop(instanceproperties, u"viewPortHeight", data_storage::Property<int, RangeAnnotation<int>, data_storage::DisplayNameAnnotation, core::LinkEndAnnotation>{oldviewportprop.asVec4i().i4_.asInt(), {0, 7680}, {"Viewport Height"}, {}});
 			return true;
-		});
+		}});
 	}
 	
 	// File Version 11: Added the viewport background color to the ProjectSettings.
 	if (documentVersion < 11) {
-		iterateInstances(documentObject, [](QString const& instancetype, QJsonObject& instanceproperties) {
+		instanceMigrations.push_back({11, [](QString const& instancetype, QJsonObject& instanceproperties) {
 			if (instancetype == "ProjectSettings") {
 				addprop(instanceproperties, u"backgroundColor", data_storage::Property<Vec3f, DisplayNameAnnotation>{{}, {"Display Background Color"}});
 				return true;
 			}
 			return false;
-		});
+		}});
 	}
 
 
@@ -426,8 +479,7 @@ QJsonDocument migrateProject(const QJsonDocument& document, std::unordered_map<s
 	// Rename 'depthfunction' ->  'depthFunction' in options container of meshnode material slot.
 	// Add LinkEndAnnotation to material uniform properties
 	if (documentVersion < 12) {
-		auto factory = deserializationFactoryV10plus();
-		iterateInstances(documentObject, [&factory](const QString& instanceType, QJsonObject& instanceproperties) {
+		instanceMigrations.push_back({12, [&factory](const QString& instanceType, QJsonObject& instanceproperties) {
 			if (instanceType == "MeshNode" && instanceproperties.contains(u"materials")) {
 				Property<Table, DisplayNameAnnotation> materials;
 
@@ -466,13 +518,12 @@ QJsonDocument migrateProject(const QJsonDocument& document, std::unordered_map<s
 			}
 
 			return false;
-		});
+		}});
 	}
 
 	// File version 13: introduction of struct properties for camera viewport, frustum, and material/meshnode blend options
 	if (documentVersion < 13) {
-		auto factory = deserializationFactoryV10plus();
-		iterateInstances(documentObject, [&factory](const QString& instanceType, QJsonObject& instanceproperties) {
+		instanceMigrations.push_back({13, [&factory](const QString& instanceType, QJsonObject& instanceproperties) {
 			bool changed = false;
 			if (instanceType == "PerspectiveCamera" || instanceType == "OrthographicCamera") {
 				Property<int, RangeAnnotation<int>, DisplayNameAnnotation, LinkEndAnnotation> offsetX{0, {-7680, 7680}, {"Viewport Offset X"}, {}};
@@ -633,7 +684,7 @@ QJsonDocument migrateProject(const QJsonDocument& document, std::unordered_map<s
 			}			
 
 			return changed;
-		});
+		}});
 
 		std::vector<SLink> links;
 		auto inJsonLinks = documentObject[raco::serialization::keys::LINKS].toArray();
@@ -671,8 +722,7 @@ QJsonDocument migrateProject(const QJsonDocument& document, std::unordered_map<s
 	}
 
 	if (documentVersion < 14) {
-		auto factory = deserializationFactoryV10plus();
-		iterateInstances(documentObject, [&factory](const QString& instanceType, QJsonObject& instanceproperties) {
+		instanceMigrations.push_back({14, [&factory](const QString& instanceType, QJsonObject& instanceproperties) {
 			bool changed = false;
 			if (instanceType == "Texture") {
 				Property<int, DisplayNameAnnotation, EnumerationAnnotation> origin{ DEFAULT_VALUE_TEXTURE_ORIGIN_BOTTOM, DisplayNameAnnotation("U/V Origin"), EnumerationAnnotation{EngineEnumeration::TextureOrigin}};
@@ -687,15 +737,14 @@ QJsonDocument migrateProject(const QJsonDocument& document, std::unordered_map<s
 			}
 
 			return changed;
-		});
+		}});
 	}
 
 	// File version 15: offscreen rendering
 	// - changed texture uniform type for normal 2D textures from STexture -> STextureSampler2DBase
 	if (documentVersion < 15) {
-		auto factory = deserializationFactoryV10plus();
 
-		iterateInstances(documentObject, [&factory](const QString& instanceType, QJsonObject& instanceproperties) {
+		instanceMigrations.push_back({15, [&factory](const QString& instanceType, QJsonObject& instanceproperties) {
 			bool changed = false;
 
 			auto migrateUniforms = [](Table& uniforms, raco::serialization::References& references) {
@@ -728,8 +777,6 @@ QJsonDocument migrateProject(const QJsonDocument& document, std::unordered_map<s
 				changed = true;
 			}
 
-			auto sprops = QString(QJsonDocument(instanceproperties).toJson()).toStdString();
-
 			if (instanceType == "MeshNode" && instanceproperties.contains(u"materials")) {
 				Property<Table, DisplayNameAnnotation> materials;
 				auto references = readprop(factory, instanceproperties, u"materials", materials);
@@ -746,13 +793,12 @@ QJsonDocument migrateProject(const QJsonDocument& document, std::unordered_map<s
 			}
 
 			return changed;
-		});
+		}});
 
 		// create default render setup
 		// - tag top-level Nodes with "render_main" tag
 		// - create default RenderLayer and RenderPass 
 		
-		std::set<std::string> childObjIds;
 		std::string perspCameraID;
 		std::string orthoCameraID;
 		iterateInstances(documentObject, [&factory, &childObjIds, &perspCameraID, &orthoCameraID](const QString& instanceType, QJsonObject& instanceproperties) {
@@ -784,7 +830,7 @@ QJsonDocument migrateProject(const QJsonDocument& document, std::unordered_map<s
 			return false;
 		});
 
-		iterateInstances(documentObject, [&factory, &childObjIds](const QString& instanceType, QJsonObject& instanceproperties) {
+		instanceMigrations.push_back({15, [&factory, &childObjIds](const QString& instanceType, QJsonObject& instanceproperties) {
 			if (instanceType == "Node" || instanceType == "MeshNode" || instanceType == "PrefabInstance") {
 				Property<std::string, HiddenProperty> objectID{std::string(), HiddenProperty()};
 				readprop(factory, instanceproperties, u"objectID", objectID);
@@ -799,21 +845,16 @@ QJsonDocument migrateProject(const QJsonDocument& document, std::unordered_map<s
 			}
 
 			return false;
-		});
+		}});
 
 		std::string cameraID = perspCameraID.empty() ? orthoCameraID : perspCameraID;
 
-		auto instances = documentObject[raco::serialization::keys::INSTANCES].toArray();
 		auto layerID = QUuid::createUuid().toString(QUuid::WithoutBraces).toStdString();
-		instances.push_back(QJsonDocument::fromJson(serializedRenderLayerV14(layerID).c_str()).object());
-		instances.push_back(QJsonDocument::fromJson(serializedRenderPassV14(layerID, cameraID).c_str()).object());
-
-		documentObject[raco::serialization::keys::INSTANCES] = instances;
+		createdInstances.push_back({15, QJsonDocument::fromJson(serializedRenderLayerV14(layerID).c_str()).object()});
+		createdInstances.push_back({15, QJsonDocument::fromJson(serializedRenderPassV14(layerID, cameraID).c_str()).object()});
 	}
 
 	if (documentVersion < 16) {
-		auto factory = deserializationFactoryV10plus();
-		std::map<std::string, std::array<bool, 2>> objectsWithAffectedProperties;
 
 		auto inJsonLinks = documentObject[raco::serialization::keys::LINKS].toArray();
 		for (const auto& linkJson : inJsonLinks) {
@@ -832,7 +873,7 @@ QJsonDocument migrateProject(const QJsonDocument& document, std::unordered_map<s
 			}
 		}
 
-		iterateInstances(documentObject, [&migrationWarnings, &objectsWithAffectedProperties, &factory](const QString& instanceType, QJsonObject& instanceproperties) {
+		instanceMigrations.push_back({16, [&migrationWarnings, &objectsWithAffectedProperties, &factory](const QString& instanceType, QJsonObject& instanceproperties) {
 			if (instanceType != "Node" && instanceType != "MeshNode") {
 				return false;
 			}
@@ -875,13 +916,12 @@ QJsonDocument migrateProject(const QJsonDocument& document, std::unordered_map<s
 			}
 
 			return changed;
-		});
+		}});
 	}
 
 	// File version 17: removed "Optimized" option from render layer sort options
 	if (documentVersion < 17) {
-		auto factory = deserializationFactoryV10plus();
-		iterateInstances(documentObject, [&factory](const QString& instanceType, QJsonObject& instanceproperties) {
+		instanceMigrations.push_back({17, [&factory](const QString& instanceType, QJsonObject& instanceproperties) {
 			if (instanceType != "RenderLayer") {
 				return false;
 			}
@@ -906,13 +946,12 @@ QJsonDocument migrateProject(const QJsonDocument& document, std::unordered_map<s
 			}
 			addprop(instanceproperties, u"sortOrder", sortOrder);
 			return true;
-		});
+		}});
 	}
 
 	// File version 19: Changed ProjectSettings::backgroundColor from Vec3f to Vec4f
 	if (documentVersion < 19) {
-		auto factory = deserializationFactoryV10plus();
-		iterateInstances(documentObject, [&factory](const QString& instanceType, QJsonObject& instanceproperties) {
+		instanceMigrations.push_back({19, [&factory](const QString& instanceType, QJsonObject& instanceproperties) {
 			if (instanceType != "ProjectSettings") {
 				return false;
 			}
@@ -929,13 +968,12 @@ QJsonDocument migrateProject(const QJsonDocument& document, std::unordered_map<s
 				bgColor4Vec, { "Display Background Color" }
 			});
 			return true;
-		});
+		}});
 	}
 
 	// File version 21: Added mipmap flag to textures
 	if (documentVersion < 21) {
-		auto factory = deserializationFactoryV10plus();
-		iterateInstances(documentObject, [&factory](const QString& instanceType, QJsonObject& instanceproperties) {
+		instanceMigrations.push_back({21, [&factory](const QString& instanceType, QJsonObject& instanceproperties) {
 			if (instanceType != "Texture") {
 				return false;
 			}
@@ -945,9 +983,23 @@ QJsonDocument migrateProject(const QJsonDocument& document, std::unordered_map<s
 			addprop(instanceproperties, u"generateMipmaps", generateMipMaps);
 			
 			return true;
-		});
+		}});
+	}
+
+	// File version 22: Added mesh optimization flag to meshes
+	if (documentVersion < 22) {
+		instanceMigrations.push_back({22, [](const QString& instanceType, QJsonObject& instanceproperties) {
+			if (instanceType != "Mesh") {
+				return false;
+			}
+			Property<bool, DisplayNameAnnotation> optimizeMesh{false, DisplayNameAnnotation("Optimize Mesh")};
+			addprop(instanceproperties, u"optimizeMesh", optimizeMesh);
+			return true;
+		}});
 	}
 	
+	migrateInstances(documentObject, documentVersion, instanceMigrations, createdInstances);
+
 	QJsonDocument newDocument{documentObject};
 	// for debugging:
 	//auto migratedJSON = QString(newDocument.toJson()).toStdString();
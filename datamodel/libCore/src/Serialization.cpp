@@ -11,6 +11,7 @@
 #include "core/SerializationKeys.h"
 
 #include "data_storage/Table.h"
+#include "utils/ParallelUtils.h"
 #include "utils/stdfilesystem.h"
 #include "log_system/log.h"
 
@@ -525,9 +526,10 @@ std::string raco::serialization::serializeObjects(const std::vector<SReflectionI
 	return QJsonDocument{result}.toJson().toStdString();
 }
 
-QJsonDocument raco::serialization::serializeProject(const std::unordered_map<std::string, std::vector<int>>& fileVersions, const std::vector<SReflectionInterface>& instances, const std::vector<SReflectionInterface>& links, 
-	const std::map<std::string, ExternalProjectInfo>& externalProjectsMap, 
-	const ResolveReferencedId& resolveReferenceId) {
+namespace {
+
+/** Creates the project container with everything except the instances and links. */
+QJsonObject serializeProjectHeader(const std::unordered_map<std::string, std::vector<int>>& fileVersions, const std::map<std::string, ExternalProjectInfo>& externalProjectsMap) {
 	QJsonObject container{};
 
 	auto ramsesVer = fileVersions.at(keys::RAMSES_VERSION);
@@ -539,6 +541,53 @@ QJsonDocument raco::serialization::serializeProject(const std::unordered_map<std
 	container.insert(keys::RAMSES_COMPOSER_VERSION, QJsonArray{raCoVersion[0], raCoVersion[1], raCoVersion[2]});
 
 	serializeExternalProjectsMap(container, externalProjectsMap);
+	return container;
+}
+
+/**
+ * Formats `value` exactly like QJsonDocument::toJson formats an array element at nesting level `depth`, without the
+ * indentation of the first line. This is done by letting Qt format the value wrapped into `depth` single-element arrays
+ * and cutting off the brackets and indentation of the wrappers.
+ */
+QByteArray toNestedJson(const QJsonValue& value, int depth) {
+	QJsonArray wrapped;
+	wrapped.append(value);
+	for (int level = 1; level < depth; level++) {
+		QJsonArray outer;
+		outer.append(wrapped);
+		wrapped = outer;
+	}
+	int prefix = 4 * depth;
+	int suffix = 1;
+	for (int level = 0; level < depth; level++) {
+		prefix += 4 * level + 2;
+		suffix += 4 * level + 2;
+	}
+	auto json = QJsonDocument{wrapped}.toJson();
+	return json.mid(prefix, json.size() - prefix - suffix);
+}
+
+bool writeJsonArray(QIODevice& device, const std::vector<SReflectionInterface>& objects, const InstanceFragmentFunction& fragment) {
+	bool success = device.write("[\n") != -1;
+	for (size_t index = 0; index < objects.size() && success; index++) {
+		auto json = fragment(objects[index]);
+		success = device.write("        ") != -1 &&
+				  device.write(json) != -1 &&
+				  device.write(index + 1 < objects.size() ? ",\n" : "\n") != -1;
+	}
+	return success && device.write("    ]") != -1;
+}
+
+}  // namespace
+
+QByteArray raco::serialization::serializeInstanceFragment(const ReflectionInterface& object, const ResolveReferencedId& resolveReferenceId) {
+	return toNestedJson(serializeTypedObject(object, resolveReferenceId), 2);
+}
+
+QJsonDocument raco::serialization::serializeProject(const std::unordered_map<std::string, std::vector<int>>& fileVersions, const std::vector<SReflectionInterface>& instances, const std::vector<SReflectionInterface>& links, 
+	const std::map<std::string, ExternalProjectInfo>& externalProjectsMap, 
+	const ResolveReferencedId& resolveReferenceId) {
+	QJsonObject container{serializeProjectHeader(fileVersions, externalProjectsMap)};
 
 	QJsonArray objectArray{};
 	for (const auto& object : instances) {
@@ -553,6 +602,65 @@ QJsonDocument raco::serialization::serializeProject(const std::unordered_map<std
 	return QJsonDocument{container};
 }
 
+bool raco::serialization::writeProject(QIODevice& device, const std::unordered_map<std::string, std::vector<int>>& fileVersions, const std::vector<SReflectionInterface>& instances, const std::vector<SReflectionInterface>& links,
+	const std::map<std::string, ExternalProjectInfo>& externalProjectsMap,
+	const ResolveReferencedId& resolveReferenceId,
+	const InstanceFragmentFunction& instanceFragment) {
+	auto serializeFragment = [&resolveReferenceId](const SReflectionInterface& object) {
+		return serializeInstanceFragment(*object, resolveReferenceId);
+	};
+
+	// The placeholders make the header iterate over all top-level keys in the order QJsonObject sorts them.
+	QJsonObject container{serializeProjectHeader(fileVersions, externalProjectsMap)};
+	container.insert(keys::INSTANCES, QJsonArray{});
+	container.insert(keys::LINKS, QJsonArray{});
+
+	bool success = device.write("{\n") != -1;
+	for (auto it = container.begin(); it != container.end() && success; ++it) {
+		success = device.write("    ") != -1 &&
+				  device.write(toNestedJson(it.key(), 1)) != -1 &&
+				  device.write(": ") != -1;
+		if (success) {
+			if (it.key() == keys::INSTANCES) {
+				success = writeJsonArray(device, instances, instanceFragment ? instanceFragment : InstanceFragmentFunction{serializeFragment});
+			} else if (it.key() == keys::LINKS) {
+				success = writeJsonArray(device, links, serializeFragment);
+			} else {
+				success = device.write(toNestedJson(it.value(), 1)) != -1;
+			}
+		}
+		success = success && device.write(it + 1 != container.end() ? ",\n" : "\n") != -1;
+	}
+	return success && device.write("}\n") != -1;
+}
+
+namespace {
+
+// Below this number of objects per thread, starting a thread costs more than it saves.
+constexpr size_t MIN_OBJECTS_PER_THREAD = 500;
+
+/**
+ * Deserializes the typed objects of `array` on multiple threads. The objects are independent of each other until
+ * the references are resolved. Every chunk collects its references separately and the chunk maps are merged
+ * afterwards, so the result does not depend on the thread scheduling.
+ */
+std::vector<SReflectionInterface> deserializeTypedObjects(const QJsonArray& array, const DeserializationFactory& factory, References& references) {
+	const auto count = static_cast<size_t>(array.size());
+	std::vector<SReflectionInterface> objects(count);
+	std::vector<References> chunkReferences(raco::utils::parallel::chunkCount(count, MIN_OBJECTS_PER_THREAD));
+	raco::utils::parallel::forEachChunk(count, MIN_OBJECTS_PER_THREAD, [&array, &factory, &objects, &chunkReferences](size_t chunk, size_t begin, size_t end) {
+		for (size_t index = begin; index < end; index++) {
+			objects[index] = deserializeTypedObject(array[static_cast<int>(index)].toObject(), factory, chunkReferences[chunk]);
+		}
+	});
+	for (auto& chunk : chunkReferences) {
+		references.merge(chunk);
+	}
+	return objects;
+}
+
+}  // namespace
+
 ProjectDeserializationInfo raco::serialization::deserializeProjectVersionInfo(const QJsonDocument& document) {
 	ProjectDeserializationInfo deserializedProjectInfo;
 
@@ -572,16 +680,8 @@ ProjectDeserializationInfo raco::serialization::deserializeProject(const QJsonDo
 
 	deserializeExternalProjectsMap(document[keys::EXTERNAL_PROJECTS].toVariant(), deserializedProjectInfo.objectsDeserialization.externalProjectsMap);
 
-	const auto instances = document[keys::INSTANCES].toArray();
-	deserializedProjectInfo.objectsDeserialization.objects.reserve(instances.size());
-	for (const auto& instance : instances) {
-		deserializedProjectInfo.objectsDeserialization.objects.push_back(deserializeTypedObject(instance.toObject(), factory, deserializedProjectInfo.objectsDeserialization.references));
-	}
-	const auto links = document[keys::LINKS].toArray();
-	deserializedProjectInfo.objectsDeserialization.links.reserve(links.size());
-	for (const auto& link : links) {
-		deserializedProjectInfo.objectsDeserialization.links.push_back(deserializeTypedObject(link.toObject(), factory, deserializedProjectInfo.objectsDeserialization.references));
-	}
+	deserializedProjectInfo.objectsDeserialization.objects = deserializeTypedObjects(document[keys::INSTANCES].toArray(), factory, deserializedProjectInfo.objectsDeserialization.references);
+	deserializedProjectInfo.objectsDeserialization.links = deserializeTypedObjects(document[keys::LINKS].toArray(), factory, deserializedProjectInfo.objectsDeserialization.references);
 	return deserializedProjectInfo;
 }
 
@@ -0,0 +1,54 @@
+/*
+ * SPDX-License-Identifier: MPL-2.0
+ *
+ * This file is part of Ramses Composer
+ * (see https://github.com/GENIVI/ramses-composer).
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "core/SerializationCache.h"
+
+#include "core/ChangeRecorder.h"
+
+namespace raco::core {
+
+SerializationCache::SerializationCache(const serialization::ResolveReferencedId& resolveReferenceId) : resolveReferenceId_(resolveReferenceId) {
+}
+
+QByteArray SerializationCache::instanceFragment(const serialization::SReflectionInterface& object) {
+	auto it = entries_.find(object.get());
+	if (it != entries_.end() && it->second.object.lock() == object) {
+		return it->second.fragment;
+	}
+	auto fragment = serialization::serializeInstanceFragment(*object, resolveReferenceId_);
+	entries_[object.get()] = {object, fragment};
+	++serializedCount_;
+	return fragment;
+}
+
+void SerializationCache::invalidate(const DataChangeRecorder& changes) {
+	if (entries_.empty()) {
+		return;
+	}
+	for (const auto& object : changes.getAllChangedObjects()) {
+		entries_.erase(object.get());
+	}
+	for (const auto& object : changes.getDeletedObjects()) {
+		entries_.erase(object.get());
+	}
+}
+
+void SerializationCache::clear() {
+	entries_.clear();
+}
+
+size_t SerializationCache::size() const {
+	return entries_.size();
+}
+
+size_t SerializationCache::serializedCount() const {
+	return serializedCount_;
+}
+
+}  // namespace raco::core
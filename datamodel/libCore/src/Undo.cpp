@@ -14,13 +14,23 @@
 #include "core/EditorObject.h"
 #include "core/ExternalReferenceAnnotation.h"
 #include "core/Project.h"
+#include "core/Serialization.h"
 #include "core/UserObjectFactoryInterface.h"
 #include "core/Link.h"
 #include "data_storage/ReflectionInterface.h"
 #include "data_storage/Table.h"
 #include "data_storage/Value.h"
+#include "log_system/log.h"
 
+#include <QCborValue>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QTemporaryFile>
+#include <algorithm>
 #include <cassert>
+#include <iterator>
+#include <map>
+#include <set>
 
 namespace raco::core {
 
@@ -181,108 +191,433 @@ void updateEditorObject(const EditorObject *src, SEditorObject dest, translateRe
 }
 
 
-void UndoStack::saveProjectState(const Project *src, Project *dest, Project *ref, const DataChangeRecorder &changes, UserObjectFactoryInterface &factory) {
-	assert(dest->links().empty());
-	assert(dest->linkStartPoints().empty());
-	assert(dest->linkEndPoints().empty());
-	assert(dest->instances().empty());
+namespace {
 
-	SEditorObjectSet dirtyObjects;
-	if (ref) {
-		dirtyObjects = changes.getAllChangedObjects();
-	} else {
-		std::copy(src->instances().begin(), src->instances().end(), std::inserter(dirtyObjects, dirtyObjects.end()));
+ValueBase* resolvePropertyPath(ReflectionInterface& object, const std::vector<std::string>& propertyPath) {
+	ReflectionInterface* o = &object;
+	ValueBase* v = nullptr;
+	for (const auto& name : propertyPath) {
+		if (v) {
+			if (!hasTypeSubstructure(v->type())) {
+				return nullptr;
+			}
+			o = &v->getSubstructure();
+		}
+		v = o->get(name);
+		if (!v) {
+			return nullptr;
+		}
+	}
+	return v;
+}
+
+// Collect the property paths of all changed values of an object.
+// - paths end before the first array element since array elements can't be identified by name.
+// - paths are shortened until they can be resolved in both the source and destination object with matching classes.
+void collectChangedPaths(const std::set<ValueHandle>& handles, EditorObject& srcObj, EditorObject& destObj, std::set<std::vector<std::string>>& paths) {
+	for (const auto& handle : handles) {
+		if (!handle || handle.isObject()) {
+			for (size_t index = 0; index < srcObj.size(); index++) {
+				paths.insert(std::vector<std::string>{srcObj.name(index)});
+			}
+			continue;
+		}
+
+		auto names = handle.getPropertyNamesVector();
+		auto arrayIt = std::find(names.begin(), names.end(), std::string());
+		names.erase(arrayIt, names.end());
+		while (names.size() > 1) {
+			auto srcValue = resolvePropertyPath(srcObj, names);
+			auto destValue = resolvePropertyPath(destObj, names);
+			if (srcValue && destValue && ValueBase::classesEqual(*srcValue, *destValue)) {
+				break;
+			}
+			names.pop_back();
+		}
+		if (!names.empty()) {
+			paths.insert(names);
+		}
+	}
+}
+
+// Remove all paths nested inside other paths of the set.
+std::vector<std::vector<std::string>> outermostPaths(const std::set<std::vector<std::string>>& paths) {
+	std::vector<std::vector<std::string>> result;
+	for (const auto& path : paths) {
+		// Lexicographic order puts nested paths directly behind their enclosing path.
+		if (result.empty() || !(result.back().size() < path.size() && std::equal(result.back().begin(), result.back().end(), path.begin()))) {
+			result.emplace_back(path);
+		}
 	}
+	return result;
+}
+
+size_t estimateSize(const ValueBase* value);
+
+size_t estimateSize(const ReflectionInterface& object) {
+	size_t result = 0;
+	for (size_t index = 0; index < object.size(); index++) {
+		result += object.name(index).capacity() + estimateSize(object.get(index));
+	}
+	return result;
+}
+
+size_t estimateSize(const ValueBase* value) {
+	size_t result = sizeof(Value<SEditorObject>) + value->baseAnnotationPtrs().size() * (sizeof(AnnotationBase*) + sizeof(Value<bool>));
+	switch (value->type()) {
+		case PrimitiveType::String:
+			result += value->asString().capacity();
+			break;
+		case PrimitiveType::Table:
+			result += value->asTable().size() * sizeof(std::pair<std::string, std::unique_ptr<ValueBase>>);
+			result += estimateSize(value->getSubstructure());
+			break;
+		default:
+			if (hasTypeSubstructure(value->type())) {
+				result += estimateSize(value->getSubstructure());
+			}
+			break;
+	}
+	return result;
+}
+
+size_t estimateSize(const SLink& link) {
+	return sizeof(Link) + estimateSize(*link);
+}
+
+namespace spill_keys {
+constexpr const char* CREATED_OBJECTS = "createdObjects";
+constexpr const char* DELETED_OBJECTS = "deletedObjects";
+constexpr const char* CHANGED_VALUES = "changedValues";
+constexpr const char* OBJECT = "object";
+constexpr const char* PATH = "path";
+constexpr const char* VALUE = "value";
+constexpr const char* ADDED_LINKS = "addedLinks";
+constexpr const char* REMOVED_LINKS = "removedLinks";
+constexpr const char* VALIDITY_CHANGED_LINKS = "validityChangedLinks";
+constexpr const char* EXTERNAL_PROJECTS = "externalProjects";
+constexpr const char* EXTERNAL_PROJECT_PATH = "path";
+constexpr const char* EXTERNAL_PROJECT_NAME = "name";
+}  // namespace spill_keys
+
+std::optional<std::string> resolveReferenceId(const ValueBase& value) {
+	if (auto object = value.asRef()) {
+		return object->objectID();
+	}
+	return {};
+}
+
+// Deserialization doesn't touch null references and only adds missing Table properties:
+// reset these in a cloned value to get the serialized state.
+void resetForDeserialization(ValueBase& value) {
+	switch (value.type()) {
+		case PrimitiveType::Ref:
+			value = SEditorObject();
+			break;
+		case PrimitiveType::Table:
+			value.asTable().clear();
+			break;
+		default:
+			if (hasTypeSubstructure(value.type())) {
+				auto& substructure = value.getSubstructure();
+				for (size_t index = 0; index < substructure.size(); index++) {
+					resetForDeserialization(*substructure.get(index));
+				}
+			}
+			break;
+	}
+}
+
+QJsonArray serializeLinks(const std::vector<SLink>& links) {
+	QJsonArray result;
+	for (const auto& link : links) {
+		result.push_back(serialization::serializeTypedObject(*link, resolveReferenceId));
+	}
+	return result;
+}
+
+}  // namespace
+
+size_t UndoStack::Entry::estimateMemoryUsage() const {
+	size_t result = sizeof(Entry) + description.capacity() + mergeId.capacity();
+	for (const auto& object : createdObjects) {
+		result += estimateSize(*object);
+	}
+	for (const auto& object : deletedObjects) {
+		result += estimateSize(*object);
+	}
+	for (const auto& change : changedValues) {
+		result += sizeof(ValueChange) + estimateSize(change.value.get());
+		for (const auto& name : change.propertyPath) {
+			result += sizeof(std::string) + name.capacity();
+		}
+	}
+	for (const auto& links : {&addedLinks, &removedLinks, &validityChangedLinks}) {
+		for (const auto& link : *links) {
+			result += estimateSize(link);
+		}
+	}
+	for (const auto& [projectID, info] : externalProjectsMap) {
+		result += projectID.capacity() + info.path.capacity() + info.name.capacity();
+	}
+	return result;
+}
+
+void UndoStack::Entry::collectModifiedIDs(std::set<std::string> &objectIDs, std::set<std::string> &linkEndObjectIDs) const {
+	for (const auto *objects : {&createdObjects, &deletedObjects}) {
+		for (const auto &object : *objects) {
+			objectIDs.insert(object->objectID());
+		}
+	}
+	for (const auto &change : changedValues) {
+		objectIDs.insert(change.object->objectID());
+	}
+	for (const auto *links : {&addedLinks, &removedLinks, &validityChangedLinks}) {
+		for (const auto &link : *links) {
+			linkEndObjectIDs.insert((*link->endObject_)->objectID());
+		}
+	}
+}
+
+void UndoStack::saveProjectState(const Project *src, UserObjectFactoryInterface &factory) {
+	state_ = Project();
 
 	for (const auto &srcObj : src->instances()) {
-		if (!ref || dirtyObjects.find(srcObj) != dirtyObjects.end()) {
-			// changed -> create new object
-			auto destObj = factory.createObject(srcObj->getTypeDescription().typeName, srcObj->objectName(), srcObj->objectID());
-			dest->addInstance(destObj);
-		} else {
-			// unchanged -> use object from ref
-			dest->addInstance(ref->getInstanceByID(srcObj->objectID()));
+		state_.addInstance(factory.createObject(srcObj->getTypeDescription().typeName, srcObj->objectName(), srcObj->objectID()));
+	}
+
+	auto translateRef = [this](SEditorObject srcObj) -> SEditorObject {
+		if (srcObj) {
+			return state_.getInstanceByID(srcObj->objectID());
 		}
+		return nullptr;
+	};
+
+	for (const auto &srcObj : src->instances()) {
+		updateEditorObject(
+			srcObj.get(), state_.getInstanceByID(srcObj->objectID()), translateRef, [](const std::string &) { return false; }, factory, nullptr, false);
 	}
 
-	auto translateRef = [dest](SEditorObject srcObj) -> SEditorObject {
+	for (const auto &srcLink : src->links()) {
+		state_.addLink(Link::cloneLinkWithTranslation(srcLink, translateRef));
+	}
+
+	state_.externalProjectsMap_ = src->externalProjectsMap_;
+}
+
+void UndoStack::saveProjectState(const Project *src, Entry &entry, const DataChangeRecorder &changes, UserObjectFactoryInterface &factory) {
+	auto translateRef = [this](SEditorObject srcObj) -> SEditorObject {
 		if (srcObj) {
-			return dest->getInstanceByID(srcObj->objectID());
+			return state_.getInstanceByID(srcObj->objectID());
 		}
 		return nullptr;
 	};
 
-	for (const auto &srcObj : dirtyObjects) {
-		auto destObj = dest->getInstanceByID(srcObj->objectID());
+	// Remove deleted objects
+	SEditorObjectSet toRemove;
+	for (const auto &srcObj : changes.getDeletedObjects()) {
+		if (auto destObj = state_.getInstanceByID(srcObj->objectID())) {
+			toRemove.insert(destObj);
+		}
+	}
+	// Objects may get recreated with the same object id, e.g. by the external reference update.
+	for (const auto &srcObj : changes.getCreatedObjects()) {
+		if (auto destObj = state_.getInstanceByID(srcObj->objectID())) {
+			toRemove.insert(destObj);
+		}
+	}
+	if (!toRemove.empty()) {
+		// Keep the instance order stable for undo
+		std::copy_if(state_.instances().begin(), state_.instances().end(), std::back_inserter(entry.deletedObjects), [&toRemove](const SEditorObject &obj) {
+			return toRemove.find(obj) != toRemove.end();
+		});
+		state_.removeInstances(toRemove, false);
+	}
+
+	// Create and fill new objects
+	std::vector<SEditorObject> created;
+	if (!changes.getCreatedObjects().empty()) {
+		std::copy_if(src->instances().begin(), src->instances().end(), std::back_inserter(created), [&changes](const SEditorObject &obj) {
+			return changes.getCreatedObjects().find(obj) != changes.getCreatedObjects().end();
+		});
+	}
+	for (const auto &srcObj : created) {
+		auto destObj = factory.createObject(srcObj->getTypeDescription().typeName, srcObj->objectName(), srcObj->objectID());
+		state_.addInstance(destObj);
+		entry.createdObjects.emplace_back(destObj);
+	}
+	for (const auto &srcObj : created) {
 		updateEditorObject(
-			srcObj.get(), destObj, translateRef, [](const std::string &) { return false; }, factory, nullptr, false);
+			srcObj.get(), translateRef(srcObj), translateRef, [](const std::string &) { return false; }, factory, nullptr, false);
 	}
 
+	updateProjectState(src, entry, changes, factory);
+
+	// Update links
 	for (const auto &srcLink : src->links()) {
-		if (!ref || changes.isLinkAdded(srcLink) || changes.isLinkValidityChanged(srcLink)) {
-			dest->addLink(Link::cloneLinkWithTranslation(srcLink, translateRef));
-		} else {
-			dest->addLink(ref->findLinkByObjectID(srcLink));
+		auto destLink = state_.findLinkByObjectID(srcLink);
+		if (!destLink) {
+			destLink = Link::cloneLinkWithTranslation(srcLink, translateRef);
+			state_.addLink(destLink);
+			entry.addedLinks.emplace_back(destLink);
+		} else if (destLink->isValid() != srcLink->isValid()) {
+			destLink->isValid_ = srcLink->isValid();
+			entry.validityChangedLinks.emplace_back(destLink);
+		}
+	}
+	const auto destLinks{state_.links()};
+	for (const auto &destLink : destLinks) {
+		if (!src->findLinkByObjectID(destLink)) {
+			state_.removeLink(destLink);
+			entry.removedLinks.emplace_back(destLink);
 		}
 	}
 
 	// Update external project name map
-	dest->externalProjectsMap_ = src->externalProjectsMap_;
-}
+	if (state_.externalProjectsMap_ != src->externalProjectsMap_) {
+		entry.externalProjectsMapChanged = true;
+		entry.externalProjectsMap = state_.externalProjectsMap_;
+		state_.externalProjectsMap_ = src->externalProjectsMap_;
+	}
 
-void UndoStack::updateProjectState(const Project *src, Project *dest, const DataChangeRecorder &changes, UserObjectFactoryInterface &factory) {
-	SEditorObjectSet dirtyObjects = changes.getAllChangedObjects();
+	entry.memoryUsage = entry.estimateMemoryUsage();
+}
 
-	auto translateRef = [dest](SEditorObject srcObj) -> SEditorObject {
+void UndoStack::updateProjectState(const Project *src, Entry &entry, const DataChangeRecorder &changes, UserObjectFactoryInterface &factory) {
+	auto translateRef = [this](SEditorObject srcObj) -> SEditorObject {
 		if (srcObj) {
-			return dest->getInstanceByID(srcObj->objectID());
+			return state_.getInstanceByID(srcObj->objectID());
 		}
 		return nullptr;
 	};
 
-	for (const auto &srcObj : dirtyObjects) {
-		auto destObj = dest->getInstanceByID(srcObj->objectID());
-		updateEditorObject(srcObj.get(), destObj, translateRef, [](const std::string &) { return false; }, factory, nullptr, false);
+	// Revert the value changes already recorded in the entry: they are recorded again together with the new changes.
+	std::map<SEditorObject, std::set<std::vector<std::string>>> changedPaths;
+	for (auto &change : entry.changedValues) {
+		applyValueChange(change);
+		changedPaths[change.object].insert(change.propertyPath);
 	}
+	entry.changedValues.clear();
 
-	// Update external project name map
-	dest->externalProjectsMap_ = src->externalProjectsMap_;
+	for (const auto &[object, handles] : changes.getChangedValues()) {
+		auto srcObj = src->getInstanceByID(object->objectID());
+		auto destObj = state_.getInstanceByID(object->objectID());
+		// Objects created since the last push have already been copied completely.
+		if (srcObj && destObj && changes.getCreatedObjects().find(srcObj) == changes.getCreatedObjects().end()) {
+			collectChangedPaths(handles, *srcObj, *destObj, changedPaths[destObj]);
+		}
+	}
+
+	const std::set<SEditorObject> createdObjects(entry.createdObjects.begin(), entry.createdObjects.end());
+	for (const auto &[destObj, paths] : changedPaths) {
+		auto srcObj = src->getInstanceByID(destObj->objectID());
+		if (!srcObj) {
+			continue;
+		}
+		for (const auto &path : outermostPaths(paths)) {
+			auto srcValue = resolvePropertyPath(*srcObj, path);
+			auto destValue = resolvePropertyPath(*destObj, path);
+			assert(srcValue && destValue);
+			if (!srcValue || !destValue) {
+				continue;
+			}
+			if (createdObjects.find(destObj) != createdObjects.end()) {
+				// The entry contains the complete object
+				updateSingleValue(srcValue, destValue, ValueHandle(), translateRef, nullptr, false);
+			} else {
+				auto previous = destValue->clone(nullptr);
+				updateSingleValue(srcValue, destValue, ValueHandle(), translateRef, nullptr, false);
+				entry.changedValues.emplace_back(ValueChange{destObj, path, std::move(previous)});
+			}
+		}
+	}
+
+	entry.memoryUsage = entry.estimateMemoryUsage();
+}
+
+void UndoStack::applyValueChange(ValueChange &change) {
+	auto value = resolvePropertyPath(*change.object, change.propertyPath);
+	assert(value && ValueBase::classesEqual(*value, *change.value));
+	auto previous = value->clone(nullptr);
+	value->assign(*change.value);
+	value->copyAnnotationData(*change.value);
+	change.value = std::move(previous);
 }
 
-void UndoStack::restoreProjectState(Project *src, Project *dest, BaseContext &context, UserObjectFactoryInterface &factory) {
+void UndoStack::applyEntry(Entry &entry, bool redo) {
+	for (const auto &link : redo ? entry.removedLinks : entry.addedLinks) {
+		state_.removeLink(link);
+	}
+
+	const auto &toRemove = redo ? entry.deletedObjects : entry.createdObjects;
+	state_.removeInstances(SEditorObjectSet(toRemove.begin(), toRemove.end()), false);
+	for (const auto &object : redo ? entry.createdObjects : entry.deletedObjects) {
+		state_.addInstance(object);
+	}
+
+	for (auto &change : entry.changedValues) {
+		applyValueChange(change);
+	}
+
+	for (const auto &link : redo ? entry.addedLinks : entry.removedLinks) {
+		state_.addLink(link);
+	}
+	for (const auto &link : entry.validityChangedLinks) {
+		link->isValid_ = !link->isValid();
+	}
+
+	if (entry.externalProjectsMapChanged) {
+		std::swap(state_.externalProjectsMap_, entry.externalProjectsMap);
+	}
+}
+
+void UndoStack::restoreProjectState(Project *src, Project *dest, BaseContext &context, UserObjectFactoryInterface &factory, const std::set<std::string> &objectIDs, const std::set<std::string> &linkEndObjectIDs) {
 	DataChangeRecorder changes;
 	bool extrefDirty = false;
 
-	const auto destLinks{dest->links()};
-	const auto srcLinks{src->links()};
-
 	// Remove dest links not present in src
-	for (const auto &destLink : destLinks) {
-		if (!src->findLinkByObjectID(destLink)) {
-			changes.recordRemoveLink(destLink->descriptor());
-			dest->removeLink(destLink);
-			extrefDirty = extrefDirty || (*destLink->endObject_)->query<ExternalReferenceAnnotation>();
+	for (const auto &endObjectID : linkEndObjectIDs) {
+		auto it = dest->linkEndPoints().find(endObjectID);
+		if (it != dest->linkEndPoints().end()) {
+			const auto destLinks{it->second};
+			for (const auto &destLink : destLinks) {
+				if (!src->findLinkByObjectID(destLink)) {
+					changes.recordRemoveLink(destLink->descriptor());
+					dest->removeLink(destLink);
+					extrefDirty = extrefDirty || (*destLink->endObject_)->query<ExternalReferenceAnnotation>();
+				}
+			}
 		}
 	}
 
 	// Remove dest objects not present in src
 	SEditorObjectSet toRemove;
-	for (auto destObj : dest->instances()) {
-		if (!src->getInstanceByID(destObj->objectID())) {
+	bool missingInDest = false;
+	for (const auto &id : objectIDs) {
+		auto srcObj = src->getInstanceByID(id);
+		auto destObj = dest->getInstanceByID(id);
+		if (destObj && !srcObj) {
 			toRemove.insert(destObj);
 			changes.recordDeleteObject(destObj);
 			extrefDirty = extrefDirty || destObj->query<ExternalReferenceAnnotation>();
+		} else if (srcObj && !destObj) {
+			missingInDest = true;
 		}
 	}
-	BaseContext::deleteWithVolatileSideEffects(dest, toRemove, context.errors());
+	if (!toRemove.empty()) {
+		BaseContext::deleteWithVolatileSideEffects(dest, toRemove, context.errors());
+	}
 
 	// Create src object not present in dest
-	for (const auto &srcObj : src->instances()) {
-		if (!dest->getInstanceByID(srcObj->objectID())) {
-			auto destObj = factory.createObject(srcObj->getTypeDescription().typeName, srcObj->objectName(), srcObj->objectID());
-			dest->addInstance(destObj);
-			changes.recordCreateObject(destObj);
-			extrefDirty = extrefDirty || srcObj->query<ExternalReferenceAnnotation>();
+	// Iterate over the src instances to keep the instance order of dest deterministic.
+	if (missingInDest) {
+		for (const auto &srcObj : src->instances()) {
+			if (objectIDs.find(srcObj->objectID()) != objectIDs.end() && !dest->getInstanceByID(srcObj->objectID())) {
+				auto destObj = factory.createObject(srcObj->getTypeDescription().typeName, srcObj->objectName(), srcObj->objectID());
+				dest->addInstance(destObj);
+				changes.recordCreateObject(destObj);
+				extrefDirty = extrefDirty || srcObj->query<ExternalReferenceAnnotation>();
+			}
 		}
 	}
 
@@ -294,13 +629,16 @@ void UndoStack::restoreProjectState(Project *src, Project *dest, BaseContext &co
 	};
 
 	// Update objects
-	for (const auto &destObj : dest->instances()) {
-		auto srcObj = src->getInstanceByID(destObj->objectID());
-		updateEditorObject(srcObj.get(), destObj, translateRef, [](const std::string &) { return false; }, factory, &changes, true);
+	for (const auto &id : objectIDs) {
+		auto srcObj = src->getInstanceByID(id);
+		auto destObj = dest->getInstanceByID(id);
+		if (srcObj && destObj) {
+			updateEditorObject(srcObj.get(), destObj, translateRef, [](const std::string &) { return false; }, factory, &changes, true);
+		}
 	}
 
-	auto findExtref = [](const std::map<std::string, std::set<ValueHandle>>& changes) {
-		for (const auto &[id, handles] : changes) {
+	auto findExtref = [](const DataChangeRecorder::ChangedValueMap& changes) {
+		for (const auto &[object, handles] : changes) {
 			for (const auto &handle : handles) {
 				if (handle.rootObject()->query<ExternalReferenceAnnotation>()) {
 					return true;
@@ -312,19 +650,34 @@ void UndoStack::restoreProjectState(Project *src, Project *dest, BaseContext &co
 	extrefDirty = extrefDirty || findExtref(changes.getChangedValues());
 
 
-	for (const auto &srcLink : srcLinks) {
-		auto foundDestLink = dest->findLinkByObjectID(srcLink);
-		if (!foundDestLink) {
-			// Create src link not present in dest
-			auto destLink = Link::cloneLinkWithTranslation(srcLink, translateRef);
-			dest->addLink(destLink);
-			changes.recordAddLink(destLink->descriptor());
-			extrefDirty = extrefDirty || (*srcLink->endObject_)->query<ExternalReferenceAnnotation>();
-		} else if (srcLink->isValid() != foundDestLink->isValid()) {
-			// set validity of dest link to validity of src link
-			foundDestLink->isValid_ = srcLink->isValid();
-			changes.recordChangeValidityOfLink(foundDestLink->descriptor());
-			extrefDirty = extrefDirty || (*srcLink->endObject_)->query<ExternalReferenceAnnotation>();
+	std::set<SLink> toAdd;
+	for (const auto &endObjectID : linkEndObjectIDs) {
+		auto it = src->linkEndPoints().find(endObjectID);
+		if (it != src->linkEndPoints().end()) {
+			for (const auto &srcLink : it->second) {
+				auto foundDestLink = dest->findLinkByObjectID(srcLink);
+				if (!foundDestLink) {
+					toAdd.insert(srcLink);
+				} else if (srcLink->isValid() != foundDestLink->isValid()) {
+					// set validity of dest link to validity of src link
+					foundDestLink->isValid_ = srcLink->isValid();
+					changes.recordChangeValidityOfLink(foundDestLink->descriptor());
+					extrefDirty = extrefDirty || (*srcLink->endObject_)->query<ExternalReferenceAnnotation>();
+				}
+			}
+		}
+	}
+
+	// Create src links not present in dest
+	// Iterate over the src links to keep the link order of dest deterministic.
+	if (!toAdd.empty()) {
+		for (const auto &srcLink : src->links()) {
+			if (toAdd.find(srcLink) != toAdd.end()) {
+				auto destLink = Link::cloneLinkWithTranslation(srcLink, translateRef);
+				dest->addLink(destLink);
+				changes.recordAddLink(destLink->descriptor());
+				extrefDirty = extrefDirty || (*srcLink->endObject_)->query<ExternalReferenceAnnotation>();
+			}
 		}
 	}
 
@@ -338,19 +691,22 @@ void UndoStack::restoreProjectState(Project *src, Project *dest, BaseContext &co
 	for (const auto &destObj : changes.getAllChangedObjects()) {
 		destObj->onAfterDeserialization();
 	}
+	dest->updateInstanceNames(changes.getAllChangedObjects());
+
+	// Sync from external files for new or changed objects.
+	// Also update broken link error messages in Node::onAfterContextActivated, so we need to include
+	//   the link endpoints in the changed object set.
+	const auto &changedObjects = changes.getAllChangedObjects(false, false, true);
+	std::vector<SEditorObject> reloadObjects{changedObjects.begin(), changedObjects.end()};
 
 	// Use the change recorder in the context from here on
-	context_->uiChanges().mergeChanges(changes);
+	context_->uiChanges().mergeChanges(std::move(changes));
 
 	// Reset model changes here to make sure the next undo stack push will see 
 	// all changes relative to the last undo stack entry
 	context_->modelChanges().reset();
 
-	// Sync from external files for new or changed objects.
-	// Also update broken link error messages in Node::onAfterContextActivated, so we need to include
-	//   the link endpoints in the changed object set.
-	auto changedObjects = changes.getAllChangedObjects(false, false, true);
-	context_->performExternalFileReload({changedObjects.begin(), changedObjects.end()});
+	context_->performExternalFileReload(reloadObjects);
 
 	if (extrefDirty) {
 		std::vector<std::string> stack;
@@ -370,17 +726,30 @@ void UndoStack::restoreProjectState(Project *src, Project *dest, BaseContext &co
 	}
 }
 
-UndoStack::UndoStack(BaseContext* context, const Callback& onChange) : context_(context), onChange_ { onChange } {
-	auto initialState = &stack_.emplace_back(new Entry("Initial"))->state;
-	saveProjectState(context_->project(), initialState, nullptr, context_->modelChanges(), *context_->objectFactory());
+UndoStack::UndoStack(BaseContext* context, const Callback& onChange, bool enabled) : context_(context), onChange_{onChange}, enabled_{enabled} {
+	stack_.emplace_back(new Entry("Initial"));
+	if (enabled_) {
+		saveProjectState(context_->project(), *context_->objectFactory());
+	}
+}
+
+UndoStack::~UndoStack() = default;
+
+bool UndoStack::enabled() const noexcept {
+	return enabled_;
 }
 
 void UndoStack::reset() {
+	if (!enabled_) {
+		context_->modelChanges().reset();
+		return;
+	}
 	stack_.clear();
 	index_ = 0;
-	auto initialState = &stack_.emplace_back(new Entry("Initial"))->state;
+	spillFile_.reset();
+	stack_.emplace_back(new Entry("Initial"));
 	context_->modelChanges().reset();
-	saveProjectState(context_->project(), initialState, nullptr, context_->modelChanges(), *context_->objectFactory());
+	saveProjectState(context_->project(), *context_->objectFactory());
 	onChange_();
 }
 
@@ -389,22 +758,52 @@ bool UndoStack::canMerge(const DataChangeRecorder &changes) {
 }
 
 void UndoStack::push(const std::string &description, std::string mergeId) {
+	assert(context_->project()->checkInstanceNames());
+	if (!enabled_) {
+		context_->modelChanges().reset();
+		return;
+	}
 	stack_.resize(index_ + 1);
 	if (!mergeId.empty() && mergeId == stack_.back()->mergeId && canMerge(context_->modelChanges())) {
-		// mergable -> In-place update of the last stack state
-		updateProjectState(context_->project(), &stack_.back()->state, context_->modelChanges(), *context_->objectFactory());
+		// mergable -> In-place update of the last stack entry
+		updateProjectState(context_->project(), *stack_.back(), context_->modelChanges(), *context_->objectFactory());
 		stack_.back()->description = description;
+		// The copy in the spill file doesn't contain the merged changes.
+		stack_.back()->spillSize = 0;
 	} else {
-		// not mergable -> create and fill new state
-		auto nextState = &stack_.emplace_back(new Entry(description, mergeId))->state;
+		// not mergable -> create and fill new entry
+		auto& entry = stack_.emplace_back(new Entry(description, mergeId));
 		++index_;
-		saveProjectState(context_->project(), nextState, &stack_[index_ - 1]->state, context_->modelChanges(), *context_->objectFactory());
+		saveProjectState(context_->project(), *entry, context_->modelChanges(), *context_->objectFactory());
 	}
+	evictEntries();
+	trimSpillFile();
+	spillEntries();
 
 	onChange_();
 	context_->modelChanges().reset();
 }
 
+void UndoStack::evictEntries() {
+	if (memoryBudget_ == 0) {
+		return;
+	}
+	size_t usage = 0;
+	for (const auto &entry : stack_) {
+		usage += entry->memoryUsage;
+	}
+	// The oldest remaining entry becomes the new initial state and doesn't need its delta anymore.
+	while (usage > memoryBudget_ && index_ > 0) {
+		usage -= stack_[0]->memoryUsage + stack_[1]->memoryUsage;
+		stack_.erase(stack_.begin());
+		--index_;
+		auto &front = stack_.front();
+		front.reset(new Entry(front->description, front->mergeId));
+		front->memoryUsage = front->estimateMemoryUsage();
+		usage += front->memoryUsage;
+	}
+}
+
 size_t UndoStack::size() const {
 	return stack_.size();
 }
@@ -415,8 +814,53 @@ size_t UndoStack::getIndex() const {
 
 size_t UndoStack::setIndex(size_t newIndex, bool force) {
 	if (newIndex < size() && (newIndex != index_ || force)) {
-		index_ = newIndex;
-		restoreProjectState(&stack_[index_]->state, context_->project(), *context_, *context_->objectFactory());
+		// Only the objects and links modified by the applied entries or by changes not pushed yet
+		// need to be synchronized unless a full restore is forced.
+		std::set<std::string> objectIDs;
+		std::set<std::string> linkEndObjectIDs;
+		auto project = context_->project();
+		if (force) {
+			for (const Project *p : {static_cast<const Project *>(&state_), static_cast<const Project *>(project)}) {
+				for (const auto &object : p->instances()) {
+					objectIDs.insert(object->objectID());
+				}
+				for (const auto &[id, links] : p->linkEndPoints()) {
+					linkEndObjectIDs.insert(id);
+				}
+			}
+		} else {
+			const auto &changes = context_->modelChanges();
+			for (const auto *objects : {&changes.getCreatedObjects(), &changes.getDeletedObjects()}) {
+				for (const auto &object : *objects) {
+					objectIDs.insert(object->objectID());
+				}
+			}
+			for (const auto &[object, handles] : changes.getChangedValues()) {
+				objectIDs.insert(object->objectID());
+			}
+			for (const auto *links : {&changes.getAddedLinks(), &changes.getRemovedLinks(), &changes.getValidityChangedLinks()}) {
+				for (const auto &[id, descriptors] : *links) {
+					linkEndObjectIDs.insert(id);
+				}
+			}
+		}
+
+		while (index_ > newIndex) {
+			if (stack_[index_]->spilled) {
+				loadSpilledEntry(*stack_[index_]);
+			}
+			stack_[index_]->collectModifiedIDs(objectIDs, linkEndObjectIDs);
+			applyEntry(*stack_[index_], false);
+			--index_;
+		}
+		while (index_ < newIndex) {
+			++index_;
+			stack_[index_]->collectModifiedIDs(objectIDs, linkEndObjectIDs);
+			applyEntry(*stack_[index_], true);
+		}
+		restoreProjectState(&state_, project, *context_, *context_->objectFactory(), objectIDs, linkEndObjectIDs);
+		assert(project->checkInstanceNames());
+		spillEntries();
 		onChange_();
 	}
 	return index_;
@@ -449,4 +893,279 @@ bool UndoStack::canRedo() const noexcept {
 	return getIndex() < (size()-1);
 }
 
-}  // namespace raco::core
\ No newline at end of file
+size_t UndoStack::entryMemoryUsage(size_t index) const {
+	return stack_.at(index)->memoryUsage;
+}
+
+size_t UndoStack::memoryUsage() const {
+	size_t usage = 0;
+	for (const auto &entry : stack_) {
+		usage += entry->memoryUsage;
+	}
+	for (const auto &object : state_.instances()) {
+		usage += estimateSize(*object);
+	}
+	for (const auto &link : state_.links()) {
+		usage += estimateSize(link);
+	}
+	return usage;
+}
+
+void UndoStack::setMemoryBudget(size_t bytes) {
+	memoryBudget_ = bytes;
+	evictEntries();
+	trimSpillFile();
+}
+
+size_t UndoStack::memoryBudget() const {
+	return memoryBudget_;
+}
+
+void UndoStack::setSpillDepth(size_t depth) {
+	spillDepth_ = depth;
+	spillEntries();
+}
+
+size_t UndoStack::spillDepth() const {
+	return spillDepth_;
+}
+
+bool UndoStack::entrySpilled(size_t index) const {
+	return stack_.at(index)->spilled;
+}
+
+int64_t UndoStack::spillFileSize() const {
+	return spillFile_ ? spillFile_->size() : 0;
+}
+
+void UndoStack::spillEntries() {
+	if (spillDepth_ == 0 || index_ <= spillDepth_) {
+		return;
+	}
+	// The spilled entries always form a contiguous range starting after the initial entry,
+	// so we can stop at the first entry which is already spilled.
+	for (size_t index = index_ - spillDepth_ - 1; index > 0 && !stack_[index]->spilled; index--) {
+		if (!spillEntry(*stack_[index])) {
+			break;
+		}
+	}
+}
+
+bool UndoStack::spillEntry(Entry &entry) {
+	if (!spillFile_) {
+		spillFile_ = std::make_unique<QTemporaryFile>();
+		if (!spillFile_->open()) {
+			LOG_WARNING(log_system::CONTEXT, "Can't create temporary file for undo history: {}", spillFile_->errorString().toStdString());
+			spillFile_.reset();
+			spillDepth_ = 0;
+			return false;
+		}
+	}
+
+	if (entry.spillSize == 0) {
+		if (!writeSpilledEntry(entry)) {
+			return false;
+		}
+	}
+
+	entry.createdObjects.clear();
+	entry.deletedObjects.clear();
+	entry.changedValues.clear();
+	entry.addedLinks.clear();
+	entry.removedLinks.clear();
+	entry.validityChangedLinks.clear();
+	entry.externalProjectsMap.clear();
+	entry.spilled = true;
+	entry.memoryUsage = entry.estimateMemoryUsage();
+	return true;
+}
+
+bool UndoStack::writeSpilledEntry(Entry &entry) {
+	QJsonObject json;
+
+	// Created objects are part of state_ when the entry is loaded again so only their IDs need to be stored.
+	QJsonArray createdObjects;
+	for (const auto &object : entry.createdObjects) {
+		createdObjects.push_back(QString::fromStdString(object->objectID()));
+	}
+	json.insert(spill_keys::CREATED_OBJECTS, createdObjects);
+
+	QJsonArray deletedObjects;
+	for (const auto &object : entry.deletedObjects) {
+		deletedObjects.push_back(serialization::serializeTypedObject(*object, resolveReferenceId));
+	}
+	json.insert(spill_keys::DELETED_OBJECTS, deletedObjects);
+
+	QJsonArray changedValues;
+	for (const auto &change : entry.changedValues) {
+		QJsonObject jsonChange;
+		jsonChange.insert(spill_keys::OBJECT, QString::fromStdString(change.object->objectID()));
+		QJsonArray path;
+		for (const auto &name : change.propertyPath) {
+			path.push_back(QString::fromStdString(name));
+		}
+		jsonChange.insert(spill_keys::PATH, path);
+		if (auto value = serialization::serializePropertyForMigration(*change.value, resolveReferenceId, false)) {
+			jsonChange.insert(spill_keys::VALUE, value.value());
+		}
+		changedValues.push_back(jsonChange);
+	}
+	json.insert(spill_keys::CHANGED_VALUES, changedValues);
+
+	json.insert(spill_keys::ADDED_LINKS, serializeLinks(entry.addedLinks));
+	json.insert(spill_keys::REMOVED_LINKS, serializeLinks(entry.removedLinks));
+	json.insert(spill_keys::VALIDITY_CHANGED_LINKS, serializeLinks(entry.validityChangedLinks));
+
+	if (entry.externalProjectsMapChanged) {
+		QJsonObject externalProjects;
+		for (const auto &[projectID, info] : entry.externalProjectsMap) {
+			externalProjects.insert(QString::fromStdString(projectID), QJsonObject{
+				{spill_keys::EXTERNAL_PROJECT_PATH, QString::fromStdString(info.path)},
+				{spill_keys::EXTERNAL_PROJECT_NAME, QString::fromStdString(info.name)}});
+		}
+		json.insert(spill_keys::EXTERNAL_PROJECTS, externalProjects);
+	}
+
+	QByteArray data = QCborValue::fromJsonValue(json).toCbor();
+	int64_t offset = spillFile_->size();
+	if (!spillFile_->seek(offset) || spillFile_->write(data) != data.size()) {
+		LOG_WARNING(log_system::CONTEXT, "Can't write undo history to temporary file: {}", spillFile_->errorString().toStdString());
+		return false;
+	}
+	entry.spillOffset = offset;
+	entry.spillSize = data.size();
+	return true;
+}
+
+void UndoStack::trimSpillFile() {
+	if (!spillFile_) {
+		return;
+	}
+	int64_t usedSize = 0;
+	int64_t usedEnd = 0;
+	for (const auto &entry : stack_) {
+		if (entry->spillSize > 0) {
+			usedSize += entry->spillSize;
+			usedEnd = std::max(usedEnd, entry->spillOffset + entry->spillSize);
+		}
+	}
+
+	if (usedSize * 2 >= usedEnd) {
+		// Only a small part of the file is unused: drop the unused tail.
+		if (usedEnd < spillFile_->size()) {
+			spillFile_->resize(usedEnd);
+		}
+		return;
+	}
+
+	// Most of the file is unused, e.g. after the oldest entries have been evicted: copy the used parts to a new file.
+	auto compacted = std::make_unique<QTemporaryFile>();
+	if (!compacted->open()) {
+		LOG_WARNING(log_system::CONTEXT, "Can't create temporary file for undo history: {}", compacted->errorString().toStdString());
+		return;
+	}
+	std::vector<int64_t> offsets;
+	for (const auto &entry : stack_) {
+		if (entry->spillSize > 0) {
+			spillFile_->seek(entry->spillOffset);
+			offsets.emplace_back(compacted->pos());
+			if (compacted->write(spillFile_->read(entry->spillSize)) != entry->spillSize) {
+				LOG_WARNING(log_system::CONTEXT, "Can't write undo history to temporary file: {}", compacted->errorString().toStdString());
+				return;
+			}
+		}
+	}
+	auto offset = offsets.begin();
+	for (auto &entry : stack_) {
+		if (entry->spillSize > 0) {
+			entry->spillOffset = *offset++;
+		}
+	}
+	spillFile_ = std::move(compacted);
+}
+
+// Must be called with state_ at the index of the entry: all objects and links created by the entry
+// and all objects modified by the entry are then present in state_.
+void UndoStack::loadSpilledEntry(Entry &entry) {
+	spillFile_->seek(entry.spillOffset);
+	QByteArray data = spillFile_->read(entry.spillSize);
+	auto json = QCborValue::fromCbor(data).toJsonValue().toObject();
+
+	auto factory = UserObjectFactoryInterface::deserializationFactory(context_->objectFactory());
+	serialization::References references;
+
+	for (const auto &id : json[spill_keys::CREATED_OBJECTS].toArray()) {
+		entry.createdObjects.emplace_back(state_.getInstanceByID(id.toString().toStdString()));
+	}
+
+	std::map<std::string, SEditorObject> deletedObjects;
+	for (const auto &jsonObject : json[spill_keys::DELETED_OBJECTS].toArray()) {
+		auto object = std::dynamic_pointer_cast<EditorObject>(serialization::deserializeTypedObject(jsonObject.toObject(), factory, references));
+		entry.deletedObjects.emplace_back(object);
+		deletedObjects[object->objectID()] = object;
+	}
+
+	for (const auto &jsonChangeValue : json[spill_keys::CHANGED_VALUES].toArray()) {
+		auto jsonChange = jsonChangeValue.toObject();
+		auto object = state_.getInstanceByID(jsonChange[spill_keys::OBJECT].toString().toStdString());
+		std::vector<std::string> propertyPath;
+		for (const auto &name : jsonChange[spill_keys::PATH].toArray()) {
+			propertyPath.emplace_back(name.toString().toStdString());
+		}
+		// The property exists with the same class on both sides of the entry so the current value
+		// can be used as template for the deserialized value.
+		auto value = resolvePropertyPath(*object, propertyPath)->clone(nullptr);
+		resetForDeserialization(*value);
+		if (jsonChange.contains(spill_keys::VALUE)) {
+			auto valueReferences = serialization::deserializePropertyForMigration(jsonChange[spill_keys::VALUE], *value, factory);
+			references.insert(valueReferences.begin(), valueReferences.end());
+		}
+		entry.changedValues.emplace_back(ValueChange{object, propertyPath, std::move(value)});
+	}
+
+	auto deserializeLinks = [&factory, &references](const QJsonArray &jsonLinks) {
+		std::vector<SLink> links;
+		for (const auto &jsonLink : jsonLinks) {
+			links.emplace_back(std::dynamic_pointer_cast<Link>(serialization::deserializeTypedObject(jsonLink.toObject(), factory, references)));
+		}
+		return links;
+	};
+	entry.removedLinks = deserializeLinks(json[spill_keys::REMOVED_LINKS].toArray());
+	auto addedLinks = deserializeLinks(json[spill_keys::ADDED_LINKS].toArray());
+	auto validityChangedLinks = deserializeLinks(json[spill_keys::VALIDITY_CHANGED_LINKS].toArray());
+
+	// References on the other side of the entry point to the deleted objects of the entry
+	// if an object with the same ID has been deleted and created again.
+	for (const auto &[value, id] : references) {
+		auto it = deletedObjects.find(id);
+		if (it != deletedObjects.end()) {
+			*value = it->second;
+		} else {
+			*value = state_.getInstanceByID(id);
+		}
+	}
+
+	// Added links and links with changed validity are part of state_.
+	for (const auto &link : addedLinks) {
+		entry.addedLinks.emplace_back(state_.findLinkByObjectID(link));
+	}
+	for (const auto &link : validityChangedLinks) {
+		entry.validityChangedLinks.emplace_back(state_.findLinkByObjectID(link));
+	}
+
+	if (json.contains(spill_keys::EXTERNAL_PROJECTS)) {
+		entry.externalProjectsMapChanged = true;
+		auto externalProjects = json[spill_keys::EXTERNAL_PROJECTS].toObject();
+		for (auto it = externalProjects.begin(); it != externalProjects.end(); ++it) {
+			auto info = it.value().toObject();
+			entry.externalProjectsMap[it.key().toStdString()] = serialization::ExternalProjectInfo{
+				info[spill_keys::EXTERNAL_PROJECT_PATH].toString().toStdString(),
+				info[spill_keys::EXTERNAL_PROJECT_NAME].toString().toStdString()};
+		}
+	}
+
+	entry.spilled = false;
+	entry.memoryUsage = entry.estimateMemoryUsage();
+}
+
+}  // namespace raco::core
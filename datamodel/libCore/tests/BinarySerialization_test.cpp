@@ -0,0 +1,168 @@
+/*
+ * SPDX-License-Identifier: MPL-2.0
+ *
+ * This file is part of Ramses Composer
+ * (see https://github.com/GENIVI/ramses-composer).
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "core/BinarySerialization.h"
+
+#include "core/RamsesProjectMigration.h"
+#include "core/SerializationKeys.h"
+#include "testing/TestEnvironmentCore.h"
+#include "user_types/Node.h"
+
+#include <QBuffer>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <limits>
+#include <set>
+
+using namespace raco::serialization;
+using raco::user_types::Node;
+
+struct BinarySerializationTest : public TestEnvironmentCore {
+	QJsonDocument readJson(const std::string& fileName) {
+		QFile file{QString::fromStdString((cwd_path() / "migrationTestData" / fileName).string())};
+		EXPECT_TRUE(file.open(QIODevice::ReadOnly));
+		return QJsonDocument::fromJson(file.readAll());
+	}
+
+	void checkRoundTrip(const QJsonDocument& document) {
+		auto binary = toBinaryProject(document);
+		ASSERT_TRUE(isBinaryProject(binary));
+		auto decoded = fromBinaryProject(binary);
+		EXPECT_EQ(decoded, document);
+		EXPECT_EQ(decoded.toJson(), document.toJson());
+	}
+};
+
+TEST_F(BinarySerializationTest, round_trip_project_files) {
+	for (auto fileName : {"V1.rca", "V9.rca", "V10.rca", "V12.rca", "V13.rca", "V14.rca", "V14b.rca", "V14c.rca", "V16.rca", "V18.rca", "version-current.rca"}) {
+		SCOPED_TRACE(fileName);
+		auto document = readJson(fileName);
+		ASSERT_FALSE(document.isNull());
+		EXPECT_FALSE(isBinaryProject(document.toJson()));
+		checkRoundTrip(document);
+		EXPECT_LT(toBinaryProject(document).size(), document.toJson(QJsonDocument::Compact).size());
+	}
+}
+
+TEST_F(BinarySerializationTest, round_trip_value_types) {
+	QJsonObject object{
+		{"null", QJsonValue::Null},
+		{"false", false},
+		{"true", true},
+		{"zero", 0},
+		{"negativeZero", -0.0},
+		{"int", -123456},
+		{"maxInt", std::numeric_limits<int>::max()},
+		{"largeInt", static_cast<qint64>(1) << 52},
+		{"fraction", 0.1},
+		{"huge", 1e300},
+		{"empty", ""},
+		{"unicode", QString::fromUtf8("\xc3\xa4\xe2\x82\xac")},
+		{"emptyArray", QJsonArray{}},
+		{"emptyObject", QJsonObject{}},
+		{"nested", QJsonArray{QJsonObject{{"id", "ref_id"}}, QJsonArray{"ref_id", 1, 2.5}}}};
+	checkRoundTrip(QJsonDocument{object});
+	checkRoundTrip(QJsonDocument{QJsonArray{1, "two", QJsonObject{{"three", 3}}}});
+	checkRoundTrip(QJsonDocument{});
+
+	auto negativeZero = fromBinaryProject(toBinaryProject(QJsonDocument{object}))["negativeZero"].toDouble();
+	EXPECT_TRUE(std::signbit(negativeZero));
+}
+
+TEST_F(BinarySerializationTest, names_and_object_ids_are_interned) {
+	auto document = readJson("version-current.rca");
+	auto binary = toBinaryProject(document);
+	BinaryProject project{binary};
+
+	const auto& names = project.names();
+	EXPECT_EQ(std::set<std::string>(names.begin(), names.end()).size(), names.size());
+	EXPECT_NE(std::find(names.begin(), names.end(), "objectName"), names.end());
+	EXPECT_EQ(binary.count("objectName"), 1);
+
+	std::set<std::string> instanceIDs;
+	for (const auto& instance : document["instances"].toArray()) {
+		instanceIDs.insert(instance["properties"]["objectID"].toString().toStdString());
+	}
+	const auto& objectIDs = project.objectIDs();
+	EXPECT_EQ(std::set<std::string>(objectIDs.begin(), objectIDs.end()), instanceIDs);
+	for (const auto& id : instanceIDs) {
+		EXPECT_EQ(binary.count(id.c_str()), 1) << id;
+	}
+}
+
+TEST_F(BinarySerializationTest, write_and_deserialize_project) {
+	auto root = create<Node>("root");
+	auto node = create<Node>("node", root);
+	auto meshnode = create_meshnode("meshnode", create_mesh("mesh", "meshes/Duck.glb"), create_material("material", "shaders/basic.vert", "shaders/basic.frag"), root);
+	auto lua = create_lua("lua", "scripts/types-scalar.lua", root);
+	link(lua, {"luaOutputs", "ovector3f"}, node, {"translation"});
+
+	std::unordered_map<std::string, std::vector<int>> versions{
+		{keys::FILE_VERSION, {raco::core::RAMSES_PROJECT_FILE_VERSION}},
+		{keys::RAMSES_VERSION, {27, 0, 130}},
+		{keys::RAMSES_LOGIC_ENGINE_VERSION, {1, 4, 2}},
+		{keys::RAMSES_COMPOSER_VERSION, {1, 9, 0}}};
+	std::map<std::string, ExternalProjectInfo> externalProjects{{"external_id", {"../external.rca", "external"}}};
+	auto serialize = [&versions, &externalProjects](const std::vector<SReflectionInterface>& instances, const std::vector<SReflectionInterface>& links, const ResolveReferencedId& resolveReferenceId) {
+		QBuffer buffer;
+		buffer.open(QIODevice::WriteOnly);
+		EXPECT_TRUE(writeBinaryProject(buffer, versions, instances, links, externalProjects, resolveReferenceId));
+		return std::make_pair(buffer.data(), serializeProject(versions, instances, links, externalProjects, resolveReferenceId));
+	};
+	auto resolveReferenceId = [](const ValueBase& value) -> std::optional<std::string> {
+		if (value.asRef()) {
+			return value.asRef()->objectID();
+		}
+		return {};
+	};
+
+	auto [binary, json] = serialize({project.instances().begin(), project.instances().end()}, {project.links().begin(), project.links().end()}, resolveReferenceId);
+	BinaryProject binaryProject{binary};
+	EXPECT_EQ(binaryProject.toJson(), json);
+	EXPECT_EQ(binaryProject.fileVersion(), raco::core::RAMSES_PROJECT_FILE_VERSION);
+
+	auto result = binaryProject.deserialize(raco::core::UserObjectFactoryInterface::deserializationFactory(objectFactory()));
+	EXPECT_EQ(result.ramsesVersion.patch, 130);
+	EXPECT_EQ(result.ramsesLogicEngineVersion.minor, 4);
+	EXPECT_EQ(result.raCoVersion.minor, 9);
+	EXPECT_EQ(result.objectsDeserialization.externalProjectsMap, externalProjects);
+	ASSERT_EQ(result.objectsDeserialization.objects.size(), project.instances().size());
+	ASSERT_EQ(result.objectsDeserialization.links.size(), 1);
+
+	// The unresolved references serialize to the same IDs as the original objects.
+	auto& references = result.objectsDeserialization.references;
+	auto resolveDeserialized = [&references](const ValueBase& value) -> std::optional<std::string> {
+		auto it = references.find(const_cast<ValueBase*>(&value));
+		if (it != references.end()) {
+			return it->second;
+		}
+		return {};
+	};
+	auto [rebinary, rejson] = serialize(result.objectsDeserialization.objects, result.objectsDeserialization.links, resolveDeserialized);
+	EXPECT_EQ(rejson, json);
+	EXPECT_EQ(rebinary, binary);
+}
+
+TEST_F(BinarySerializationTest, invalid_data_throws) {
+	EXPECT_THROW(fromBinaryProject(QByteArray{"{}"}), std::runtime_error);
+
+	auto binary = toBinaryProject(readJson("version-current.rca"));
+	for (int size : {4, 5, binary.size() / 2, binary.size() - 1}) {
+		EXPECT_THROW(fromBinaryProject(binary.left(size)), std::runtime_error);
+	}
+	EXPECT_THROW(fromBinaryProject(binary + QByteArray(1, '\0')), std::runtime_error);
+
+	QByteArray futureVersion{BINARY_PROJECT_MAGIC};
+	futureVersion.append(static_cast<char>(BINARY_PROJECT_FORMAT_VERSION + 1));
+	EXPECT_THROW(fromBinaryProject(futureVersion), std::runtime_error);
+}
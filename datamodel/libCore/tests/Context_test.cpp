@@ -13,6 +13,7 @@
 #include "core/Project.h"
 #include "core/PropertyDescriptor.h"
 #include "core/MeshCacheInterface.h"
+#include "core/ObjectsSnapshot.h"
 #include "ramses_base/HeadlessEngineBackend.h"
 #include "testing/RacoBaseTest.h"
 #include "testing/TestEnvironmentCore.h"
@@ -20,6 +21,7 @@
 #include "user_types/UserObjectFactory.h"
 #include "testing/TestUtil.h"
 
+#include "user_types/LuaScript.h"
 #include "user_types/Mesh.h"
 #include "user_types/MeshNode.h"
 #include "user_types/Node.h"
@@ -77,7 +79,7 @@ TEST_F(ContextTest, Simple) {
 	EXPECT_EQ(vh_s.asString(), "dog");
 
 	auto changedValues = recorder.getChangedValues();
-	std::map<std::string, std::set<ValueHandle>> refChangedValues{{foo->objectID(), {vh_x, vh_b, vh_i, vh_s}}};
+	DataChangeRecorder::ChangedValueMap refChangedValues{{foo.get(), {vh_x, vh_b, vh_i, vh_s}}};
 	EXPECT_EQ(changedValues, refChangedValues);
 
 	ValueHandle vh_vec = o.get("vec");
@@ -823,6 +825,67 @@ TEST_F(ContextTest, pasteInvalidJsonSchema) {
 	ASSERT_EQ(0, copyResult.size());
 }
 
+TEST_F(ContextTest, copyObjectsSnapshot_serializes_like_copyObjects) {
+	auto root = create<Node>("root");
+	auto mesh = create_mesh("mesh", "meshes/Duck.glb");
+	auto meshnode = create<MeshNode>("meshnode", root);
+	context.set({meshnode, {"mesh"}}, mesh);
+	auto node = create<Node>("node", root);
+	auto lua = create_lua("lua", "scripts/types-scalar.lua", root);
+	link(lua, {"luaOutputs", "ovector3f"}, node, {"translation"});
+
+	for (bool deep : {false, true}) {
+		auto snapshot = context.copyObjectsSnapshot({root}, deep);
+		EXPECT_EQ(snapshot->serialize(), context.copyObjects({root}, deep));
+	}
+}
+
+TEST_F(ContextTest, pasteObjectsSnapshot_pastes_copied_state) {
+	auto root = create<Node>("root");
+	auto mesh = create_mesh("mesh", "meshes/Duck.glb");
+	auto meshnode = create<MeshNode>("meshnode", root);
+	context.set({meshnode, {"mesh"}}, mesh);
+	auto node = create<Node>("node", root);
+	auto lua = create_lua("lua", "scripts/types-scalar.lua", root);
+	link(lua, {"luaOutputs", "ovector3f"}, node, {"translation"});
+
+	auto snapshot = context.copyObjectsSnapshot({root});
+	context.set({root, {"translation", "x"}}, 5.0);
+
+	for (int paste = 0; paste < 2; paste++) {
+		auto pasted = context.pasteObjects(*snapshot);
+		ASSERT_EQ(pasted.size(), 1u);
+		auto pastedRoot = pasted[0]->as<Node>();
+		EXPECT_NE(pastedRoot->objectID(), root->objectID());
+		EXPECT_EQ(*pastedRoot->translation_->x, 0.0);
+
+		ASSERT_EQ(pastedRoot->children_->size(), 3u);
+		auto pastedMeshnode = pastedRoot->children_->get(0)->asRef()->as<MeshNode>();
+		auto pastedNode = pastedRoot->children_->get(1)->asRef();
+		auto pastedLua = pastedRoot->children_->get(2)->asRef();
+		EXPECT_EQ(pastedMeshnode->getParent(), pastedRoot);
+		EXPECT_EQ(*pastedMeshnode->mesh_, mesh);
+
+		auto pastedLink = Queries::getLink(project, {pastedNode, {"translation"}});
+		ASSERT_TRUE(pastedLink != nullptr);
+		EXPECT_EQ(*pastedLink->startObject_, pastedLua);
+	}
+	EXPECT_EQ(project.instances().size(), 5u + 2 * 4u);
+	EXPECT_EQ(project.links().size(), 3u);
+}
+
+TEST_F(ContextTest, cutObjectsSnapshot_and_paste) {
+	auto parent = create<Node>("parent");
+	auto child = create<Node>("child", parent);
+	auto snapshot = context.cutObjectsSnapshot({parent});
+	ASSERT_EQ(project.instances().size(), 0u);
+
+	auto pasted = context.pasteObjects(*snapshot);
+	ASSERT_EQ(pasted.size(), 1u);
+	EXPECT_EQ(pasted[0]->objectName(), "parent");
+	EXPECT_EQ(project.instances().size(), 2u);
+}
+
 TEST_F(ContextTest, copyAndPasteKeepAbsolutePath) {
 	auto absoluteDuckPath{(cwd_path() / "testData" / "Duck.glb").generic_string()};
 	const auto sMesh{context.createObject(raco::user_types::Mesh::typeDescription.typeName, "mesh", "mesh_id")};
@@ -1058,6 +1121,54 @@ TEST_F(ContextTest, cutAndPasteNodeUniqueName) {
 	ASSERT_EQ(node2->objectName(), "Node");
 }
 
+TEST_F(ContextTest, insertAssetScenegraphUniqueName) {
+	raco::core::MeshDescriptor desc;
+	desc.absPath = cwd_path().append("meshes/Duck.glb").string();
+	desc.bakeAllSubmeshes = false;
+	auto scenegraph = commandInterface.meshCache()->getMeshScenegraph(desc);
+
+	// The project name index needs to give the same names as a scan of the siblings.
+	auto checkNameIndex = [this](const std::string& name) {
+		EXPECT_TRUE(project.checkInstanceNames());
+		std::vector<SEditorObject> parents{nullptr};
+		parents.insert(parents.end(), project.instances().begin(), project.instances().end());
+		for (const auto& parent : parents) {
+			std::vector<SEditorObject> siblings;
+			std::copy_if(project.instances().begin(), project.instances().end(), std::back_inserter(siblings), [parent](const SEditorObject& obj) { return obj->getParent() == parent; });
+			EXPECT_EQ(project.findAvailableUniqueName(parent, nullptr, name), Project::findAvailableUniqueName(siblings.begin(), siblings.end(), nullptr, name));
+			for (const auto& sibling : siblings) {
+				EXPECT_EQ(project.findAvailableUniqueName(parent, sibling, sibling->objectName()), Project::findAvailableUniqueName(siblings.begin(), siblings.end(), sibling, sibling->objectName()));
+			}
+		}
+	};
+
+	auto node = commandInterface.createObject(Node::typeDescription.typeName, "Duck.glb");
+	commandInterface.insertAssetScenegraph(*scenegraph, desc.absPath, nullptr);
+	EXPECT_NE(Queries::findByName(project.instances(), "Duck.glb (1)"), nullptr);
+	checkNameIndex("Duck.glb");
+
+	commandInterface.insertAssetScenegraph(*scenegraph, desc.absPath, node);
+	auto childRoot = Queries::findByName(project.instances(), "Duck.glb (2)");
+	ASSERT_NE(childRoot, nullptr);
+	EXPECT_EQ(childRoot->getParent(), node);
+	checkNameIndex("Duck.glb");
+
+	// The root node inserted below node no longer blocks its name at the top level.
+	EXPECT_EQ(project.findAvailableUniqueName(nullptr, nullptr, "Duck.glb"), "Duck.glb (2)");
+	commandInterface.insertAssetScenegraph(*scenegraph, desc.absPath, nullptr);
+	EXPECT_EQ(project.findAvailableUniqueName(nullptr, nullptr, "Duck.glb"), "Duck.glb (3)");
+	checkNameIndex("Duck.glb");
+
+	commandInterface.undoStack().undo();
+	commandInterface.undoStack().undo();
+	EXPECT_EQ(project.findAvailableUniqueName(nullptr, nullptr, "Duck.glb"), "Duck.glb (2)");
+	checkNameIndex("Duck.glb");
+
+	commandInterface.undoStack().redo();
+	EXPECT_EQ(project.findAvailableUniqueName(node, nullptr, "Duck.glb (2)"), "Duck.glb (3)");
+	checkNameIndex("Duck.glb");
+}
+
 TEST_F(ContextTest, queryLinkConnectedToObjectsReturnsNoDuplicateLinks) {
 	auto objs{raco::createLinkedScene(*this)};
 
@@ -1115,3 +1226,69 @@ TEST_F(ContextTest, meshnode_shared_mat_modify_material) {
 
 
 
+
+TEST_F(ContextTest, recorder_cached_changed_objects_follow_changes) {
+	auto node_1 = create<Node>("node_1");
+	auto node_2 = create<Node>("node_2");
+	recorder.reset();
+	EXPECT_TRUE(recorder.getAllChangedObjects().empty());
+
+	context.set({node_1, {"translation", "x"}}, 1.0);
+	EXPECT_EQ(recorder.getAllChangedObjects(), SEditorObjectSet({node_1}));
+
+	context.set({node_1, {"translation", "y"}}, 2.0);
+	context.set({node_2, {"visibility"}}, false);
+	EXPECT_EQ(recorder.getAllChangedObjects(), SEditorObjectSet({node_1, node_2}));
+
+	recorder.recordPreviewDirty(node_2);
+	EXPECT_EQ(recorder.getAllChangedObjects(true), SEditorObjectSet({node_1, node_2}));
+	EXPECT_TRUE(recorder.hasValueChanged({node_1, {"translation", "y"}}));
+
+	context.deleteObjects({node_1});
+	EXPECT_EQ(recorder.getAllChangedObjects(), SEditorObjectSet({node_2}));
+	EXPECT_EQ(recorder.getDeletedObjects(), SEditorObjectSet({node_1}));
+
+	auto released = recorder.release();
+	EXPECT_TRUE(recorder.getAllChangedObjects().empty());
+	EXPECT_TRUE(recorder.getChangedValues().empty());
+	EXPECT_EQ(released.getAllChangedObjects(), SEditorObjectSet({node_2}));
+	EXPECT_EQ(released.getPreviewDirtyObjects(), SEditorObjectSet({node_2}));
+}
+
+TEST_F(ContextTest, recorder_changed_objects_stay_valid) {
+	auto node_1 = create<Node>("node_1");
+	auto node_2 = create<Node>("node_2");
+	recorder.reset();
+
+	context.set({node_1, {"translation", "x"}}, 1.0);
+	const auto& changed = recorder.getAllChangedObjects();
+	for (const auto& object : changed) {
+		EXPECT_EQ(object, node_1);
+		context.set({node_2, {"translation", "x"}}, 1.0);
+		EXPECT_EQ(recorder.getAllChangedObjects(), SEditorObjectSet({node_1, node_2}));
+		context.deleteObjects({node_1});
+		EXPECT_EQ(recorder.getAllChangedObjects(), SEditorObjectSet({node_2}));
+	}
+	EXPECT_EQ(changed, SEditorObjectSet({node_1}));
+}
+
+TEST_F(ContextTest, recorder_move_merge) {
+	auto node_1 = create<Node>("node_1");
+	auto node_2 = create<Node>("node_2");
+	recorder.reset();
+
+	DataChangeRecorder source;
+	source.recordValueChanged({node_1, {"translation", "x"}});
+
+	DataChangeRecorder empty;
+	empty.mergeChanges(std::move(source));
+	EXPECT_TRUE(source.getChangedValues().empty());
+	EXPECT_EQ(empty.getAllChangedObjects(), SEditorObjectSet({node_1}));
+
+	DataChangeRecorder other;
+	other.recordValueChanged({node_2, {"translation"}});
+	other.recordValueChanged({node_1, {"translation", "y"}});
+	empty.mergeChanges(std::move(other));
+	EXPECT_EQ(empty.getAllChangedObjects(), SEditorObjectSet({node_1, node_2}));
+	EXPECT_EQ(empty.getChangedValues().at(node_1.get()).size(), static_cast<size_t>(2));
+}
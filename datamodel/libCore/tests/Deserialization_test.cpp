@@ -23,6 +23,51 @@
 
 using namespace raco::user_types;
 
+namespace {
+
+// Nodes forming a binary tree, so that all but the root node are referenced as child.
+std::vector<raco::serialization::SReflectionInterface> createNodeTree(size_t count) {
+	std::vector<raco::serialization::SReflectionInterface> objects;
+	std::vector<SNode> nodes;
+	for (size_t index = 0; index < count; index++) {
+		auto node = std::make_shared<Node>("node_" + std::to_string(index), "node_id_" + std::to_string(index));
+		if (index > 0) {
+			*nodes[(index - 1) / 2]->children_->addProperty(raco::data_storage::PrimitiveType::Ref) = std::static_pointer_cast<raco::core::EditorObject>(node);
+		}
+		nodes.emplace_back(node);
+		objects.emplace_back(node);
+	}
+	return objects;
+}
+
+QJsonDocument serializeNodes(const std::vector<raco::serialization::SReflectionInterface>& objects) {
+	return raco::serialization::serializeProject(
+		{{raco::serialization::keys::FILE_VERSION, {1}},
+			{raco::serialization::keys::RAMSES_VERSION, {1, 0, 0}},
+			{raco::serialization::keys::RAMSES_LOGIC_ENGINE_VERSION, {1, 0, 0}},
+			{raco::serialization::keys::RAMSES_COMPOSER_VERSION, {1, 0, 0}}},
+		objects, {}, {},
+		[](const raco::data_storage::ValueBase& value) -> std::optional<std::string> {
+			if (value.asRef()) {
+				return value.asRef()->objectID();
+			}
+			return {};
+		});
+}
+
+void resolveReferences(const raco::serialization::ObjectsDeserialization& result) {
+	std::map<std::string, raco::core::SEditorObject> objectsByID;
+	for (const auto& object : result.objects) {
+		auto editorObject = std::dynamic_pointer_cast<raco::core::EditorObject>(object);
+		objectsByID[editorObject->objectID()] = editorObject;
+	}
+	for (const auto& [value, id] : result.references) {
+		*value = objectsByID.at(id);
+	}
+}
+
+}  // namespace
+
 struct DeserializationTest : public TestEnvironmentCore {
 	raco::serialization::DeserializationFactory deserializationFactory() noexcept {
 		return {[this](const std::string& typeName) -> raco::serialization::SReflectionInterface {
@@ -235,4 +280,19 @@ TEST_F(DeserializationTest, deserializeObjects_luaScriptLinkedToNode) {
 
 	std::set<std::string> refRootObjectIDs{"node_id", "lua_script_id"};
 	EXPECT_EQ(result.rootObjectIDs, refRootObjectIDs);
-}
\ No newline at end of file
+}
+
+TEST_F(DeserializationTest, deserializeProject_multithreaded_result_matches_input) {
+	auto objects = createNodeTree(5000);
+	auto document = serializeNodes(objects);
+
+	auto result = raco::serialization::deserializeProject(document, deserializationFactory());
+	ASSERT_EQ(result.objectsDeserialization.objects.size(), objects.size());
+	ASSERT_EQ(result.objectsDeserialization.references.size(), objects.size() - 1);
+	for (size_t index = 0; index < objects.size(); index++) {
+		EXPECT_EQ(std::dynamic_pointer_cast<raco::core::EditorObject>(result.objectsDeserialization.objects[index])->objectID(), "node_id_" + std::to_string(index));
+	}
+
+	resolveReferences(result.objectsDeserialization);
+	EXPECT_TRUE(serializeNodes(result.objectsDeserialization.objects).toJson() == document.toJson());
+}
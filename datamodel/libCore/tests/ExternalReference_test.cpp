@@ -13,6 +13,7 @@
 #include "core/MeshCacheInterface.h"
 #include "core/Project.h"
 #include "core/Queries.h"
+#include "core/Undo.h"
 #include "ramses_base/HeadlessEngineBackend.h"
 #include "testing/RacoBaseTest.h"
 #include "testing/TestEnvironmentCore.h"
@@ -285,6 +286,120 @@ TEST_F(ExtrefTest, duplicate_normal_paste) {
 	});
 }
 
+TEST_F(ExtrefTest, external_project_loaded_read_only) {
+	auto basePathName{(cwd_path() / "base.rcp").string()};
+
+	setupBase(basePathName, [this]() {
+		auto prefab = create<Prefab>("Prefab");
+		auto node = create<Node>("prefab_child", prefab);
+	});
+
+	setupGeneric([this, basePathName]() {
+		ASSERT_TRUE(pasteFromExt(basePathName, {"Prefab"}, true));
+
+		auto originCmd = app->externalProjects()->getExternalProjectCommandInterface(basePathName);
+		ASSERT_NE(originCmd, nullptr);
+		EXPECT_FALSE(originCmd->undoStack().enabled());
+		EXPECT_EQ(originCmd->undoStack().size(), 1u);
+		EXPECT_FALSE(originCmd->undoStack().canUndo());
+		EXPECT_TRUE(cmd->undoStack().enabled());
+
+		auto prefab = find("Prefab");
+		auto node = find("prefab_child");
+		ASSERT_TRUE(prefab->query<ExternalReferenceAnnotation>());
+		ASSERT_EQ(prefab->children_->asVector<SEditorObject>(), std::vector<SEditorObject>({node}));
+	});
+}
+
+
+TEST_F(ExtrefTest, external_project_loaded_partially) {
+	auto basePathName{(cwd_path() / "base.rcp").string()};
+	auto midPathName((cwd_path() / "mid.rcp").string());
+	auto compositePathName{(cwd_path() / "composite.rcp").string()};
+
+	std::string base_id;
+	std::string mid_id;
+
+	setupBase(basePathName, [this, &base_id]() {
+		create<Mesh>("mesh");
+		create<Mesh>("other_mesh");
+		base_id = project->projectID();
+	});
+
+	setupComposite(basePathName, midPathName, {"mesh"}, [this, &mid_id]() {
+		auto prefab = create<Prefab>("prefab");
+		auto meshnode = create<MeshNode>("prefab_child", prefab);
+		cmd->set({meshnode, {"mesh"}}, findExt("mesh"));
+		create<Node>("unused_node");
+		mid_id = project->projectID();
+	}, "mid");
+
+	setupComposite(midPathName, compositePathName, {"prefab"}, []() {});
+
+	auto loadComposite = [this, compositePathName](RaCoApplication& application) {
+		application.setPartialExternalProjects(true);
+		application.switchActiveRaCoProject(QString::fromStdString(compositePathName));
+		app = &application;
+		project = application.activeRaCoProject().project();
+		cmd = application.activeRaCoProject().commandInterface();
+	};
+
+	{
+		RaCoApplication application{backend};
+		loadComposite(application);
+
+		auto meshnode = findExt<MeshNode>("prefab_child", mid_id);
+		EXPECT_EQ(*meshnode->mesh_, findExt("mesh", base_id));
+
+		auto midProject = app->externalProjects()->getExternalProject(midPathName);
+		auto baseProject = app->externalProjects()->getExternalProject(basePathName);
+		ASSERT_NE(midProject, nullptr);
+		ASSERT_NE(baseProject, nullptr);
+		EXPECT_EQ(midProject->projectID(), mid_id);
+		EXPECT_NE(Queries::findByName(midProject->instances(), "prefab_child"), nullptr);
+		EXPECT_EQ(Queries::findByName(midProject->instances(), "unused_node"), nullptr);
+		EXPECT_NE(Queries::findByName(baseProject->instances(), "mesh"), nullptr);
+		EXPECT_EQ(Queries::findByName(baseProject->instances(), "other_mesh"), nullptr);
+	}
+
+	// A new reference in mid to another object of base extends the objects loaded from base.
+	updateComposite(midPathName, [this, basePathName]() {
+		ASSERT_TRUE(pasteFromExt(basePathName, {"other_mesh"}, true));
+		cmd->set({find("prefab_child"), {"mesh"}}, findExt("other_mesh"));
+		ASSERT_TRUE(app->activeRaCoProject().save());
+	});
+
+	{
+		RaCoApplication application{backend};
+		loadComposite(application);
+
+		auto meshnode = findExt<MeshNode>("prefab_child", mid_id);
+		EXPECT_EQ(*meshnode->mesh_, findExt("other_mesh", base_id));
+
+		auto baseProject = app->externalProjects()->getExternalProject(basePathName);
+		ASSERT_NE(baseProject, nullptr);
+		EXPECT_NE(Queries::findByName(baseProject->instances(), "mesh"), nullptr);
+		EXPECT_NE(Queries::findByName(baseProject->instances(), "other_mesh"), nullptr);
+	}
+
+	// Disabling partial loading, e.g. when the editor opens a Project Browser, loads the projects completely.
+	{
+		RaCoApplication application{backend};
+		loadComposite(application);
+		application.setPartialExternalProjects(false);
+
+		auto midProject = app->externalProjects()->getExternalProject(midPathName);
+		auto baseProject = app->externalProjects()->getExternalProject(basePathName);
+		ASSERT_NE(midProject, nullptr);
+		ASSERT_NE(baseProject, nullptr);
+		EXPECT_NE(Queries::findByName(midProject->instances(), "unused_node"), nullptr);
+		EXPECT_NE(Queries::findByName(baseProject->instances(), "mesh"), nullptr);
+		EXPECT_NE(Queries::findByName(baseProject->instances(), "other_mesh"), nullptr);
+
+		auto meshnode = findExt<MeshNode>("prefab_child", mid_id);
+		EXPECT_EQ(*meshnode->mesh_, findExt("other_mesh", base_id));
+	}
+}
 
 TEST_F(ExtrefTest, extref_paste_empty_projectname) {
 	auto basePathName{(cwd_path() / "base.rcp").string()};
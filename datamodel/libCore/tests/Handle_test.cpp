@@ -118,3 +118,76 @@ TEST(HandleTests, Node)
 	AnnotationValueHandle<RangeAnnotation<double>> rot_range_invalid = rot_x_range.get("invalid");
 	EXPECT_FALSE(rot_range_invalid);
 }
+
+TEST(HandleTests, deep_index_path) {
+	auto obj = std::make_shared<ObjectWithTableProperty>();
+	ValueBase* inner = obj->t_->addProperty("level1", PrimitiveType::Table);
+	for (int level = 2; level <= 6; level++) {
+		inner = inner->asTable().addProperty("level" + std::to_string(level), PrimitiveType::Table);
+	}
+	inner->asTable().addProperty("value", PrimitiveType::Double)->set(3.0);
+
+	ValueHandle handle(obj, {"t", "level1", "level2", "level3", "level4", "level5", "level6", "value"});
+	EXPECT_TRUE(handle);
+	EXPECT_EQ(handle.depth(), 8);
+	EXPECT_EQ(handle.asDouble(), 3.0);
+	EXPECT_EQ(handle.getPropertyNamesVector(), std::vector<std::string>({"t", "level1", "level2", "level3", "level4", "level5", "level6", "value"}));
+
+	ValueHandle parent = handle.parent();
+	EXPECT_EQ(parent.depth(), 7);
+	EXPECT_TRUE(parent.contains(handle));
+	EXPECT_EQ(parent.get("value"), handle);
+
+	ValueHandle level3 = parent.parent().parent().parent();
+	EXPECT_EQ(level3.depth(), 4);
+	EXPECT_EQ(level3.get("level4").get("level5").get("level6").get("value"), handle);
+	EXPECT_TRUE(level3.contains(handle));
+	EXPECT_TRUE(level3 < handle);
+	EXPECT_FALSE(handle < level3);
+}
+
+TEST(HandleTests, cached_value_invalidated_by_table_change) {
+	auto obj = std::make_shared<ObjectWithTableProperty>();
+	obj->t_->addProperty("a", PrimitiveType::Double)->set(1.0);
+	obj->t_->addProperty("b", PrimitiveType::Double)->set(2.0);
+
+	ValueHandle table(obj, {"t"});
+	ValueHandle index_1 = table[1];
+	EXPECT_EQ(ValueHandle(obj, {"t", "b"}).asDouble(), 2.0);
+	EXPECT_EQ(index_1.asDouble(), 2.0);
+
+	obj->t_->removeProperty("a");
+	EXPECT_FALSE(index_1);
+	EXPECT_EQ(table[0].asDouble(), 2.0);
+
+	obj->t_->addProperty("c", ValueBase::create(PrimitiveType::Double), 0);
+	EXPECT_TRUE(index_1);
+	EXPECT_EQ(index_1.asDouble(), 2.0);
+
+	obj->t_->replaceProperty("b", ValueBase::create(PrimitiveType::Double).release());
+	EXPECT_EQ(index_1.asDouble(), 0.0);
+}
+
+TEST(HandleTests, cached_value_kept_by_unrelated_table_change) {
+	auto obj = std::make_shared<ObjectWithTableProperty>();
+	obj->t_->addProperty("a", PrimitiveType::Double)->set(1.0);
+	auto& nested = obj->t_->addProperty("nested", PrimitiveType::Table)->asTable();
+	auto other = std::make_shared<ObjectWithTableProperty>();
+
+	ValueHandle a(obj, {"t", "a"});
+	EXPECT_EQ(a.asDouble(), 1.0);
+	auto version = obj->t_->structureVersion();
+
+	// Structural changes of another object don't touch the Table the handle resolves through.
+	other->t_->addProperty("b", PrimitiveType::Double);
+	other->t_->addProperty("nested", PrimitiveType::Table)->asTable().addProperty("c", PrimitiveType::Int);
+	other->t_->removeProperty("b");
+	EXPECT_EQ(obj->t_->structureVersion(), version);
+	EXPECT_EQ(a.asDouble(), 1.0);
+
+	// Changes of Tables nested inside it do.
+	nested.addProperty("d", PrimitiveType::Int);
+	EXPECT_EQ(obj->t_->structureVersion(), version + 1);
+	EXPECT_EQ(ValueHandle(obj, {"t", "nested", "d"}).asInt(), 0);
+	EXPECT_EQ(a.asDouble(), 1.0);
+}
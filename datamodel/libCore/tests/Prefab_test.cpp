@@ -593,3 +593,73 @@ TEST_F(PrefabTest, update_luascript_module_dependant_in_prefab_remove_module) {
 	ASSERT_TRUE(commandInterface.errors().hasError({lua}));
 	ASSERT_TRUE(commandInterface.errors().hasError({inst_lua}));
 }
+
+TEST_F(PrefabTest, set_node_prop_only_updates_instances_of_changed_prefab) {
+	auto prefab1 = create<Prefab>("prefab 1");
+	auto node1 = create<Node>("node 1", prefab1);
+	auto inst1 = create<PrefabInstance>("inst 1");
+	commandInterface.set({inst1, {"template"}}, prefab1);
+
+	auto prefab2 = create<Prefab>("prefab 2");
+	auto node2 = create<Node>("node 2", prefab2);
+	auto inst2 = create<PrefabInstance>("inst 2");
+	commandInterface.set({inst2, {"template"}}, prefab2);
+
+	auto instNode1 = inst1->children_->asVector<SEditorObject>()[0];
+	auto instNode2 = inst2->children_->asVector<SEditorObject>()[0];
+	recorder.reset();
+
+	commandInterface.set({node1, {"translation", "x"}}, 2.0);
+
+	EXPECT_EQ(*instNode1->as<Node>()->translation_->x, 2.0);
+	EXPECT_TRUE(recorder.hasValueChanged({instNode1, {"translation", "x"}}));
+	const auto& changed = recorder.getAllChangedObjects();
+	EXPECT_TRUE(changed.find(instNode2) == changed.end());
+	EXPECT_TRUE(changed.find(inst2) == changed.end());
+}
+
+TEST_F(PrefabTest, nesting_dirty_prefab_propagates_through_update) {
+	auto prefab1 = create<Prefab>("prefab 1");
+	auto node = create<Node>("node", prefab1);
+	auto prefab2 = create<Prefab>("prefab 2");
+	auto inst1 = create<PrefabInstance>("inst 1", prefab2);
+	commandInterface.set({inst1, {"template"}}, prefab1);
+	auto inst2 = create<PrefabInstance>("inst 2");
+	commandInterface.set({inst2, {"template"}}, prefab2);
+
+	auto nestedInst = inst2->children_->asVector<SEditorObject>()[0]->as<PrefabInstance>();
+	ASSERT_TRUE(nestedInst);
+	auto nestedNode = nestedInst->children_->asVector<SEditorObject>()[0]->as<Node>();
+
+	// Only prefab 1 is changed directly; prefab 2 becomes dirty by the update of inst 1.
+	commandInterface.set({node, {"visible"}}, false);
+	EXPECT_EQ(*nestedNode->visible_, false);
+}
+
+TEST_F(PrefabTest, update_order_only_contains_prefabs_reachable_from_changes) {
+	auto prefab1 = create<Prefab>("prefab 1");
+	auto node1 = create<Node>("node 1", prefab1);
+	auto inst1 = create<PrefabInstance>("inst 1");
+	commandInterface.set({inst1, {"template"}}, prefab1);
+
+	auto prefab2 = create<Prefab>("prefab 2");
+	create<Node>("node 2", prefab2);
+	auto inst2 = create<PrefabInstance>("inst 2");
+	commandInterface.set({inst2, {"template"}}, prefab2);
+
+	auto prefab3 = create<Prefab>("prefab 3");
+	auto nestedInst = create<PrefabInstance>("nested inst", prefab3);
+	commandInterface.set({nestedInst, {"template"}}, prefab1);
+
+	auto node = create<Node>("node");
+
+	// An edit outside of all prefabs doesn't visit any prefab.
+	recorder.reset();
+	commandInterface.set({node, {"translation", "x"}}, 2.0);
+	EXPECT_TRUE(PrefabOperations::prefabUpdateOrder(project, recorder).empty());
+
+	// An edit inside prefab 1 visits it and prefab 3 containing an instance of it, but not prefab 2.
+	recorder.reset();
+	commandInterface.set({node1, {"translation", "x"}}, 2.0);
+	EXPECT_EQ(PrefabOperations::prefabUpdateOrder(project, recorder), std::vector<SPrefab>({prefab3, prefab1}));
+}
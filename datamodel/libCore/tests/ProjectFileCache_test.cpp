@@ -0,0 +1,161 @@
+/*
+ * SPDX-License-Identifier: MPL-2.0
+ *
+ * This file is part of Ramses Composer
+ * (see https://github.com/GENIVI/ramses-composer).
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "core/ProjectFileCache.h"
+
+#include "core/BinarySerialization.h"
+#include "core/RamsesProjectMigration.h"
+#include "testing/TestEnvironmentCore.h"
+#include "utils/FileUtils.h"
+#include "utils/PathUtils.h"
+
+#include <QDateTime>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <gtest/gtest.h>
+
+using namespace raco::serialization;
+
+struct ProjectFileCacheTest : public TestEnvironmentCore {
+	ProjectFileCache cache{(cwd_path() / "projectcache").string()};
+
+	QByteArray readFile(const std::string& path) {
+		QFile file{QString::fromStdString(path)};
+		EXPECT_TRUE(file.open(QIODevice::ReadOnly));
+		return file.readAll();
+	}
+
+	std::string writeProjectFile(const std::string& fileName, const std::string& contents) {
+		auto path = (cwd_path() / fileName).string();
+		raco::utils::file::write(path, contents);
+		return path;
+	}
+
+	QJsonDocument migratedDocument(const std::string& objectName) {
+		return QJsonDocument{QJsonObject{
+			{"fileVersion", raco::core::RAMSES_PROJECT_FILE_VERSION},
+			{"instances", QJsonArray{QJsonObject{{"typeName", "Node"}, {"properties", QJsonObject{{"objectName", QString::fromStdString(objectName)}}}}}}}};
+	}
+
+	QByteArray migratedProject(const std::string& objectName) {
+		return toBinaryProject(migratedDocument(objectName));
+	}
+
+	// The cached document or a null document if there is no valid entry.
+	QJsonDocument lookupDocument(const ProjectFileCache& cache, const std::string& path, const QByteArray& data) {
+		auto project = cache.lookup(path, data);
+		return project ? project->toJson() : QJsonDocument{};
+	}
+};
+
+TEST_F(ProjectFileCacheTest, lookup_without_entry) {
+	auto path = writeProjectFile("project.rca", "{}");
+	EXPECT_FALSE(cache.lookup(path, readFile(path)));
+}
+
+TEST_F(ProjectFileCacheTest, store_and_lookup) {
+	auto path = writeProjectFile("project.rca", "{}");
+	auto data = readFile(path);
+	ASSERT_TRUE(cache.store(path, data, migratedProject("node")));
+	EXPECT_TRUE(raco::utils::path::isExistingFile(cache.entryPath(path)));
+
+	EXPECT_EQ(lookupDocument(cache, path, data), migratedDocument("node"));
+	EXPECT_EQ(lookupDocument(ProjectFileCache{cache.directory()}, path, data), migratedDocument("node"));
+}
+
+TEST_F(ProjectFileCacheTest, entries_are_per_file) {
+	auto path1 = writeProjectFile("project1.rca", "{}");
+	auto path2 = writeProjectFile("project2.rca", "{}");
+	EXPECT_NE(cache.entryPath(path1), cache.entryPath(path2));
+
+	ASSERT_TRUE(cache.store(path1, readFile(path1), migratedProject("node1")));
+	EXPECT_FALSE(cache.lookup(path2, readFile(path2)));
+
+	ASSERT_TRUE(cache.store(path2, readFile(path2), migratedProject("node2")));
+	EXPECT_EQ(lookupDocument(cache, path1, readFile(path1)), migratedDocument("node1"));
+	EXPECT_EQ(lookupDocument(cache, path2, readFile(path2)), migratedDocument("node2"));
+}
+
+TEST_F(ProjectFileCacheTest, changed_content_is_detected) {
+	auto path = writeProjectFile("project.rca", "{\"a\": 1}");
+	ASSERT_TRUE(cache.store(path, readFile(path), migratedProject("node")));
+
+	// Same size, different content
+	writeProjectFile("project.rca", "{\"a\": 2}");
+	EXPECT_FALSE(cache.lookup(path, readFile(path)));
+
+	writeProjectFile("project.rca", "{\"a\": 1}");
+	auto data = readFile(path);
+	EXPECT_FALSE(cache.lookup(path, data + " "));
+}
+
+TEST_F(ProjectFileCacheTest, store_replaces_outdated_entry) {
+	auto path = writeProjectFile("project.rca", "{\"a\": 1}");
+	ASSERT_TRUE(cache.store(path, readFile(path), migratedProject("old")));
+
+	writeProjectFile("project.rca", "{\"a\": 22}");
+	auto data = readFile(path);
+	ASSERT_FALSE(cache.lookup(path, data));
+	ASSERT_TRUE(cache.store(path, data, migratedProject("new")));
+	EXPECT_EQ(lookupDocument(cache, path, data), migratedDocument("new"));
+}
+
+TEST_F(ProjectFileCacheTest, invalid_entry_is_ignored) {
+	auto path = writeProjectFile("project.rca", "{}");
+	auto data = readFile(path);
+	ASSERT_TRUE(cache.store(path, data, migratedProject("node")));
+
+	auto entry = readFile(cache.entryPath(path));
+	for (int size : {0, 3, entry.size() / 2, entry.size() - 1}) {
+		raco::utils::file::write(cache.entryPath(path), entry.left(size).toStdString());
+		EXPECT_FALSE(cache.lookup(path, data));
+	}
+
+	raco::utils::file::write(cache.entryPath(path), "RCAB");
+	EXPECT_FALSE(cache.lookup(path, data));
+}
+
+TEST_F(ProjectFileCacheTest, least_recently_used_entries_are_evicted) {
+	auto path1 = writeProjectFile("project1.rca", "{}");
+	auto path2 = writeProjectFile("project2.rca", "{}");
+	auto path3 = writeProjectFile("project3.rca", "{}");
+	ASSERT_TRUE(cache.store(path1, readFile(path1), migratedProject("node")));
+	auto entrySize = QFileInfo(QString::fromStdString(cache.entryPath(path1))).size();
+
+	// Room for two entries of the same size.
+	ProjectFileCache smallCache{(cwd_path() / "smallcache").string(), 2 * entrySize + entrySize / 2};
+	ASSERT_TRUE(smallCache.store(path1, readFile(path1), migratedProject("node")));
+	ASSERT_TRUE(smallCache.store(path2, readFile(path2), migratedProject("node")));
+	auto setModified = [&smallCache](const std::string& path, int secondsAgo) {
+		QFile entry{QString::fromStdString(smallCache.entryPath(path))};
+		ASSERT_TRUE(entry.open(QIODevice::ReadWrite));
+		ASSERT_TRUE(entry.setFileTime(QDateTime::currentDateTime().addSecs(-secondsAgo), QFileDevice::FileModificationTime));
+	};
+	setModified(path1, 200);
+	setModified(path2, 100);
+
+	// The lookup makes project 1 the most recently used entry, so storing project 3 evicts project 2.
+	EXPECT_EQ(lookupDocument(smallCache, path1, readFile(path1)), migratedDocument("node"));
+	ASSERT_TRUE(smallCache.store(path3, readFile(path3), migratedProject("node")));
+	EXPECT_EQ(lookupDocument(smallCache, path1, readFile(path1)), migratedDocument("node"));
+	EXPECT_FALSE(smallCache.lookup(path2, readFile(path2)));
+	EXPECT_FALSE(raco::utils::path::isExistingFile(smallCache.entryPath(path2)));
+	EXPECT_EQ(lookupDocument(smallCache, path3, readFile(path3)), migratedDocument("node"));
+}
+
+TEST_F(ProjectFileCacheTest, remove_entry) {
+	auto path = writeProjectFile("project.rca", "{}");
+	ASSERT_TRUE(cache.store(path, readFile(path), migratedProject("node")));
+	cache.remove(path);
+	EXPECT_FALSE(raco::utils::path::isExistingFile(cache.entryPath(path)));
+	EXPECT_FALSE(cache.lookup(path, readFile(path)));
+	cache.remove(path);
+}
@@ -30,6 +30,7 @@
 
 #include "testing/TestEnvironmentCore.h"
 
+#include <QBuffer>
 #include <gtest/gtest.h>
 
 constexpr bool GENERATE_DIFF{false};
@@ -67,6 +68,11 @@ struct MigrationTest : public TestEnvironmentCore {
 		auto serialized = racoproject->serializeProject(currentVersions);
 		auto serializedJson = serialized.toJson().toStdString();
 
+		QBuffer streamed;
+		EXPECT_TRUE(streamed.open(QIODevice::WriteOnly));
+		EXPECT_TRUE(racoproject->writeProject(streamed, currentVersions));
+		EXPECT_TRUE(streamed.data().toStdString() == serializedJson);
+
 		if (GENERATE_DIFF) {
 			// This show a diff but is _very_ slow when run under the visual studio
 			EXPECT_EQ(migratedJson, serializedJson);
@@ -371,3 +377,15 @@ TEST_F(MigrationTest, migrate_from_current) {
 	}
 }
 
+
+TEST_F(MigrationTest, migrate_current_returns_document_unchanged) {
+	QFile file{QString::fromStdString((cwd_path() / "migrationTestData" / "version-current.rca").string())};
+	ASSERT_TRUE(file.open(QIODevice::ReadOnly));
+	auto document{QJsonDocument::fromJson(file.readAll())};
+	ASSERT_EQ(raco::serialization::deserializeFileVersion(document), raco::core::RAMSES_PROJECT_FILE_VERSION);
+
+	std::unordered_map<std::string, std::string> migrationObjWarnings;
+	auto migratedDoc{raco::core::migrateProject(document, migrationObjWarnings)};
+	EXPECT_EQ(migratedDoc, document);
+	EXPECT_TRUE(migrationObjWarnings.empty());
+}
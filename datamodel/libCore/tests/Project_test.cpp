@@ -0,0 +1,233 @@
+/*
+ * SPDX-License-Identifier: MPL-2.0
+ *
+ * This file is part of Ramses Composer
+ * (see https://github.com/GENIVI/ramses-composer).
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "core/Link.h"
+#include "core/Project.h"
+#include "user_types/Node.h"
+
+#include "gtest/gtest.h"
+
+#include <random>
+#include <regex>
+
+using namespace raco::core;
+using namespace raco::user_types;
+
+namespace {
+
+// Regular expression based implementation used before the introduction of the UniqueNameIndex.
+std::string referenceUniqueName(const std::vector<SEditorObject>& objects, SEditorObject newObject, const std::string& name) {
+	static const std::regex namingPattern{"(.*)\\s+\\((\\d+)\\)"};
+	if (std::find_if(objects.begin(), objects.end(), [newObject, name](auto obj) {
+			return obj != newObject && obj->objectName() == name;
+		}) == objects.end()) {
+		return name;
+	}
+
+	std::string basename;
+	std::smatch match;
+	if (std::regex_match(name, match, namingPattern)) {
+		basename = match[1];
+	} else {
+		basename = name;
+	}
+
+	std::set<int> indices;
+	for (const auto& obj : objects) {
+		auto currentName = obj->objectName();
+		std::smatch m;
+		if (std::regex_match(currentName, m, namingPattern)) {
+			if (basename == m[1]) {
+				indices.insert(std::stoi(m[2]));
+			}
+		} else if (currentName == basename) {
+			indices.insert(0);
+		}
+	}
+
+	auto it = std::adjacent_find(indices.begin(), indices.end(), [](int l, int r) { return l + 1 < r; });
+	if (it == indices.end()) {
+		--it;
+	}
+	return fmt::format("{} ({})", basename, *it + 1);
+}
+
+std::vector<SEditorObject> createNodes(const std::vector<std::string>& names) {
+	std::vector<SEditorObject> nodes;
+	for (const auto& name : names) {
+		nodes.emplace_back(std::make_shared<Node>(name));
+	}
+	return nodes;
+}
+
+SLink makeLink(const SEditorObject& start, const SEditorObject& end) {
+	return std::make_shared<Link>(PropertyDescriptor(start, {"translation"}), PropertyDescriptor(end, {"rotation"}));
+}
+
+// Reference loop check: search the links for a path end -> start.
+bool referenceCreatesLoop(const Project& project, const SEditorObject& start, const SEditorObject& end) {
+	if (start == end) {
+		return true;
+	}
+	std::set<SEditorObject> visited{end};
+	std::vector<SEditorObject> stack{end};
+	while (!stack.empty()) {
+		auto current = stack.back();
+		stack.pop_back();
+		for (const auto& link : project.links()) {
+			if (*link->startObject_ == current) {
+				auto next = *link->endObject_;
+				if (next == start) {
+					return true;
+				}
+				if (visited.insert(next).second) {
+					stack.emplace_back(next);
+				}
+			}
+		}
+	}
+	return false;
+}
+
+void checkLoops(const Project& project, const std::vector<SEditorObject>& nodes) {
+	for (const auto& start : nodes) {
+		for (const auto& end : nodes) {
+			EXPECT_EQ(project.createsLoop(PropertyDescriptor(start, {"translation"}), PropertyDescriptor(end, {"rotation"})), referenceCreatesLoop(project, start, end))
+				<< start->objectName() << " -> " << end->objectName();
+		}
+	}
+}
+
+}  // namespace
+
+TEST(LinkGraphTest, loop_detection_with_reordering) {
+	auto nodes = createNodes({"a", "b", "c", "d"});
+	Project project;
+	// Added against the initial order of the objects to force reordering
+	project.addLink(makeLink(nodes[2], nodes[3]));
+	project.addLink(makeLink(nodes[1], nodes[2]));
+	project.addLink(makeLink(nodes[0], nodes[1]));
+	checkLoops(project, nodes);
+	EXPECT_TRUE(project.createsLoop(PropertyDescriptor(nodes[3], {"translation"}), PropertyDescriptor(nodes[0], {"rotation"})));
+	EXPECT_FALSE(project.createsLoop(PropertyDescriptor(nodes[0], {"translation"}), PropertyDescriptor(nodes[3], {"rotation"})));
+}
+
+TEST(LinkGraphTest, parallel_links) {
+	auto nodes = createNodes({"a", "b"});
+	Project project;
+	auto link1 = makeLink(nodes[0], nodes[1]);
+	auto link2 = std::make_shared<Link>(PropertyDescriptor(nodes[0], {"scaling"}), PropertyDescriptor(nodes[1], {"translation"}));
+	project.addLink(link1);
+	project.addLink(link2);
+	project.removeLink(link1);
+	// The remaining link still connects the objects.
+	EXPECT_TRUE(project.createsLoop(PropertyDescriptor(nodes[1], {"translation"}), PropertyDescriptor(nodes[0], {"rotation"})));
+	project.removeLink(link2);
+	EXPECT_FALSE(project.createsLoop(PropertyDescriptor(nodes[1], {"translation"}), PropertyDescriptor(nodes[0], {"rotation"})));
+}
+
+TEST(LinkGraphTest, existing_loop_removed) {
+	auto nodes = createNodes({"a", "b", "c"});
+	Project project;
+	// Loops can't be created by the user but can exist in broken project files.
+	auto closing = makeLink(nodes[2], nodes[0]);
+	project.addLink(makeLink(nodes[0], nodes[1]));
+	project.addLink(makeLink(nodes[1], nodes[2]));
+	project.addLink(closing);
+	checkLoops(project, nodes);
+
+	project.removeLink(closing);
+	checkLoops(project, nodes);
+
+	project.addLink(makeLink(nodes[0], nodes[0]));
+	checkLoops(project, nodes);
+}
+
+TEST(LinkGraphTest, random_links_match_reference) {
+	auto nodes = createNodes({"0", "1", "2", "3", "4", "5", "6", "7", "8", "9"});
+	Project project;
+	std::mt19937 random(42);
+	std::uniform_int_distribution<size_t> nodeDist(0, nodes.size() - 1);
+	for (int step = 0; step < 200; step++) {
+		if (!project.links().empty() && random() % 3 == 0) {
+			project.removeLink(project.links()[random() % project.links().size()]);
+		} else {
+			auto start = nodes[nodeDist(random)];
+			auto end = nodes[nodeDist(random)];
+			// Mostly loop-free as in the application but occasionally also add loops.
+			if (!project.createsLoop(PropertyDescriptor(start, {"translation"}), PropertyDescriptor(end, {"rotation"})) || random() % 10 == 0) {
+				project.addLink(makeLink(start, end));
+			}
+		}
+		checkLoops(project, nodes);
+	}
+}
+
+TEST(UniqueNameIndexTest, split_name) {
+	std::string basename;
+	int suffix;
+	EXPECT_TRUE(UniqueNameIndex::splitName("Node (12)", basename, suffix));
+	EXPECT_EQ(basename, "Node");
+	EXPECT_EQ(suffix, 12);
+
+	EXPECT_TRUE(UniqueNameIndex::splitName("Node  (3)", basename, suffix));
+	EXPECT_EQ(basename, "Node ");
+	EXPECT_TRUE(UniqueNameIndex::splitName(" (3)", basename, suffix));
+	EXPECT_EQ(basename, "");
+
+	EXPECT_FALSE(UniqueNameIndex::splitName("Node", basename, suffix));
+	EXPECT_FALSE(UniqueNameIndex::splitName("Node(1)", basename, suffix));
+	EXPECT_FALSE(UniqueNameIndex::splitName("Node ()", basename, suffix));
+	EXPECT_FALSE(UniqueNameIndex::splitName("Node (1a)", basename, suffix));
+	EXPECT_FALSE(UniqueNameIndex::splitName("Node (1) ", basename, suffix));
+}
+
+TEST(UniqueNameIndexTest, matches_regex_implementation) {
+	std::vector<std::string> names{"Node", "Node (1)", "Node (3)", "Node  (2)", "Mesh", "Mesh (0)", "Other (5)", "Other (6)", " (1)", "Line\nbreak (1)", "Line\nbreak", "Line \n (2)"};
+	auto nodes = createNodes(names);
+
+	std::vector<std::string> queries{"Node", "Node (1)", "Node (2)", "Node (3)", "Node ", "Mesh", "Mesh (0)", "Other (5)", "Other", " (1)", "", "Line\nbreak", "Line (1)", "New"};
+	for (const auto& query : queries) {
+		EXPECT_EQ(Project::findAvailableUniqueName(nodes.begin(), nodes.end(), nullptr, query), referenceUniqueName(nodes, nullptr, query)) << query;
+		for (const auto& node : nodes) {
+			EXPECT_EQ(Project::findAvailableUniqueName(nodes.begin(), nodes.end(), node, query), referenceUniqueName(nodes, node, query)) << query;
+		}
+	}
+}
+
+TEST(UniqueNameIndexTest, incremental_updates) {
+	auto nodes = createNodes({"Node", "Node (1)", "Node (2)", "Node (4)"});
+	UniqueNameIndex index(nodes.begin(), nodes.end());
+	EXPECT_EQ(index.findAvailableName("Node"), "Node (3)");
+
+	index.removeName("Node (1)");
+	EXPECT_EQ(index.findAvailableName("Node"), "Node (1)");
+	EXPECT_EQ(index.findAvailableName("Node (1)"), "Node (1)");
+
+	index.addName("Node (1)");
+	index.addName("Node (3)");
+	EXPECT_EQ(index.findAvailableName("Node (4)"), "Node (5)");
+
+	index.removeName("Node");
+	EXPECT_EQ(index.findAvailableName("Node"), "Node");
+	EXPECT_EQ(index.findAvailableName("Node (2)"), "Node (5)");
+
+	index.addName("Node (2)");
+	EXPECT_EQ(index.findAvailableName("Node (2)", true), "Node (5)");
+	EXPECT_EQ(index.findAvailableName("Node (3)", true), "Node (3)");
+}
+
+TEST(UniqueNameIndexTest, repeated_name_generation) {
+	UniqueNameIndex index;
+	for (int count = 0; count < 100; count++) {
+		auto name = index.findAvailableName("Node");
+		EXPECT_EQ(name, count == 0 ? "Node" : fmt::format("Node ({})", count));
+		index.addName(name);
+	}
+}
@@ -783,6 +783,210 @@ void main() {
 	postCheck("alt_name");
 }
 
+TEST_F(UndoTest, memory_usage_value_change_smaller_than_create) {
+	auto node = create<Node>("node");
+	size_t createUsage = undoStack.entryMemoryUsage(undoStack.getIndex());
+
+	commandInterface.set({node, {"translation", "x"}}, 2.0);
+	size_t setUsage = undoStack.entryMemoryUsage(undoStack.getIndex());
+
+	EXPECT_GT(setUsage, 0);
+	EXPECT_LT(setUsage, createUsage);
+	EXPECT_GT(undoStack.memoryUsage(), createUsage + setUsage);
+}
+
+TEST_F(UndoTest, memory_budget_evicts_oldest_entries) {
+	for (int i = 0; i < 10; i++) {
+		create<Node>("node" + std::to_string(i));
+	}
+	ASSERT_EQ(undoStack.size(), 11);
+	size_t entryUsage = undoStack.entryMemoryUsage(undoStack.getIndex());
+
+	undoStack.setMemoryBudget(4 * entryUsage);
+	EXPECT_LT(undoStack.size(), 11);
+	EXPECT_GE(undoStack.size(), 2);
+	EXPECT_EQ(undoStack.getIndex(), undoStack.size() - 1);
+
+	size_t stackUsage = 0;
+	for (size_t index = 0; index < undoStack.size(); index++) {
+		stackUsage += undoStack.entryMemoryUsage(index);
+	}
+	EXPECT_LE(stackUsage, undoStack.memoryBudget());
+
+	size_t numEntries = undoStack.size();
+	undoStack.setIndex(0);
+	EXPECT_EQ(project.instances().size(), 10 - (numEntries - 1));
+
+	undoStack.setIndex(numEntries - 1);
+	EXPECT_EQ(project.instances().size(), 10);
+	for (int i = 0; i < 10; i++) {
+		EXPECT_TRUE(findInstance("node" + std::to_string(i)));
+	}
+}
+
+TEST_F(UndoTest, merge_nested_and_enclosing_value_change) {
+	auto node = create<Node>("node");
+
+	checkUndoRedo([this, node]() {
+			context.set({node, {"translation", "x"}}, 2.0);
+			undoStack.push("set translation x", "translation");
+
+			context.set({node, {"translation", "x"}}, 3.0);
+			context.set({node, {"translation", "z"}}, 5.0);
+			context.modelChanges().recordValueChanged({node, {"translation"}});
+			undoStack.push("set translation", "translation");
+		},
+		[this, node]() {
+			EXPECT_EQ(ValueHandle(node, {"translation", "x"}).asDouble(), 0.0);
+			EXPECT_EQ(ValueHandle(node, {"translation", "z"}).asDouble(), 0.0);
+		},
+		[this, node]() {
+			EXPECT_EQ(ValueHandle(node, {"translation", "x"}).asDouble(), 3.0);
+			EXPECT_EQ(ValueHandle(node, {"translation", "z"}).asDouble(), 5.0);
+		});
+}
+
+TEST_F(UndoTest, partial_restore_matches_full_restore) {
+	// A forced restore compares the complete project with the undo stack state and must not find
+	// any differences left over by the partial restore done by undo/redo.
+	auto checkFullRestore = [this]() {
+		recorder.reset();
+		undoStack.setIndex(undoStack.getIndex(), true);
+		EXPECT_TRUE(recorder.getCreatedObjects().empty());
+		EXPECT_TRUE(recorder.getDeletedObjects().empty());
+		EXPECT_TRUE(recorder.getChangedValues().empty());
+		EXPECT_TRUE(recorder.getAddedLinks().empty());
+		EXPECT_TRUE(recorder.getRemovedLinks().empty());
+		EXPECT_TRUE(recorder.getValidityChangedLinks().empty());
+	};
+
+	auto parent = create<Node>("parent");
+	auto child = create<Node>("child", parent);
+	auto other = create<Node>("other");
+	commandInterface.set({child, {"translation", "x"}}, 2.0);
+	commandInterface.moveScenegraphChildren({child}, other);
+
+	auto start = create<LuaScript>("start");
+	commandInterface.set({start, {"uri"}}, cwd_path().append("scripts/types-scalar.lua").string());
+	auto end = create<LuaScript>("end");
+	commandInterface.set({end, {"uri"}}, cwd_path().append("scripts/types-scalar.lua").string());
+	commandInterface.addLink({start, {"luaOutputs", "ofloat"}}, {end, {"luaInputs", "float"}});
+	commandInterface.set({start, {"uri"}}, cwd_path().append("scripts/SimpleScript.lua").string());
+
+	auto prefab = create<Prefab>("prefab");
+	auto prefabNode = create<Node>("prefab_node", prefab);
+	auto inst = create<PrefabInstance>("inst");
+	commandInterface.set({inst, {"template"}}, prefab);
+	commandInterface.set({prefabNode, {"scaling", "y"}}, 3.0);
+
+	commandInterface.deleteObjects({parent, prefabNode});
+
+	size_t topIndex = undoStack.getIndex();
+	while (undoStack.canUndo()) {
+		undoStack.undo();
+		checkFullRestore();
+	}
+	while (undoStack.canRedo()) {
+		undoStack.redo();
+		checkFullRestore();
+	}
+	EXPECT_EQ(undoStack.getIndex(), topIndex);
+
+	undoStack.setIndex(0);
+	checkFullRestore();
+	undoStack.setIndex(topIndex);
+	checkFullRestore();
+}
+
+TEST_F(UndoTest, spilled_entries_restored_on_undo) {
+	undoStack.setSpillDepth(2);
+
+	auto parent = create<Node>("parent");
+	auto child = create<Node>("child", parent);
+	commandInterface.set({child, {"translation", "y"}}, 4.0);
+
+	auto start = create<LuaScript>("start");
+	commandInterface.set({start, {"uri"}}, cwd_path().append("scripts/types-scalar.lua").string());
+	auto end = create<LuaScript>("end", parent);
+	commandInterface.set({end, {"uri"}}, cwd_path().append("scripts/types-scalar.lua").string());
+	commandInterface.set({end, {"luaInputs", "float"}}, 2.0);
+	commandInterface.addLink({start, {"luaOutputs", "ofloat"}}, {end, {"luaInputs", "float"}});
+	commandInterface.set({start, {"uri"}}, cwd_path().append("scripts/SimpleScript.lua").string());
+	size_t brokenLinkIndex = undoStack.getIndex();
+
+	commandInterface.deleteObjects({parent});
+	commandInterface.set({start, {"uri"}}, cwd_path().append("scripts/types-scalar.lua").string());
+	create<Node>("last");
+	create<Node>("final");
+
+	size_t topIndex = undoStack.getIndex();
+	EXPECT_FALSE(undoStack.entrySpilled(0));
+	EXPECT_TRUE(undoStack.entrySpilled(1));
+	EXPECT_TRUE(undoStack.entrySpilled(brokenLinkIndex));
+	EXPECT_TRUE(undoStack.entrySpilled(topIndex - 3));
+	EXPECT_FALSE(undoStack.entrySpilled(topIndex - 2));
+
+	undoStack.setIndex(brokenLinkIndex);
+	EXPECT_FALSE(undoStack.entrySpilled(brokenLinkIndex + 1));
+	checkInstances({"parent", "child", "start", "end"}, {"last", "final"});
+	auto restoredParent = getInstance<Node>("parent");
+	auto restoredChild = getInstance<Node>("child");
+	EXPECT_EQ(restoredChild->getParent(), restoredParent);
+	EXPECT_EQ(getInstance<Node>("end")->getParent(), restoredParent);
+	EXPECT_EQ(ValueHandle(restoredChild, {"translation", "y"}).asDouble(), 4.0);
+	EXPECT_EQ(ValueHandle(getInstance<LuaScript>("end"), {"luaInputs", "float"}).asDouble(), 2.0);
+	ASSERT_EQ(project.links().size(), 1);
+	EXPECT_FALSE(project.links()[0]->isValid());
+
+	// A forced full restore must not find any differences after undoing loaded entries.
+	while (undoStack.canUndo()) {
+		undoStack.undo();
+		recorder.reset();
+		undoStack.setIndex(undoStack.getIndex(), true);
+		EXPECT_TRUE(recorder.getCreatedObjects().empty());
+		EXPECT_TRUE(recorder.getDeletedObjects().empty());
+		EXPECT_TRUE(recorder.getChangedValues().empty());
+		EXPECT_TRUE(recorder.getAddedLinks().empty());
+		EXPECT_TRUE(recorder.getRemovedLinks().empty());
+		EXPECT_TRUE(recorder.getValidityChangedLinks().empty());
+	}
+	EXPECT_TRUE(project.instances().empty());
+
+	undoStack.setIndex(topIndex);
+	checkInstances({"start", "last", "final"}, {"parent", "child", "end"});
+	EXPECT_TRUE(project.links().empty());
+	EXPECT_TRUE(undoStack.entrySpilled(topIndex - 3));
+}
+
+TEST_F(UndoTest, spill_file_reused_by_undo_redo_and_trimmed_on_truncation) {
+	undoStack.setSpillDepth(1);
+
+	for (int index = 0; index < 6; index++) {
+		auto node = create<Node>("node " + std::to_string(index));
+		commandInterface.set({node, {"translation", "x"}}, static_cast<double>(index));
+	}
+	size_t topIndex = undoStack.getIndex();
+	auto spillFileSize = undoStack.spillFileSize();
+	EXPECT_GT(spillFileSize, 0);
+
+	// Entries loaded by undo are unchanged when spilled again by redo and keep their place in the file.
+	for (int cycle = 0; cycle < 3; cycle++) {
+		undoStack.setIndex(1);
+		undoStack.setIndex(topIndex);
+		EXPECT_TRUE(undoStack.entrySpilled(topIndex - 2));
+		EXPECT_EQ(undoStack.spillFileSize(), spillFileSize);
+	}
+	checkInstances({"node 0", "node 5"}, {});
+
+	// Dropping the entries above the index releases their part of the file.
+	undoStack.setIndex(3);
+	create<Node>("other");
+	EXPECT_LT(undoStack.spillFileSize(), spillFileSize);
+
+	undoStack.reset();
+	EXPECT_EQ(undoStack.spillFileSize(), 0);
+}
+
 #if (!defined(__linux__))
 // awaitPreviewDirty does not work in Linux as expected. See RAOS-692
 
@@ -934,7 +1138,7 @@ end
 	checkLinks({{sprop, eprop, true}});
 
 	{
-		Project& stackProject = stack().back()->state;
+		Project& stackProject = undoStack.state();
 
 		auto stackLua = getInstance<LuaScript>(stackProject, "lua");
 		ASSERT_EQ(stackProject.links().size(), 1);
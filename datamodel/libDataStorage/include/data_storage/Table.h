@@ -12,9 +12,11 @@
 #include "ReflectionInterface.h"
 #include "Value.h"
 
+#include <cstdint>
 #include <vector>
 #include <string>
 #include <memory>
+#include <unordered_map>
 
 namespace raco::data_storage {
 
@@ -96,8 +98,37 @@ public:
 	template <typename T>
 	bool compare(std::vector<T> const& array) const;
 
+	// Tables with at least this number of properties use a hash index for the lookup by name.
+	static constexpr size_t NAME_INDEX_THRESHOLD = 16;
+
+	// Counter incremented by every structural change of this Table or of a Table nested inside it, i.e. when properties
+	// are added, removed, renamed or replaced. Pointers to values nested inside the Table obtained before the last
+	// structural change may be invalid.
+	uint64_t structureVersion() const {
+		return structureVersion_;
+	}
+
 private:
+	void structureChanged();
+	// Makes this Table the parent of the Tables in `value`, which are then nested inside this Table.
+	void adopt(ValueBase* value);
+
+	// Innermost Table containing this Table, nullptr for Tables that are not nested inside a Table.
+	Table* parent_ = nullptr;
+	uint64_t structureVersion_ = 0;
+
+	// Index of the first property with the given name or -1 if there is none.
+	int findIndex(std::string const& propertyName) const;
+	void rebuildNameIndex();
+
 	std::vector<std::pair<std::string, std::unique_ptr<ValueBase>>> properties_;
+
+	// Maps property names to the index of the first property with that name.
+	// Only kept for tables with at least NAME_INDEX_THRESHOLD properties; the property order is not affected.
+	// The index is updated by the modifying functions, so lookups don't write to the Table and concurrent
+	// lookups on the same Table are safe.
+	std::unordered_map<std::string, size_t> nameIndex_;
+	bool nameIndexValid_ = false;
 };
 
 }
\ No newline at end of file
@@ -23,12 +23,9 @@ Table::Table(const Table& other, std::function<SEditorObject(SEditorObject)>* tr
 }
 
 ValueBase* Table::get(std::string const& propertyName) {
-	auto it = std::find_if(properties_.begin(), properties_.end(),
-		[&propertyName](auto const& item) {
-			return item.first == propertyName;
-		});
-	if (it != properties_.end()) {
-		return it->second.get();
+	int index = findIndex(propertyName);
+	if (index != -1) {
+		return properties_[index].second.get();
 	}
 	return nullptr;
 }
@@ -41,12 +38,9 @@ ValueBase* Table::get(size_t index) {
 }
 
 const ValueBase* Table::get(std::string const& propertyName) const {
-	auto it = std::find_if(properties_.begin(), properties_.end(),
-		[&propertyName](auto const& item) {
-			return item.first == propertyName;
-		});
-	if (it != properties_.end()) {
-		return it->second.get();
+	int index = findIndex(propertyName);
+	if (index != -1) {
+		return properties_[index].second.get();
 	}
 	return nullptr;
 }
@@ -69,55 +63,92 @@ const std::string& Table::name(size_t index) const {
 }
 
 int Table::index(std::string const& propertyName) const {
-	auto it = std::find_if(properties_.begin(), properties_.end(),
-		[&propertyName](auto const& item) {
-			return item.first == propertyName;
-		});
-	if (it != properties_.end()) {
-		return static_cast<int>(it - properties_.begin());
+	return findIndex(propertyName);
+}
+
+int Table::findIndex(std::string const& propertyName) const {
+	if (!nameIndexValid_) {
+		auto it = std::find_if(properties_.begin(), properties_.end(),
+			[&propertyName](auto const& item) {
+				return item.first == propertyName;
+			});
+		if (it != properties_.end()) {
+			return static_cast<int>(it - properties_.begin());
+		}
+		return -1;
+	}
+
+	auto it = nameIndex_.find(propertyName);
+	if (it != nameIndex_.end()) {
+		return static_cast<int>(it->second);
 	}
 	return -1;
 }
 
+void Table::structureChanged() {
+	for (Table* table = this; table; table = table->parent_) {
+		++table->structureVersion_;
+	}
+}
+
+void Table::adopt(ValueBase* value) {
+	if (value->type() == PrimitiveType::Table) {
+		value->asTable().parent_ = this;
+	} else if (value->type() == PrimitiveType::Struct) {
+		auto& members = value->getSubstructure();
+		for (size_t index = 0; index < members.size(); index++) {
+			adopt(members.get(index));
+		}
+	}
+}
+
+void Table::rebuildNameIndex() {
+	nameIndex_.clear();
+	nameIndexValid_ = properties_.size() >= NAME_INDEX_THRESHOLD;
+	if (nameIndexValid_) {
+		nameIndex_.reserve(properties_.size());
+		for (size_t index = 0; index < properties_.size(); index++) {
+			// emplace keeps the existing entry for duplicate names, i.e. the first property with the name.
+			nameIndex_.emplace(properties_[index].first, index);
+		}
+	}
+}
+
 
 ValueBase *Table::addProperty(std::string const &name, PrimitiveType type)
 {
-	properties_.emplace_back(std::make_pair(name, ValueBase::create(type)));
-	return properties_.back().second.get();
+	return addProperty(name, ValueBase::create(type));
 }
 
 ValueBase* Table::addProperty(std::string const& name, ValueBase* property, int index_before) {
 	assert(index_before >= -1 && index_before <= static_cast<int>(properties_.size()));
 
-	if (index_before == -1) {
-		properties_.emplace_back(std::make_pair(name, std::unique_ptr<ValueBase>(property)));
-		return properties_.back().second.get();
-	}
-
-	return properties_.insert(properties_.begin() + index_before, std::make_pair(name, std::unique_ptr<ValueBase>(property)))->second.get();
+	return addProperty(name, std::unique_ptr<ValueBase>(property), index_before);
 }
 
 ValueBase* Table::addProperty(const std::string& name, std::unique_ptr<ValueBase>&& property, int index_before) {
 	assert(index_before >= -1 && index_before <= static_cast<int>(properties_.size()));
 
-	if (index_before == -1) {
+	structureChanged();
+	adopt(property.get());
+	if (index_before == -1 || index_before == static_cast<int>(properties_.size())) {
 		properties_.emplace_back(std::make_pair(name, std::move(property)));
+		if (nameIndexValid_) {
+			nameIndex_.emplace(name, properties_.size() - 1);
+		} else if (properties_.size() >= NAME_INDEX_THRESHOLD) {
+			rebuildNameIndex();
+		}
 		return properties_.back().second.get();
 	}
 
-	return properties_.insert(properties_.begin() + index_before, std::make_pair(name, std::move(property)))->second.get();
+	auto newValue = properties_.insert(properties_.begin() + index_before, std::make_pair(name, std::move(property)))->second.get();
+	rebuildNameIndex();
+	return newValue;
 }
 
 
 ValueBase* Table::addProperty(PrimitiveType type, int index_before) {
-	assert(index_before >= -1 && index_before <= static_cast<int>(properties_.size()));
-
-	if (index_before == -1) {
-		properties_.emplace_back(std::make_pair(std::string(), ValueBase::create(type)));
-		return properties_.back().second.get();
-	}
-
-	return properties_.insert(properties_.begin() + index_before, std::make_pair(std::string(), ValueBase::create(type)))->second.get();
+	return addProperty(std::string(), ValueBase::create(type), index_before);
 }
 
 ValueBase* Table::addProperty(ValueBase* property, int index_before) {
@@ -125,19 +156,14 @@ ValueBase* Table::addProperty(ValueBase* property, int index_before) {
 }
 
 ValueBase* Table::addProperty(std::unique_ptr<ValueBase>&& property, int index_before) {
-	assert(index_before >= -1 && index_before <= static_cast<int>(properties_.size()));
-
-	if (index_before == -1) {
-		properties_.emplace_back(std::make_pair(std::string(), std::move(property)));
-		return properties_.back().second.get();
-	}
-
-	return properties_.insert(properties_.begin() + index_before, std::make_pair(std::string(), std::move(property)))->second.get();
+	return addProperty(std::string(), std::move(property), index_before);
 }
 
 void Table::removeProperty(size_t index) {
 	assert(index < properties_.size());
 	properties_.erase(properties_.begin() + index);
+	rebuildNameIndex();
+	structureChanged();
 }
 
 void Table::removeProperty(std::string const &propertyName) {
@@ -148,18 +174,19 @@ void Table::removeProperty(std::string const &propertyName) {
 }
 
 void Table::renameProperty(const std::string& oldName, const std::string& newName) {
-	auto it = std::find_if(properties_.begin(), properties_.end(),
-		[&oldName](auto const& item) {
-			return item.first == oldName;
-		});
-	if (it != properties_.end()) {
-		it->first = newName;
+	int index = findIndex(oldName);
+	if (index != -1) {
+		properties_[index].first = newName;
+		rebuildNameIndex();
+		structureChanged();
 	}
 }
 
 void Table::replaceProperty(size_t index, ValueBase* property) {
 	if (index < properties_.size()) {
 		properties_[index].second = std::unique_ptr<ValueBase>(property);
+		adopt(property);
+		structureChanged();
 	}
 }
 
@@ -172,6 +199,8 @@ void Table::replaceProperty(const std::string& name, ValueBase* property) {
 
 void Table::clear() {
 	properties_.clear();
+	rebuildNameIndex();
+	structureChanged();
 }
 
 template<typename T>
@@ -181,7 +210,7 @@ template<> struct TypeMap<std::string> { static const PrimitiveType primType = P
 
 template<typename T>
 void Table::set(std::vector<T> const& array) {
-	properties_.clear();
+	clear();
 
 	for (auto item : array) {
 		ValueBase* prop = addProperty(TypeMap<T>::primType);
@@ -232,7 +261,7 @@ template bool Table::compare<std::string>(std::vector<std::string> const& array)
 
 
 Table& Table::operator=(const Table& value) {
-	properties_.clear();
+	clear();
 	for (auto const &item : value.properties_) {
 		addProperty(item.first, item.second->clone(nullptr));
 	}
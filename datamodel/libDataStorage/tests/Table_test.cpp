@@ -0,0 +1,130 @@
+/*
+ * SPDX-License-Identifier: MPL-2.0
+ *
+ * This file is part of Ramses Composer
+ * (see https://github.com/GENIVI/ramses-composer).
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "data_storage/Table.h"
+#include "data_storage/Value.h"
+
+#include "gtest/gtest.h"
+
+#include <string>
+#include <thread>
+
+using namespace raco::data_storage;
+
+namespace {
+
+void fillTable(Table& table, size_t count) {
+	for (size_t index = 0; index < count; index++) {
+		table.addProperty("prop_" + std::to_string(index), PrimitiveType::Int)->set(static_cast<int>(index));
+	}
+}
+
+void checkLookup(const Table& table) {
+	for (size_t index = 0; index < table.size(); index++) {
+		EXPECT_EQ(table.index(table.name(index)), static_cast<int>(index));
+		EXPECT_EQ(table.get(table.name(index)), table.get(index));
+	}
+	EXPECT_EQ(table.index("missing"), -1);
+	EXPECT_EQ(table.get("missing"), nullptr);
+}
+
+}  // namespace
+
+TEST(TableTest, lookup_above_index_threshold) {
+	Table table;
+	fillTable(table, 2 * Table::NAME_INDEX_THRESHOLD);
+	checkLookup(table);
+
+	table.addProperty("appended", PrimitiveType::Double);
+	checkLookup(table);
+
+	table.addProperty("inserted", ValueBase::create(PrimitiveType::Double), 3);
+	EXPECT_EQ(table.index("inserted"), 3);
+	EXPECT_EQ(table.index("prop_3"), 4);
+	checkLookup(table);
+
+	table.removeProperty("prop_0");
+	EXPECT_EQ(table.index("prop_0"), -1);
+	EXPECT_EQ(table.index("inserted"), 2);
+	checkLookup(table);
+
+	table.renameProperty("prop_5", "renamed");
+	EXPECT_EQ(table.index("prop_5"), -1);
+	EXPECT_EQ(table.get("renamed")->asInt(), 5);
+	checkLookup(table);
+}
+
+TEST(TableTest, lookup_across_index_threshold) {
+	Table table;
+	fillTable(table, Table::NAME_INDEX_THRESHOLD - 1);
+	checkLookup(table);
+
+	table.addProperty("crossing", PrimitiveType::Int);
+	checkLookup(table);
+
+	table.removeProperty(0);
+	checkLookup(table);
+
+	table.clear();
+	EXPECT_EQ(table.index("crossing"), -1);
+	fillTable(table, 3 * Table::NAME_INDEX_THRESHOLD);
+	checkLookup(table);
+}
+
+TEST(TableTest, lookup_duplicate_names_finds_first) {
+	Table table;
+	for (size_t index = 0; index < 2 * Table::NAME_INDEX_THRESHOLD; index++) {
+		table.addProperty(PrimitiveType::Int);
+	}
+	table.addProperty("named", PrimitiveType::Int);
+	EXPECT_EQ(table.index(""), 0);
+	EXPECT_EQ(table.index("named"), static_cast<int>(2 * Table::NAME_INDEX_THRESHOLD));
+
+	table.addProperty("named", ValueBase::create(PrimitiveType::Int), 1);
+	EXPECT_EQ(table.index("named"), 1);
+}
+
+TEST(TableTest, copy_keeps_order_and_lookup) {
+	Table table;
+	fillTable(table, 2 * Table::NAME_INDEX_THRESHOLD);
+	checkLookup(table);
+
+	Table copy(table);
+	EXPECT_EQ(copy.propertyNames(), table.propertyNames());
+	checkLookup(copy);
+
+	Table assigned;
+	fillTable(assigned, 5);
+	assigned = table;
+	EXPECT_EQ(assigned.propertyNames(), table.propertyNames());
+	checkLookup(assigned);
+}
+
+TEST(TableTest, concurrent_lookup) {
+	Table table;
+	fillTable(table, 4 * Table::NAME_INDEX_THRESHOLD);
+	table.removeProperty("prop_0");
+
+	// Lookups don't modify the Table, so they can run on several threads at once.
+	std::vector<int> mismatches(4, 0);
+	std::vector<std::thread> threads;
+	for (size_t thread = 0; thread < mismatches.size(); thread++) {
+		threads.emplace_back([&table, &mismatches, thread]() {
+			for (size_t index = 0; index < table.size(); index++) {
+				if (table.index(table.name(index)) != static_cast<int>(index)) {
+					++mismatches[thread];
+				}
+			}
+		});
+	}
+	for (auto& thread : threads) {
+		thread.join();
+	}
+	EXPECT_EQ(mismatches, std::vector<int>(4, 0));
+}
@@ -53,6 +53,10 @@ public:
 	std::vector<std::unique_ptr<Entry>>& stack() {
 		return stack_;
 	}
+
+	raco::core::Project& state() {
+		return state_;
+	}
 };
 
 template <class BaseClass = ::testing::Test>
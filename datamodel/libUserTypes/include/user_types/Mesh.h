@@ -25,7 +25,7 @@ public:
 		return typeDescription;
 	}
 
-	Mesh(Mesh const& other) : BaseObject(other), uri_(other.uri_), meshIndex_(other.meshIndex_), bakeMeshes_(other.bakeMeshes_), materialNames_(other.materialNames_)
+	Mesh(Mesh const& other) : BaseObject(other), uri_(other.uri_), meshIndex_(other.meshIndex_), bakeMeshes_(other.bakeMeshes_), optimizeMesh_(other.optimizeMesh_), materialNames_(other.materialNames_)
 	{
 		fillPropertyDescription();
 	}
@@ -39,6 +39,7 @@ public:
 		properties_.emplace_back("uri", &uri_);
 		properties_.emplace_back("meshIndex", &meshIndex_);
 		properties_.emplace_back("bakeMeshes", &bakeMeshes_);
+		properties_.emplace_back("optimizeMesh", &optimizeMesh_);
 		properties_.emplace_back("materialNames", &materialNames_);
 	}
 
@@ -51,6 +52,7 @@ public:
 
 	Property<int, DisplayNameAnnotation> meshIndex_{0, DisplayNameAnnotation("Mesh Index")};
 	Property<bool, DisplayNameAnnotation> bakeMeshes_{true, DisplayNameAnnotation("Bake All Meshes")};
+	Property<bool, DisplayNameAnnotation> optimizeMesh_{false, DisplayNameAnnotation("Optimize Mesh")};
 	
 	Property<Table, ArraySemanticAnnotation, HiddenProperty> materialNames_{{}, {}, {}};
 	
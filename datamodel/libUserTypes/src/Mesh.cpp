@@ -25,6 +25,7 @@ void Mesh::updateFromExternalFile(BaseContext& context) {
 	desc.absPath = PathQueries::resolveUriPropertyToAbsolutePath(*context.project(), {shared_from_this(), &Mesh::uri_});
 	desc.bakeAllSubmeshes = bakeMeshes_.asBool();
 	desc.submeshIndex = meshIndex_.asInt();
+	desc.optimize = optimizeMesh_.asBool();
 
 	if (validateURI(context, {shared_from_this(), &Mesh::uri_})) {
 		mesh_ = context.meshCache()->loadMesh(desc);
@@ -52,6 +53,7 @@ void Mesh::updateFromExternalFile(BaseContext& context) {
 
 		infoText += fmt::format("Triangles: {}\n", selectedMesh->numTriangles());
 		infoText += fmt::format("Vertices: {}\n", selectedMesh->numVertices());
+		infoText += fmt::format("Index Size: {} bit\n", selectedMesh->getIndices16().empty() ? 32 : 16);
 		//infoText += fmt::format("Submeshes: {}\n", selectedMesh->numSubmeshes());
 		infoText += fmt::format("Total Asset File Meshes: {}\n", context.meshCache()->getTotalMeshCount(desc.absPath));
 		infoText += "\nAttributes:";
@@ -77,7 +79,7 @@ std::vector<std::string> Mesh::materialNames() {
 void Mesh::onAfterValueChanged(BaseContext& context, ValueHandle const& value) {
 	BaseObject::onAfterValueChanged(context, value);
 
-	if (value.isRefToProp(&Mesh::bakeMeshes_) || !bakeMeshes_.asBool() && value.isRefToProp(&Mesh::meshIndex_)) {
+	if (value.isRefToProp(&Mesh::bakeMeshes_) || value.isRefToProp(&Mesh::optimizeMesh_) || !bakeMeshes_.asBool() && value.isRefToProp(&Mesh::meshIndex_)) {
 		context.changeMultiplexer().recordPreviewDirty(shared_from_this());
 		updateFromExternalFile(context);
 	}
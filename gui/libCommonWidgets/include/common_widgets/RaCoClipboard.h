@@ -9,8 +9,13 @@
  */
 #pragma once
 
+#include <memory>
 #include <string>
 
+namespace raco::core {
+class ObjectsSnapshot;
+}
+
 namespace raco::MimeTypes {
 constexpr const char* EDITOR_OBJECT_ID = "raco/editor-object-id";
 constexpr const char* VALUE_HANDLE_PATH = "raco/value-handle-path";
@@ -20,7 +25,11 @@ constexpr const char* EDITOR_OBJECT_CLIPBOARD = "application/raco-json";
 namespace raco::RaCoClipboard {
 
 void set(const std::string& content);
+// Put copied objects on the clipboard: the JSON text is only created when it is requested, e.g. by another process.
+void set(const std::shared_ptr<const core::ObjectsSnapshot>& snapshot);
 bool hasEditorObject();
 std::string get();
+// The snapshot set by this process if it is still on the clipboard, nullptr otherwise.
+std::shared_ptr<const core::ObjectsSnapshot> getSnapshot();
 
 }  // namespace raco::RaCoClipboard
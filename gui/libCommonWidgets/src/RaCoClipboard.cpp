@@ -9,10 +9,53 @@
  */
 #include "common_widgets/RaCoClipboard.h"
 
+#include "core/ObjectsSnapshot.h"
+
 #include <QApplication>
 #include <QClipboard>
 #include <QMimeData>
 
+namespace {
+
+// Clipboard data of copied objects which serializes the snapshot on the first request of its text.
+class SnapshotMimeData : public QMimeData {
+public:
+	explicit SnapshotMimeData(std::shared_ptr<const raco::core::ObjectsSnapshot> snapshot) : snapshot_(std::move(snapshot)) {
+	}
+
+	const std::shared_ptr<const raco::core::ObjectsSnapshot>& snapshot() const {
+		return snapshot_;
+	}
+
+	bool hasFormat(const QString& mimeType) const override {
+		return formats().contains(mimeType);
+	}
+
+	QStringList formats() const override {
+		return {"text/plain", raco::MimeTypes::EDITOR_OBJECT_CLIPBOARD};
+	}
+
+protected:
+	QVariant retrieveData(const QString& mimeType, QVariant::Type type) const override {
+		if (!hasFormat(mimeType)) {
+			return {};
+		}
+		if (serialized_.isNull()) {
+			serialized_ = QByteArray::fromStdString(snapshot_->serialize());
+		}
+		if (type == QVariant::String) {
+			return QString::fromUtf8(serialized_);
+		}
+		return serialized_;
+	}
+
+private:
+	std::shared_ptr<const raco::core::ObjectsSnapshot> snapshot_;
+	mutable QByteArray serialized_;
+};
+
+}  // namespace
+
 void raco::RaCoClipboard::set(const std::string& content) {
 	QMimeData* mimeData = new QMimeData();
 	mimeData->setData("text/plain", content.c_str());
@@ -20,6 +63,10 @@ void raco::RaCoClipboard::set(const std::string& content) {
 	QApplication::clipboard()->setMimeData(mimeData);
 }
 
+void raco::RaCoClipboard::set(const std::shared_ptr<const core::ObjectsSnapshot>& snapshot) {
+	QApplication::clipboard()->setMimeData(new SnapshotMimeData(snapshot));
+}
+
 bool raco::RaCoClipboard::hasEditorObject() {
 	return QApplication::clipboard()->mimeData()->formats().contains(MimeTypes::EDITOR_OBJECT_CLIPBOARD);
 }
@@ -32,3 +79,11 @@ std::string raco::RaCoClipboard::get() {
 		return QApplication::clipboard()->text().toStdString();
 	}
 }
+
+std::shared_ptr<const raco::core::ObjectsSnapshot> raco::RaCoClipboard::getSnapshot() {
+	// The clipboard only returns our own mime data object while this process owns the clipboard.
+	if (auto mimeData = dynamic_cast<const SnapshotMimeData*>(QApplication::clipboard()->mimeData())) {
+		return mimeData->snapshot();
+	}
+	return nullptr;
+}
@@ -31,6 +31,7 @@ Traversal through the entire tree is guaranteed by the iterateThroughTree() meth
 #include "style/Icons.h"
 
 #include "core/ExtrefOperations.h"
+#include "core/ObjectsSnapshot.h"
 
 #include <QAbstractItemModel>
 
@@ -92,6 +93,8 @@ public:
 
 public:
 	std::pair<std::vector<core::SEditorObject>, std::set<std::string>> getObjectsAndRootIdsFromClipboardString(const std::string& serializedObjs) const;
+	// Same as getObjectsAndRootIdsFromClipboardString for the clipboard content, using its snapshot if there is one.
+	std::pair<std::vector<core::SEditorObject>, std::set<std::string>> getObjectsAndRootIdsFromClipboard() const;
 	
 	virtual bool canCopyAtIndices(const QModelIndexList& index) const;
 	virtual bool canDeleteAtIndices(const QModelIndexList& indices) const;
@@ -112,6 +115,9 @@ public Q_SLOTS:
 	virtual void copyObjectsAtIndices(const QModelIndexList& indices, bool deepCopy);
 	virtual void cutObjectsAtIndices(const QModelIndexList& indices, bool deepCut);
 	virtual bool pasteObjectAtIndex(const QModelIndex& index, bool pasteAsExtref = false, std::string* outError = nullptr, const std::string& serializedObjects = RaCoClipboard::get());
+	virtual bool pasteObjectAtIndex(const QModelIndex& index, bool pasteAsExtref, std::string* outError, const core::SObjectsSnapshot& snapshot);
+	// Paste the snapshot on the clipboard if there is one and the clipboard text otherwise.
+	bool pasteClipboardAtIndex(const QModelIndex& index, bool pasteAsExtref = false, std::string* outError = nullptr);
 	void moveScenegraphChildren(const std::vector<core::SEditorObject>& objects, core::SEditorObject parent, int row = -1);
 	void importMeshScenegraph(const QString& filePath, const QModelIndex& selectedIndex);
 	void deleteUnusedResources();
@@ -60,6 +60,7 @@ public Q_SLOTS:
 	void copyObjectsAtIndices(const QModelIndexList& indices, bool deepCopy) override;
 	void cutObjectsAtIndices(const QModelIndexList& indices, bool deepCut) override;
 	bool pasteObjectAtIndex(const QModelIndex& index, bool pasteAsExtref = false, std::string* outError = nullptr, const std::string& serializedObjects = RaCoClipboard::get()) override;
+	bool pasteObjectAtIndex(const QModelIndex& index, bool pasteAsExtref, std::string* outError, const core::SObjectsSnapshot& snapshot) override;
 
 protected:
 	void buildObjectTree() override;
@@ -22,6 +22,7 @@ public:
 	ObjectTreeViewResourceModel(raco::core::CommandInterface* commandInterface, components::SDataChangeDispatcher dispatcher, core::ExternalProjectsStoreInterface* externalProjectStore, const std::vector<std::string>& allowedCreatableUserTypes = {});
 
 	bool pasteObjectAtIndex(const QModelIndex& index, bool pasteAsExtref, std::string* outError, const std::string& serializedObjects = RaCoClipboard::get()) override;
+	bool pasteObjectAtIndex(const QModelIndex& index, bool pasteAsExtref, std::string* outError, const core::SObjectsSnapshot& snapshot) override;
 
 	std::vector<std::string> typesAllowedIntoIndex(const QModelIndex& index) const override;
 	bool isObjectAllowedIntoIndex(const QModelIndex& index, const core::SEditorObject& obj) const override;
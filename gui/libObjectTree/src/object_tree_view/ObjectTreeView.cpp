@@ -159,7 +159,7 @@ void ObjectTreeView::cut() {
 
 void ObjectTreeView::globalPasteCallback(const QModelIndex &index, bool asExtRef) {
 	if (canPasteIntoIndex(index, asExtRef)) {
-		treeModel_->pasteObjectAtIndex(index, asExtRef);
+		treeModel_->pasteClipboardAtIndex(index, asExtRef);
 	}
 }
 
@@ -188,7 +188,7 @@ bool ObjectTreeView::canPasteIntoIndex(const QModelIndex &index, bool asExtref)
 	if (!RaCoClipboard::hasEditorObject()) {
 		return false;
 	} else {
-		auto [pasteObjects, sourceProjectTopLevelObjectIds] = treeModel_->getObjectsAndRootIdsFromClipboardString(RaCoClipboard::get());
+		auto [pasteObjects, sourceProjectTopLevelObjectIds] = treeModel_->getObjectsAndRootIdsFromClipboard();
 		return treeModel_->canPasteIntoIndex(index, pasteObjects, sourceProjectTopLevelObjectIds, asExtref);
 	}
 
@@ -263,14 +263,14 @@ QMenu* ObjectTreeView::createCustomContextMenu(const QPoint &p) {
 	}, QKeySequence::Copy);
 	actionCopy->setEnabled(canCopySelectedIndices);
 
-	auto [pasteObjects, sourceProjectTopLevelObjectIds] = treeModel_->getObjectsAndRootIdsFromClipboardString(RaCoClipboard::get());
+	auto [pasteObjects, sourceProjectTopLevelObjectIds] = treeModel_->getObjectsAndRootIdsFromClipboard();
 	QAction* actionPaste;
 	if (treeModel_->canPasteIntoIndex(insertionTargetIndex, pasteObjects, sourceProjectTopLevelObjectIds)) {
 		actionPaste = treeViewMenu->addAction(
-			"Paste Here", [this, insertionTargetIndex]() { treeModel_->pasteObjectAtIndex(insertionTargetIndex); }, QKeySequence::Paste);
+			"Paste Here", [this, insertionTargetIndex]() { treeModel_->pasteClipboardAtIndex(insertionTargetIndex); }, QKeySequence::Paste);
 	} else if (treeModel_->canPasteIntoIndex({}, pasteObjects, sourceProjectTopLevelObjectIds)) {
 		actionPaste = treeViewMenu->addAction(
-			"Paste Into Project", [this]() { treeModel_->pasteObjectAtIndex(QModelIndex()); }, QKeySequence::Paste);
+			"Paste Into Project", [this]() { treeModel_->pasteClipboardAtIndex(QModelIndex()); }, QKeySequence::Paste);
 	} else {
 		actionPaste = treeViewMenu->addAction("Paste", [](){}, QKeySequence::Paste);
 		actionPaste->setEnabled(false);
@@ -302,7 +302,7 @@ QMenu* ObjectTreeView::createCustomContextMenu(const QPoint &p) {
 		auto extrefPasteAction = treeViewMenu->addAction(
 			"Paste As External Reference", [this]() {
 				std::string error;
-				if (!treeModel_->pasteObjectAtIndex({}, true, &error)) {
+				if (!treeModel_->pasteClipboardAtIndex({}, true, &error)) {
 					QMessageBox::warning(this, "Paste As External Reference",
 						fmt::format("Update of pasted external references failed!\n\n{}", error).c_str());
 				}
@@ -293,10 +293,10 @@ bool ObjectTreeViewDefaultModel::dropMimeData(const QMimeData* data, Qt::DropAct
 				objs.emplace_back(externalProjectObj);
 			}
 		}
-		auto serializedObjects = originCommandInterface->copyObjects(objs, true);
+		auto snapshot = originCommandInterface->copyObjectsSnapshot(objs, true);
 
 		auto pressedKeys = QGuiApplication::queryKeyboardModifiers();
-		pasteObjectAtIndex(parent, pressedKeys.testFlag(Qt::KeyboardModifier::AltModifier), nullptr, serializedObjects);
+		pasteObjectAtIndex(parent, pressedKeys.testFlag(Qt::KeyboardModifier::AltModifier), nullptr, snapshot);
 	}
 
 	return true;
@@ -383,19 +383,7 @@ void ObjectTreeViewDefaultModel::setUpTreeModificationFunctions() {
 }
 
 SEditorObject ObjectTreeViewDefaultModel::createNewObject(const EditorObject::TypeDescriptor& typeDesc, const std::string& nodeName, const QModelIndex& parent) {
-	std::vector<SEditorObject> nodes;
-	if (!parent.isValid()) {
-		std::copy_if(project()->instances().begin(), project()->instances().end(), std::back_inserter(nodes), [](const SEditorObject& obj) { return obj->getParent() == nullptr; });
-	} else {
-		std::copy_if(project()->instances().begin(), project()->instances().end(), std::back_inserter(nodes), [this, parent](const SEditorObject& obj) {
-			if (parent.isValid()) {
-				return obj->getParent() == indexToSEditorObject(parent);
-			} else {
-				return false;
-			}
-		});
-	}
-	auto name = project()->findAvailableUniqueName(nodes.begin(), nodes.end(), nullptr, nodeName.empty() ? raco::components::Naming::format(typeDesc.typeName) : nodeName);
+	auto name = project()->findAvailableUniqueName(parent.isValid() ? indexToSEditorObject(parent) : nullptr, nullptr, nodeName.empty() ? raco::components::Naming::format(typeDesc.typeName) : nodeName);
 
 	auto newObj = commandInterface_->createObject(typeDesc.typeName, name, std::string(), parent.isValid() ? indexToSEditorObject(parent) : nullptr);
 
@@ -433,6 +421,16 @@ std::pair<std::vector<core::SEditorObject>, std::set<std::string>> ObjectTreeVie
 	return {objects, deserialization.rootObjectIDs};
 }
 
+std::pair<std::vector<core::SEditorObject>, std::set<std::string>> ObjectTreeViewDefaultModel::getObjectsAndRootIdsFromClipboard() const {
+	if (auto snapshot = RaCoClipboard::getSnapshot()) {
+		auto deserialization{snapshot->deserialize(*commandInterface_->objectFactory())};
+		auto objects = BaseContext::getTopLevelObjectsFromDeserializedObjects(deserialization, commandInterface_->objectFactory(), project());
+
+		return {objects, deserialization.rootObjectIDs};
+	}
+	return getObjectsAndRootIdsFromClipboardString(RaCoClipboard::get());
+}
+
 bool ObjectTreeViewDefaultModel::canPasteIntoIndex(const QModelIndex& index, const std::vector<core::SEditorObject>& objects, const std::set<std::string>& sourceProjectTopLevelObjectIds, bool asExtRef) const {
 	if (asExtRef) {
 		if (index.isValid()) {
@@ -475,7 +473,7 @@ void ObjectTreeViewDefaultModel::deleteUnusedResources() {
 
 void ObjectTreeViewDefaultModel::copyObjectsAtIndices(const QModelIndexList& indices, bool deepCopy) {
 	auto objects = indicesToSEditorObjects(indices);
-	RaCoClipboard::set(commandInterface_->copyObjects(objects, deepCopy));
+	RaCoClipboard::set(commandInterface_->copyObjectsSnapshot(objects, deepCopy));
 }
 
 bool ObjectTreeViewDefaultModel::pasteObjectAtIndex(const QModelIndex& index, bool pasteAsExtref, std::string* outError, const std::string& serializedObjects) {
@@ -484,11 +482,23 @@ bool ObjectTreeViewDefaultModel::pasteObjectAtIndex(const QModelIndex& index, bo
 	return success;
 }
 
+bool ObjectTreeViewDefaultModel::pasteObjectAtIndex(const QModelIndex& index, bool pasteAsExtref, std::string* outError, const core::SObjectsSnapshot& snapshot) {
+	bool success = true;
+	commandInterface_->pasteObjects(*snapshot, indexToSEditorObject(index), pasteAsExtref, &success, outError);
+	return success;
+}
+
+bool ObjectTreeViewDefaultModel::pasteClipboardAtIndex(const QModelIndex& index, bool pasteAsExtref, std::string* outError) {
+	if (auto snapshot = RaCoClipboard::getSnapshot()) {
+		return pasteObjectAtIndex(index, pasteAsExtref, outError, snapshot);
+	}
+	return pasteObjectAtIndex(index, pasteAsExtref, outError, RaCoClipboard::get());
+}
+
 void ObjectTreeViewDefaultModel::cutObjectsAtIndices(const QModelIndexList& indices, bool deepCut) {
 	auto objects = indicesToSEditorObjects(indices);
-	auto text = commandInterface_->cutObjects(objects, deepCut);
-	if (!text.empty()) {
-		RaCoClipboard::set(text);
+	if (auto snapshot = commandInterface_->cutObjectsSnapshot(objects, deepCut)) {
+		RaCoClipboard::set(snapshot);
 	}
 }
 
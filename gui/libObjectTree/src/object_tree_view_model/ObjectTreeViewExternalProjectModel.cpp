@@ -128,7 +128,7 @@ void ObjectTreeViewExternalProjectModel::copyObjectsAtIndices(const QModelIndexL
 	}
 
 	if (commandInterface) {
-		RaCoClipboard::set(commandInterface->copyObjects(objects, deepCopy));
+		RaCoClipboard::set(commandInterface->copyObjectsSnapshot(objects, deepCopy));
 	}
 }
 
@@ -226,4 +226,9 @@ bool ObjectTreeViewExternalProjectModel::pasteObjectAtIndex(const QModelIndex& i
 	return true;
 }
 
+bool ObjectTreeViewExternalProjectModel::pasteObjectAtIndex(const QModelIndex& index, bool pasteAsExtref, std::string* outError, const core::SObjectsSnapshot& snapshot) {
+	// Don't modify external project structure.
+	return true;
+}
+
 }  // namespace raco::object_tree::model
\ No newline at end of file
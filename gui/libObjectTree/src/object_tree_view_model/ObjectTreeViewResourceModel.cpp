@@ -25,6 +25,11 @@ bool ObjectTreeViewResourceModel::pasteObjectAtIndex(const QModelIndex& index, b
 	return ObjectTreeViewDefaultModel::pasteObjectAtIndex({}, pasteAsExtref, outError, serializedObjects);
 }
 
+bool ObjectTreeViewResourceModel::pasteObjectAtIndex(const QModelIndex& index, bool pasteAsExtref, std::string* outError, const core::SObjectsSnapshot& snapshot) {
+	// ignore index: resources always get pasted at top level.
+	return ObjectTreeViewDefaultModel::pasteObjectAtIndex({}, pasteAsExtref, outError, snapshot);
+}
+
 bool ObjectTreeViewResourceModel::isObjectAllowedIntoIndex(const QModelIndex& index, const core::SEditorObject& obj) const {
 	// Only allow root level pasting here, thus only invalid indices are ok.
 	return !index.isValid() && ObjectTreeViewDefaultModel::isObjectAllowedIntoIndex(index, obj);
@@ -9,6 +9,7 @@
  */
 #pragma once
 
+#include <cstddef>
 #include <string>
 #include <vector>
 
@@ -19,4 +20,30 @@ std::string read(const Path& path);
 std::vector<unsigned char> readBinary(const Path& path);
 void write(const Path& path, const std::string& content);
 
+// Read-only memory mapping of a whole file. data() is nullptr if the file can't be opened or mapped, or is empty.
+class MappedFile {
+public:
+	explicit MappedFile(const Path& path);
+	~MappedFile();
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	const unsigned char* data() const {
+		return data_;
+	}
+
+	size_t size() const {
+		return size_;
+	}
+
+private:
+	const unsigned char* data_ = nullptr;
+	size_t size_ = 0;
+#if (defined(__WIN32) || defined(_WIN32))
+	void* file_ = nullptr;
+	void* mapping_ = nullptr;
+#endif
+};
+
 }  // namespace raco::utils::file
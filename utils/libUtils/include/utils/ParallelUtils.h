@@ -0,0 +1,32 @@
+/*
+ * SPDX-License-Identifier: MPL-2.0
+ *
+ * This file is part of Ramses Composer
+ * (see https://github.com/GENIVI/ramses-composer).
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+namespace raco::utils::parallel {
+
+using ChunkFunction = std::function<void(size_t chunk, size_t begin, size_t end)>;
+
+/**
+ * Number of chunks `forEachChunk` splits `count` items into: one per hardware thread, but no chunk smaller than `minChunkSize`.
+ */
+size_t chunkCount(size_t count, size_t minChunkSize);
+
+/**
+ * Splits [0, count) into `chunkCount(count, minChunkSize)` consecutive ranges and calls `function` for each of them,
+ * every chunk on its own thread. The first chunk runs on the calling thread. Returns after all chunks are done.
+ * The chunk boundaries only depend on the arguments, so results collected per chunk can be merged deterministically.
+ * If chunks throw, the exception of the first throwing chunk is rethrown after all threads have finished.
+ */
+void forEachChunk(size_t count, size_t minChunkSize, const ChunkFunction& function);
+
+}  // namespace raco::utils::parallel
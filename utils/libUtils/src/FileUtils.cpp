@@ -17,6 +17,15 @@
 #include <iostream>
 #include <sstream>
 
+#if (defined(__WIN32) || defined(_WIN32))
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 namespace raco::utils::file {
 
 std::string read(const Path& path) {
@@ -58,4 +67,66 @@ void write(const Path& path, const std::string& content) {
 	out.close();
 }
 
+#if (defined(__WIN32) || defined(_WIN32))
+
+MappedFile::MappedFile(const Path& path) {
+	file_ = CreateFileW(std::filesystem::path(path).wstring().c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file_ == INVALID_HANDLE_VALUE) {
+		file_ = nullptr;
+		return;
+	}
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(file_, &fileSize) || fileSize.QuadPart == 0) {
+		return;
+	}
+	mapping_ = CreateFileMappingW(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (!mapping_) {
+		return;
+	}
+	data_ = static_cast<const unsigned char*>(MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0));
+	if (data_) {
+		size_ = static_cast<size_t>(fileSize.QuadPart);
+	}
+}
+
+MappedFile::~MappedFile() {
+	if (data_) {
+		UnmapViewOfFile(data_);
+	}
+	if (mapping_) {
+		CloseHandle(mapping_);
+	}
+	if (file_) {
+		CloseHandle(file_);
+	}
+}
+
+#else
+
+MappedFile::MappedFile(const Path& path) {
+	auto fd = open(path.c_str(), O_RDONLY);
+	if (fd < 0) {
+		return;
+	}
+	struct stat fileStat;
+	if (fstat(fd, &fileStat) == 0 && fileStat.st_size > 0) {
+		auto size = static_cast<size_t>(fileStat.st_size);
+		auto* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (data != MAP_FAILED) {
+			data_ = static_cast<const unsigned char*>(data);
+			size_ = size;
+		}
+	}
+	// The mapping stays valid after closing the file descriptor.
+	close(fd);
+}
+
+MappedFile::~MappedFile() {
+	if (data_) {
+		munmap(const_cast<unsigned char*>(data_), size_);
+	}
+}
+
+#endif
+
 }  // namespace raco::utils::file
@@ -0,0 +1,61 @@
+/*
+ * SPDX-License-Identifier: MPL-2.0
+ *
+ * This file is part of Ramses Composer
+ * (see https://github.com/GENIVI/ramses-composer).
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "utils/ParallelUtils.h"
+
+#include <algorithm>
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace raco::utils::parallel {
+
+size_t chunkCount(size_t count, size_t minChunkSize) {
+	size_t threads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+	size_t maxChunks = std::max<size_t>(count / std::max<size_t>(minChunkSize, 1), 1);
+	return std::min(threads, maxChunks);
+}
+
+void forEachChunk(size_t count, size_t minChunkSize, const ChunkFunction& function) {
+	size_t chunks = chunkCount(count, minChunkSize);
+	auto chunkBegin = [count, chunks](size_t chunk) {
+		return count * chunk / chunks;
+	};
+	if (chunks == 1) {
+		function(0, 0, count);
+		return;
+	}
+
+	std::vector<std::exception_ptr> exceptions(chunks);
+	auto runChunk = [&function, &exceptions, &chunkBegin](size_t chunk) {
+		try {
+			function(chunk, chunkBegin(chunk), chunkBegin(chunk + 1));
+		} catch (...) {
+			exceptions[chunk] = std::current_exception();
+		}
+	};
+
+	std::vector<std::thread> threads;
+	threads.reserve(chunks - 1);
+	for (size_t chunk = 1; chunk < chunks; chunk++) {
+		threads.emplace_back(runChunk, chunk);
+	}
+	runChunk(0);
+	for (auto& thread : threads) {
+		thread.join();
+	}
+
+	for (const auto& exception : exceptions) {
+		if (exception) {
+			std::rethrow_exception(exception);
+		}
+	}
+}
+
+}  // namespace raco::utils::parallel